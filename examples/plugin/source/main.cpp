@@ -105,20 +105,80 @@ struct Voice
     float parameterOffsets[P_COUNT];
 };
 
-struct MyEditor : public yup::AudioProcessorEditor
+struct ParameterSlider : public yup::Slider
+{
+    ParameterSlider (yup::AudioProcessorParameter& parameterToControl)
+        : yup::Slider ("Slider", yup::Font())
+        , parameter (parameterToControl)
+    {
+        updateFromParameter();
+    }
+
+    // Refreshes the slider after the host changed the parameter, without sending the value back
+    void updateFromParameter()
+    {
+        const yup::ScopedValueSetter<bool> svs (isUpdatingFromParameter, true);
+        setValue (parameter.getValue());
+    }
+
+    void valueChanged() override
+    {
+        if (! isUpdatingFromParameter)
+            parameter.setValueNotifyingHost (getValue());
+    }
+
+    // Each edit is wrapped in a gesture, so the host records it as a single automation pass
+    void mouseDown (const yup::MouseEvent& event) override
+    {
+        parameter.beginChangeGesture();
+        yup::Slider::mouseDown (event);
+    }
+
+    void mouseUp (const yup::MouseEvent& event) override
+    {
+        yup::Slider::mouseUp (event);
+        parameter.endChangeGesture();
+    }
+
+    void mouseWheel (const yup::MouseEvent& event, const yup::MouseWheelData& data) override
+    {
+        parameter.beginChangeGesture();
+        yup::Slider::mouseWheel (event, data);
+        parameter.endChangeGesture();
+    }
+
+    yup::AudioProcessorParameter& parameter;
+    bool isUpdatingFromParameter = false;
+};
+
+struct MyEditor
+    : public yup::AudioProcessorEditor
+    , public yup::Timer
 {
     MyEditor (yup::AudioProcessor& processor)
         : audioProcessor (processor)
     {
-        x = std::make_unique<yup::Slider> ("Slider", yup::Font());
-        x->setValue (audioProcessor.getParameter (0).getValue());
-        x->onValueChanged = [this] (float value)
-        {
-            audioProcessor.getParameter (0).setValue (value);
-        };
+        x = std::make_unique<ParameterSlider> (audioProcessor.getParameter (0));
         addAndMakeVisible (*x);
 
         setSize (getPreferredSize().to<float>());
+
+        startTimerHz (30);
+    }
+
+    ~MyEditor() override
+    {
+        stopTimer();
+    }
+
+    void timerCallback() override
+    {
+        // Refresh only the parameters the host changed since the last tick
+        audioProcessor.getHostParameterChanges().forEachChanged ([this] (int parameterIndex)
+        {
+            if (parameterIndex == 0)
+                x->updateFromParameter();
+        });
     }
 
     bool isResizable() const override
@@ -148,7 +208,7 @@ struct MyEditor : public yup::AudioProcessorEditor
     }
 
     yup::AudioProcessor& audioProcessor;
-    std::unique_ptr<yup::Slider> x;
+    std::unique_ptr<ParameterSlider> x;
 };
 
 struct MyPlugin : public yup::AudioProcessor
@@ -190,6 +250,11 @@ struct MyPlugin : public yup::AudioProcessor
         return 1; // One but stereo
     }
 
+    int getMinimumSubBlockSize() const override
+    {
+        return 32; // Follow volume automation inside the host blocks
+    }
+
     void prepareToPlay (float sampleRate, int maxBlockSize) override
     {
         this->sampleRate = sampleRate;
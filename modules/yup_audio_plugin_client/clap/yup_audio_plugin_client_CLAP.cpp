@@ -72,73 +72,174 @@ std::optional<MidiMessage> clapEventToMidiNoteMessage (const clap_event_header_t
 
 //==============================================================================
 
-void clapEventToParameterChange (const clap_event_header_t* event, AudioProcessor& audioProcessor)
+bool clapEventToParameterChange (const clap_event_header_t* event, const AudioProcessor& audioProcessor, ParameterChangeList& parameterChanges)
 {
     if (event->type != CLAP_EVENT_PARAM_VALUE)
-        return;
+        return false;
 
     const clap_event_param_value_t* paramEvent = reinterpret_cast<const clap_event_param_value_t*> (event);
 
     auto parameterIndex = static_cast<int> (paramEvent->param_id);
     if (! yup::isPositiveAndBelow (parameterIndex, audioProcessor.getNumParameters()))
-        return;
+        return false;
 
     auto parameterValue = static_cast<float> (paramEvent->value);
-    audioProcessor.getParameter (parameterIndex).setValue (parameterValue);
+    parameterChanges.addChange (static_cast<int> (event->time), parameterIndex, parameterValue);
+
+    return true;
 }
 
 //==============================================================================
 
-/*
-void pluginSyncMainToAudio (AudioProcessor& audioProcessor, const clap_output_events_t* out)
+template <class FloatType>
+FloatType* const* getClapChannels (const clap_audio_buffer_t& buffer) noexcept;
+
+template <>
+float* const* getClapChannels<float> (const clap_audio_buffer_t& buffer) noexcept
+{
+    return buffer.data32;
+}
+
+template <>
+double* const* getClapChannels<double> (const clap_audio_buffer_t& buffer) noexcept
 {
-    auto sl = yup::CriticalSection::ScopedLockType (plugin->syncParameters);
+    return buffer.data64;
+}
+
+/** Maps the host audio ports to the channels of an AudioBuffer without copying.
 
-    for (uint32_t i = 0; i < P_COUNT; i++)
+    Each port is a stereo bus, so the bus channels are laid out as pairs in the buffer. Output
+    channels are used directly, and inputs are only copied into them when the host isn't
+    processing in place. Channels without a host buffer are backed by preallocated scratch space.
+*/
+template <class FloatType>
+class AudioBusMappingCLAP
+{
+public:
+    void prepare (int numChannelsToUse, int maximumSamples)
     {
-        if (plugin->mainChanged[i])
+        numChannels = numChannelsToUse;
+        maxSamples = maximumSamples;
+
+        scratchBuffer.setSize (numChannels, maxSamples);
+        channels.resize (static_cast<std::size_t> (numChannels));
+    }
+
+    AudioBuffer<FloatType>& map (const clap_process_t& process)
+    {
+        const int numSamples = static_cast<int> (process.frames_count);
+        jassert (numSamples <= maxSamples);
+
+        bool allInputsSilent = true;
+
+        for (int channel = 0; channel < numChannels; ++channel)
         {
-            plugin->parameters[i] = plugin->mainParameters[i];
-            plugin->mainChanged[i] = false;
+            auto output = getChannel (process.audio_outputs, process.audio_outputs_count, channel);
+            channels[static_cast<std::size_t> (channel)] = output != nullptr ? output : scratchBuffer.getWritePointer (channel);
 
+            if (auto input = getChannel (process.audio_inputs, process.audio_inputs_count, channel))
+                allInputsSilent = allInputsSilent && isConstant (process.audio_inputs, channel) && input[0] == FloatType (0);
+        }
+
+        buffer.setDataToReferTo (channels.data(), numChannels, numSamples);
+
+        // Let the processor know it's receiving silence, so it can skip work
+        if (allInputsSilent)
+        {
+            buffer.clear();
+            return buffer;
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto destination = channels[static_cast<std::size_t> (channel)];
+            auto input = getChannel (process.audio_inputs, process.audio_inputs_count, channel);
+
+            if (input == nullptr)
+                FloatVectorOperations::clear (destination, numSamples);
+            else if (isConstant (process.audio_inputs, channel))
+                FloatVectorOperations::fill (destination, input[0], numSamples);
+            else if (input != destination)
+                FloatVectorOperations::copy (destination, input, numSamples);
+        }
+
+        return buffer;
+    }
+
+    void updateConstantMasks (const clap_process_t& process) const
+    {
+        const uint64_t constantMask = buffer.hasBeenCleared() ? ~uint64_t (0) : uint64_t (0);
+
+        for (uint32_t bus = 0; bus < process.audio_outputs_count; ++bus)
+            process.audio_outputs[bus].constant_mask = constantMask;
+    }
+
+private:
+    static FloatType* getChannel (const clap_audio_buffer_t* buses, uint32_t numBuses, int channel) noexcept
+    {
+        const auto bus = static_cast<uint32_t> (channel / 2);
+        const auto busChannel = static_cast<uint32_t> (channel % 2);
+
+        if (bus >= numBuses || busChannel >= buses[bus].channel_count)
+            return nullptr;
+
+        auto busChannels = getClapChannels<FloatType> (buses[bus]);
+        return busChannels != nullptr ? busChannels[busChannel] : nullptr;
+    }
+
+    static bool isConstant (const clap_audio_buffer_t* buses, int channel) noexcept
+    {
+        return (buses[channel / 2].constant_mask & (uint64_t (1) << (channel % 2))) != 0;
+    }
+
+    int numChannels = 0;
+    int maxSamples = 0;
+
+    AudioBuffer<FloatType> scratchBuffer;
+    std::vector<FloatType*> channels;
+    AudioBuffer<FloatType> buffer;
+};
+
+//==============================================================================
+
+void sendEditorParameterChangesToHost (AudioProcessor& audioProcessor, const clap_output_events_t* out)
+{
+    audioProcessor.getEditorParameterChanges().popAll ([out] (const ParameterChangeQueue::Event& change)
+    {
+        if (change.type == ParameterChangeQueue::EventType::valueChange)
+        {
             clap_event_param_value_t event = {};
-            event.header.size = sizeof(event);
+            event.header.size = sizeof (event);
             event.header.time = 0;
             event.header.space_id = CLAP_CORE_EVENT_SPACE_ID;
             event.header.type = CLAP_EVENT_PARAM_VALUE;
             event.header.flags = 0;
-            event.param_id = i;
-            event.cookie = NULL;
+            event.param_id = static_cast<clap_id> (change.parameterIndex);
+            event.cookie = nullptr;
             event.note_id = -1;
             event.port_index = -1;
             event.channel = -1;
             event.key = -1;
-            event.value = plugin->parameters[i];
-            out->try_push(out, &event.header);
-        }
-    }
-}
+            event.value = change.value;
 
-bool pluginSyncAudioToMain (AudioProcessor& audioProcessor)
-{
-    bool anyChanged = false;
-    auto sl = yup::CriticalSection::ScopedLockType (plugin->syncParameters);
-
-    for (uint32_t i = 0; i < P_COUNT; i++)
-    {
-        if (plugin->changed[i])
-        {
-            plugin->mainParameters[i] = plugin->parameters[i];
-            plugin->changed[i] = false;
-            anyChanged = true;
+            out->try_push (out, &event.header);
         }
-    }
-
-    return anyChanged;
+        else
+        {
+            clap_event_param_gesture_t event = {};
+            event.header.size = sizeof (event);
+            event.header.time = 0;
+            event.header.space_id = CLAP_CORE_EVENT_SPACE_ID;
+            event.header.type = change.type == ParameterChangeQueue::EventType::gestureBegin
+                                  ? CLAP_EVENT_PARAM_GESTURE_BEGIN
+                                  : CLAP_EVENT_PARAM_GESTURE_END;
+            event.header.flags = 0;
+            event.param_id = static_cast<clap_id> (change.parameterIndex);
 
-    return false;
+            out->try_push (out, &event.header);
+        }
+    });
 }
-*/
 
 //==============================================================================
 
@@ -213,14 +314,23 @@ private:
     clap_plugin_note_ports_t extensionNotePorts;
     clap_plugin_audio_ports_t extensionAudioPorts;
     clap_plugin_state_t extensionState;
+    clap_plugin_thread_pool_t extensionThreadPool;
 
     clap_plugin_timer_support_t extensionTimerSupport;
     clap_plugin_gui_t extensionGUI;
 
     const clap_host_timer_support_t* hostTimerSupport = nullptr;
+    const clap_host_params_t* hostParams = nullptr;
+    const clap_host_thread_pool_t* hostThreadPool = nullptr;
     clap_id timerID;
 
+    static constexpr int maxMidiBytesPerBlock = 4096;
+
     yup::MidiBuffer midiEvents;
+    yup::ParameterChangeList parameterChanges;
+
+    AudioBusMappingCLAP<float> floatBusMapping;
+    AudioBusMappingCLAP<double> doubleBusMapping;
 
     static std::atomic_int instancesCount;
 };
@@ -299,14 +409,17 @@ AudioPluginWrapperCLAP::AudioPluginWrapperCLAP (const clap_host_t* host)
 
         auto& audioProcessor = *wrapper->audioProcessor;
         auto& midiBuffer = wrapper->midiEvents;
+        auto& parameterChanges = wrapper->parameterChanges;
 
         jassert (process->audio_outputs_count == audioProcessor.getNumAudioOutputs());
         jassert (process->audio_inputs_count == audioProcessor.getNumAudioInputs());
 
-        // PluginSyncMainToAudio(plugin, process->out_events);
+        // Send the parameter changes made by the editor
+        sendEditorParameterChangesToHost (audioProcessor, process->out_events);
 
-        // Prepare midi events
+        // Prepare midi events and time-stamped parameter changes
         midiBuffer.clear();
+        parameterChanges.clear();
 
         const uint32_t inputEventCount = process->in_events->size (process->in_events);
         for (uint32_t eventIndex = 0; eventIndex < inputEventCount; ++eventIndex)
@@ -319,19 +432,33 @@ AudioPluginWrapperCLAP::AudioPluginWrapperCLAP (const clap_host_t* host)
             if (auto convertedEvent = clapEventToMidiNoteMessage (event))
                 midiBuffer.addEvent (*convertedEvent, static_cast<int> (event->time));
             else
-                clapEventToParameterChange (event, audioProcessor);
+                clapEventToParameterChange (event, audioProcessor, parameterChanges);
         }
 
-        // Prepare audio buffers
-        float* buffers[2] = {
-            process->audio_outputs[0].data32[0],
-            process->audio_outputs[0].data32[1]
-        };
+        // Map the host ports onto the processor buffer and process it, splitting at the
+        // parameter changes if the processor asks for it
+        const bool useDoublePrecision = audioProcessor.supportsDoublePrecisionProcessing()
+                                     && process->audio_outputs_count > 0
+                                     && process->audio_outputs[0].data64 != nullptr;
 
-        AudioSampleBuffer audioBuffer (&buffers[0], 2, 0, static_cast<int> (process->frames_count));
+        if (useDoublePrecision)
+        {
+            auto& audioBuffer = wrapper->doubleBusMapping.map (*process);
+            audioProcessor.processBlockWithParameterChanges (audioBuffer, midiBuffer, parameterChanges);
+            wrapper->doubleBusMapping.updateConstantMasks (*process);
+        }
+        else
+        {
+            auto& audioBuffer = wrapper->floatBusMapping.map (*process);
+            audioProcessor.processBlockWithParameterChanges (audioBuffer, midiBuffer, parameterChanges);
+            wrapper->floatBusMapping.updateConstantMasks (*process);
+        }
 
-        // Process block
-        audioProcessor.processBlock (audioBuffer, midiBuffer);
+        // Processors handling the changes themselves don't go through applyParameterChanges, so mark
+        // the host automation for the editor here, once the new values are in place
+        auto& hostParameterChanges = audioProcessor.getHostParameterChanges();
+        for (const auto& change : parameterChanges)
+            hostParameterChanges.markChanged (change.parameterIndex);
 
         // Send back note end to host
         for (const MidiMessageMetadata metadata : midiBuffer)
@@ -385,6 +512,28 @@ bool AudioPluginWrapperCLAP::initialise()
     if (audioProcessor == nullptr)
         return false;
 
+    audioProcessor->connectParameters();
+
+    // Changes made by the editor are sent in process, or in params.flush when the audio isn't running
+    hostParams = reinterpret_cast<const clap_host_params_t*> (host->get_extension (host, CLAP_EXT_PARAMS));
+
+    audioProcessor->onEditorParameterChange = [this]
+    {
+        if (hostParams != nullptr && hostParams->request_flush != nullptr)
+            hostParams->request_flush (host);
+    };
+
+    // Parallel tasks run on the host threads when possible, falling back to the processor pool
+    hostThreadPool = reinterpret_cast<const clap_host_thread_pool_t*> (host->get_extension (host, CLAP_EXT_THREAD_POOL));
+
+    if (hostThreadPool != nullptr && hostThreadPool->request_exec != nullptr)
+    {
+        audioProcessor->setParallelTaskDispatcher ([this] (int numTasks)
+        {
+            return hostThreadPool->request_exec (host, static_cast<uint32_t> (numTasks));
+        });
+    }
+
     // ==== Setup extensions: parameters
     extensionParams.count = [] (const clap_plugin_t* plugin) -> uint32_t
     {
@@ -450,19 +599,25 @@ bool AudioPluginWrapperCLAP::initialise()
     {
         auto wrapper = getWrapper (plugin);
 
-        /*
-        MyPlugin *plugin = (MyPlugin *) _plugin->plugin_data;
-        const uint32_t eventCount = in->size(in);
+        auto& audioProcessor = *wrapper->audioProcessor;
+        auto& parameterChanges = wrapper->parameterChanges;
 
-        // For parameters that have been modified by the main thread, send CLAP_EVENT_PARAM_VALUE events to the host.
-        PluginSyncMainToAudio(plugin, out);
+        // Apply the changes coming from the host, without audio they all happen now
+        parameterChanges.clear();
 
-        // Process events sent to our plugin from the host.
-        for (uint32_t eventIndex = 0; eventIndex < eventCount; eventIndex++)
+        const uint32_t inputEventCount = in->size (in);
+        for (uint32_t eventIndex = 0; eventIndex < inputEventCount; ++eventIndex)
         {
-            PluginProcessEvent(plugin, in->get(in, eventIndex));
+            const clap_event_header_t* event = in->get (in, eventIndex);
+
+            if (event->space_id == CLAP_CORE_EVENT_SPACE_ID)
+                clapEventToParameterChange (event, audioProcessor, parameterChanges);
         }
-        */
+
+        audioProcessor.applyParameterChanges (parameterChanges);
+
+        // Send the parameter changes made by the editor
+        sendEditorParameterChangesToHost (audioProcessor, out);
     };
 
     // ==== Setup extensions: note ports
@@ -488,25 +643,43 @@ bool AudioPluginWrapperCLAP::initialise()
     // ==== Setup extensions: audio ports
     extensionAudioPorts.count = [] (const clap_plugin_t* plugin, bool isInput) -> uint32_t
     {
-        return isInput ? 0 : 1;
+        auto& audioProcessor = *getWrapper (plugin)->audioProcessor;
+
+        return static_cast<uint32_t> (isInput ? audioProcessor.getNumAudioInputs() : audioProcessor.getNumAudioOutputs());
     };
 
     extensionAudioPorts.get = [] (const clap_plugin_t* plugin, uint32_t index, bool isInput, clap_audio_port_info_t* info) -> bool
     {
-        if (isInput || index)
+        auto& audioProcessor = *getWrapper (plugin)->audioProcessor;
+
+        const auto numInputs = static_cast<uint32_t> (audioProcessor.getNumAudioInputs());
+        const auto numOutputs = static_cast<uint32_t> (audioProcessor.getNumAudioOutputs());
+
+        if (index >= (isInput ? numInputs : numOutputs))
             return false;
 
-        info->id = 0;
+        info->id = index;
         info->channel_count = 2;
-        info->flags = CLAP_AUDIO_PORT_IS_MAIN;
+        info->flags = index == 0 ? CLAP_AUDIO_PORT_IS_MAIN : 0;
         info->port_type = CLAP_PORT_STEREO;
-        info->in_place_pair = CLAP_INVALID_ID;
 
-        std::snprintf (info->name, sizeof (info->name), "%s", "Audio Output");
+        // Inputs and outputs sharing an index map to the same buffer channels
+        info->in_place_pair = (index < numInputs && index < numOutputs) ? index : CLAP_INVALID_ID;
+
+        if (audioProcessor.supportsDoublePrecisionProcessing())
+            info->flags |= CLAP_AUDIO_PORT_SUPPORTS_64BITS | CLAP_AUDIO_PORT_REQUIRES_COMMON_SAMPLE_SIZE;
+
+        std::snprintf (info->name, sizeof (info->name), "%s %u", isInput ? "Audio Input" : "Audio Output", index + 1);
 
         return true;
     };
 
+    // ==== Setup extensions: thread pool
+    extensionThreadPool.exec = [] (const clap_plugin_t* plugin, uint32_t taskIndex)
+    {
+        getWrapper (plugin)->audioProcessor->performParallelTask (static_cast<int> (taskIndex));
+    };
+
     // ==== Setup extensions: state
     extensionState.save = [] (const clap_plugin_t* plugin, const clap_ostream_t* stream) -> bool
     {
@@ -535,6 +708,8 @@ bool AudioPluginWrapperCLAP::initialise()
         for (int i = 0; i < wrapper->audioProcessor->getNumParameters(); ++i)
             wrapper->audioProcessor->getParameter (i).setValue (params.getReference (i));
 
+        wrapper->audioProcessor->getHostParameterChanges().markAllChanged();
+
         return success;
     };
 
@@ -776,6 +951,18 @@ bool AudioPluginWrapperCLAP::activate (float sampleRate, int samplesPerBlock)
             hostTimerSupport->register_timer (host, 16, &timerID);
     }
 
+    parameterChanges.ensureCapacity (jmax (1024, audioProcessor->getNumParameters()));
+
+    // The events buffer is swapped with the processor one when splitting blocks, so both are reserved
+    midiEvents.ensureSize (maxMidiBytesPerBlock);
+    audioProcessor->prepareSubBlockMidi (maxMidiBytesPerBlock);
+
+    const int numChannels = 2 * jmax (audioProcessor->getNumAudioInputs(), audioProcessor->getNumAudioOutputs());
+    floatBusMapping.prepare (numChannels, samplesPerBlock);
+
+    if (audioProcessor->supportsDoublePrecisionProcessing())
+        doubleBusMapping.prepare (numChannels, samplesPerBlock);
+
     audioProcessor->prepareToPlay (sampleRate, samplesPerBlock);
     return true;
 }
@@ -828,6 +1015,8 @@ const void* AudioPluginWrapperCLAP::getExtension (std::string_view id)
         return std::addressof (extensionParams);
     if (id == CLAP_EXT_STATE)
         return std::addressof (extensionState);
+    if (id == CLAP_EXT_THREAD_POOL)
+        return std::addressof (extensionThreadPool);
     if (id == CLAP_EXT_TIMER_SUPPORT)
         return std::addressof (extensionTimerSupport);
     if (id == CLAP_EXT_GUI)
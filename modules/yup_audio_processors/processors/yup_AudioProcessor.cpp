@@ -32,4 +32,194 @@ AudioProcessor::~AudioProcessor()
 {
 }
 
+//==============================================================================
+
+void AudioProcessor::processBlock (AudioBuffer<double>& audioBuffer, MidiBuffer& midiBuffer)
+{
+    ignoreUnused (audioBuffer, midiBuffer);
+
+    // Processors supporting double precision must override this
+    jassertfalse;
+}
+
+//==============================================================================
+
+void AudioProcessor::processBlockWithParameterChanges (AudioSampleBuffer& audioBuffer, MidiBuffer& midiBuffer, const ParameterChangeList& parameterChanges)
+{
+    processSubBlocks (audioBuffer, midiBuffer, parameterChanges);
+}
+
+void AudioProcessor::processBlockWithParameterChanges (AudioBuffer<double>& audioBuffer, MidiBuffer& midiBuffer, const ParameterChangeList& parameterChanges)
+{
+    processSubBlocks (audioBuffer, midiBuffer, parameterChanges);
+}
+
+void AudioProcessor::prepareSubBlockMidi (int maxMidiBytesPerBlock)
+{
+    const auto numBytes = static_cast<std::size_t> (jmax (0, maxMidiBytesPerBlock));
+
+    subBlockMidi.ensureSize (numBytes);
+    processedMidi.ensureSize (numBytes);
+}
+
+template <class FloatType>
+void AudioProcessor::processSubBlocks (AudioBuffer<FloatType>& audioBuffer, MidiBuffer& midiBuffer, const ParameterChangeList& parameterChanges)
+{
+    const int numSamples = audioBuffer.getNumSamples();
+    const int minimumSubBlockSize = getMinimumSubBlockSize();
+
+    if (minimumSubBlockSize <= 0 || numSamples == 0 || parameterChanges.isEmpty())
+    {
+        applyParameterChanges (parameterChanges);
+
+        processBlock (audioBuffer, midiBuffer);
+        return;
+    }
+
+    processedMidi.clear();
+
+    const auto* nextChange = parameterChanges.begin();
+    int startSample = 0;
+
+    while (startSample < numSamples)
+    {
+        while (nextChange != parameterChanges.end() && nextChange->sampleOffset <= startSample)
+            applyParameterChange (*nextChange++);
+
+        // Changes falling inside a sub-block shorter than the minimum are applied at its end
+        const int nextChangeSample = nextChange != parameterChanges.end() ? nextChange->sampleOffset : numSamples;
+        const int endSample = jmin (numSamples, jmax (nextChangeSample, startSample + minimumSubBlockSize));
+        const int subBlockSize = endSample - startSample;
+
+        AudioBuffer<FloatType> subBlockAudio (audioBuffer.getArrayOfWritePointers(), audioBuffer.getNumChannels(), startSample, subBlockSize);
+
+        subBlockMidi.clear();
+        subBlockMidi.addEvents (midiBuffer, startSample, subBlockSize, -startSample);
+
+        processBlock (subBlockAudio, subBlockMidi);
+
+        processedMidi.addEvents (subBlockMidi, 0, -1, startSample);
+        startSample = endSample;
+    }
+
+    while (nextChange != parameterChanges.end())
+        applyParameterChange (*nextChange++);
+
+    midiBuffer.swapWith (processedMidi);
+}
+
+//==============================================================================
+
+void AudioProcessor::connectParameters()
+{
+    const int numParameters = getNumParameters();
+
+    for (int i = 0; i < numParameters; ++i)
+    {
+        auto& parameter = getParameter (i);
+        parameter.owner = this;
+        parameter.parameterIndex = i;
+    }
+
+    hostParameterChanges.setNumParameters (numParameters);
+}
+
+void AudioProcessor::applyParameterChanges (const ParameterChangeList& parameterChanges)
+{
+    for (const auto& change : parameterChanges)
+        applyParameterChange (change);
+}
+
+void AudioProcessor::applyParameterChange (const ParameterChangeList::Change& change)
+{
+    if (! isPositiveAndBelow (change.parameterIndex, getNumParameters()))
+        return;
+
+    getParameter (change.parameterIndex).setValue (change.value);
+    hostParameterChanges.markChanged (change.parameterIndex);
+}
+
+void AudioProcessor::queueEditorParameterChange (const ParameterChangeQueue::Event& event)
+{
+    if (! editorParameterChanges.push (event))
+    {
+        // The host isn't reading the changes fast enough, this one is lost
+        jassertfalse;
+        return;
+    }
+
+    if (onEditorParameterChange)
+        onEditorParameterChange();
+}
+
+//==============================================================================
+
+void AudioProcessor::setNumParallelWorkerThreads (int numThreads)
+{
+    numThreads = jmax (0, numThreads);
+
+    if (numThreads == getNumParallelWorkerThreads())
+        return;
+
+    parallelTaskPool.reset();
+
+    if (numThreads > 0)
+        parallelTaskPool = std::make_unique<ParallelTaskPool> (numThreads);
+}
+
+int AudioProcessor::getNumParallelWorkerThreads() const noexcept
+{
+    return parallelTaskPool != nullptr ? parallelTaskPool->getNumWorkerThreads() : 0;
+}
+
+void AudioProcessor::setParallelTaskDispatcher (std::function<bool (int numTasks)> dispatcher)
+{
+    parallelTaskDispatcher = std::move (dispatcher);
+}
+
+void AudioProcessor::performParallelTask (int taskIndex) noexcept
+{
+    jassert (isPositiveAndBelow (taskIndex, numParallelTasks));
+
+    if (isPositiveAndBelow (taskIndex, numParallelTasks))
+        parallelTaskFunction (parallelTaskContext, taskIndex);
+}
+
+void AudioProcessor::runParallelTasks (int numTasks, ParallelTaskPool::TaskFunction function, void* context)
+{
+    jassert (numParallelTasks == 0); // parallelFor is not reentrant!
+
+    if (numTasks <= 0)
+        return;
+
+    if (numTasks == 1)
+    {
+        function (context, 0);
+        return;
+    }
+
+    parallelTaskFunction = function;
+    parallelTaskContext = context;
+    numParallelTasks = numTasks;
+
+    const bool dispatchedToHost = parallelTaskDispatcher != nullptr && parallelTaskDispatcher (numTasks);
+
+    if (! dispatchedToHost)
+    {
+        if (parallelTaskPool != nullptr)
+        {
+            parallelTaskPool->run (numTasks, function, context);
+        }
+        else
+        {
+            for (int taskIndex = 0; taskIndex < numTasks; ++taskIndex)
+                function (context, taskIndex);
+        }
+    }
+
+    parallelTaskFunction = nullptr;
+    parallelTaskContext = nullptr;
+    numParallelTasks = 0;
+}
+
 } // namespace yup
@@ -35,16 +35,158 @@ public:
     virtual int getNumAudioOutputs() const = 0;
     virtual int getNumAudioInputs() const = 0;
 
+    /** Returns the number of samples the output of the processor is delayed from its input. */
+    virtual int getLatencySamples() const { return 0; }
+
     virtual void prepareToPlay (float sampleRate, int maxBlockSize) = 0;
     virtual void releaseResources() = 0;
 
     virtual void processBlock (yup::AudioSampleBuffer& audioBuffer, yup::MidiBuffer& midiBuffer) = 0;
 
+    /** Processes a block of double precision samples.
+
+        This is only called when supportsDoublePrecisionProcessing returns true.
+    */
+    virtual void processBlock (yup::AudioBuffer<double>& audioBuffer, yup::MidiBuffer& midiBuffer);
+
+    /** Returns true if the processor implements the double precision processBlock. */
+    virtual bool supportsDoublePrecisionProcessing() const { return false; }
+
+    /** Processes a block together with the parameter changes happening inside it.
+
+        The default implementation applies the changes and then calls processBlock. When
+        getMinimumSubBlockSize returns a positive size, the block is instead split at the sample
+        offsets of the changes, and each sub-block is processed with the values the parameters
+        have at its start. Override this to handle the changes with full sample accuracy.
+    */
+    virtual void processBlockWithParameterChanges (yup::AudioSampleBuffer& audioBuffer,
+                                                   yup::MidiBuffer& midiBuffer,
+                                                   const ParameterChangeList& parameterChanges);
+
+    /** Processes a block of double precision samples together with the parameter changes
+        happening inside it.
+
+        @see processBlockWithParameterChanges, supportsDoublePrecisionProcessing
+    */
+    virtual void processBlockWithParameterChanges (yup::AudioBuffer<double>& audioBuffer,
+                                                   yup::MidiBuffer& midiBuffer,
+                                                   const ParameterChangeList& parameterChanges);
+
+    /** Returns the minimum number of samples of the sub-blocks used when splitting blocks at
+        parameter changes, or zero to apply all the changes at the start of the block.
+    */
+    virtual int getMinimumSubBlockSize() const { return 0; }
+
+    /** Reserves the MIDI storage used when splitting blocks at parameter changes, so that
+        processBlockWithParameterChanges doesn't allocate.
+
+        Hosts call this before prepareToPlay, with the largest number of MIDI bytes they deliver in a
+        block. The MIDI buffer passed to processBlockWithParameterChanges should be reserved to the
+        same size, since it's swapped with the internal one.
+    */
+    void prepareSubBlockMidi (int maxMidiBytesPerBlock);
+
     virtual void flush() {}
 
     virtual bool hasEditor() const = 0;
 
     virtual AudioProcessorEditor* createEditor() { return nullptr; }
+
+    //==============================================================================
+    /** Connects the parameters to the processor, so the changes made with
+        AudioProcessorParameter::setValueNotifyingHost and the gestures reach the host.
+
+        Hosts call this after creating the processor, and again if its parameters change.
+    */
+    void connectParameters();
+
+    /** Applies parameter changes coming from the host immediately, marking them for the editor. */
+    void applyParameterChanges (const ParameterChangeList& parameterChanges);
+
+    /** Returns the changes made by the editor, in order, which the host hasn't received yet.
+
+        The queue is written on the message thread and read by the host while processing or
+        flushing the parameters.
+    */
+    ParameterChangeQueue& getEditorParameterChanges() noexcept { return editorParameterChanges; }
+
+    /** Returns the parameters changed by the host, which the editor hasn't refreshed yet.
+
+        The flags are marked when the host changes are applied, and read on the message thread.
+    */
+    ParameterChangeFlags& getHostParameterChanges() noexcept { return hostParameterChanges; }
+
+    /** Called on the message thread whenever the editor queues a parameter change, so the host can
+        be asked to flush the changes when the audio isn't running.
+    */
+    std::function<void()> onEditorParameterChange;
+
+    //==============================================================================
+    /** Calls a function for each index from 0 to numTasks - 1 in parallel, returning when all
+        the calls have completed.
+
+        This is meant to be called from processBlock, to spread independent work like rendering
+        voices across cores. The tasks run on the threads of the host when it offers them (see
+        setParallelTaskDispatcher), otherwise on the internal pool created with
+        setNumParallelWorkerThreads, or on the calling thread when there's no pool.
+
+        The function is called concurrently, and must not call parallelFor itself.
+    */
+    template <class Function>
+    void parallelFor (int numTasks, Function&& function)
+    {
+        using FunctionType = std::remove_reference_t<Function>;
+
+        runParallelTasks (numTasks, [] (void* context, int taskIndex)
+        {
+            (*static_cast<FunctionType*> (context)) (taskIndex);
+        }, const_cast<void*> (static_cast<const void*> (std::addressof (function))));
+    }
+
+    /** Sets the number of threads of the internal pool used by parallelFor when the host doesn't
+        run the tasks. With zero threads, the tasks run on the calling thread.
+
+        This starts or stops threads, so don't call it while processing.
+    */
+    void setNumParallelWorkerThreads (int numThreads);
+
+    /** Returns the number of threads of the internal pool used by parallelFor. */
+    int getNumParallelWorkerThreads() const noexcept;
+
+    /** Sets a function used by parallelFor to run the tasks on the threads of the host.
+
+        The function receives the number of tasks, and returns true once the host has called
+        performParallelTask for each of them, or false if the host can't run them, in which case
+        parallelFor falls back to the internal pool. Hosts set this before processing starts.
+    */
+    void setParallelTaskDispatcher (std::function<bool (int numTasks)> dispatcher);
+
+    /** Runs one of the tasks of the current parallelFor, called by the host threads. */
+    void performParallelTask (int taskIndex) noexcept;
+
+private:
+    friend class AudioProcessorParameter;
+
+    template <class FloatType>
+    void processSubBlocks (yup::AudioBuffer<FloatType>& audioBuffer,
+                           yup::MidiBuffer& midiBuffer,
+                           const ParameterChangeList& parameterChanges);
+
+    void applyParameterChange (const ParameterChangeList::Change& change);
+    void queueEditorParameterChange (const ParameterChangeQueue::Event& event);
+    void runParallelTasks (int numTasks, ParallelTaskPool::TaskFunction function, void* context);
+
+    yup::MidiBuffer subBlockMidi;
+    yup::MidiBuffer processedMidi;
+
+    ParameterChangeQueue editorParameterChanges;
+    ParameterChangeFlags hostParameterChanges;
+
+    std::unique_ptr<ParallelTaskPool> parallelTaskPool;
+    std::function<bool (int)> parallelTaskDispatcher;
+    ParallelTaskPool::TaskFunction parallelTaskFunction = nullptr;
+    void* parallelTaskContext = nullptr;
+    int numParallelTasks = 0;
 };
 
 } // namespace yup
@@ -0,0 +1,872 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+/** A bounded Chase-Lev deque of node indices.
+
+    The owner thread pushes and pops at the bottom, while the other threads steal from the top.
+    The indices are reset at the start of each block, and each node is pushed at most once per
+    block, so the capacity never needs to grow while rendering.
+*/
+class AudioProcessorGraph::WorkStealingQueue
+{
+public:
+    explicit WorkStealingQueue (int capacity)
+    {
+        const auto size = nextPowerOfTwo (jmax (2, capacity));
+
+        slots = std::make_unique<std::atomic<int>[]> (static_cast<std::size_t> (size));
+        mask = size - 1;
+    }
+
+    void reset() noexcept
+    {
+        top.store (0, std::memory_order_relaxed);
+        bottom.store (0, std::memory_order_relaxed);
+    }
+
+    void push (int item) noexcept
+    {
+        const auto b = bottom.load (std::memory_order_relaxed);
+
+        slots[b & mask].store (item, std::memory_order_relaxed);
+        bottom.store (b + 1, std::memory_order_release);
+    }
+
+    int pop() noexcept
+    {
+        const auto b = bottom.load (std::memory_order_relaxed) - 1;
+        bottom.store (b, std::memory_order_relaxed);
+
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+
+        auto t = top.load (std::memory_order_relaxed);
+        if (t > b)
+        {
+            bottom.store (b + 1, std::memory_order_relaxed);
+            return -1;
+        }
+
+        auto item = slots[b & mask].load (std::memory_order_relaxed);
+
+        if (t == b)
+        {
+            // Last item, race against the thieves for it
+            if (! top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                item = -1;
+
+            bottom.store (b + 1, std::memory_order_relaxed);
+        }
+
+        return item;
+    }
+
+    int steal() noexcept
+    {
+        auto t = top.load (std::memory_order_acquire);
+
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+
+        const auto b = bottom.load (std::memory_order_acquire);
+        if (t >= b)
+            return -1;
+
+        const auto item = slots[t & mask].load (std::memory_order_relaxed);
+
+        if (! top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return -1;
+
+        return item;
+    }
+
+private:
+    std::unique_ptr<std::atomic<int>[]> slots;
+    int64 mask = 0;
+
+    alignas (64) std::atomic<int64> top { 0 };
+    alignas (64) std::atomic<int64> bottom { 0 };
+};
+
+//==============================================================================
+class AudioProcessorGraph::RenderSequence
+{
+public:
+    RenderSequence (const std::vector<std::unique_ptr<Node>>& nodes,
+                    const std::vector<Connection>& connections,
+                    int numInputChannels,
+                    int numOutputChannels,
+                    int maxBlockSize,
+                    int numQueuesToUse)
+        : maxNumSamples (maxBlockSize)
+        , numQueues (numQueuesToUse)
+    {
+        const auto numNodes = static_cast<int> (nodes.size());
+
+        std::unordered_map<NodeID, int> nodeIndices;
+        for (int i = 0; i < numNodes; ++i)
+            nodeIndices.emplace (nodes[i]->nodeID, i);
+
+        // Sort the nodes topologically, the graph never contains cycles
+        std::vector<std::vector<int>> successorsOf (static_cast<std::size_t> (numNodes));
+        std::vector<int> numPredecessorsOf (static_cast<std::size_t> (numNodes), 0);
+
+        for (const auto& connection : connections)
+        {
+            const auto source = nodeIndices.find (connection.sourceNode);
+            const auto destination = nodeIndices.find (connection.destinationNode);
+            if (source == nodeIndices.end() || destination == nodeIndices.end())
+                continue;
+
+            auto& successors = successorsOf[source->second];
+            if (std::find (successors.begin(), successors.end(), destination->second) == successors.end())
+            {
+                successors.push_back (destination->second);
+                ++numPredecessorsOf[destination->second];
+            }
+        }
+
+        std::vector<int> order;
+        order.reserve (static_cast<std::size_t> (numNodes));
+
+        {
+            auto remaining = numPredecessorsOf;
+
+            for (int i = 0; i < numNodes; ++i)
+            {
+                if (remaining[i] == 0)
+                    order.push_back (i);
+            }
+
+            for (std::size_t i = 0; i < order.size(); ++i)
+            {
+                for (const auto successor : successorsOf[order[i]])
+                {
+                    if (--remaining[successor] == 0)
+                        order.push_back (successor);
+                }
+            }
+        }
+
+        jassert (static_cast<int> (order.size()) == numNodes);
+
+        std::vector<int> renderIndexOf (static_cast<std::size_t> (numNodes), 0);
+        for (int i = 0; i < numNodes; ++i)
+            renderIndexOf[order[i]] = i;
+
+        // Allocate the buffers of every node up front
+        inputBuffer.setSize (numInputChannels, maxBlockSize);
+        inputMidi.ensureSize (midiBufferSize);
+
+        for (const auto nodeIndex : order)
+        {
+            auto* processor = nodes[nodeIndex]->processor.get();
+            const auto numChannels = 2 * jmax (processor->getNumAudioInputs(), processor->getNumAudioOutputs());
+
+            auto renderNode = std::make_unique<RenderNode>();
+            renderNode->processor = processor;
+            renderNode->buffer.setSize (numChannels, maxBlockSize);
+            renderNode->midi.ensureSize (midiBufferSize);
+            renderNode->numPredecessors = numPredecessorsOf[nodeIndex];
+
+            for (const auto successor : successorsOf[nodeIndex])
+                renderNode->successors.push_back (renderIndexOf[successor]);
+
+            renderNodes.push_back (std::move (renderNode));
+        }
+
+        outputNode.buffer.setSize (numOutputChannels, maxBlockSize);
+        outputNode.midi.ensureSize (midiBufferSize);
+
+        // Compute the latency at the inputs of every node, then delay the connections coming from
+        // sources that are ahead of the other inputs of the same destination
+        const auto findNode = [&] (NodeID nodeID) -> RenderNode*
+        {
+            if (nodeID == outputNodeID)
+                return &outputNode;
+
+            const auto it = nodeIndices.find (nodeID);
+            return it != nodeIndices.end() ? renderNodes[renderIndexOf[it->second]].get() : nullptr;
+        };
+
+        const auto getOutputLatency = [&] (NodeID nodeID)
+        {
+            if (nodeID == inputNodeID)
+                return 0;
+
+            const auto* node = findNode (nodeID);
+            return node->inputLatency + node->processor->getLatencySamples();
+        };
+
+        const auto updateInputLatency = [&] (RenderNode& node, NodeID nodeID)
+        {
+            for (const auto& connection : connections)
+            {
+                if (connection.destinationNode == nodeID && ! connection.isMidi())
+                    node.inputLatency = jmax (node.inputLatency, getOutputLatency (connection.sourceNode));
+            }
+        };
+
+        for (const auto nodeIndex : order)
+            updateInputLatency (*renderNodes[renderIndexOf[nodeIndex]], nodes[nodeIndex]->nodeID);
+
+        updateInputLatency (outputNode, outputNodeID);
+
+        for (const auto& connection : connections)
+        {
+            auto* destination = findNode (connection.destinationNode);
+            const auto* source = connection.sourceNode == inputNodeID ? nullptr : findNode (connection.sourceNode);
+
+            if (destination == nullptr)
+                continue;
+
+            if (connection.isMidi())
+            {
+                destination->midiInputs.push_back (source != nullptr ? &source->midi : &inputMidi);
+                continue;
+            }
+
+            AudioInput input;
+            input.source = source != nullptr ? &source->buffer : &inputBuffer;
+            input.sourceChannel = connection.sourceChannel;
+            input.destinationChannel = connection.destinationChannel;
+            input.delayLine.resize (static_cast<std::size_t> (destination->inputLatency - getOutputLatency (connection.sourceNode)), 0.0f);
+
+            destination->audioInputs.push_back (std::move (input));
+        }
+
+        // Prepare the scheduling state used when rendering on multiple threads
+        for (int i = 0; i < numQueues; ++i)
+            queues.push_back (std::make_unique<WorkStealingQueue> (numNodes + 1));
+    }
+
+    //==============================================================================
+    int getLatencySamples() const noexcept
+    {
+        return outputNode.inputLatency;
+    }
+
+    int getNumQueues() const noexcept
+    {
+        return numQueues;
+    }
+
+    void reset()
+    {
+        for (auto& node : renderNodes)
+            node->resetDelayLines();
+
+        outputNode.resetDelayLines();
+    }
+
+    //==============================================================================
+    void process (AudioSampleBuffer& audioBuffer, MidiBuffer& midiBuffer, ParallelTaskPool* workerPool);
+
+    void beginParallelBlock() noexcept
+    {
+        for (auto& queue : queues)
+            queue->reset();
+
+        int nextQueue = 0;
+
+        for (int i = 0; i < static_cast<int> (renderNodes.size()); ++i)
+        {
+            auto& node = *renderNodes[i];
+            node.pendingPredecessors.store (node.numPredecessors, std::memory_order_relaxed);
+
+            // Spread the nodes without dependencies over all the queues
+            if (node.numPredecessors == 0)
+            {
+                queues[nextQueue]->push (i);
+                nextQueue = (nextQueue + 1) % numQueues;
+            }
+        }
+
+        remainingNodes.store (static_cast<int> (renderNodes.size()), std::memory_order_release);
+    }
+
+    void runParallel (int queueIndex) noexcept
+    {
+        auto& ownQueue = *queues[queueIndex];
+
+        while (remainingNodes.load (std::memory_order_acquire) > 0)
+        {
+            auto index = ownQueue.pop();
+
+            for (int i = 1; index < 0 && i < numQueues; ++i)
+                index = queues[(queueIndex + i) % numQueues]->steal();
+
+            if (index < 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            auto& node = *renderNodes[index];
+            node.render (currentNumSamples);
+
+            for (const auto successor : node.successors)
+            {
+                if (renderNodes[successor]->pendingPredecessors.fetch_sub (1, std::memory_order_acq_rel) == 1)
+                    ownQueue.push (successor);
+            }
+
+            remainingNodes.fetch_sub (1, std::memory_order_acq_rel);
+        }
+    }
+
+private:
+    struct AudioInput
+    {
+        const AudioSampleBuffer* source = nullptr;
+        int sourceChannel = 0;
+        int destinationChannel = 0;
+        std::vector<float> delayLine;
+        std::size_t delayPosition = 0;
+
+        void addTo (float* destination, int numSamples) noexcept
+        {
+            const auto* samples = source->getReadPointer (sourceChannel);
+
+            if (delayLine.empty())
+            {
+                FloatVectorOperations::add (destination, samples, numSamples);
+                return;
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                destination[i] += delayLine[delayPosition];
+                delayLine[delayPosition] = samples[i];
+
+                if (++delayPosition == delayLine.size())
+                    delayPosition = 0;
+            }
+        }
+    };
+
+    struct RenderNode
+    {
+        AudioProcessor* processor = nullptr;
+        AudioSampleBuffer buffer;
+        MidiBuffer midi;
+
+        std::vector<AudioInput> audioInputs;
+        std::vector<const MidiBuffer*> midiInputs;
+        int inputLatency = 0;
+
+        std::vector<int> successors;
+        int numPredecessors = 0;
+        std::atomic<int> pendingPredecessors { 0 };
+
+        void gatherInputs (int numSamples) noexcept
+        {
+            buffer.setSize (buffer.getNumChannels(), numSamples, false, false, true);
+            buffer.clear();
+
+            for (auto& input : audioInputs)
+                input.addTo (buffer.getWritePointer (input.destinationChannel), numSamples);
+
+            midi.clear();
+
+            for (const auto* source : midiInputs)
+                addEventsWithinCapacity (midi, *source, numSamples);
+        }
+
+        void render (int numSamples) noexcept
+        {
+            gatherInputs (numSamples);
+            processor->processBlock (buffer, midi);
+        }
+
+        void resetDelayLines() noexcept
+        {
+            for (auto& input : audioInputs)
+            {
+                std::fill (input.delayLine.begin(), input.delayLine.end(), 0.0f);
+                input.delayPosition = 0;
+            }
+        }
+    };
+
+    static constexpr std::size_t midiBufferSize = 4096;
+
+    // Copies the events of a block without growing the destination past the storage reserved when
+    // the sequence was built, so that the audio thread never allocates
+    static void addEventsWithinCapacity (MidiBuffer& destination, const MidiBuffer& source, int numSamples) noexcept
+    {
+        for (auto it = source.findNextSamplePosition (0); it != source.cend(); ++it)
+        {
+            const auto metadata = *it;
+
+            if (metadata.samplePosition >= numSamples)
+                break;
+
+            const auto eventSize = static_cast<int> (sizeof (int32) + sizeof (uint16)) + metadata.numBytes;
+
+            if (destination.data.size() + eventSize > static_cast<int> (midiBufferSize))
+            {
+                // Too many MIDI events in a single block, the remaining ones are dropped
+                jassertfalse;
+                return;
+            }
+
+            destination.addEvent (metadata.data, metadata.numBytes, metadata.samplePosition);
+        }
+    }
+
+    AudioSampleBuffer inputBuffer;
+    MidiBuffer inputMidi;
+    std::vector<std::unique_ptr<RenderNode>> renderNodes;
+    RenderNode outputNode;
+    const int maxNumSamples;
+
+    const int numQueues;
+    std::vector<std::unique_ptr<WorkStealingQueue>> queues;
+    std::atomic<int> remainingNodes { 0 };
+    int currentNumSamples = 0;
+};
+
+//==============================================================================
+void AudioProcessorGraph::RenderSequence::process (AudioSampleBuffer& audioBuffer, MidiBuffer& midiBuffer, ParallelTaskPool* workerPool)
+{
+    jassert (audioBuffer.getNumSamples() <= maxNumSamples);
+
+    const auto numSamples = jmin (audioBuffer.getNumSamples(), maxNumSamples);
+    currentNumSamples = numSamples;
+
+    inputBuffer.setSize (inputBuffer.getNumChannels(), numSamples, false, false, true);
+
+    for (int channel = 0; channel < inputBuffer.getNumChannels(); ++channel)
+    {
+        if (channel < audioBuffer.getNumChannels())
+            inputBuffer.copyFrom (channel, 0, audioBuffer, channel, 0, numSamples);
+        else
+            inputBuffer.clear (channel, 0, numSamples);
+    }
+
+    inputMidi.clear();
+    addEventsWithinCapacity (inputMidi, midiBuffer, numSamples);
+
+    if (workerPool != nullptr && workerPool->getNumWorkerThreads() + 1 == numQueues && renderNodes.size() > 1)
+    {
+        beginParallelBlock();
+
+        // Every task owns one of the queues, and returns once all the nodes have been rendered
+        workerPool->run (numQueues, [] (void* context, int queueIndex)
+        {
+            static_cast<RenderSequence*> (context)->runParallel (queueIndex);
+        }, this);
+    }
+    else
+    {
+        for (auto& node : renderNodes)
+            node->render (numSamples);
+    }
+
+    outputNode.gatherInputs (numSamples);
+
+    for (int channel = 0; channel < audioBuffer.getNumChannels(); ++channel)
+    {
+        if (channel < outputNode.buffer.getNumChannels())
+            audioBuffer.copyFrom (channel, 0, outputNode.buffer, channel, 0, numSamples);
+        else
+            audioBuffer.clear (channel, 0, numSamples);
+    }
+
+    // The output buffer belongs to the caller, which is expected to reserve enough space for it
+    midiBuffer.clear();
+    midiBuffer.addEvents (outputNode.midi, 0, numSamples, 0);
+}
+
+//==============================================================================
+bool AudioProcessorGraph::Connection::operator== (const Connection& other) const noexcept
+{
+    return sourceNode == other.sourceNode
+        && sourceChannel == other.sourceChannel
+        && destinationNode == other.destinationNode
+        && destinationChannel == other.destinationChannel;
+}
+
+bool AudioProcessorGraph::Connection::operator!= (const Connection& other) const noexcept
+{
+    return ! operator== (other);
+}
+
+//==============================================================================
+AudioProcessorGraph::AudioProcessorGraph (int numInputBusesToUse, int numOutputBusesToUse)
+    : numInputBuses (jmax (0, numInputBusesToUse))
+    , numOutputBuses (jmax (0, numOutputBusesToUse))
+{
+}
+
+AudioProcessorGraph::~AudioProcessorGraph()
+{
+    workerPool.reset();
+    renderSequence.reset();
+}
+
+//==============================================================================
+AudioProcessorGraph::NodeID AudioProcessorGraph::addNode (std::unique_ptr<AudioProcessor> processor)
+{
+    if (processor == nullptr)
+        return 0;
+
+    if (isPrepared)
+        processor->prepareToPlay (currentSampleRate, currentMaxBlockSize);
+
+    auto node = std::make_unique<Node>();
+    node->nodeID = ++lastNodeID;
+    node->processor = std::move (processor);
+
+    nodes.push_back (std::move (node));
+
+    updateParameters();
+    rebuild();
+
+    return lastNodeID;
+}
+
+bool AudioProcessorGraph::removeNode (NodeID nodeID)
+{
+    auto it = std::find_if (nodes.begin(), nodes.end(), [nodeID] (const auto& node)
+    {
+        return node->nodeID == nodeID;
+    });
+
+    if (it == nodes.end())
+        return false;
+
+    // Keep the node alive until the audio thread has switched to the new sequence
+    auto removedNode = std::move (*it);
+    nodes.erase (it);
+
+    connections.erase (std::remove_if (connections.begin(), connections.end(), [nodeID] (const Connection& connection)
+    {
+        return connection.sourceNode == nodeID || connection.destinationNode == nodeID;
+    }), connections.end());
+
+    updateParameters();
+    rebuild();
+
+    if (isPrepared)
+        removedNode->processor->releaseResources();
+
+    return true;
+}
+
+void AudioProcessorGraph::clear()
+{
+    auto removedNodes = std::move (nodes);
+    nodes.clear();
+    connections.clear();
+
+    updateParameters();
+    rebuild();
+
+    if (isPrepared)
+    {
+        for (auto& node : removedNodes)
+            node->processor->releaseResources();
+    }
+}
+
+int AudioProcessorGraph::getNumNodes() const noexcept
+{
+    return static_cast<int> (nodes.size());
+}
+
+AudioProcessor* AudioProcessorGraph::getProcessorForNode (NodeID nodeID) const
+{
+    auto* node = getNode (nodeID);
+    return node != nullptr ? node->processor.get() : nullptr;
+}
+
+int AudioProcessorGraph::getNumInputChannels (NodeID nodeID) const
+{
+    if (nodeID == outputNodeID)
+        return 2 * numOutputBuses;
+
+    auto* node = getNode (nodeID);
+    return node != nullptr ? 2 * node->processor->getNumAudioInputs() : 0;
+}
+
+int AudioProcessorGraph::getNumOutputChannels (NodeID nodeID) const
+{
+    if (nodeID == inputNodeID)
+        return 2 * numInputBuses;
+
+    auto* node = getNode (nodeID);
+    return node != nullptr ? 2 * node->processor->getNumAudioOutputs() : 0;
+}
+
+//==============================================================================
+bool AudioProcessorGraph::canConnect (const Connection& connection) const
+{
+    if (connection.sourceNode == connection.destinationNode)
+        return false;
+
+    if (connection.isMidi() != (connection.destinationChannel == midiChannelIndex))
+        return false;
+
+    if (! isValidSource (connection.sourceNode, connection.sourceChannel)
+        || ! isValidDestination (connection.destinationNode, connection.destinationChannel))
+    {
+        return false;
+    }
+
+    if (isConnected (connection))
+        return false;
+
+    return ! isReachable (connection.destinationNode, connection.sourceNode);
+}
+
+bool AudioProcessorGraph::addConnection (const Connection& connection)
+{
+    if (! canConnect (connection))
+        return false;
+
+    connections.push_back (connection);
+    rebuild();
+
+    return true;
+}
+
+bool AudioProcessorGraph::removeConnection (const Connection& connection)
+{
+    auto it = std::find (connections.begin(), connections.end(), connection);
+    if (it == connections.end())
+        return false;
+
+    connections.erase (it);
+    rebuild();
+
+    return true;
+}
+
+bool AudioProcessorGraph::isConnected (const Connection& connection) const
+{
+    return std::find (connections.begin(), connections.end(), connection) != connections.end();
+}
+
+//==============================================================================
+void AudioProcessorGraph::setNumWorkerThreads (int numThreads)
+{
+    numThreads = jmax (0, numThreads);
+    if (numWorkerThreads == numThreads)
+        return;
+
+    numWorkerThreads = numThreads;
+
+    if (! isPrepared)
+        return;
+
+    auto newWorkerPool = numWorkerThreads > 0 ? std::make_unique<ParallelTaskPool> (numWorkerThreads) : nullptr;
+    auto newSequence = createRenderSequence (numWorkerThreads + 1);
+
+    {
+        const SpinLock::ScopedLockType sl (renderLock);
+
+        std::swap (workerPool, newWorkerPool);
+        std::swap (renderSequence, newSequence);
+    }
+}
+
+//==============================================================================
+int AudioProcessorGraph::getNumParameters() const
+{
+    const SpinLock::ScopedLockType sl (parameterLock);
+    return static_cast<int> (parameters->size());
+}
+
+AudioProcessorParameter& AudioProcessorGraph::getParameter (int index)
+{
+    const SpinLock::ScopedLockType sl (parameterLock);
+
+    jassert (isPositiveAndBelow (index, static_cast<int> (parameters->size())));
+    return *(*parameters)[static_cast<std::size_t> (index)];
+}
+
+int AudioProcessorGraph::getLatencySamples() const
+{
+    return latencySamples;
+}
+
+//==============================================================================
+void AudioProcessorGraph::prepareToPlay (float sampleRate, int maxBlockSize)
+{
+    currentSampleRate = sampleRate;
+    currentMaxBlockSize = maxBlockSize;
+
+    for (auto& node : nodes)
+        node->processor->prepareToPlay (sampleRate, maxBlockSize);
+
+    isPrepared = true;
+
+    if (numWorkerThreads > 0 && workerPool == nullptr)
+        workerPool = std::make_unique<ParallelTaskPool> (numWorkerThreads);
+
+    rebuild();
+}
+
+void AudioProcessorGraph::releaseResources()
+{
+    std::unique_ptr<ParallelTaskPool> oldWorkerPool;
+    std::unique_ptr<RenderSequence> oldSequence;
+
+    {
+        const SpinLock::ScopedLockType sl (renderLock);
+
+        std::swap (workerPool, oldWorkerPool);
+        std::swap (renderSequence, oldSequence);
+    }
+
+    isPrepared = false;
+
+    for (auto& node : nodes)
+        node->processor->releaseResources();
+}
+
+void AudioProcessorGraph::processBlock (AudioSampleBuffer& audioBuffer, MidiBuffer& midiBuffer)
+{
+    // Never wait on the message thread: output silence for the block where the sequence is swapped
+    const SpinLock::ScopedTryLockType sl (renderLock);
+
+    if (! sl.isLocked() || renderSequence == nullptr)
+    {
+        audioBuffer.clear();
+        midiBuffer.clear();
+        return;
+    }
+
+    renderSequence->process (audioBuffer, midiBuffer, workerPool.get());
+}
+
+void AudioProcessorGraph::flush()
+{
+    for (auto& node : nodes)
+        node->processor->flush();
+
+    const SpinLock::ScopedLockType sl (renderLock);
+
+    if (renderSequence != nullptr)
+        renderSequence->reset();
+}
+
+//==============================================================================
+AudioProcessorGraph::Node* AudioProcessorGraph::getNode (NodeID nodeID) const
+{
+    for (auto& node : nodes)
+    {
+        if (node->nodeID == nodeID)
+            return node.get();
+    }
+
+    return nullptr;
+}
+
+bool AudioProcessorGraph::isValidSource (NodeID nodeID, int channel) const
+{
+    if (channel == midiChannelIndex)
+        return nodeID == inputNodeID || getNode (nodeID) != nullptr;
+
+    return isPositiveAndBelow (channel, getNumOutputChannels (nodeID));
+}
+
+bool AudioProcessorGraph::isValidDestination (NodeID nodeID, int channel) const
+{
+    if (channel == midiChannelIndex)
+        return nodeID == outputNodeID || getNode (nodeID) != nullptr;
+
+    return isPositiveAndBelow (channel, getNumInputChannels (nodeID));
+}
+
+bool AudioProcessorGraph::isReachable (NodeID fromNode, NodeID toNode) const
+{
+    std::vector<NodeID> pending { fromNode };
+    std::vector<NodeID> visited;
+
+    while (! pending.empty())
+    {
+        const auto nodeID = pending.back();
+        pending.pop_back();
+
+        if (nodeID == toNode)
+            return true;
+
+        if (std::find (visited.begin(), visited.end(), nodeID) != visited.end())
+            continue;
+
+        visited.push_back (nodeID);
+
+        for (const auto& connection : connections)
+        {
+            if (connection.sourceNode == nodeID)
+                pending.push_back (connection.destinationNode);
+        }
+    }
+
+    return false;
+}
+
+void AudioProcessorGraph::updateParameters()
+{
+    ParameterList nodeParameters;
+
+    for (auto& node : nodes)
+    {
+        for (int i = 0; i < node->processor->getNumParameters(); ++i)
+            nodeParameters.push_back (&node->processor->getParameter (i));
+    }
+
+    auto newParameters = std::make_unique<const ParameterList> (std::move (nodeParameters));
+
+    // The previous list ends up in newParameters, and is freed after the lock is released
+    const SpinLock::ScopedLockType sl (parameterLock);
+    std::swap (parameters, newParameters);
+}
+
+std::unique_ptr<AudioProcessorGraph::RenderSequence> AudioProcessorGraph::createRenderSequence (int numQueues) const
+{
+    return std::make_unique<RenderSequence> (nodes,
+                                             connections,
+                                             2 * numInputBuses,
+                                             2 * numOutputBuses,
+                                             currentMaxBlockSize,
+                                             numQueues);
+}
+
+void AudioProcessorGraph::rebuild()
+{
+    if (! isPrepared)
+        return;
+
+    auto newSequence = createRenderSequence (workerPool != nullptr ? workerPool->getNumWorkerThreads() + 1 : 1);
+    latencySamples = newSequence->getLatencySamples();
+
+    const SpinLock::ScopedLockType sl (renderLock);
+    std::swap (renderSequence, newSequence);
+}
+
+} // namespace yup
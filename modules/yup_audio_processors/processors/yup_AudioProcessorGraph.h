@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+/** An AudioProcessor that renders a graph of other processors.
+
+    Each node of the graph owns an AudioProcessor, and nodes are wired together with connections
+    between single audio channels or between their MIDI streams. Every bus of a processor is stereo,
+    so a node exposes two channels for each of its buses. The audio and MIDI passed to processBlock
+    enter the graph from the node with id inputNodeID, and what is connected to the node with id
+    outputNodeID is what the graph returns.
+
+    Whenever the topology changes on a prepared graph, a render sequence is built on the calling
+    thread: the nodes are sorted topologically, each one gets a buffer allocated for the maximum
+    block size, and audio connections coming from a source which is less delayed than the other
+    inputs of their destination get a delay line, so the latencies reported by the processors are
+    compensated. The sequence is then handed to the audio thread, which never allocates nor waits
+    for it: a block processed while the sequence is being swapped is silent. Every node reserves
+    room for 4096 bytes of MIDI per block, the events beyond that are dropped.
+
+    When worker threads are enabled, the nodes which have all their inputs ready are processed in
+    parallel. Every thread, the audio thread included, keeps a lock-free queue of ready nodes: a
+    thread pushes the nodes it unblocks to its own queue, and steals from the queues of the others
+    when it runs out of work. All the nodes are joined before the output node is mixed, so the
+    result is the same as the one of a single threaded render.
+
+    The topology methods must be called from a single thread, which is not the audio thread.
+
+    @see AudioProcessor
+*/
+class JUCE_API AudioProcessorGraph : public AudioProcessor
+{
+public:
+    //==============================================================================
+    /** The identifier of a node in the graph. */
+    using NodeID = uint32;
+
+    /** The node providing the audio and MIDI passed to processBlock. */
+    static constexpr NodeID inputNodeID = 1;
+
+    /** The node collecting the audio and MIDI returned by processBlock. */
+    static constexpr NodeID outputNodeID = 2;
+
+    /** The channel index used by connections carrying MIDI instead of audio. */
+    static constexpr int midiChannelIndex = -1;
+
+    //==============================================================================
+    /** A connection between a channel of a node and a channel of another node. */
+    struct Connection
+    {
+        NodeID sourceNode = 0;
+        int sourceChannel = 0;
+        NodeID destinationNode = 0;
+        int destinationChannel = 0;
+
+        /** Returns true if the connection carries MIDI. */
+        bool isMidi() const noexcept { return sourceChannel == midiChannelIndex; }
+
+        bool operator== (const Connection& other) const noexcept;
+        bool operator!= (const Connection& other) const noexcept;
+    };
+
+    //==============================================================================
+    /** Creates an empty graph.
+
+        @param numInputBusesToUse The number of stereo buses read by the graph.
+        @param numOutputBusesToUse The number of stereo buses written by the graph.
+    */
+    AudioProcessorGraph (int numInputBusesToUse = 1, int numOutputBusesToUse = 1);
+
+    /** Destructor. */
+    ~AudioProcessorGraph() override;
+
+    //==============================================================================
+    /** Adds a node processing audio with the given processor.
+
+        If the graph is prepared, the processor is prepared with the same settings.
+
+        @return The id of the new node, or 0 if the processor is null.
+    */
+    NodeID addNode (std::unique_ptr<AudioProcessor> processor);
+
+    /** Removes a node and all its connections.
+
+        @return True if the node existed and was removed.
+    */
+    bool removeNode (NodeID nodeID);
+
+    /** Removes all the nodes and connections. */
+    void clear();
+
+    /** Returns the number of nodes, excluding the input and output ones. */
+    int getNumNodes() const noexcept;
+
+    /** Returns the processor of a node, or nullptr if the node doesn't exist. */
+    AudioProcessor* getProcessorForNode (NodeID nodeID) const;
+
+    /** Returns the number of audio channels a node can be connected to as a destination. */
+    int getNumInputChannels (NodeID nodeID) const;
+
+    /** Returns the number of audio channels a node can be connected from as a source. */
+    int getNumOutputChannels (NodeID nodeID) const;
+
+    //==============================================================================
+    /** Returns true if the connection is valid and can be added without creating a cycle. */
+    bool canConnect (const Connection& connection) const;
+
+    /** Adds a connection.
+
+        @return True if the connection was added, false if it was invalid, would create a cycle
+                or already existed.
+    */
+    bool addConnection (const Connection& connection);
+
+    /** Removes a connection.
+
+        @return True if the connection existed and was removed.
+    */
+    bool removeConnection (const Connection& connection);
+
+    /** Returns true if the connection exists. */
+    bool isConnected (const Connection& connection) const;
+
+    /** Returns all the connections of the graph. */
+    const std::vector<Connection>& getConnections() const noexcept { return connections; }
+
+    //==============================================================================
+    /** Sets the number of worker threads helping the audio thread to process the nodes.
+
+        With zero worker threads, which is the default, the nodes are processed in order on the
+        audio thread. The workers are started as realtime threads when the system allows it.
+    */
+    void setNumWorkerThreads (int numThreads);
+
+    /** Returns the number of worker threads. */
+    int getNumWorkerThreads() const noexcept { return numWorkerThreads; }
+
+    //==============================================================================
+    /** Returns the parameters of all the nodes, in the order the nodes were added. */
+    int getNumParameters() const override;
+
+    /** Returns a parameter of one of the nodes. */
+    AudioProcessorParameter& getParameter (int index) override;
+
+    int getNumAudioOutputs() const override { return numOutputBuses; }
+    int getNumAudioInputs() const override { return numInputBuses; }
+
+    /** Returns the latency of the longest path between the input and the output node. */
+    int getLatencySamples() const override;
+
+    void prepareToPlay (float sampleRate, int maxBlockSize) override;
+    void releaseResources() override;
+
+    void processBlock (AudioSampleBuffer& audioBuffer, MidiBuffer& midiBuffer) override;
+
+    void flush() override;
+
+    bool hasEditor() const override { return false; }
+
+private:
+    struct Node
+    {
+        NodeID nodeID = 0;
+        std::unique_ptr<AudioProcessor> processor;
+    };
+
+    class WorkStealingQueue;
+    class RenderSequence;
+
+    using ParameterList = std::vector<AudioProcessorParameter*>;
+
+    Node* getNode (NodeID nodeID) const;
+    bool isValidSource (NodeID nodeID, int channel) const;
+    bool isValidDestination (NodeID nodeID, int channel) const;
+    bool isReachable (NodeID fromNode, NodeID toNode) const;
+    void updateParameters();
+    std::unique_ptr<RenderSequence> createRenderSequence (int numQueues) const;
+    void rebuild();
+
+    const int numInputBuses;
+    const int numOutputBuses;
+
+    std::vector<std::unique_ptr<Node>> nodes;
+    std::vector<Connection> connections;
+    NodeID lastNodeID = outputNodeID;
+
+    float currentSampleRate = 0.0f;
+    int currentMaxBlockSize = 0;
+    bool isPrepared = false;
+    int numWorkerThreads = 0;
+    int latencySamples = 0;
+
+    // The parameters can be queried from any thread, so the list is replaced as a whole like the render sequence
+    SpinLock parameterLock;
+    std::unique_ptr<const ParameterList> parameters = std::make_unique<const ParameterList>();
+
+    SpinLock renderLock;
+    std::unique_ptr<RenderSequence> renderSequence;
+    std::unique_ptr<ParallelTaskPool> workerPool;
+
+    JUCE_DECLARE_NON_COPYABLE (AudioProcessorGraph)
+};
+
+} // namespace yup
@@ -41,4 +41,28 @@ AudioProcessorParameter::~AudioProcessorParameter()
 {
 }
 
+//==============================================================================
+
+void AudioProcessorParameter::setValueNotifyingHost (float value)
+{
+    setValue (value);
+    sendChangeToHost (ParameterChangeQueue::EventType::valueChange);
+}
+
+void AudioProcessorParameter::beginChangeGesture()
+{
+    sendChangeToHost (ParameterChangeQueue::EventType::gestureBegin);
+}
+
+void AudioProcessorParameter::endChangeGesture()
+{
+    sendChangeToHost (ParameterChangeQueue::EventType::gestureEnd);
+}
+
+void AudioProcessorParameter::sendChangeToHost (ParameterChangeQueue::EventType type)
+{
+    if (owner != nullptr)
+        owner->queueEditorParameterChange ({ type, parameterIndex, getValue() });
+}
+
 } // namespace yup
@@ -22,6 +22,8 @@
 namespace yup
 {
 
+class AudioProcessor;
+
 //==============================================================================
 class JUCE_API AudioProcessorParameter
 {
@@ -38,6 +40,18 @@ public:
 
     void setValue (float value) { currentValue = jlimit (minValue, maxValue, value); }
 
+    /** Changes the value from the editor, queueing the change so the host is told about it. */
+    void setValueNotifyingHost (float value);
+
+    /** Tells the host the user started changing the value, for example by grabbing a slider. */
+    void beginChangeGesture();
+
+    /** Tells the host the user finished changing the value. */
+    void endChangeGesture();
+
+    /** Returns the index of the parameter in its processor, or -1 if it's not connected to one. */
+    int getParameterIndex() const { return parameterIndex; }
+
     float getMinimumValue() const { return minValue; }
 
     float getMaximumValue() const { return maxValue; }
@@ -47,6 +61,13 @@ public:
     const String& getName() const { return name; }
 
 private:
+    friend class AudioProcessor;
+
+    void sendChangeToHost (ParameterChangeQueue::EventType type);
+
+    AudioProcessor* owner = nullptr;
+    int parameterIndex = -1;
+
     std::atomic<float> currentValue;
     const float minValue;
     const float maxValue;
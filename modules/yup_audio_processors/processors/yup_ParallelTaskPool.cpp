@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+class ParallelTaskPool::Worker : public Thread
+{
+public:
+    explicit Worker (ParallelTaskPool& pool)
+        : Thread ("ParallelTaskPool worker")
+        , owner (pool)
+    {
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            wakeUp.wait (-1);
+
+            if (! threadShouldExit())
+                owner.runWorker();
+        }
+    }
+
+    WaitableEvent wakeUp;
+
+private:
+    ParallelTaskPool& owner;
+};
+
+//==============================================================================
+ParallelTaskPool::ParallelTaskPool (int numWorkerThreads)
+{
+    for (int i = 0; i < numWorkerThreads; ++i)
+        workers.push_back (std::make_unique<Worker> (*this));
+
+    for (auto& worker : workers)
+    {
+        if (! worker->startRealtimeThread (Thread::RealtimeOptions().withPriority (8)))
+            worker->startThread (Thread::Priority::highest);
+    }
+}
+
+ParallelTaskPool::~ParallelTaskPool()
+{
+    for (auto& worker : workers)
+    {
+        worker->signalThreadShouldExit();
+        worker->wakeUp.signal();
+    }
+
+    for (auto& worker : workers)
+        worker->stopThread (-1);
+}
+
+//==============================================================================
+int ParallelTaskPool::getNumWorkerThreads() const noexcept
+{
+    return static_cast<int> (workers.size());
+}
+
+//==============================================================================
+void ParallelTaskPool::run (int numTasks, TaskFunction function, void* context) noexcept
+{
+    jassert (function != nullptr);
+    jassert ((batchState.load (std::memory_order_relaxed) & batchClosedFlag) != 0); // Not reentrant!
+
+    if (numTasks <= 0)
+        return;
+
+    taskFunction = function;
+    taskContext = context;
+    numTasksInBatch = numTasks;
+
+    nextTask.store (0, std::memory_order_relaxed);
+    batchState.store (0, std::memory_order_release);
+
+    // There's no point in waking up more workers than the tasks left for them
+    const auto numWorkersToWake = jmin (getNumWorkerThreads(), numTasks - 1);
+    for (int i = 0; i < numWorkersToWake; ++i)
+        workers[static_cast<std::size_t> (i)]->wakeUp.signal();
+
+    runTasks();
+
+    // Close the batch, then wait for the workers that joined it to finish their last task
+    batchState.fetch_or (batchClosedFlag, std::memory_order_acq_rel);
+
+    while ((batchState.load (std::memory_order_acquire) & ~batchClosedFlag) != 0)
+        std::this_thread::yield();
+}
+
+//==============================================================================
+void ParallelTaskPool::runWorker() noexcept
+{
+    // Workers waking up after the batch was closed must not touch the tasks anymore
+    auto state = batchState.load (std::memory_order_acquire);
+
+    do
+    {
+        if ((state & batchClosedFlag) != 0)
+            return;
+    }
+    while (! batchState.compare_exchange_weak (state, state + 1, std::memory_order_acq_rel, std::memory_order_acquire));
+
+    runTasks();
+
+    batchState.fetch_sub (1, std::memory_order_release);
+}
+
+void ParallelTaskPool::runTasks() noexcept
+{
+    for (int taskIndex = nextTask.fetch_add (1, std::memory_order_relaxed);
+         taskIndex < numTasksInBatch;
+         taskIndex = nextTask.fetch_add (1, std::memory_order_relaxed))
+    {
+        taskFunction (taskContext, taskIndex);
+    }
+}
+
+} // namespace yup
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+/** A pool of realtime threads running a batch of independent tasks in parallel.
+
+    The thread calling run takes part in the work, and the call returns once every task of the
+    batch has been completed. Tasks are claimed one at a time, so batches with tasks of uneven
+    cost are still balanced across the threads.
+
+    Running a batch doesn't allocate, and the tasks are claimed and joined with atomics only. The
+    sleeping workers are woken through a WaitableEvent though, whose signal briefly takes the lock
+    of the event, which a worker only holds while going to sleep or waking up.
+
+    @see AudioProcessor::parallelFor
+*/
+class JUCE_API ParallelTaskPool
+{
+public:
+    /** The function called for each task, receiving the context passed to run. */
+    using TaskFunction = void (*) (void* context, int taskIndex);
+
+    //==============================================================================
+    /** Creates a pool, starting the worker threads. */
+    explicit ParallelTaskPool (int numWorkerThreads);
+
+    /** Destructor, stopping the worker threads. */
+    ~ParallelTaskPool();
+
+    //==============================================================================
+    /** Returns the number of worker threads, not counting the calling thread. */
+    int getNumWorkerThreads() const noexcept;
+
+    /** Runs the tasks with indices from 0 to numTasks - 1, returning when all have completed.
+
+        This must not be called concurrently, or from inside a running task.
+    */
+    void run (int numTasks, TaskFunction function, void* context) noexcept;
+
+private:
+    class Worker;
+
+    void runWorker() noexcept;
+    void runTasks() noexcept;
+
+    static constexpr int batchClosedFlag = 1 << 30;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    TaskFunction taskFunction = nullptr;
+    void* taskContext = nullptr;
+    int numTasksInBatch = 0;
+
+    std::atomic<int> nextTask { 0 };
+    std::atomic<int> batchState { batchClosedFlag };
+
+    JUCE_DECLARE_NON_COPYABLE (ParallelTaskPool)
+};
+
+} // namespace yup
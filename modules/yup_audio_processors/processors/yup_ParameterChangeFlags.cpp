@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+void ParameterChangeFlags::setNumParameters (int newNumParameters)
+{
+    numParameters = jmax (0, newNumParameters);
+    numWords = (numParameters + 63) / 64;
+
+    words = std::make_unique<std::atomic<uint64>[]> (static_cast<std::size_t> (numWords));
+}
+
+void ParameterChangeFlags::markChanged (int parameterIndex) noexcept
+{
+    if (! isPositiveAndBelow (parameterIndex, numParameters))
+        return;
+
+    words[parameterIndex / 64].fetch_or (uint64 (1) << (parameterIndex % 64), std::memory_order_release);
+}
+
+void ParameterChangeFlags::markAllChanged() noexcept
+{
+    for (int parameterIndex = 0; parameterIndex < numParameters; parameterIndex += 64)
+    {
+        const auto numBits = jmin (64, numParameters - parameterIndex);
+        const auto mask = numBits == 64 ? ~uint64 (0) : (uint64 (1) << numBits) - 1;
+
+        words[parameterIndex / 64].fetch_or (mask, std::memory_order_release);
+    }
+}
+
+bool ParameterChangeFlags::hasChanges() const noexcept
+{
+    for (int word = 0; word < numWords; ++word)
+    {
+        if (words[word].load (std::memory_order_relaxed) != 0)
+            return true;
+    }
+
+    return false;
+}
+
+int ParameterChangeFlags::countTrailingZeros (uint64 value) noexcept
+{
+    jassert (value != 0);
+
+#if JUCE_MSVC
+    unsigned long index = 0;
+    _BitScanForward64 (&index, value);
+    return static_cast<int> (index);
+#else
+    return __builtin_ctzll (value);
+#endif
+}
+
+} // namespace yup
@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+/** A lock-free set of flags marking which parameters have changed.
+
+    This is used to tell an editor which parameters the host changed: the audio thread marks the
+    parameters as it applies the changes, and the message thread visits only the marked ones
+    (clearing them) instead of comparing the values of all the parameters. Repeated changes of the
+    same parameter are coalesced, so the flags never overflow.
+
+    Marking and visiting never allocate nor lock, and can happen concurrently.
+
+    @see AudioProcessor::getHostParameterChanges
+*/
+class JUCE_API ParameterChangeFlags
+{
+public:
+    //==============================================================================
+    /** Creates an empty set of flags. */
+    ParameterChangeFlags() = default;
+
+    /** Resizes the set for a number of parameters, clearing all the flags. This allocates, and must
+        not be called while other threads are using the flags.
+    */
+    void setNumParameters (int numParameters);
+
+    /** Returns the number of parameters the set can mark. */
+    int getNumParameters() const noexcept { return numParameters; }
+
+    //==============================================================================
+    /** Marks a parameter as changed. */
+    void markChanged (int parameterIndex) noexcept;
+
+    /** Marks all the parameters as changed. */
+    void markAllChanged() noexcept;
+
+    /** Returns true if any parameter is marked as changed. */
+    bool hasChanges() const noexcept;
+
+    /** Clears the flags, passing the index of each parameter which was marked to a callback.
+
+        @return The number of parameters which were marked.
+    */
+    template <class Callback>
+    int forEachChanged (Callback&& callback)
+    {
+        int numChanged = 0;
+
+        for (int word = 0; word < numWords; ++word)
+        {
+            if (words[word].load (std::memory_order_relaxed) == 0)
+                continue;
+
+            auto bits = words[word].exchange (0, std::memory_order_acquire);
+
+            while (bits != 0)
+            {
+                const auto bit = countTrailingZeros (bits);
+                bits &= bits - 1;
+
+                callback (word * 64 + bit);
+                ++numChanged;
+            }
+        }
+
+        return numChanged;
+    }
+
+private:
+    static int countTrailingZeros (uint64 value) noexcept;
+
+    std::unique_ptr<std::atomic<uint64>[]> words;
+    int numWords = 0;
+    int numParameters = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (ParameterChangeFlags)
+};
+
+} // namespace yup
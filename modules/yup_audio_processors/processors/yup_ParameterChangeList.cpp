@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+ParameterChangeList::ParameterChangeList()
+{
+    ensureCapacity (defaultCapacity);
+}
+
+void ParameterChangeList::ensureCapacity (int numChanges)
+{
+    changes.reserve (static_cast<std::size_t> (jmax (0, numChanges)));
+}
+
+void ParameterChangeList::clear() noexcept
+{
+    changes.clear();
+}
+
+void ParameterChangeList::addChange (int sampleOffset, int parameterIndex, float value) noexcept
+{
+    const Change change { jmax (0, sampleOffset), parameterIndex, value };
+
+    if (changes.size() == changes.capacity())
+    {
+        // The list is full, reserve more room with ensureCapacity before processing
+        jassertfalse;
+
+        for (auto it = changes.rbegin(); it != changes.rend(); ++it)
+        {
+            if (it->parameterIndex == parameterIndex && it->sampleOffset <= change.sampleOffset)
+            {
+                it->value = value;
+                break;
+            }
+        }
+
+        return;
+    }
+
+    // Hosts usually send the changes in order, so appending is the common case
+    if (changes.empty() || changes.back().sampleOffset <= change.sampleOffset)
+    {
+        changes.push_back (change);
+        return;
+    }
+
+    auto position = std::upper_bound (changes.begin(), changes.end(), change, [] (const Change& a, const Change& b)
+    {
+        return a.sampleOffset < b.sampleOffset;
+    });
+
+    changes.insert (position, change);
+}
+
+const ParameterChangeList::Change& ParameterChangeList::getChange (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, getNumChanges()));
+    return changes[static_cast<std::size_t> (index)];
+}
+
+} // namespace yup
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+/** A list of time-stamped parameter changes happening inside an audio block.
+
+    The changes are kept sorted by their sample offset, changes at the same offset keeping the
+    order they were added in. The storage is reused between blocks and never grows when adding
+    changes, so the audio thread doesn't allocate: once the capacity reserved with ensureCapacity
+    is used up, a change updates the latest earlier change of the same parameter, or is dropped.
+
+    @see AudioProcessor::processBlockWithParameterChanges
+*/
+class JUCE_API ParameterChangeList
+{
+public:
+    //==============================================================================
+    /** A change of the value of a parameter, at a sample offset inside the block. */
+    struct Change
+    {
+        int sampleOffset = 0;
+        int parameterIndex = 0;
+        float value = 0.0f;
+    };
+
+    /** The number of changes reserved by the constructor. */
+    static constexpr int defaultCapacity = 128;
+
+    //==============================================================================
+    /** Creates an empty list, with room for defaultCapacity changes. */
+    ParameterChangeList();
+
+    /** Reserves space for a number of changes, so they can be added without allocating. */
+    void ensureCapacity (int numChanges);
+
+    /** Removes all the changes, keeping the allocated storage. */
+    void clear() noexcept;
+
+    /** Adds a change, keeping the list sorted by sample offset.
+
+        When the list is full, the value of the latest change of the same parameter at an earlier
+        or equal offset is replaced instead, and the change is dropped if there is none.
+    */
+    void addChange (int sampleOffset, int parameterIndex, float value) noexcept;
+
+    //==============================================================================
+    /** Returns the number of changes the list can hold. */
+    int getCapacity() const noexcept { return static_cast<int> (changes.capacity()); }
+
+    /** Returns the number of changes in the list. */
+    int getNumChanges() const noexcept { return static_cast<int> (changes.size()); }
+
+    /** Returns true if the list contains no changes. */
+    bool isEmpty() const noexcept { return changes.empty(); }
+
+    /** Returns a change by index. */
+    const Change& getChange (int index) const noexcept;
+
+    //==============================================================================
+    const Change* begin() const noexcept { return changes.data(); }
+    const Change* end() const noexcept { return changes.data() + changes.size(); }
+
+private:
+    std::vector<Change> changes;
+};
+
+} // namespace yup
@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+ParameterChangeQueue::ParameterChangeQueue (int capacity)
+    : fifo (jmax (1, capacity) + 1)
+    , events (static_cast<std::size_t> (jmax (1, capacity) + 1))
+{
+}
+
+bool ParameterChangeQueue::push (const Event& event) noexcept
+{
+    if (fifo.getFreeSpace() < 1)
+        return false;
+
+    const auto scope = fifo.write (1);
+    events[static_cast<std::size_t> (scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)] = event;
+
+    return true;
+}
+
+} // namespace yup
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+/** A lock-free queue of parameter changes, written by one thread and read by another.
+
+    This is used to pass the changes made by an editor to the host: the message thread pushes value
+    changes and the begin and end of the user gestures in the order they happen, and the host
+    drains them while processing or flushing, so it only hears about the parameters which actually
+    changed instead of polling all of them.
+
+    Pushing and popping never allocate nor lock. When the queue is full new events are dropped, so
+    its capacity should cover the changes expected between two reads.
+
+    @see AudioProcessor::getEditorParameterChanges
+*/
+class JUCE_API ParameterChangeQueue
+{
+public:
+    //==============================================================================
+    /** The kind of a queued event. */
+    enum class EventType
+    {
+        valueChange,
+        gestureBegin,
+        gestureEnd
+    };
+
+    /** A queued event. */
+    struct Event
+    {
+        EventType type = EventType::valueChange;
+        int parameterIndex = 0;
+        float value = 0.0f;
+    };
+
+    //==============================================================================
+    /** Creates a queue holding up to the given number of events. */
+    explicit ParameterChangeQueue (int capacity = 1024);
+
+    //==============================================================================
+    /** Adds an event to the queue. Must only be called by the writing thread.
+
+        @return True if the event was added, false if the queue was full.
+    */
+    bool push (const Event& event) noexcept;
+
+    /** Removes all the queued events, in order, passing each one to a callback. Must only be
+        called by the reading thread.
+
+        @return The number of events removed.
+    */
+    template <class Callback>
+    int popAll (Callback&& callback)
+    {
+        const auto scope = fifo.read (fifo.getNumReady());
+
+        for (int i = scope.startIndex1; i < scope.startIndex1 + scope.blockSize1; ++i)
+            callback (events[static_cast<std::size_t> (i)]);
+
+        for (int i = scope.startIndex2; i < scope.startIndex2 + scope.blockSize2; ++i)
+            callback (events[static_cast<std::size_t> (i)]);
+
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+    /** Returns the number of events waiting to be read. */
+    int getNumReady() const noexcept { return fifo.getNumReady(); }
+
+private:
+    AbstractFifo fifo;
+    std::vector<Event> events;
+
+    JUCE_DECLARE_NON_COPYABLE (ParameterChangeQueue)
+};
+
+} // namespace yup
@@ -31,6 +31,11 @@
 #include "yup_audio_processors.h"
 
 //==============================================================================
+#include "processors/yup_ParameterChangeQueue.cpp"
+#include "processors/yup_ParameterChangeFlags.cpp"
 #include "processors/yup_AudioProcessorParameter.cpp"
+#include "processors/yup_ParameterChangeList.cpp"
+#include "processors/yup_ParallelTaskPool.cpp"
 #include "processors/yup_AudioProcessorEditor.cpp"
 #include "processors/yup_AudioProcessor.cpp"
+#include "processors/yup_AudioProcessorGraph.cpp"
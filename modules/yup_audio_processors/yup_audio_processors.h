@@ -47,6 +47,11 @@
 #include <yup_gui/yup_gui.h>
 
 //==============================================================================
+#include "processors/yup_ParameterChangeQueue.h"
+#include "processors/yup_ParameterChangeFlags.h"
 #include "processors/yup_AudioProcessorParameter.h"
+#include "processors/yup_ParameterChangeList.h"
+#include "processors/yup_ParallelTaskPool.h"
 #include "processors/yup_AudioProcessorEditor.h"
 #include "processors/yup_AudioProcessor.h"
+#include "processors/yup_AudioProcessorGraph.h"
@@ -41,7 +41,8 @@ public:
         OpenGL,   ///< Specifies the use of OpenGL for rendering.
         Direct3D, ///< Specifies the use of Direct3D for rendering.
         Metal,    ///< Specifies the use of Metal for rendering.
-        Dawn      ///< Specifies the use of Dawn, a Vulkan-like API.
+        Dawn,     ///< Specifies the use of Dawn, a Vulkan-like API.
+        Software  ///< Specifies the use of the CPU rasteriser, rendering offscreen into an Image.
     };
 
     /** Configuration options for creating a graphics context. */
@@ -55,6 +56,7 @@ public:
         bool synchronousShaderCompilations = false; ///< Controls whether shader compilations are done synchronously.
         bool enableReadPixels = false;              ///< Enables reading pixels directly from the framebuffer.
         bool disableRasterOrdering = false;         ///< Disables specific raster ordering features for performance.
+        int numRenderThreads = 0;                   ///< Number of additional threads used by the software rasteriser, 0 renders on the calling thread only.
     };
 
     //==============================================================================
@@ -134,6 +136,65 @@ public:
     /** Performs periodic operations, potentially related to animation or state updates. */
     virtual void tick() {}
 
+    //==============================================================================
+    /** Reads back the content of the framebuffer rendered by the last completed frame.
+
+        This is only supported by contexts rendering into memory, like the Software one.
+
+        @return An RGBA image with unpremultiplied pixels, or an invalid image if the context can't read back pixels.
+    */
+    virtual Image readPixels() { return {}; }
+
+    /** Creates a render image that can be drawn by the renderers of this context.
+
+        Contexts with a GPU render context create their images from it, so this is only needed
+        by contexts that return nullptr from renderContextOrNull.
+
+        @param image The image to wrap.
+
+        @return The render image, or nullptr if the context doesn't support it.
+    */
+    virtual rive::rcp<rive::RenderImage> makeRenderImage (const Image& image)
+    {
+        ignoreUnused (image);
+        return nullptr;
+    }
+
+    /** Creates a render image whose pixels can be updated in place after creation.
+
+        Unlike the textures created for plain images, these are created without mipmaps, so that
+        areas of them can be re-uploaded cheaply with updateRenderImage.
+
+        @param image The RGBA image providing the initial pixels.
+
+        @return The render image, or nullptr if the context can't create images.
+    */
+    virtual rive::rcp<rive::RenderImage> makeUpdatableRenderImage (const Image& image);
+
+    /** Uploads an area of an image into a render image created from it by makeUpdatableRenderImage.
+
+        @param renderImage The render image to update.
+        @param image The image holding the new pixels, with the same size as the render image.
+        @param area The area of the image to upload.
+
+        @return True if the render image has been updated, false if the context can't update it in
+                place and the render image needs to be recreated instead.
+    */
+    virtual bool updateRenderImage (rive::RenderImage& renderImage, const Image& image, const Rectangle<int>& area);
+
+    //==============================================================================
+    /** Returns the cache of render paths and paints shared by the Graphics objects drawing into this context.
+
+        @return A reference to the RenderCache owned by this context.
+    */
+    RenderCache& getRenderCache() noexcept { return renderCache; }
+
+    /** Returns the atlas packing the small images drawn into this context.
+
+        @return A reference to the ImageAtlas owned by this context.
+    */
+    ImageAtlas& getImageAtlas() noexcept { return imageAtlas; }
+
     //==============================================================================
     /** Static factory method to create a graphics context using a specific graphics API.
 
@@ -143,6 +204,20 @@ public:
         @return A unique pointer to a GraphicsContext, using the specified graphics API and configured according to the options.
     */
     static std::unique_ptr<GraphicsContext> createContext (Api graphicsApi, Options options);
+
+protected:
+    //==============================================================================
+    /** Releases the renderer objects cached for this context and the pages of its image atlas.
+
+        The cached objects and the atlas textures are created by the device of the backend, which is
+        destroyed before the members of this base class, so backends must call this at the start of
+        their destructor.
+    */
+    void releaseCachedResources();
+
+private:
+    RenderCache renderCache;
+    ImageAtlas imageAtlas;
 };
 
 } // namespace yup
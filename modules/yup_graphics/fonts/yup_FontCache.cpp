@@ -0,0 +1,262 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace yup
+{
+
+//==============================================================================
+FontCache& FontCache::getInstance()
+{
+    static FontCache instance;
+    return instance;
+}
+
+//==============================================================================
+std::shared_ptr<const rive::RawPath> FontCache::getGlyphPath (const rive::rcp<rive::Font>& font, rive::GlyphID glyph)
+{
+    jassert (font != nullptr);
+
+    const auto hash = hashGlyph (font.get(), glyph);
+
+    {
+        const ScopedLock sl (lock);
+
+        for (auto [it, end] = glyphLookup.equal_range (hash); it != end; ++it)
+        {
+            const auto& entry = *it->second;
+
+            if (entry.font == font && entry.glyph == glyph)
+            {
+                glyphs.splice (glyphs.begin(), glyphs, it->second);
+
+                ++statistics.glyphHits;
+                return entry.path;
+            }
+        }
+
+        ++statistics.glyphMisses;
+    }
+
+    // Extract the outline outside of the lock, as it's the expensive part
+    auto path = std::make_shared<const rive::RawPath> (font->getPath (glyph));
+
+    const ScopedLock sl (lock);
+
+    glyphs.push_front ({ font, glyph, path });
+    glyphLookup.emplace (hash, glyphs.begin());
+
+    trimGlyphs();
+
+    return path;
+}
+
+//==============================================================================
+std::shared_ptr<const rive::SimpleArray<rive::Paragraph>> FontCache::getShapedText (rive::Span<const rive::Unichar> text,
+                                                                                   rive::Span<const rive::TextRun> runs)
+{
+    if (text.empty() || runs.empty() || runs[0].font == nullptr)
+        return std::make_shared<const rive::SimpleArray<rive::Paragraph>>();
+
+    const auto hash = hashShaping (text, runs);
+
+    {
+        const ScopedLock sl (lock);
+
+        for (auto [it, end] = shapingLookup.equal_range (hash); it != end; ++it)
+        {
+            const auto& entry = *it->second;
+
+            if (isSameShaping (entry, text, runs))
+            {
+                shapings.splice (shapings.begin(), shapings, it->second);
+
+                ++statistics.shapingHits;
+                return entry.paragraphs;
+            }
+        }
+
+        ++statistics.shapingMisses;
+    }
+
+    // Shape outside of the lock, as it's the expensive part
+    auto paragraphs = std::make_shared<const rive::SimpleArray<rive::Paragraph>> (runs[0].font->shapeText (text, runs));
+
+    ShapingEntry entry;
+    entry.hash = hash;
+    entry.text.assign (text.begin(), text.end());
+    entry.paragraphs = paragraphs;
+
+    entry.runs.reserve (runs.size());
+    for (const auto& run : runs)
+        entry.runs.push_back ({ run.font, run.size, run.lineHeight, run.letterSpacing, run.unicharCount, run.script, run.styleId, run.dir });
+
+    const ScopedLock sl (lock);
+
+    shapings.push_front (std::move (entry));
+    shapingLookup.emplace (hash, shapings.begin());
+
+    trimShapings();
+
+    return paragraphs;
+}
+
+//==============================================================================
+void FontCache::setMaxGlyphPaths (int numGlyphs)
+{
+    const ScopedLock sl (lock);
+
+    maxGlyphPaths = jmax (0, numGlyphs);
+    trimGlyphs();
+}
+
+void FontCache::setMaxShapedTexts (int numTexts)
+{
+    const ScopedLock sl (lock);
+
+    maxShapedTexts = jmax (0, numTexts);
+    trimShapings();
+}
+
+void FontCache::clear()
+{
+    const ScopedLock sl (lock);
+
+    glyphs.clear();
+    glyphLookup.clear();
+    shapings.clear();
+    shapingLookup.clear();
+
+    statistics = {};
+}
+
+//==============================================================================
+FontCache::Statistics FontCache::getStatistics() const
+{
+    const ScopedLock sl (lock);
+    return statistics;
+}
+
+int FontCache::getNumCachedGlyphPaths() const
+{
+    const ScopedLock sl (lock);
+    return static_cast<int> (glyphs.size());
+}
+
+int FontCache::getNumCachedShapedTexts() const
+{
+    const ScopedLock sl (lock);
+    return static_cast<int> (shapings.size());
+}
+
+//==============================================================================
+uint64 FontCache::hashGlyph (const rive::Font* font, rive::GlyphID glyph) noexcept
+{
+    return Hasher().add (static_cast<const void*> (font)).add (static_cast<uint32> (glyph)).getHash();
+}
+
+uint64 FontCache::hashShaping (rive::Span<const rive::Unichar> text, rive::Span<const rive::TextRun> runs) noexcept
+{
+    Hasher hasher;
+
+    for (const auto character : text)
+        hasher.add (static_cast<uint32> (character));
+
+    for (const auto& run : runs)
+    {
+        hasher.add (static_cast<const void*> (run.font.get()));
+        hasher.add (run.size);
+        hasher.add (run.lineHeight);
+        hasher.add (run.letterSpacing);
+        hasher.add ((static_cast<uint64> (run.unicharCount) << 32) | run.script);
+        hasher.add ((static_cast<uint64> (run.styleId) << 8) | static_cast<uint64> (run.dir));
+    }
+
+    return hasher.getHash();
+}
+
+bool FontCache::isSameShaping (const ShapingEntry& entry, rive::Span<const rive::Unichar> text, rive::Span<const rive::TextRun> runs) noexcept
+{
+    if (entry.text.size() != text.size() || entry.runs.size() != runs.size())
+        return false;
+
+    if (! std::equal (entry.text.begin(), entry.text.end(), text.begin()))
+        return false;
+
+    for (std::size_t i = 0; i < runs.size(); ++i)
+    {
+        const auto& a = entry.runs[i];
+        const auto& b = runs[i];
+
+        if (a.font != b.font
+            || a.size != b.size
+            || a.lineHeight != b.lineHeight
+            || a.letterSpacing != b.letterSpacing
+            || a.unicharCount != b.unicharCount
+            || a.script != b.script
+            || a.styleId != b.styleId
+            || a.dir != b.dir)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+void FontCache::trimGlyphs()
+{
+    while (static_cast<int> (glyphs.size()) > maxGlyphPaths)
+    {
+        const auto& entry = glyphs.back();
+        const auto hash = hashGlyph (entry.font.get(), entry.glyph);
+
+        for (auto [it, end] = glyphLookup.equal_range (hash); it != end; ++it)
+        {
+            if (it->second == std::prev (glyphs.end()))
+            {
+                glyphLookup.erase (it);
+                break;
+            }
+        }
+
+        glyphs.pop_back();
+    }
+}
+
+void FontCache::trimShapings()
+{
+    while (static_cast<int> (shapings.size()) > maxShapedTexts)
+    {
+        for (auto [it, end] = shapingLookup.equal_range (shapings.back().hash); it != end; ++it)
+        {
+            if (it->second == std::prev (shapings.end()))
+            {
+                shapingLookup.erase (it);
+                break;
+            }
+        }
+
+        shapings.pop_back();
+    }
+}
+
+} // namespace yup
@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace yup
+{
+
+//==============================================================================
+/** A process wide cache of glyph outlines and shaped text.
+
+    Extracting the outline of a glyph from a font and shaping a string with HarfBuzz are both
+    expensive operations, and text that is laid out every frame (like value readouts or button
+    labels) would otherwise repeat them over and over with the same inputs. This cache keeps the
+    glyph outlines keyed by font and glyph id, and the shaped paragraphs keyed by the text and the
+    runs describing its style, both bounded in size and evicting the least recently used entries.
+
+    Cached values are immutable and handed out as shared pointers, so they can be referenced by
+    laid out text without copying them and stay valid even after being evicted.
+
+    All the methods can be called from any thread.
+
+    @see StyledText
+*/
+class JUCE_API FontCache
+{
+public:
+    //==============================================================================
+    /** Counters collected by the cache since it was created or cleared. */
+    struct Statistics
+    {
+        int64 glyphHits = 0;     ///< Number of glyph outlines served from the cache.
+        int64 glyphMisses = 0;   ///< Number of glyph outlines extracted from the fonts.
+        int64 shapingHits = 0;   ///< Number of shaped texts served from the cache.
+        int64 shapingMisses = 0; ///< Number of texts that had to be shaped.
+    };
+
+    //==============================================================================
+    /** Returns the shared cache instance. */
+    static FontCache& getInstance();
+
+    //==============================================================================
+    /** Returns the outline of a glyph, in font units scaled to a size of 1.
+
+        @param font The font containing the glyph.
+        @param glyph The id of the glyph in the font.
+
+        @return The cached or newly extracted outline.
+    */
+    std::shared_ptr<const rive::RawPath> getGlyphPath (const rive::rcp<rive::Font>& font, rive::GlyphID glyph);
+
+    /** Returns the paragraphs resulting from shaping a text.
+
+        @param text The text to shape.
+        @param runs The runs describing the fonts and styles to use for consecutive portions of the text.
+
+        @return The cached or newly shaped paragraphs.
+    */
+    std::shared_ptr<const rive::SimpleArray<rive::Paragraph>> getShapedText (rive::Span<const rive::Unichar> text,
+                                                                            rive::Span<const rive::TextRun> runs);
+
+    //==============================================================================
+    /** Sets the maximum number of glyph outlines held by the cache. */
+    void setMaxGlyphPaths (int numGlyphs);
+
+    /** Sets the maximum number of shaped texts held by the cache. */
+    void setMaxShapedTexts (int numTexts);
+
+    /** Removes all the cached entries and resets the statistics. */
+    void clear();
+
+    //==============================================================================
+    /** Returns the statistics collected so far. */
+    Statistics getStatistics() const;
+
+    /** Returns the number of glyph outlines currently held by the cache. */
+    int getNumCachedGlyphPaths() const;
+
+    /** Returns the number of shaped texts currently held by the cache. */
+    int getNumCachedShapedTexts() const;
+
+private:
+    FontCache() = default;
+
+    struct GlyphEntry
+    {
+        rive::rcp<rive::Font> font;
+        rive::GlyphID glyph = 0;
+        std::shared_ptr<const rive::RawPath> path;
+    };
+
+    struct RunKey
+    {
+        rive::rcp<rive::Font> font;
+        float size = 0.0f;
+        float lineHeight = 0.0f;
+        float letterSpacing = 0.0f;
+        uint32 unicharCount = 0;
+        uint32 script = 0;
+        uint16 styleId = 0;
+        rive::TextDirection dir = rive::TextDirection::ltr;
+    };
+
+    struct ShapingEntry
+    {
+        uint64 hash = 0;
+        std::vector<rive::Unichar> text;
+        std::vector<RunKey> runs;
+        std::shared_ptr<const rive::SimpleArray<rive::Paragraph>> paragraphs;
+    };
+
+    using GlyphList = std::list<GlyphEntry>;
+    using ShapingList = std::list<ShapingEntry>;
+
+    static uint64 hashGlyph (const rive::Font* font, rive::GlyphID glyph) noexcept;
+    static uint64 hashShaping (rive::Span<const rive::Unichar> text, rive::Span<const rive::TextRun> runs) noexcept;
+    static bool isSameShaping (const ShapingEntry& entry, rive::Span<const rive::Unichar> text, rive::Span<const rive::TextRun> runs) noexcept;
+
+    void trimGlyphs();
+    void trimShapings();
+
+    mutable CriticalSection lock;
+
+    GlyphList glyphs;
+    std::unordered_multimap<uint64, GlyphList::iterator> glyphLookup;
+    int maxGlyphPaths = 4096;
+
+    ShapingList shapings;
+    std::unordered_multimap<uint64, ShapingList::iterator> shapingLookup;
+    int maxShapedTexts = 256;
+
+    Statistics statistics;
+
+    JUCE_DECLARE_NON_COPYABLE (FontCache)
+};
+
+} // namespace yup
@@ -49,10 +49,10 @@ StyledText::StyledText()
 void StyledText::clear()
 {
     unicodeChars.clear();
-    textRuns.clear();
-    glyphPaths.clear();
+    segments.clear();
+    glyphs.clear();
 
-    paragraphs = rive::SimpleArray<rive::Paragraph> {};
+    firstSegmentToShape = 0;
 }
 
 //==============================================================================
@@ -62,80 +62,118 @@ void StyledText::appendText (const Font& font,
                              float lineHeight,
                              const char text[])
 {
-    textRuns.push_back (append (font, size, lineHeight, text));
-
     jassert (font.getFont() != nullptr);
-    paragraphs = font.getFont()->shapeText (unicodeChars, textRuns);
+
+    const uint8_t* ptr = (const uint8_t*) text;
+
+    while (*ptr != '\0')
+    {
+        // Text after a new line starts a new paragraph, which is shaped independently
+        if (segments.empty() || segments.back().isTerminated)
+        {
+            Segment segment;
+            segment.startIndex = unicodeChars.size();
+            segments.push_back (std::move (segment));
+        }
+
+        auto& segment = segments.back();
+        firstSegmentToShape = jmin (firstSegmentToShape, segments.size() - 1);
+
+        uint32_t n = 0;
+
+        while (*ptr != '\0' && ! segment.isTerminated)
+        {
+            const auto character = rive::UTF::NextUTF8 (&ptr);
+            unicodeChars.push_back (character);
+            segment.isTerminated = (character == '\n');
+            n += 1;
+        }
+
+        segment.numChars += n;
+        segment.textRuns.push_back ({ font.getFont(), size, lineHeight, 0.0f, n });
+    }
+
+    if (editDepth == 0)
+        shapePendingSegments();
 }
 
 //==============================================================================
 
-rive::TextRun StyledText::append (const Font& font,
-                                  float size,
-                                  float lineHeight,
-                                  const char text[])
+void StyledText::beginEdit()
 {
-    const uint8_t* ptr = (const uint8_t*) text;
-    uint32_t n = 0;
+    ++editDepth;
+}
 
-    while (*ptr != '\0')
+void StyledText::endEdit()
+{
+    jassert (editDepth > 0);
+
+    if (editDepth > 0 && --editDepth == 0)
+        shapePendingSegments();
+}
+
+//==============================================================================
+
+void StyledText::shapePendingSegments()
+{
+    auto& fontCache = FontCache::getInstance();
+
+    for (std::size_t index = firstSegmentToShape; index < segments.size(); ++index)
     {
-        unicodeChars.push_back (rive::UTF::NextUTF8 (&ptr));
-        n += 1;
+        auto& segment = segments[index];
+
+        const rive::Span<const rive::Unichar> text (unicodeChars.data() + segment.startIndex, segment.numChars);
+        segment.paragraphs = fontCache.getShapedText (text, segment.textRuns);
     }
 
-    return { font.getFont(), size, lineHeight, 0.0f, n };
+    firstSegmentToShape = segments.size();
 }
 
 //==============================================================================
 
 void StyledText::layout (const Rectangle<float>& rect, Alignment align)
 {
-    glyphPaths.clear();
+    glyphs.clear();
+
+    shapePendingSegments();
 
     float x = rect.getX();
     float y = rect.getY();
     float paragraphWidth = rect.getWidth();
     float lineHeight = 11.0f;
 
-    float totalTextHeight = paragraphs.size() * lineHeight;
-
-    rive::SimpleArray<rive::SimpleArray<rive::GlyphLine>> linesArray (paragraphs.size());
-
-    std::size_t paragraphIndex = 0;
-    for (const auto& paragraph : paragraphs)
+    bool isFirstParagraph = true;
+    for (const auto& segment : segments)
     {
-        linesArray[paragraphIndex] = rive::GlyphLine::BreakLines (paragraph.runs, paragraphWidth);
-
-        ++paragraphIndex;
-    }
+        if (segment.paragraphs == nullptr)
+            continue;
 
-    paragraphIndex = 0;
-    for (const auto& paragraph : paragraphs)
-    {
-        rive::SimpleArray<rive::GlyphLine>& lines = linesArray[paragraphIndex];
+        for (const auto& paragraph : *segment.paragraphs)
+        {
+            auto lines = rive::GlyphLine::BreakLines (paragraph.runs, paragraphWidth);
 
-        rive::GlyphLine::ComputeLineSpacing (paragraphIndex == 0,
-                                             lines,
-                                             paragraph.runs,
-                                             paragraphWidth,
-                                             toTextAlign (align));
+            rive::GlyphLine::ComputeLineSpacing (isFirstParagraph,
+                                                 lines,
+                                                 paragraph.runs,
+                                                 paragraphWidth,
+                                                 toTextAlign (align));
 
-        y = layoutParagraph (paragraph,
-                             lines,
-                             { x, y });
+            y = layoutParagraph (paragraph,
+                                 lines,
+                                 { x, y });
 
-        y += lineHeight;
+            y += lineHeight;
 
-        ++paragraphIndex;
+            isFirstParagraph = false;
+        }
     }
 }
 
 //==============================================================================
 
-const std::vector<rive::RawPath>& StyledText::getGlyphs() const
+const std::vector<StyledText::Glyph>& StyledText::getGlyphs() const
 {
-    return glyphPaths;
+    return glyphs;
 }
 
 //==============================================================================
@@ -145,7 +183,7 @@ float StyledText::layoutText (const rive::GlyphRun& run,
                               unsigned endIndex,
                               rive::Vec2D origin)
 {
-    auto font = run.font.get();
+    auto& fontCache = FontCache::getInstance();
     const auto scale = rive::Mat2D::fromScale (run.size, run.size);
 
     float x = origin.x;
@@ -170,10 +208,7 @@ float StyledText::layoutText (const rive::GlyphRun& run,
         auto trans = rive::Mat2D::fromTranslate (x, origin.y);
         x += run.advances[i];
 
-        auto rawpath = font->getPath (run.glyphs[i]);
-        rawpath.transformInPlace (trans * scale);
-
-        glyphPaths.push_back (std::move (rawpath));
+        glyphs.push_back ({ fontCache.getGlyphPath (run.font, run.glyphs[i]), trans * scale });
 
         i += inc;
     }
@@ -35,6 +35,14 @@ public:
         right
     };
 
+    //==============================================================================
+    /** A glyph outline placed by the layout. */
+    struct Glyph
+    {
+        std::shared_ptr<const rive::RawPath> path; ///< The glyph outline, shared with the FontCache.
+        rive::Mat2D transform;                     ///< The transform placing the outline in the layout.
+    };
+
     //==============================================================================
     StyledText();
 
@@ -42,23 +50,37 @@ public:
     void clear();
 
     //==============================================================================
+    /** Appends a run of text using the specified font and size.
+
+        Only the last paragraph of the text, which is the one affected by the new run, is shaped
+        again: paragraphs that were terminated by a new line before the call are left untouched. When
+        called between beginEdit() and endEdit(), shaping is postponed until the last endEdit().
+    */
     void appendText (const Font& font,
                      float size,
                      float lineHeight,
                      const char text[]);
 
+    //==============================================================================
+    /** Starts a batch of edits.
+
+        Text appended after this call is shaped only once, when the matching endEdit() is called.
+        Calls can be nested, in which case shaping happens when the outermost batch ends.
+
+        @see endEdit
+    */
+    void beginEdit();
+
+    /** Ends a batch of edits started with beginEdit(), shaping any pending text. */
+    void endEdit();
+
     //==============================================================================
     void layout (const Rectangle<float>& rect, Alignment align);
 
     //==============================================================================
-    const std::vector<rive::RawPath>& getGlyphs() const;
+    const std::vector<Glyph>& getGlyphs() const;
 
 private:
-    rive::TextRun append (const Font& font,
-                          float size,
-                          float lineHeight,
-                          const char text[]);
-
     float layoutText (const rive::GlyphRun& run,
                       unsigned startIndex,
                       unsigned endIndex,
@@ -68,10 +90,22 @@ private:
                            const rive::SimpleArray<rive::GlyphLine>& lines,
                            rive::Vec2D origin);
 
+    struct Segment
+    {
+        std::size_t startIndex = 0;
+        std::size_t numChars = 0;
+        bool isTerminated = false;
+        std::vector<rive::TextRun> textRuns;
+        std::shared_ptr<const rive::SimpleArray<rive::Paragraph>> paragraphs;
+    };
+
+    void shapePendingSegments();
+
     std::vector<rive::Unichar> unicodeChars;
-    rive::SimpleArray<rive::Paragraph> paragraphs;
-    std::vector<rive::TextRun> textRuns;
-    std::vector<rive::RawPath> glyphPaths;
+    std::vector<Segment> segments;
+    std::size_t firstSegmentToShape = 0;
+    int editDepth = 0;
+    std::vector<Glyph> glyphs;
 };
 
 } // namespace yup
@@ -23,10 +23,11 @@ namespace yup
 {
 
 //==============================================================================
-/** Represents a gradient for graphical use, defined by two colors and their positions.
+/** Represents a gradient for graphical use, defined by two or more colors and their positions.
 
-    This class encapsulates a gradient, which can be either linear or radial, specified by two color stops.
-    Each stop has a color and a position, and in the case of radial gradients, a radius is calculated.
+    This class encapsulates a gradient, which can be either linear or radial, specified by a start and a finish color
+    stop, and optionally by any number of intermediate stops between them. Each stop has a color and a relative
+    position along the gradient, and in the case of radial gradients, a radius is calculated.
 */
 class JUCE_API ColorGradient
 {
@@ -156,6 +157,64 @@ public:
         return finish.delta;
     }
 
+    //==============================================================================
+    /** Adds a color stop between the start and the finish of the gradient.
+
+        Stops are kept sorted by their relative position, stops added at the same position of an existing one are
+        placed after it, allowing hard transitions between colors.
+
+        @param color The color of the stop.
+        @param delta The relative position of the stop along the gradient, in the range 0 to 1.
+    */
+    void addColorStop (Color color, float delta)
+    {
+        delta = jlimit (0.0f, 1.0f, delta);
+
+        const auto position = std::upper_bound (intermediateStops.begin(), intermediateStops.end(), delta, [] (float value, const ColorStop& stop)
+        {
+            return value < stop.delta;
+        });
+
+        intermediateStops.insert (position, ColorStop (color, start.x + (finish.x - start.x) * delta, start.y + (finish.y - start.y) * delta, delta));
+    }
+
+    /** Removes all the stops added with addColorStop, leaving only the start and the finish colors. */
+    void clearIntermediateStops()
+    {
+        intermediateStops.clear();
+    }
+
+    /** Gets the number of color stops, including the start and the finish ones.
+
+        @return The number of stops, at least 2.
+    */
+    int getNumStops() const noexcept
+    {
+        return static_cast<int> (intermediateStops.size()) + 2;
+    }
+
+    /** Gets the color of a stop.
+
+        @param index The index of the stop, where 0 is the start and getNumStops() - 1 the finish.
+
+        @return The color of the stop.
+    */
+    Color getStopColor (int index) const
+    {
+        return getStop (index).color;
+    }
+
+    /** Gets the relative position of a stop along the gradient.
+
+        @param index The index of the stop, where 0 is the start and getNumStops() - 1 the finish.
+
+        @return The relative position of the stop, in the range 0 to 1.
+    */
+    float getStopDelta (int index) const
+    {
+        return getStop (index).delta;
+    }
+
     //==============================================================================
     /** Gets the radius of the radial gradient.
 
@@ -175,15 +234,13 @@ public:
     */
     void setAlpha (uint8 alpha)
     {
-        start.color.setAlpha (alpha);
-        finish.color.setAlpha (alpha);
+        forEachStop ([alpha] (ColorStop& stop) { stop.color.setAlpha (alpha); });
     }
 
     // TODO - doxygen
     void setAlpha (float alpha)
     {
-        start.color.setAlpha (alpha);
-        finish.color.setAlpha (alpha);
+        forEachStop ([alpha] (ColorStop& stop) { stop.color.setAlpha (alpha); });
     }
 
     /** Creates a new gradient with a specified alpha value for both color stops.
@@ -213,8 +270,7 @@ public:
     ColorGradient withMultipliedAlpha (uint8 alpha) const
     {
         ColorGradient result (*this);
-        result.start.color = result.start.color.withMultipliedAlpha (alpha);
-        result.finish.color = result.finish.color.withMultipliedAlpha (alpha);
+        result.forEachStop ([alpha] (ColorStop& stop) { stop.color = stop.color.withMultipliedAlpha (alpha); });
         return result;
     }
 
@@ -222,11 +278,32 @@ public:
     ColorGradient withMultipliedAlpha (float alpha) const
     {
         ColorGradient result (*this);
-        result.start.color = result.start.color.withMultipliedAlpha (alpha);
-        result.finish.color = result.finish.color.withMultipliedAlpha (alpha);
+        result.forEachStop ([alpha] (ColorStop& stop) { stop.color = stop.color.withMultipliedAlpha (alpha); });
         return result;
     }
 
+    //==============================================================================
+    /** Compares two gradients for equality of type, geometry and color stops. */
+    bool operator== (const ColorGradient& other) const noexcept
+    {
+        if (type != other.type
+            || radius != other.radius
+            || intermediateStops.size() != other.intermediateStops.size()
+            || ! isSameStop (start, other.start)
+            || ! isSameStop (finish, other.finish))
+        {
+            return false;
+        }
+
+        return std::equal (intermediateStops.begin(), intermediateStops.end(), other.intermediateStops.begin(), isSameStop);
+    }
+
+    /** Compares two gradients for inequality. */
+    bool operator!= (const ColorGradient& other) const noexcept
+    {
+        return ! (*this == other);
+    }
+
 private:
     struct ColorStop
     {
@@ -251,9 +328,42 @@ private:
         float delta = 0.0f;
     };
 
+    const ColorStop& getStop (int index) const
+    {
+        jassert (isPositiveAndBelow (index, getNumStops()));
+
+        if (index <= 0)
+            return start;
+
+        if (index > static_cast<int> (intermediateStops.size()))
+            return finish;
+
+        return intermediateStops[static_cast<std::size_t> (index - 1)];
+    }
+
+    template <class F>
+    void forEachStop (F&& function)
+    {
+        function (start);
+
+        for (auto& stop : intermediateStops)
+            function (stop);
+
+        function (finish);
+    }
+
+    static bool isSameStop (const ColorStop& a, const ColorStop& b) noexcept
+    {
+        return a.color.getARGB() == b.color.getARGB()
+            && a.x == b.x
+            && a.y == b.y
+            && a.delta == b.delta;
+    }
+
     Type type = Type::Linear;
     ColorStop start;
     ColorStop finish;
+    std::vector<ColorStop> intermediateStops;
     float radius = 0.0f;
 };
 
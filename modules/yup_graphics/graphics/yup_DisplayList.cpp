@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace yup
+{
+
+//==============================================================================
+void DisplayList::startRecording (const AffineTransform& transform, const Rectangle<float>& area, float opacity)
+{
+    invalidate();
+
+    recordedTransform = transform;
+    recordedArea = area;
+    recordedOpacity = opacity;
+}
+
+void DisplayList::finishRecording (uint32 atlasGeneration) noexcept
+{
+    recordedAtlasGeneration = atlasGeneration;
+    valid = true;
+}
+
+bool DisplayList::isRecordedWith (const AffineTransform& transform, const Rectangle<float>& area, float opacity, uint32 atlasGeneration) const noexcept
+{
+    return valid
+        && recordedTransform == transform
+        && recordedArea == area
+        && recordedOpacity == opacity
+        && recordedAtlasGeneration == atlasGeneration;
+}
+
+void DisplayList::invalidate()
+{
+    commands.clear();
+    transforms.clear();
+    paths.clear();
+    paints.clear();
+    images.clear();
+    imageMeshes.clear();
+    imageDraws.clear();
+
+    valid = false;
+}
+
+//==============================================================================
+void DisplayList::replay (rive::Renderer& renderer) const
+{
+    std::size_t transformIndex = 0, pathIndex = 0, paintIndex = 0, imageIndex = 0, imageMeshIndex = 0;
+
+    for (const auto command : commands)
+    {
+        switch (command)
+        {
+            case Command::save:
+                renderer.save();
+                break;
+
+            case Command::restore:
+                renderer.restore();
+                break;
+
+            case Command::transform:
+                renderer.transform (transforms[transformIndex++]);
+                break;
+
+            case Command::drawPath:
+            {
+                auto path = paths[pathIndex++].get();
+                renderer.drawPath (path, paints[paintIndex++].get());
+                break;
+            }
+
+            case Command::clipPath:
+                renderer.clipPath (paths[pathIndex++].get());
+                break;
+
+            case Command::drawImage:
+            {
+                const auto& draw = images[imageIndex++];
+                renderer.drawImage (draw.image.get(), draw.blendMode, draw.opacity);
+                break;
+            }
+
+            case Command::drawImageMesh:
+            {
+                const auto& draw = imageMeshes[imageMeshIndex++];
+                renderer.drawImageMesh (draw.image.get(),
+                                        draw.vertices,
+                                        draw.uvCoords,
+                                        draw.indices,
+                                        draw.vertexCount,
+                                        draw.indexCount,
+                                        draw.blendMode,
+                                        draw.opacity);
+                break;
+            }
+        }
+    }
+}
+
+//==============================================================================
+void DisplayList::recordImageDraw (const void* texture, bool isFromAtlas)
+{
+    imageDraws.push_back ({ texture, isFromAtlas });
+}
+
+//==============================================================================
+void DisplayList::save()
+{
+    commands.push_back (Command::save);
+}
+
+void DisplayList::restore()
+{
+    commands.push_back (Command::restore);
+}
+
+void DisplayList::transform (const rive::Mat2D& transform)
+{
+    commands.push_back (Command::transform);
+    transforms.push_back (transform);
+}
+
+void DisplayList::drawPath (rive::RenderPath* path, rive::RenderPaint* paint)
+{
+    commands.push_back (Command::drawPath);
+    paths.push_back (rive::ref_rcp (path));
+    paints.push_back (rive::ref_rcp (paint));
+}
+
+void DisplayList::clipPath (rive::RenderPath* path)
+{
+    commands.push_back (Command::clipPath);
+    paths.push_back (rive::ref_rcp (path));
+}
+
+void DisplayList::drawImage (const rive::RenderImage* image, rive::BlendMode blendMode, float opacity)
+{
+    commands.push_back (Command::drawImage);
+    images.push_back ({ rive::ref_rcp (const_cast<rive::RenderImage*> (image)), blendMode, opacity });
+}
+
+void DisplayList::drawImageMesh (const rive::RenderImage* image,
+                                 rive::rcp<rive::RenderBuffer> vertices,
+                                 rive::rcp<rive::RenderBuffer> uvCoords,
+                                 rive::rcp<rive::RenderBuffer> indices,
+                                 uint32_t vertexCount,
+                                 uint32_t indexCount,
+                                 rive::BlendMode blendMode,
+                                 float opacity)
+{
+    commands.push_back (Command::drawImageMesh);
+    imageMeshes.push_back ({ rive::ref_rcp (const_cast<rive::RenderImage*> (image)),
+                             std::move (vertices),
+                             std::move (uvCoords),
+                             std::move (indices),
+                             vertexCount,
+                             indexCount,
+                             blendMode,
+                             opacity });
+}
+
+} // namespace yup
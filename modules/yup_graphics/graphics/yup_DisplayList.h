@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace yup
+{
+
+//==============================================================================
+/** A recorded sequence of renderer commands that can be replayed multiple times.
+
+    A DisplayList acts as a rive::Renderer: every command sent to it (state save and restore,
+    transforms, path draws, clips and image draws) is stored in a compact command buffer together
+    with references to the render paths, paints and images it uses. The recorded commands can then
+    be replayed into any other renderer, without having to rerun the code that generated them.
+
+    Recorded render objects are retained by reference, so the owner of the objects must not
+    modify them after recording if the replayed output is expected to stay the same. Recordings
+    referencing pages of the ImageAtlas are only valid for the atlas generation they were made with.
+
+    @see Graphics::drawDisplayList
+*/
+class JUCE_API DisplayList : public rive::Renderer
+{
+public:
+    //==============================================================================
+    /** Constructs an empty display list. */
+    DisplayList() = default;
+
+    /** Destructor. */
+    ~DisplayList() override = default;
+
+    //==============================================================================
+    /** Clears the recorded commands and prepares the list for a new recording.
+
+        @param transform The transform of the Graphics state the commands are recorded with.
+        @param area The drawing area of the Graphics state the commands are recorded with.
+        @param opacity The opacity of the Graphics state the commands are recorded with.
+    */
+    void startRecording (const AffineTransform& transform, const Rectangle<float>& area, float opacity);
+
+    /** Completes a recording.
+
+        @param atlasGeneration The generation of the ImageAtlas after recording the commands.
+    */
+    void finishRecording (uint32 atlasGeneration) noexcept;
+
+    /** Returns true if the list holds a recording made with the specified state.
+
+        @param transform The transform of the Graphics state to replay into.
+        @param area The drawing area of the Graphics state to replay into.
+        @param opacity The opacity of the Graphics state to replay into.
+        @param atlasGeneration The current generation of the ImageAtlas.
+    */
+    bool isRecordedWith (const AffineTransform& transform, const Rectangle<float>& area, float opacity, uint32 atlasGeneration) const noexcept;
+
+    /** Discards the recorded commands, forcing a new recording the next time the list is drawn. */
+    void invalidate();
+
+    /** Returns true if the list holds a valid recording. */
+    bool isValid() const noexcept { return valid; }
+
+    /** Returns the number of recorded commands. */
+    int getNumCommands() const noexcept { return static_cast<int> (commands.size()); }
+
+    //==============================================================================
+    /** Replays all the recorded commands into another renderer.
+
+        @param renderer The renderer that will receive the recorded commands.
+    */
+    void replay (rive::Renderer& renderer) const;
+
+    //==============================================================================
+    /** An image draw issued while recording, to be accounted for in the ImageAtlas statistics. */
+    struct ImageDrawRecord
+    {
+        const void* texture = nullptr; ///< The texture used by the draw.
+        bool isFromAtlas = false;      ///< True if the image was drawn from an atlas page.
+    };
+
+    /** Records an image draw, so it can be accounted for every time the list is replayed. */
+    void recordImageDraw (const void* texture, bool isFromAtlas);
+
+    /** Returns the image draws issued while recording, in order. */
+    const std::vector<ImageDrawRecord>& getImageDraws() const noexcept { return imageDraws; }
+
+    //==============================================================================
+    /** @internal */
+    void save() override;
+    /** @internal */
+    void restore() override;
+    /** @internal */
+    void transform (const rive::Mat2D& transform) override;
+    /** @internal */
+    void drawPath (rive::RenderPath* path, rive::RenderPaint* paint) override;
+    /** @internal */
+    void clipPath (rive::RenderPath* path) override;
+    /** @internal */
+    void drawImage (const rive::RenderImage* image, rive::BlendMode blendMode, float opacity) override;
+    /** @internal */
+    void drawImageMesh (const rive::RenderImage* image,
+                        rive::rcp<rive::RenderBuffer> vertices,
+                        rive::rcp<rive::RenderBuffer> uvCoords,
+                        rive::rcp<rive::RenderBuffer> indices,
+                        uint32_t vertexCount,
+                        uint32_t indexCount,
+                        rive::BlendMode blendMode,
+                        float opacity) override;
+
+private:
+    enum class Command : uint8
+    {
+        save,
+        restore,
+        transform,
+        drawPath,
+        clipPath,
+        drawImage,
+        drawImageMesh
+    };
+
+    struct ImageDraw
+    {
+        rive::rcp<rive::RenderImage> image;
+        rive::BlendMode blendMode;
+        float opacity;
+    };
+
+    struct ImageMeshDraw
+    {
+        rive::rcp<rive::RenderImage> image;
+        rive::rcp<rive::RenderBuffer> vertices;
+        rive::rcp<rive::RenderBuffer> uvCoords;
+        rive::rcp<rive::RenderBuffer> indices;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        rive::BlendMode blendMode;
+        float opacity;
+    };
+
+    std::vector<Command> commands;
+    std::vector<rive::Mat2D> transforms;
+    std::vector<rive::rcp<rive::RenderPath>> paths;
+    std::vector<rive::rcp<rive::RenderPaint>> paints;
+    std::vector<ImageDraw> images;
+    std::vector<ImageMeshDraw> imageMeshes;
+    std::vector<ImageDrawRecord> imageDraws;
+
+    AffineTransform recordedTransform;
+    Rectangle<float> recordedArea;
+    float recordedOpacity = 1.0f;
+    uint32 recordedAtlasGeneration = 0;
+    bool valid = false;
+
+    JUCE_DECLARE_NON_COPYABLE (DisplayList)
+};
+
+} // namespace yup
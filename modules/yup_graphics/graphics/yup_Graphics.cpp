@@ -114,160 +114,38 @@ rive::Mat2D toMat2d (const yup::AffineTransform& t) noexcept
 
 //==============================================================================
 
-rive::rcp<rive::RenderPath> toRenderPath (rive::Factory& factory, const Path& path)
+void convertRawPathToRenderPath (const rive::RawPath& input, rive::RenderPath* output, const rive::Mat2D& transform)
 {
-    auto result = factory.makeEmptyRenderPath();
-
-    float lastX = 0.0f, lastY = 0.0f;
-
-    for (const auto& segment : path)
+    for (const auto [verb, pts] : input)
     {
-        if (segment.type == Path::SegmentType::MoveTo)
-        {
-            auto x = segment.x, y = segment.y;
-            result->move (rive::Vec2D (x, y));
-
-            lastX = x;
-            lastY = y;
-        }
-
-        else if (segment.type == Path::SegmentType::LineTo)
-        {
-            auto x = segment.x, y = segment.y;
-            result->line (rive::Vec2D (x, y));
-
-            lastX = x;
-            lastY = y;
-        }
-
-        else if (segment.type == Path::SegmentType::QuadTo)
+        switch (verb)
         {
-            auto x = segment.x, y = segment.y, x1 = segment.x1, y1 = segment.y1;
-            result->cubic (rive::Vec2D::lerp (rive::Vec2D (lastX, lastY), rive::Vec2D (x1, y1), 2 / 3.f),
-                           rive::Vec2D::lerp (rive::Vec2D (x, y), rive::Vec2D (x1, y1), 2 / 3.f),
-                           rive::Vec2D (x, y));
-
-            lastX = x;
-            lastY = y;
-        }
-
-        else if (segment.type == Path::SegmentType::CubicTo)
-        {
-            auto x = segment.x, y = segment.y, x1 = segment.x1, y1 = segment.y1, x2 = segment.x2, y2 = segment.y2;
-            result->cubic (rive::Vec2D (x, y), rive::Vec2D (x1, y1), rive::Vec2D (x2, y2));
-
-            lastX = x;
-            lastY = y;
+            case rive::PathVerb::move:
+                output->move (transform * pts[0]);
+                break;
+
+            case rive::PathVerb::line:
+                output->line (transform * pts[1]);
+                break;
+
+            case rive::PathVerb::quad:
+            {
+                const auto p0 = transform * pts[0];
+                const auto p1 = transform * pts[1];
+                const auto p2 = transform * pts[2];
+                output->cubic (rive::Vec2D::lerp (p0, p1, 2 / 3.f), rive::Vec2D::lerp (p2, p1, 2 / 3.f), p2);
+                break;
+            }
+
+            case rive::PathVerb::cubic:
+                output->cubic (transform * pts[1], transform * pts[2], transform * pts[3]);
+                break;
+
+            case rive::PathVerb::close:
+                output->close();
+                break;
         }
     }
-
-    return result;
-}
-
-rive::rcp<rive::RenderPath> toRenderPath (rive::Factory& factory, const Path& path, const AffineTransform& transform)
-{
-    if (transform.isIdentity())
-        return toRenderPath (factory, path);
-
-    auto result = factory.makeEmptyRenderPath();
-
-    float lastX = 0.0f, lastY = 0.0f;
-
-    for (const auto& segment : path)
-    {
-        if (segment.type == Path::SegmentType::MoveTo)
-        {
-            auto x = segment.x, y = segment.y;
-            transform.transformPoints (x, y);
-            result->move (rive::Vec2D (x, y));
-
-            lastX = x;
-            lastY = y;
-        }
-
-        else if (segment.type == Path::SegmentType::LineTo)
-        {
-            auto x = segment.x, y = segment.y;
-            transform.transformPoints (x, y);
-            result->line (rive::Vec2D (x, y));
-
-            lastX = x;
-            lastY = y;
-        }
-
-        else if (segment.type == Path::SegmentType::QuadTo)
-        {
-            auto x = segment.x, y = segment.y, x1 = segment.x1, y1 = segment.y1;
-            transform.transformPoints (x, y, x1, y1);
-            result->cubic (rive::Vec2D::lerp (rive::Vec2D (lastX, lastY), rive::Vec2D (x1, y1), 2 / 3.f),
-                           rive::Vec2D::lerp (rive::Vec2D (x, y), rive::Vec2D (x1, y1), 2 / 3.f),
-                           rive::Vec2D (x, y));
-
-            lastX = x;
-            lastY = y;
-        }
-
-        else if (segment.type == Path::SegmentType::CubicTo)
-        {
-            auto x = segment.x, y = segment.y, x1 = segment.x1, y1 = segment.y1, x2 = segment.x2, y2 = segment.y2;
-            transform.transformPoints (x, y, x1, y1, x2, y2);
-            result->cubic (rive::Vec2D (x, y), rive::Vec2D (x1, y1), rive::Vec2D (x2, y2));
-
-            lastX = x;
-            lastY = y;
-        }
-    }
-
-    return result;
-}
-
-//==============================================================================
-
-void convertRawPathToRenderPath (const rive::RawPath& input, rive::RenderPath* output)
-{
-    input.addTo (output);
-}
-
-void convertRawPathToRenderPath (const rive::RawPath& input, rive::RenderPath* output, const AffineTransform& transform)
-{
-    auto newInput = input.morph ([&transform] (auto point)
-                                 {
-                                     transform.transformPoints (point.x, point.y);
-                                     return point;
-                                 });
-
-    newInput.addTo (output);
-}
-
-//==============================================================================
-
-rive::rcp<rive::RenderShader> toColorGradient (rive::Factory& factory, const ColorGradient& gradient, const AffineTransform& transform)
-{
-    const uint32 colors[] = { gradient.getStartColor(), gradient.getFinishColor() };
-
-    float stops[] = { gradient.getStartDelta(), gradient.getFinishDelta() };
-    transform.transformPoints (stops[0], stops[1]);
-
-    if (gradient.getType() == ColorGradient::Linear)
-    {
-        float x1 = gradient.getStartX();
-        float y1 = gradient.getStartY();
-        float x2 = gradient.getFinishX();
-        float y2 = gradient.getFinishY();
-        transform.transformPoints (x1, y1, x2, y2);
-
-        return factory.makeLinearGradient (x1, y1, x2, y2, colors, stops, sizeof (colors));
-    }
-    else
-    {
-        float x1 = gradient.getStartX();
-        float y1 = gradient.getStartY();
-        float radiusX = gradient.getRadius();
-        [[maybe_unused]] float radiusY = gradient.getRadius();
-        transform.transformPoints (x1, y1, radiusX, radiusY);
-
-        return factory.makeRadialGradient (x1, y1, radiusX, colors, stops, sizeof (colors));
-    }
 }
 
 } // namespace
@@ -300,12 +178,22 @@ Graphics::Graphics (GraphicsContext& context, rive::Renderer& renderer, float sc
     : context (context)
     , factory (*context.factory())
     , renderer (renderer)
+    , renderCache (context.getRenderCache())
 {
     renderOptions.emplace_back();
 
     currentRenderOptions().scale = scale;
 }
 
+Graphics::Graphics (const Graphics& other, rive::Renderer& renderer) noexcept
+    : context (other.context)
+    , factory (other.factory)
+    , renderer (renderer)
+    , renderCache (other.renderCache)
+{
+    renderOptions.emplace_back (other.currentRenderOptions());
+}
+
 //==============================================================================
 rive::Factory* Graphics::getFactory()
 {
@@ -317,6 +205,11 @@ rive::Renderer* Graphics::getRenderer()
     return std::addressof (renderer);
 }
 
+const RenderCache& Graphics::getRenderCache() const
+{
+    return renderCache;
+}
+
 //==============================================================================
 Graphics::RenderOptions& Graphics::currentRenderOptions()
 {
@@ -468,10 +361,14 @@ AffineTransform Graphics::getTransform() const
 
 void Graphics::setClipPath (const Rectangle<float>& clipRect)
 {
-    Path path;
-    path.addRectangle (clipRect);
+    auto& options = currentRenderOptions();
+
+    scratchPath.clear();
+    scratchPath.addRectangle (clipRect);
+
+    options.clipPath = scratchPath;
 
-    setClipPath (path);
+    renderClipPath (scratchPath, options.getUntranslatedTransform(), true);
 }
 
 void Graphics::setClipPath (const Path& clipPath)
@@ -480,9 +377,7 @@ void Graphics::setClipPath (const Path& clipPath)
 
     options.clipPath = clipPath;
 
-    auto renderPath = toRenderPath (factory, clipPath, options.getUntranslatedTransform());
-    renderPath->fillRule (rive::FillRule::nonZero);
-    renderer.clipPath (renderPath.get());
+    renderClipPath (clipPath, options.getUntranslatedTransform(), false);
 }
 
 Path Graphics::getClipPath() const
@@ -495,11 +390,12 @@ void Graphics::strokeLine (float x1, float y1, float x2, float y2)
 {
     const auto& options = currentRenderOptions();
 
-    Path path;
+    auto& path = scratchPath;
+    path.clear();
     path.moveTo (x1, y1);
     path.lineTo (x2, y2);
 
-    renderStrokePath (path, options, options.getTransform());
+    renderStrokePath (path, options, options.getTransform(), true);
 }
 
 void Graphics::strokeLine (const Point<float>& p1, const Point<float>& p2)
@@ -513,14 +409,15 @@ void Graphics::fillAll()
     const auto& options = currentRenderOptions();
     const auto& area = options.getDrawingArea();
 
-    Path path;
+    auto& path = scratchPath;
+    path.clear();
     path.moveTo (area.getX(), area.getY());
     path.lineTo (area.getX() + area.getWidth(), area.getY());
     path.lineTo (area.getX() + area.getWidth(), area.getY() + area.getHeight());
     path.lineTo (area.getX(), area.getY() + area.getHeight());
     path.lineTo (area.getX(), area.getY());
 
-    renderFillPath (path, options, options.getUntranslatedTransform());
+    renderFillPath (path, options, options.getUntranslatedTransform(), true);
 }
 
 //==============================================================================
@@ -528,14 +425,15 @@ void Graphics::fillRect (float x, float y, float width, float height)
 {
     const auto& options = currentRenderOptions();
 
-    Path path;
+    auto& path = scratchPath;
+    path.clear();
     path.moveTo (x, y);
     path.lineTo (x + width, y);
     path.lineTo (x + width, y + height);
     path.lineTo (x, y + height);
     path.lineTo (x, y);
 
-    renderFillPath (path, options, options.getTransform());
+    renderFillPath (path, options, options.getTransform(), true);
 }
 
 void Graphics::fillRect (const Rectangle<float>& r)
@@ -548,14 +446,15 @@ void Graphics::strokeRect (float x, float y, float width, float height)
 {
     const auto& options = currentRenderOptions();
 
-    Path path;
+    auto& path = scratchPath;
+    path.clear();
     path.moveTo (x, y);
     path.lineTo (x + width, y);
     path.lineTo (x + width, y + height);
     path.lineTo (x, y + height);
     path.lineTo (x, y);
 
-    renderStrokePath (path, options, options.getTransform());
+    renderStrokePath (path, options, options.getTransform(), true);
 }
 
 void Graphics::strokeRect (const Rectangle<float>& r)
@@ -568,11 +467,12 @@ void Graphics::fillRoundedRect (float x, float y, float width, float height, flo
 {
     const auto& options = currentRenderOptions();
 
-    Path path;
+    auto& path = scratchPath;
+    path.clear();
     path.addRoundedRectangle (
         x, y, width, height, radiusTopLeft, radiusTopRight, radiusBottomLeft, radiusBottomRight);
 
-    renderFillPath (path, options, options.getTransform());
+    renderFillPath (path, options, options.getTransform(), true);
 }
 
 void Graphics::fillRoundedRect (float x, float y, float width, float height, float radius)
@@ -595,11 +495,12 @@ void Graphics::strokeRoundedRect (float x, float y, float width, float height, f
 {
     const auto& options = currentRenderOptions();
 
-    Path path;
+    auto& path = scratchPath;
+    path.clear();
     path.addRoundedRectangle (
         x, y, width, height, radiusTopLeft, radiusTopRight, radiusBottomLeft, radiusBottomRight);
 
-    renderStrokePath (path, options, options.getTransform());
+    renderStrokePath (path, options, options.getTransform(), true);
 }
 
 void Graphics::strokeRoundedRect (float x, float y, float width, float height, float radius)
@@ -622,7 +523,7 @@ void Graphics::strokePath (const Path& path)
 {
     const auto& options = currentRenderOptions();
 
-    renderStrokePath (path, options, options.getTransform());
+    renderStrokePath (path, options, options.getTransform(), false);
 }
 
 //==============================================================================
@@ -630,7 +531,7 @@ void Graphics::fillPath (const Path& path)
 {
     const auto& options = currentRenderOptions();
 
-    renderFillPath (path, options, options.getTransform());
+    renderFillPath (path, options, options.getTransform(), false);
 }
 
 //==============================================================================
@@ -638,73 +539,152 @@ void Graphics::clipPath (const Rectangle<float>& area)
 {
     const auto& options = currentRenderOptions();
 
-    Path path;
+    auto& path = scratchPath;
+    path.clear();
     path.moveTo (area.getX(), area.getY());
     path.lineTo (area.getX() + area.getWidth(), area.getY());
     path.lineTo (area.getX() + area.getWidth(), area.getY() + area.getHeight());
     path.lineTo (area.getX(), area.getY() + area.getHeight());
     path.lineTo (area.getX(), area.getY());
 
-    clipPath (path);
+    renderClipPath (path, options.getTransform(), true);
 }
 
 void Graphics::clipPath (const Path& path)
 {
     const auto& options = currentRenderOptions();
 
-    auto renderPath = toRenderPath (factory, path, options.getTransform());
-    renderer.clipPath (renderPath.get());
+    renderClipPath (path, options.getTransform(), false);
 }
 
 //==============================================================================
-void Graphics::renderStrokePath (const Path& path, const RenderOptions& options, const AffineTransform& transform)
+void Graphics::renderStrokePath (const Path& path, const RenderOptions& options, const AffineTransform& transform, bool isPrimitive)
 {
-    auto paint = factory.makeRenderPaint();
-    paint->style (rive::RenderPaintStyle::stroke);
-    paint->thickness (options.getStrokeWidth());
-    paint->join (toStrokeJoin (options.join));
-    paint->cap (toStrokeCap (options.cap));
+    rive::rcp<rive::RenderPaint> paint;
 
     if (options.isStrokeColor())
-        paint->color (options.getStrokeColor());
+    {
+        paint = renderCache.getStrokePaint (factory, options.getStrokeColor(), options.getStrokeWidth(), options.join, options.cap, toBlendMode (options.blendMode));
+    }
     else
-        paint->shader (toColorGradient (factory, options.getStrokeColorGradient(), transform));
+    {
+        paint = factory.makeRenderPaint();
+        paint->style (rive::RenderPaintStyle::stroke);
+        paint->thickness (options.getStrokeWidth());
+        paint->join (toStrokeJoin (options.join));
+        paint->cap (toStrokeCap (options.cap));
+        paint->blendMode (toBlendMode (options.blendMode));
+        paint->shader (renderCache.getGradientShader (factory, options.getStrokeColorGradient(), transform));
+    }
 
-    auto renderPath = toRenderPath (factory, path, transform);
-    renderer.drawPath (renderPath.get(), paint.get());
+    renderPathWithPaint (path, transform, isPrimitive, paint.get());
 }
 
-void Graphics::renderFillPath (const Path& path, const RenderOptions& options, const AffineTransform& transform)
+void Graphics::renderFillPath (const Path& path, const RenderOptions& options, const AffineTransform& transform, bool isPrimitive)
 {
-    auto paint = factory.makeRenderPaint();
-    paint->style (rive::RenderPaintStyle::fill);
+    rive::rcp<rive::RenderPaint> paint;
 
     if (options.isFillColor())
-        paint->color (options.getFillColor());
+    {
+        paint = renderCache.getFillPaint (factory, options.getFillColor(), toBlendMode (options.blendMode));
+    }
     else
-        paint->shader (toColorGradient (factory, options.getFillColorGradient(), transform));
+    {
+        paint = factory.makeRenderPaint();
+        paint->style (rive::RenderPaintStyle::fill);
+        paint->blendMode (toBlendMode (options.blendMode));
+        paint->shader (renderCache.getGradientShader (factory, options.getFillColorGradient(), transform));
+    }
+
+    renderPathWithPaint (path, transform, isPrimitive, paint.get());
+}
 
-    auto renderPath = toRenderPath (factory, path, transform);
-    renderer.drawPath (renderPath.get(), paint.get());
+void Graphics::renderPathWithPaint (const Path& path, const AffineTransform& transform, bool isPrimitive, rive::RenderPaint* paint)
+{
+    if (! isPrimitive)
+    {
+        auto rawPath = path.toRawPath (transform);
+        auto renderPath = factory.makeRenderPath (rawPath, rive::FillRule::nonZero);
+        renderer.drawPath (renderPath.get(), paint);
+        return;
+    }
+
+    // Cached primitives only have the linear part of the transform applied, so they are shared when moving
+    auto renderPath = renderCache.getPrimitivePath (factory, path, transform);
+
+    renderer.save();
+    renderer.translate (transform.getTranslateX(), transform.getTranslateY());
+    renderer.drawPath (renderPath.get(), paint);
+    renderer.restore();
+}
+
+void Graphics::renderClipPath (const Path& path, const AffineTransform& transform, bool isPrimitive)
+{
+    if (! isPrimitive)
+    {
+        auto rawPath = path.toRawPath (transform);
+        auto renderPath = factory.makeRenderPath (rawPath, rive::FillRule::nonZero);
+        renderer.clipPath (renderPath.get());
+        return;
+    }
+
+    // The clip is part of the renderer state, so undo the translation instead of restoring the state
+    auto renderPath = renderCache.getPrimitivePath (factory, path, transform);
+
+    renderer.translate (transform.getTranslateX(), transform.getTranslateY());
+    renderer.clipPath (renderPath.get());
+    renderer.translate (-transform.getTranslateX(), -transform.getTranslateY());
 }
 
 //==============================================================================
 void Graphics::drawImageAt (const Image& image, const Point<float>& pos)
 {
+    const auto& options = currentRenderOptions();
+    const auto opacity = jlimit (0.0f, 1.0f, options.opacity);
+
+    auto& imageAtlas = context.getImageAtlas();
+
+    // Small images are drawn as quads sampling their area of a shared atlas page
+    if (auto entry = imageAtlas.getEntry (context, image))
+    {
+        recordImageDraw (entry->pageImage.get(), true);
+
+        renderer.save();
+        renderer.transform (toMat2d (options.getTransform()));
+        renderer.translate (pos.getX(), pos.getY());
+        renderer.drawImageMesh (entry->pageImage.get(), entry->vertices, entry->uvCoords, entry->indices, 4, 6, toBlendMode (options.blendMode), opacity);
+        renderer.restore();
+        return;
+    }
+
     auto renderContext = context.renderContextOrNull();
     if (renderContext == nullptr)
+    {
+        // Contexts without a GPU render context (like the software one) draw images natively
+        auto renderImage = context.makeRenderImage (image);
+        if (renderImage == nullptr)
+            return;
+
+        recordImageDraw (renderImage.get(), false);
+
+        renderer.save();
+        renderer.transform (toMat2d (options.getTransform()));
+        renderer.translate (pos.getX(), pos.getY());
+        renderer.drawImage (renderImage.get(), toBlendMode (options.blendMode), opacity);
+        renderer.restore();
         return;
+    }
 
-    const auto& options = currentRenderOptions();
+    if (! image.createTextureIfNotPresent (context))
+        return;
+
+    recordImageDraw (image.getTexture().get(), false);
 
+    // Like the other paths, the image is drawn at its native size with its top left corner at the position
     renderer.save();
-    renderer.scale (image.getWidth(), image.getHeight());
     renderer.transform (toMat2d (options.getTransform()));
-
-    // renderer.translate (pos.getX(), pos.getY());
-
-    if (! image.createTextureIfNotPresent (context))
-        return;
+    renderer.translate (pos.getX(), pos.getY());
+    renderer.scale (static_cast<float> (image.getWidth()), static_cast<float> (image.getHeight()));
 
     static const auto unitRectPath = []
     {
@@ -715,14 +695,78 @@ void Graphics::drawImageAt (const Image& image, const Point<float>& pos)
         return unitRectPath;
     }();
 
-    rive::RiveRenderPaint paint;
-    paint.image (image.getTexture(), jlimit (0.0f, 1.0f, options.opacity));
-    paint.blendMode (toBlendMode (options.blendMode));
-    renderer.drawPath (unitRectPath.get(), &paint);
+    auto paint = rive::make_rcp<rive::RiveRenderPaint>();
+    paint->image (image.getTexture(), opacity);
+    paint->blendMode (toBlendMode (options.blendMode));
+    renderer.drawPath (unitRectPath.get(), paint.get());
 
     renderer.restore();
 }
 
+//==============================================================================
+void Graphics::drawScrollingImage (ScrollingImage& image, const Rectangle<float>& area)
+{
+    if (area.isEmpty())
+        return;
+
+    const auto drawData = image.prepareForDrawing (context);
+    if (drawData.image == nullptr || drawData.vertices == nullptr)
+        return;
+
+    const auto& options = currentRenderOptions();
+
+    renderer.save();
+    renderer.transform (toMat2d (options.getTransform()));
+    renderer.translate (area.getX(), area.getY());
+    renderer.scale (area.getWidth() / static_cast<float> (image.getWidth()), area.getHeight() / static_cast<float> (image.getHeight()));
+    renderer.drawImageMesh (drawData.image,
+                            drawData.vertices,
+                            drawData.uvCoords,
+                            drawData.indices,
+                            drawData.vertexCount,
+                            drawData.indexCount,
+                            toBlendMode (options.blendMode),
+                            jlimit (0.0f, 1.0f, options.opacity));
+    renderer.restore();
+}
+
+//==============================================================================
+void Graphics::drawDisplayList (DisplayList& displayList, const std::function<void (Graphics&)>& paintFunction)
+{
+    const auto& options = currentRenderOptions();
+    const auto transform = options.getTransform();
+
+    auto& imageAtlas = context.getImageAtlas();
+
+    if (! displayList.isRecordedWith (transform, options.getDrawingArea(), options.opacity, imageAtlas.getGeneration()))
+    {
+        YUP_PROFILE_NAMED_INTERNAL_TRACE (RecordDisplayList);
+
+        displayList.startRecording (transform, options.getDrawingArea(), options.opacity);
+
+        Graphics recordingGraphics (*this, displayList);
+        recordingGraphics.recordingDisplayList = std::addressof (displayList);
+        paintFunction (recordingGraphics);
+
+        // Recording can upload atlas pages, so take the generation the recorded entries belong to
+        displayList.finishRecording (imageAtlas.getGeneration());
+    }
+
+    displayList.replay (renderer);
+
+    for (const auto& imageDraw : displayList.getImageDraws())
+        recordImageDraw (imageDraw.texture, imageDraw.isFromAtlas);
+}
+
+void Graphics::recordImageDraw (const void* texture, bool isFromAtlas)
+{
+    // Draws issued while recording are accounted for when the list is replayed
+    if (recordingDisplayList != nullptr)
+        recordingDisplayList->recordImageDraw (texture, isFromAtlas);
+    else
+        context.getImageAtlas().recordImageDraw (texture, isFromAtlas);
+}
+
 //==============================================================================
 void Graphics::strokeFittedText (const StyledText& text, const Rectangle<float>& rect, rive::TextAlign align)
 {
@@ -730,20 +774,18 @@ void Graphics::strokeFittedText (const StyledText& text, const Rectangle<float>&
 
     auto paint = factory.makeRenderPaint();
     paint->style (rive::RenderPaintStyle::fill);
+    paint->blendMode (toBlendMode (options.blendMode));
 
     if (options.isStrokeColor())
         paint->color (options.getStrokeColor());
     else
-        paint->shader (toColorGradient (factory, options.getStrokeColorGradient(), options.getTransform()));
+        paint->shader (renderCache.getGradientShader (factory, options.getStrokeColorGradient(), options.getTransform()));
 
     auto path = factory.makeEmptyRenderPath();
 
-    std::size_t totalPathSize = 0;
-    for (const auto& rawPath : text.getGlyphs())
-        totalPathSize += rawPath.verbs().size();
-
-    for (const auto& rawPath : text.getGlyphs())
-        convertRawPathToRenderPath (rawPath, path.get(), options.getTransform());
+    const auto transform = toMat2d (options.getTransform());
+    for (const auto& glyph : text.getGlyphs())
+        convertRawPathToRenderPath (*glyph.path, path.get(), transform * glyph.transform);
 
     renderer.drawPath (path.get(), paint.get());
 }
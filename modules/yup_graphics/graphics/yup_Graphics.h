@@ -95,6 +95,13 @@ public:
     */
     Graphics (GraphicsContext& context, rive::Renderer& renderer, float scale = 1.0f) noexcept;
 
+    /** Constructs a Graphics object that starts with the current state of another one, but sends its drawing operations to a different renderer.
+
+        @param other The Graphics object whose current state, context and factory are inherited.
+        @param renderer Reference to the Renderer that executes the drawing commands.
+    */
+    Graphics (const Graphics& other, rive::Renderer& renderer) noexcept;
+
     //==============================================================================
     /** Saves the current state of the Graphics object.
 
@@ -400,11 +407,32 @@ public:
 
     void drawImageAt (const Image& image, const Point<float>& pos);
 
+    /** Draws a scrolling image stretched to fill an area, with its oldest column on the left.
+
+        Only the columns appended since the image was last drawn are uploaded.
+
+        @param image The scrolling image to draw.
+        @param area The area to fill with the image.
+    */
+    void drawScrollingImage (ScrollingImage& image, const Rectangle<float>& area);
+
     //==============================================================================
     /** Draws an attributed text.
     */
     void strokeFittedText (const StyledText& text, const Rectangle<float>& rect, rive::TextAlign align = rive::TextAlign::center);
 
+    //==============================================================================
+    /** Draws the content of a display list, recording it first if needed.
+
+        If the display list doesn't hold a recording made with the current transform, drawing area and opacity,
+        the paint function is called with a Graphics object that records its drawing operations into the list.
+        The recorded commands are then replayed into the current renderer.
+
+        @param displayList The display list to replay, and to record into if needed.
+        @param paintFunction The function that issues the drawing operations to record.
+    */
+    void drawDisplayList (DisplayList& displayList, const std::function<void (Graphics&)>& paintFunction);
+
     //==============================================================================
     /** Clips the drawing area to the specified rectangle.
 
@@ -431,6 +459,14 @@ public:
     */
     rive::Renderer* getRenderer();
 
+    /** Retrieves the cache of render paths and paints used by this object.
+
+        This can be used to inspect the cache hit rate and the number of allocations saved per frame.
+
+        @return Reference to the RenderCache of the underlying GraphicsContext.
+    */
+    const RenderCache& getRenderCache() const;
+
 private:
     struct RenderOptions
     {
@@ -520,15 +556,21 @@ private:
     const RenderOptions& currentRenderOptions() const;
     void restoreState();
 
-    void renderStrokePath (const Path& path, const RenderOptions& options, const AffineTransform& transform);
-    void renderFillPath (const Path& path, const RenderOptions& options, const AffineTransform& transform);
+    void renderStrokePath (const Path& path, const RenderOptions& options, const AffineTransform& transform, bool isPrimitive);
+    void renderFillPath (const Path& path, const RenderOptions& options, const AffineTransform& transform, bool isPrimitive);
+    void renderPathWithPaint (const Path& path, const AffineTransform& transform, bool isPrimitive, rive::RenderPaint* paint);
+    void renderClipPath (const Path& path, const AffineTransform& transform, bool isPrimitive);
+    void recordImageDraw (const void* texture, bool isFromAtlas);
 
     GraphicsContext& context;
 
     rive::Factory& factory;
     rive::Renderer& renderer;
+    RenderCache& renderCache;
+    DisplayList* recordingDisplayList = nullptr;
 
     std::vector<RenderOptions> renderOptions;
+    Path scratchPath;
 };
 
 } // namespace yup
@@ -0,0 +1,319 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace yup
+{
+
+namespace
+{
+
+//==============================================================================
+
+uint64 hashPrimitive (const Path& path, const AffineTransform& linearTransform) noexcept
+{
+    Hasher hasher;
+
+    for (const auto verb : path.getVerbs())
+        hasher.add (static_cast<uint32> (verb));
+
+    for (const auto& point : path.getPoints())
+    {
+        hasher.add (point.getX());
+        hasher.add (point.getY());
+    }
+
+    hasher.add (linearTransform.getScaleX());
+    hasher.add (linearTransform.getShearX());
+    hasher.add (linearTransform.getShearY());
+    hasher.add (linearTransform.getScaleY());
+
+    return hasher.getHash();
+}
+
+AffineTransform withoutTranslation (const AffineTransform& transform) noexcept
+{
+    return { transform.getScaleX(), transform.getShearX(), 0.0f, transform.getShearY(), transform.getScaleY(), 0.0f };
+}
+
+//==============================================================================
+
+rive::rcp<rive::RenderPath> createRenderPath (rive::Factory& factory, const Path& path, const AffineTransform& transform)
+{
+    auto rawPath = path.toRawPath (transform);
+    return factory.makeRenderPath (rawPath, rive::FillRule::nonZero);
+}
+
+//==============================================================================
+
+uint64 hashGradient (const ColorGradient& gradient, const AffineTransform& transform) noexcept
+{
+    Hasher hasher;
+    hasher.add (static_cast<uint32> (gradient.getType()));
+    hasher.add (gradient.getStartX());
+    hasher.add (gradient.getStartY());
+    hasher.add (gradient.getFinishX());
+    hasher.add (gradient.getFinishY());
+    hasher.add (gradient.getRadius());
+
+    for (int i = 0; i < gradient.getNumStops(); ++i)
+    {
+        hasher.add (gradient.getStopColor (i).getARGB());
+        hasher.add (gradient.getStopDelta (i));
+    }
+
+    for (auto value : transform.getMatrixPoints())
+        hasher.add (value);
+
+    return hasher.getHash();
+}
+
+rive::rcp<rive::RenderShader> createGradientShader (rive::Factory& factory, const ColorGradient& gradient, const AffineTransform& transform)
+{
+    constexpr int maxStopsOnStack = 8;
+
+    const auto numStops = gradient.getNumStops();
+
+    // Most gradients have a handful of stops, so avoid allocating for them
+    HeapBlock<rive::ColorInt> heapColors;
+    HeapBlock<float> heapStops;
+    rive::ColorInt stackColors[maxStopsOnStack];
+    float stackStops[maxStopsOnStack];
+
+    auto colors = stackColors;
+    auto stops = stackStops;
+
+    if (numStops > maxStopsOnStack)
+    {
+        heapColors.malloc (numStops);
+        heapStops.malloc (numStops);
+        colors = heapColors.get();
+        stops = heapStops.get();
+    }
+
+    for (int i = 0; i < numStops; ++i)
+    {
+        colors[i] = gradient.getStopColor (i);
+        stops[i] = gradient.getStopDelta (i);
+    }
+
+    float x1 = gradient.getStartX();
+    float y1 = gradient.getStartY();
+
+    if (gradient.getType() == ColorGradient::Linear)
+    {
+        float x2 = gradient.getFinishX();
+        float y2 = gradient.getFinishY();
+        transform.transformPoints (x1, y1, x2, y2);
+
+        return factory.makeLinearGradient (x1, y1, x2, y2, colors, stops, static_cast<size_t> (numStops));
+    }
+
+    transform.transformPoint (x1, y1);
+
+    // Radial gradients stay circular, so scale the radius by the average scaling of the transform
+    const auto radius = gradient.getRadius() * std::sqrt (std::abs (transform.getDeterminant()));
+
+    return factory.makeRadialGradient (x1, y1, radius, colors, stops, static_cast<size_t> (numStops));
+}
+
+} // namespace
+
+//==============================================================================
+void RenderCache::beginFrame()
+{
+    lastFrameStatistics = std::exchange (currentStatistics, {});
+
+    ++currentFrame;
+
+    const auto isStale = [this] (uint64 lastUsedFrame)
+    {
+        return currentFrame - lastUsedFrame > static_cast<uint64> (maxUnusedFrames);
+    };
+
+    for (auto it = paths.begin(); it != paths.end();)
+    {
+        if (isStale (it->second.lastUsedFrame))
+            it = paths.erase (it);
+        else
+            ++it;
+    }
+
+    for (auto it = paints.begin(); it != paints.end();)
+    {
+        if (isStale (it->second.lastUsedFrame))
+            it = paints.erase (it);
+        else
+            ++it;
+    }
+
+    for (auto it = shaders.begin(); it != shaders.end();)
+    {
+        if (isStale (it->second.lastUsedFrame))
+            it = shaders.erase (it);
+        else
+            ++it;
+    }
+}
+
+void RenderCache::clear()
+{
+    paths.clear();
+    paints.clear();
+    shaders.clear();
+}
+
+//==============================================================================
+rive::rcp<rive::RenderPath> RenderCache::getPrimitivePath (rive::Factory& factory, const Path& primitive, const AffineTransform& transform)
+{
+    const auto linearTransform = withoutTranslation (transform);
+
+    if (static_cast<int> (primitive.getPoints().size()) > maxPrimitivePoints)
+        return createRenderPath (factory, primitive, linearTransform);
+
+    const auto hash = hashPrimitive (primitive, linearTransform);
+
+    auto it = paths.find (hash);
+    if (it != paths.end())
+    {
+        auto& entry = it->second;
+
+        if (entry.linearTransform == linearTransform && entry.path == primitive)
+        {
+            entry.lastUsedFrame = currentFrame;
+
+            ++currentStatistics.pathHits;
+            return entry.renderPath;
+        }
+    }
+
+    ++currentStatistics.pathMisses;
+
+    auto renderPath = createRenderPath (factory, primitive, linearTransform);
+
+    if (it != paths.end())
+    {
+        // Hash collision, replace the existing entry as it's less likely to be used again
+        it->second = { primitive, linearTransform, renderPath, currentFrame };
+    }
+    else if (static_cast<int> (paths.size()) < maxCachedPaths)
+    {
+        paths.emplace (hash, PathEntry { primitive, linearTransform, renderPath, currentFrame });
+    }
+
+    return renderPath;
+}
+
+//==============================================================================
+rive::rcp<rive::RenderPaint> RenderCache::getFillPaint (rive::Factory& factory, Color color, rive::BlendMode blendMode)
+{
+    return getPaint (factory, rive::RenderPaintStyle::fill, color, 0.0f, StrokeJoin::Miter, StrokeCap::Butt, blendMode);
+}
+
+rive::rcp<rive::RenderPaint> RenderCache::getStrokePaint (rive::Factory& factory, Color color, float thickness, StrokeJoin join, StrokeCap cap, rive::BlendMode blendMode)
+{
+    return getPaint (factory, rive::RenderPaintStyle::stroke, color, thickness, join, cap, blendMode);
+}
+
+rive::rcp<rive::RenderPaint> RenderCache::getPaint (rive::Factory& factory, rive::RenderPaintStyle style, Color color, float thickness, StrokeJoin join, StrokeCap cap, rive::BlendMode blendMode)
+{
+    Hasher hasher;
+    hasher.add (static_cast<uint32> (style));
+    hasher.add (color.getARGB());
+    hasher.add (thickness);
+    hasher.add (static_cast<uint32> (join));
+    hasher.add (static_cast<uint32> (cap));
+    hasher.add (static_cast<uint32> (blendMode));
+
+    const auto hash = hasher.getHash();
+
+    auto it = paints.find (hash);
+    if (it != paints.end())
+    {
+        auto& entry = it->second;
+
+        if (entry.style == style
+            && entry.color.getARGB() == color.getARGB()
+            && entry.thickness == thickness
+            && entry.join == join
+            && entry.cap == cap
+            && entry.blendMode == blendMode)
+        {
+            entry.lastUsedFrame = currentFrame;
+
+            ++currentStatistics.paintHits;
+            return entry.renderPaint;
+        }
+    }
+
+    ++currentStatistics.paintMisses;
+
+    auto paint = factory.makeRenderPaint();
+    paint->style (style);
+    paint->color (color);
+    paint->blendMode (blendMode);
+
+    if (style == rive::RenderPaintStyle::stroke)
+    {
+        paint->thickness (thickness);
+        paint->join (static_cast<rive::StrokeJoin> (join));
+        paint->cap (static_cast<rive::StrokeCap> (cap));
+    }
+
+    if (it != paints.end())
+        it->second = { style, color, thickness, join, cap, blendMode, paint, currentFrame };
+    else if (static_cast<int> (paints.size()) < maxCachedPaints)
+        paints.emplace (hash, PaintEntry { style, color, thickness, join, cap, blendMode, paint, currentFrame });
+
+    return paint;
+}
+
+//==============================================================================
+rive::rcp<rive::RenderShader> RenderCache::getGradientShader (rive::Factory& factory, const ColorGradient& gradient, const AffineTransform& transform)
+{
+    const auto hash = hashGradient (gradient, transform);
+
+    auto it = shaders.find (hash);
+    if (it != shaders.end())
+    {
+        auto& entry = it->second;
+
+        if (entry.transform == transform && entry.gradient == gradient)
+        {
+            entry.lastUsedFrame = currentFrame;
+
+            ++currentStatistics.shaderHits;
+            return entry.shader;
+        }
+    }
+
+    ++currentStatistics.shaderMisses;
+
+    auto shader = createGradientShader (factory, gradient, transform);
+
+    if (it != shaders.end())
+        it->second = { gradient, transform, shader, currentFrame };
+    else
+        shaders.emplace (hash, ShaderEntry { gradient, transform, shader, currentFrame });
+
+    return shader;
+}
+
+} // namespace yup
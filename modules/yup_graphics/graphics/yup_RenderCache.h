@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace yup
+{
+
+//==============================================================================
+/** A cache of renderer objects shared by all the Graphics instances drawing into the same GraphicsContext.
+
+    Converting a Path into a rive::RenderPath and creating a rive::RenderPaint for every draw call is
+    expensive, as each of them results in one or more heap allocations. This cache keeps the render
+    paths of the primitives generated by Graphics (keyed by their geometry and the linear part of the
+    transform), the solid color paints (keyed by their style) and the gradient shaders (keyed by their
+    stops, geometry and transform) alive across frames, so that repeated draws of the same primitives
+    can skip the conversion and the allocation entirely.
+
+    User paths are not cached: they are often rebuilt every frame, and hashing and retaining them would
+    cost more than converting them.
+
+    Cached objects are never modified after creation, so they can safely be referenced by multiple
+    pending draws within a frame. Entries that haven't been used for a number of frames are evicted
+    when a new frame begins.
+
+    @see GraphicsContext::getRenderCache
+*/
+class JUCE_API RenderCache
+{
+public:
+    //==============================================================================
+    /** Counters collected while rendering a frame. */
+    struct Statistics
+    {
+        int pathHits = 0;    ///< Number of render paths served from the cache.
+        int pathMisses = 0;  ///< Number of render paths that had to be created.
+        int paintHits = 0;   ///< Number of render paints served from the cache.
+        int paintMisses = 0; ///< Number of render paints that had to be created.
+        int shaderHits = 0;   ///< Number of gradient shaders served from the cache.
+        int shaderMisses = 0; ///< Number of gradient shaders that had to be created.
+
+        /** Returns the number of renderer object allocations avoided thanks to the cache. */
+        int getAllocationsSaved() const noexcept { return pathHits + paintHits + shaderHits; }
+
+        /** Returns the ratio between hits and total lookups, in the range 0 to 1. */
+        float getHitRate() const noexcept
+        {
+            const auto total = pathHits + pathMisses + paintHits + paintMisses + shaderHits + shaderMisses;
+            return total > 0 ? static_cast<float> (getAllocationsSaved()) / static_cast<float> (total) : 0.0f;
+        }
+    };
+
+    //==============================================================================
+    /** Constructs an empty cache. */
+    RenderCache() = default;
+
+    /** Move constructor and assignment operator. */
+    RenderCache (RenderCache&& other) = default;
+    RenderCache& operator= (RenderCache&& other) = default;
+
+    //==============================================================================
+    /** Marks the beginning of a new frame.
+
+        This rolls the per-frame statistics over and evicts the entries that haven't been used for
+        more than the allowed number of frames.
+    */
+    void beginFrame();
+
+    /** Removes all the cached entries. */
+    void clear();
+
+    //==============================================================================
+    /** Returns a render path for a primitive, with the linear part of the transform applied to its points.
+
+        The translation of the transform is not applied, so a primitive drawn at different positions
+        through the transform shares a single entry, and the caller is responsible for translating the
+        renderer. Positions baked into the primitive points, like the coordinates of a rectangle, still
+        produce one entry per position. Primitives with more than maxPrimitivePoints points are
+        converted without being cached.
+
+        @param factory The factory used to create a new render path if it's not already cached.
+        @param primitive The primitive geometry, like a rectangle or an ellipse.
+        @param transform The transform whose linear part is applied to the primitive points.
+
+        @return The cached or newly created render path.
+    */
+    rive::rcp<rive::RenderPath> getPrimitivePath (rive::Factory& factory, const Path& primitive, const AffineTransform& transform);
+
+    /** The maximum number of points of a primitive held by the cache. */
+    static constexpr int maxPrimitivePoints = 64;
+
+    //==============================================================================
+    /** Returns a solid color fill paint.
+
+        Once the cache holds the maximum number of paints, new styles get a paint that isn't cached.
+
+        @param factory The factory used to create a new render paint if it's not already cached.
+        @param color The fill color.
+        @param blendMode The blend mode used to composite the fill.
+
+        @return The cached or newly created render paint.
+    */
+    rive::rcp<rive::RenderPaint> getFillPaint (rive::Factory& factory, Color color, rive::BlendMode blendMode = rive::BlendMode::srcOver);
+
+    /** Returns a solid color stroke paint.
+
+        @param factory The factory used to create a new render paint if it's not already cached.
+        @param color The stroke color.
+        @param thickness The stroke thickness.
+        @param join The stroke join style.
+        @param cap The stroke cap style.
+        @param blendMode The blend mode used to composite the stroke.
+
+        @return The cached or newly created render paint.
+    */
+    rive::rcp<rive::RenderPaint> getStrokePaint (rive::Factory& factory, Color color, float thickness, StrokeJoin join, StrokeCap cap, rive::BlendMode blendMode = rive::BlendMode::srcOver);
+
+    //==============================================================================
+    /** Returns a shader for a gradient, with the transform already applied to its geometry.
+
+        @param factory The factory used to create a new shader if it's not already cached.
+        @param gradient The gradient.
+        @param transform The transform to apply to the gradient geometry.
+
+        @return The cached or newly created shader.
+    */
+    rive::rcp<rive::RenderShader> getGradientShader (rive::Factory& factory, const ColorGradient& gradient, const AffineTransform& transform);
+
+    //==============================================================================
+    /** Returns the statistics collected during the last completed frame. */
+    Statistics getLastFrameStatistics() const noexcept { return lastFrameStatistics; }
+
+    /** Returns the statistics collected so far during the current frame. */
+    Statistics getCurrentFrameStatistics() const noexcept { return currentStatistics; }
+
+    /** Returns the number of render paths currently held by the cache. */
+    int getNumCachedPaths() const noexcept { return static_cast<int> (paths.size()); }
+
+    /** Returns the number of render paints currently held by the cache. */
+    int getNumCachedPaints() const noexcept { return static_cast<int> (paints.size()); }
+
+    /** Returns the number of gradient shaders currently held by the cache. */
+    int getNumCachedShaders() const noexcept { return static_cast<int> (shaders.size()); }
+
+    //==============================================================================
+    /** Sets the number of frames an entry can stay unused before being evicted. */
+    void setMaxUnusedFrames (int numFrames) noexcept { maxUnusedFrames = jmax (1, numFrames); }
+
+    /** Sets the maximum number of render paths the cache is allowed to hold. */
+    void setMaxCachedPaths (int numPaths) noexcept { maxCachedPaths = jmax (0, numPaths); }
+
+    /** Sets the maximum number of render paints the cache is allowed to hold. */
+    void setMaxCachedPaints (int numPaints) noexcept { maxCachedPaints = jmax (0, numPaints); }
+
+private:
+    struct PathEntry
+    {
+        Path path;
+        AffineTransform linearTransform;
+        rive::rcp<rive::RenderPath> renderPath;
+        uint64 lastUsedFrame = 0;
+    };
+
+    struct PaintEntry
+    {
+        rive::RenderPaintStyle style = rive::RenderPaintStyle::fill;
+        Color color;
+        float thickness = 0.0f;
+        StrokeJoin join = StrokeJoin::Miter;
+        StrokeCap cap = StrokeCap::Butt;
+        rive::BlendMode blendMode = rive::BlendMode::srcOver;
+        rive::rcp<rive::RenderPaint> renderPaint;
+        uint64 lastUsedFrame = 0;
+    };
+
+    struct ShaderEntry
+    {
+        ColorGradient gradient;
+        AffineTransform transform;
+        rive::rcp<rive::RenderShader> shader;
+        uint64 lastUsedFrame = 0;
+    };
+
+    rive::rcp<rive::RenderPaint> getPaint (rive::Factory& factory, rive::RenderPaintStyle style, Color color, float thickness, StrokeJoin join, StrokeCap cap, rive::BlendMode blendMode);
+
+    std::unordered_map<uint64, PathEntry> paths;
+    std::unordered_map<uint64, PaintEntry> paints;
+    std::unordered_map<uint64, ShaderEntry> shaders;
+
+    Statistics currentStatistics;
+    Statistics lastFrameStatistics;
+
+    uint64 currentFrame = 0;
+    int maxUnusedFrames = 60;
+    int maxCachedPaths = 2048;
+    int maxCachedPaints = 512;
+};
+
+} // namespace yup
@@ -19,9 +19,650 @@
   ==============================================================================
 */
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define YUP_IMAGE_USE_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define YUP_IMAGE_USE_NEON 1
+#endif
+
 namespace yup
 {
 
+namespace
+{
+
+//==============================================================================
+// Bulk kernels working on runs of pixels, with channels stored in R, G, B, A byte order.
+
+/** Divides by 255 with rounding, exact for any product of two bytes. */
+inline uint8 divideBy255 (uint32 value) noexcept
+{
+    value += 128;
+    return static_cast<uint8> ((value + (value >> 8)) >> 8);
+}
+
+inline uint8 toLuma (uint32 r, uint32 g, uint32 b) noexcept
+{
+    return static_cast<uint8> ((r * 77 + g * 150 + b * 29 + 128) >> 8);
+}
+
+#if YUP_IMAGE_USE_SSE2
+inline __m128i divideBy255 (__m128i value) noexcept
+{
+    value = _mm_add_epi16 (value, _mm_set1_epi16 (128));
+    return _mm_srli_epi16 (_mm_add_epi16 (value, _mm_srli_epi16 (value, 8)), 8);
+}
+
+inline __m128i broadcastAlpha (__m128i pixels16) noexcept
+{
+    return _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (pixels16, _MM_SHUFFLE (3, 3, 3, 3)), _MM_SHUFFLE (3, 3, 3, 3));
+}
+#elif YUP_IMAGE_USE_NEON
+inline uint8x8_t divideBy255 (uint16x8_t value) noexcept
+{
+    value = vaddq_u16 (value, vdupq_n_u16 (128));
+    return vshrn_n_u16 (vaddq_u16 (value, vshrq_n_u16 (value, 8)), 8);
+}
+#endif
+
+void fillPixels (uint8* dest, int numPixels, const uint8* pixel, int pixelStride) noexcept
+{
+    if (numPixels <= 0)
+        return;
+
+    if (pixelStride == 1)
+    {
+        std::memset (dest, pixel[0], static_cast<size_t> (numPixels));
+        return;
+    }
+
+    int i = 0;
+
+    if (pixelStride == 4)
+    {
+        uint32 value;
+        std::memcpy (&value, pixel, sizeof (value));
+
+#if YUP_IMAGE_USE_SSE2
+        const auto pattern = _mm_set1_epi32 (static_cast<int> (value));
+        for (; i + 4 <= numPixels; i += 4)
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i * 4), pattern);
+#elif YUP_IMAGE_USE_NEON
+        const auto pattern = vreinterpretq_u8_u32 (vdupq_n_u32 (value));
+        for (; i + 4 <= numPixels; i += 4)
+            vst1q_u8 (dest + i * 4, pattern);
+#endif
+
+        for (; i < numPixels; ++i)
+            std::memcpy (dest + i * 4, &value, sizeof (value));
+
+        return;
+    }
+
+    // Write one pixel, then keep doubling the filled run
+    std::memcpy (dest, pixel, static_cast<size_t> (pixelStride));
+
+    const auto totalBytes = static_cast<size_t> (numPixels) * static_cast<size_t> (pixelStride);
+    for (auto filledBytes = static_cast<size_t> (pixelStride); filledBytes < totalBytes;)
+    {
+        const auto bytesToCopy = jmin (filledBytes, totalBytes - filledBytes);
+        std::memcpy (dest + filledBytes, dest, bytesToCopy);
+        filledBytes += bytesToCopy;
+    }
+}
+
+void premultiplyPixels (uint8* pixels, int numPixels) noexcept
+{
+    int i = 0;
+
+#if YUP_IMAGE_USE_SSE2
+    const auto zero = _mm_setzero_si128();
+    const auto colorMask = _mm_setr_epi16 (-1, -1, -1, 0, -1, -1, -1, 0);
+    const auto opaqueAlpha = _mm_setr_epi16 (0, 0, 0, 255, 0, 0, 0, 255);
+
+    for (; i + 4 <= numPixels; i += 4)
+    {
+        const auto source = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (pixels + i * 4));
+
+        auto low = _mm_unpacklo_epi8 (source, zero);
+        auto high = _mm_unpackhi_epi8 (source, zero);
+
+        // Alpha is multiplied by 255, so it comes out unchanged
+        const auto lowAlpha = _mm_or_si128 (_mm_and_si128 (broadcastAlpha (low), colorMask), opaqueAlpha);
+        const auto highAlpha = _mm_or_si128 (_mm_and_si128 (broadcastAlpha (high), colorMask), opaqueAlpha);
+
+        low = divideBy255 (_mm_mullo_epi16 (low, lowAlpha));
+        high = divideBy255 (_mm_mullo_epi16 (high, highAlpha));
+
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (pixels + i * 4), _mm_packus_epi16 (low, high));
+    }
+#elif YUP_IMAGE_USE_NEON
+    for (; i + 8 <= numPixels; i += 8)
+    {
+        auto channels = vld4_u8 (pixels + i * 4);
+
+        channels.val[0] = divideBy255 (vmull_u8 (channels.val[0], channels.val[3]));
+        channels.val[1] = divideBy255 (vmull_u8 (channels.val[1], channels.val[3]));
+        channels.val[2] = divideBy255 (vmull_u8 (channels.val[2], channels.val[3]));
+
+        vst4_u8 (pixels + i * 4, channels);
+    }
+#endif
+
+    for (; i < numPixels; ++i)
+    {
+        auto pixel = pixels + i * 4;
+        const uint32 alpha = pixel[3];
+
+        pixel[0] = divideBy255 (pixel[0] * alpha);
+        pixel[1] = divideBy255 (pixel[1] * alpha);
+        pixel[2] = divideBy255 (pixel[2] * alpha);
+    }
+}
+
+void unpremultiplyPixels (uint8* pixels, int numPixels) noexcept
+{
+    // Dividing has no vector instruction for bytes, so use a fixed point reciprocal of the alpha instead
+    static const auto reciprocals = []
+    {
+        std::array<uint32, 256> result {};
+        for (uint32 alpha = 1; alpha < 256; ++alpha)
+            result[alpha] = (255u * 65536u + alpha / 2) / alpha;
+
+        return result;
+    }();
+
+    for (int i = 0; i < numPixels; ++i)
+    {
+        auto pixel = pixels + i * 4;
+        const auto alpha = pixel[3];
+
+        if (alpha == 255)
+            continue;
+
+        const auto reciprocal = reciprocals[alpha];
+        pixel[0] = static_cast<uint8> (jmin (255u, (pixel[0] * reciprocal + 32768u) >> 16));
+        pixel[1] = static_cast<uint8> (jmin (255u, (pixel[1] * reciprocal + 32768u) >> 16));
+        pixel[2] = static_cast<uint8> (jmin (255u, (pixel[2] * reciprocal + 32768u) >> 16));
+    }
+}
+
+void blendPremultipliedPixels (uint8* dest, const uint8* source, int numPixels) noexcept
+{
+    int i = 0;
+
+#if YUP_IMAGE_USE_SSE2
+    const auto zero = _mm_setzero_si128();
+    const auto full = _mm_set1_epi16 (255);
+
+    for (; i + 4 <= numPixels; i += 4)
+    {
+        const auto src = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + i * 4));
+        const auto dst = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (dest + i * 4));
+
+        const auto srcLow = _mm_unpacklo_epi8 (src, zero);
+        const auto srcHigh = _mm_unpackhi_epi8 (src, zero);
+
+        const auto lowInverseAlpha = _mm_sub_epi16 (full, broadcastAlpha (srcLow));
+        const auto highInverseAlpha = _mm_sub_epi16 (full, broadcastAlpha (srcHigh));
+
+        const auto low = divideBy255 (_mm_mullo_epi16 (_mm_unpacklo_epi8 (dst, zero), lowInverseAlpha));
+        const auto high = divideBy255 (_mm_mullo_epi16 (_mm_unpackhi_epi8 (dst, zero), highInverseAlpha));
+
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i * 4), _mm_adds_epu8 (src, _mm_packus_epi16 (low, high)));
+    }
+#elif YUP_IMAGE_USE_NEON
+    for (; i + 8 <= numPixels; i += 8)
+    {
+        const auto src = vld4_u8 (source + i * 4);
+        auto dst = vld4_u8 (dest + i * 4);
+
+        const auto inverseAlpha = vmvn_u8 (src.val[3]);
+
+        for (int c = 0; c < 4; ++c)
+            dst.val[c] = vqadd_u8 (src.val[c], divideBy255 (vmull_u8 (dst.val[c], inverseAlpha)));
+
+        vst4_u8 (dest + i * 4, dst);
+    }
+#endif
+
+    for (; i < numPixels; ++i)
+    {
+        const auto src = source + i * 4;
+        auto dst = dest + i * 4;
+        const uint32 inverseAlpha = 255u - src[3];
+
+        for (int c = 0; c < 4; ++c)
+            dst[c] = static_cast<uint8> (jmin (255u, static_cast<uint32> (src[c]) + divideBy255 (dst[c] * inverseAlpha)));
+    }
+}
+
+void convertRGBAToRGB (const uint8* source, uint8* dest, int numPixels) noexcept
+{
+    int i = 0;
+
+#if YUP_IMAGE_USE_NEON
+    for (; i + 8 <= numPixels; i += 8)
+    {
+        const auto rgba = vld4_u8 (source + i * 4);
+
+        uint8x8x3_t rgb;
+        rgb.val[0] = rgba.val[0];
+        rgb.val[1] = rgba.val[1];
+        rgb.val[2] = rgba.val[2];
+
+        vst3_u8 (dest + i * 3, rgb);
+    }
+#endif
+
+    for (; i < numPixels; ++i)
+    {
+        dest[i * 3] = source[i * 4];
+        dest[i * 3 + 1] = source[i * 4 + 1];
+        dest[i * 3 + 2] = source[i * 4 + 2];
+    }
+}
+
+void convertRGBToRGBA (const uint8* source, uint8* dest, int numPixels) noexcept
+{
+    int i = 0;
+
+#if YUP_IMAGE_USE_NEON
+    for (; i + 8 <= numPixels; i += 8)
+    {
+        const auto rgb = vld3_u8 (source + i * 3);
+
+        uint8x8x4_t rgba;
+        rgba.val[0] = rgb.val[0];
+        rgba.val[1] = rgb.val[1];
+        rgba.val[2] = rgb.val[2];
+        rgba.val[3] = vdup_n_u8 (255);
+
+        vst4_u8 (dest + i * 4, rgba);
+    }
+#endif
+
+    for (; i < numPixels; ++i)
+    {
+        dest[i * 4] = source[i * 3];
+        dest[i * 4 + 1] = source[i * 3 + 1];
+        dest[i * 4 + 2] = source[i * 3 + 2];
+        dest[i * 4 + 3] = 255;
+    }
+}
+
+void convertRGBAToGray (const uint8* source, uint8* dest, int numPixels) noexcept
+{
+    int i = 0;
+
+#if YUP_IMAGE_USE_SSE2
+    const auto zero = _mm_setzero_si128();
+    const auto weights = _mm_setr_epi16 (77, 150, 29, 0, 77, 150, 29, 0);
+    const auto rounding = _mm_set1_epi32 (128);
+
+    const auto lumaOfTwoPixels = [&] (__m128i pixels16)
+    {
+        // Each pixel gives two partial sums, (r * 77 + g * 150) and (b * 29), in consecutive lanes
+        const auto sums = _mm_madd_epi16 (pixels16, weights);
+        return _mm_add_epi32 (sums, _mm_srli_epi64 (sums, 32));
+    };
+
+    for (; i + 4 <= numPixels; i += 4)
+    {
+        const auto pixels = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + i * 4));
+
+        const auto low = lumaOfTwoPixels (_mm_unpacklo_epi8 (pixels, zero));
+        const auto high = lumaOfTwoPixels (_mm_unpackhi_epi8 (pixels, zero));
+
+        // Gather lanes 0 and 2 of both halves, then round and shift
+        const auto luma = _mm_castps_si128 (_mm_shuffle_ps (_mm_castsi128_ps (low), _mm_castsi128_ps (high), _MM_SHUFFLE (2, 0, 2, 0)));
+        const auto shifted = _mm_srli_epi32 (_mm_add_epi32 (luma, rounding), 8);
+        const auto packed = _mm_packus_epi16 (_mm_packs_epi32 (shifted, zero), zero);
+
+        const auto value = static_cast<uint32> (_mm_cvtsi128_si32 (packed));
+        std::memcpy (dest + i, &value, sizeof (value));
+    }
+#elif YUP_IMAGE_USE_NEON
+    for (; i + 8 <= numPixels; i += 8)
+    {
+        const auto rgba = vld4_u8 (source + i * 4);
+
+        auto luma = vmull_u8 (rgba.val[0], vdup_n_u8 (77));
+        luma = vmlal_u8 (luma, rgba.val[1], vdup_n_u8 (150));
+        luma = vmlal_u8 (luma, rgba.val[2], vdup_n_u8 (29));
+
+        vst1_u8 (dest + i, vrshrn_n_u16 (luma, 8));
+    }
+#endif
+
+    for (; i < numPixels; ++i)
+        dest[i] = toLuma (source[i * 4], source[i * 4 + 1], source[i * 4 + 2]);
+}
+
+void convertRGBToGray (const uint8* source, uint8* dest, int numPixels) noexcept
+{
+    int i = 0;
+
+#if YUP_IMAGE_USE_NEON
+    for (; i + 8 <= numPixels; i += 8)
+    {
+        const auto rgb = vld3_u8 (source + i * 3);
+
+        auto luma = vmull_u8 (rgb.val[0], vdup_n_u8 (77));
+        luma = vmlal_u8 (luma, rgb.val[1], vdup_n_u8 (150));
+        luma = vmlal_u8 (luma, rgb.val[2], vdup_n_u8 (29));
+
+        vst1_u8 (dest + i, vrshrn_n_u16 (luma, 8));
+    }
+#endif
+
+    for (; i < numPixels; ++i)
+        dest[i] = toLuma (source[i * 3], source[i * 3 + 1], source[i * 3 + 2]);
+}
+
+void convertGrayToRGBA (const uint8* source, uint8* dest, int numPixels) noexcept
+{
+    int i = 0;
+
+#if YUP_IMAGE_USE_SSE2
+    const auto opaqueAlpha = _mm_set1_epi32 (static_cast<int> (0xff000000u));
+
+    for (; i + 16 <= numPixels; i += 16)
+    {
+        const auto gray = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + i));
+
+        const auto low = _mm_unpacklo_epi8 (gray, gray);
+        const auto high = _mm_unpackhi_epi8 (gray, gray);
+
+        const auto store = [&] (int offset, __m128i pixels)
+        {
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + (i + offset) * 4), _mm_or_si128 (pixels, opaqueAlpha));
+        };
+
+        store (0, _mm_unpacklo_epi16 (low, low));
+        store (4, _mm_unpackhi_epi16 (low, low));
+        store (8, _mm_unpacklo_epi16 (high, high));
+        store (12, _mm_unpackhi_epi16 (high, high));
+    }
+#elif YUP_IMAGE_USE_NEON
+    for (; i + 8 <= numPixels; i += 8)
+    {
+        const auto gray = vld1_u8 (source + i);
+
+        uint8x8x4_t rgba;
+        rgba.val[0] = gray;
+        rgba.val[1] = gray;
+        rgba.val[2] = gray;
+        rgba.val[3] = vdup_n_u8 (255);
+
+        vst4_u8 (dest + i * 4, rgba);
+    }
+#endif
+
+    for (; i < numPixels; ++i)
+    {
+        dest[i * 4] = source[i];
+        dest[i * 4 + 1] = source[i];
+        dest[i * 4 + 2] = source[i];
+        dest[i * 4 + 3] = 255;
+    }
+}
+
+void convertGrayToRGB (const uint8* source, uint8* dest, int numPixels) noexcept
+{
+    int i = 0;
+
+#if YUP_IMAGE_USE_NEON
+    for (; i + 8 <= numPixels; i += 8)
+    {
+        const auto gray = vld1_u8 (source + i);
+
+        uint8x8x3_t rgb;
+        rgb.val[0] = gray;
+        rgb.val[1] = gray;
+        rgb.val[2] = gray;
+
+        vst3_u8 (dest + i * 3, rgb);
+    }
+#endif
+
+    for (; i < numPixels; ++i)
+    {
+        dest[i * 3] = source[i];
+        dest[i * 3 + 1] = source[i];
+        dest[i * 3 + 2] = source[i];
+    }
+}
+
+void convertPixels (const uint8* source, PixelFormat sourceFormat, uint8* dest, PixelFormat destFormat, int numPixels) noexcept
+{
+    if (sourceFormat == destFormat)
+    {
+        const auto pixelStride = sourceFormat == PixelFormat::RGBA ? 4 : (sourceFormat == PixelFormat::RGB ? 3 : 1);
+        std::memcpy (dest, source, static_cast<size_t> (numPixels) * static_cast<size_t> (pixelStride));
+        return;
+    }
+
+    switch (sourceFormat)
+    {
+        case PixelFormat::RGBA:
+            if (destFormat == PixelFormat::RGB)
+                convertRGBAToRGB (source, dest, numPixels);
+            else
+                convertRGBAToGray (source, dest, numPixels);
+            break;
+
+        case PixelFormat::RGB:
+            if (destFormat == PixelFormat::RGBA)
+                convertRGBToRGBA (source, dest, numPixels);
+            else
+                convertRGBToGray (source, dest, numPixels);
+            break;
+
+        case PixelFormat::Grayscale:
+            if (destFormat == PixelFormat::RGBA)
+                convertGrayToRGBA (source, dest, numPixels);
+            else
+                convertGrayToRGB (source, dest, numPixels);
+            break;
+    }
+}
+
+void accumulateLine (const uint8* source, uint32* sums, int numValues) noexcept
+{
+    int i = 0;
+
+#if YUP_IMAGE_USE_SSE2
+    const auto zero = _mm_setzero_si128();
+
+    for (; i + 16 <= numValues; i += 16)
+    {
+        const auto values = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + i));
+        const auto low = _mm_unpacklo_epi8 (values, zero);
+        const auto high = _mm_unpackhi_epi8 (values, zero);
+
+        const auto accumulate = [&] (int offset, __m128i values32)
+        {
+            auto sum = reinterpret_cast<__m128i*> (sums + i + offset);
+            _mm_storeu_si128 (sum, _mm_add_epi32 (_mm_loadu_si128 (sum), values32));
+        };
+
+        accumulate (0, _mm_unpacklo_epi16 (low, zero));
+        accumulate (4, _mm_unpackhi_epi16 (low, zero));
+        accumulate (8, _mm_unpacklo_epi16 (high, zero));
+        accumulate (12, _mm_unpackhi_epi16 (high, zero));
+    }
+#elif YUP_IMAGE_USE_NEON
+    for (; i + 8 <= numValues; i += 8)
+    {
+        const auto values = vmovl_u8 (vld1_u8 (source + i));
+
+        vst1q_u32 (sums + i, vaddw_u16 (vld1q_u32 (sums + i), vget_low_u16 (values)));
+        vst1q_u32 (sums + i + 4, vaddw_u16 (vld1q_u32 (sums + i + 4), vget_high_u16 (values)));
+    }
+#endif
+
+    for (; i < numValues; ++i)
+        sums[i] += source[i];
+}
+
+} // namespace
+
+//==============================================================================
+void BitmapData::fillRect (const Rectangle<int>& area, uint32_t color)
+{
+    const auto clipped = area.intersection ({ 0, 0, width, height });
+    if (clipped.isEmpty() || pixelBuffer == nullptr)
+        return;
+
+    uint8 pixel[4] = {};
+
+    switch (format)
+    {
+        case PixelFormat::Grayscale:
+            pixel[0] = static_cast<uint8> (color & 0xFF);
+            break;
+
+        case PixelFormat::RGB:
+            pixel[0] = static_cast<uint8> ((color >> 16) & 0xFF);
+            pixel[1] = static_cast<uint8> ((color >> 8) & 0xFF);
+            pixel[2] = static_cast<uint8> (color & 0xFF);
+            break;
+
+        case PixelFormat::RGBA:
+            pixel[0] = static_cast<uint8> ((color >> 24) & 0xFF);
+            pixel[1] = static_cast<uint8> ((color >> 16) & 0xFF);
+            pixel[2] = static_cast<uint8> ((color >> 8) & 0xFF);
+            pixel[3] = static_cast<uint8> (color & 0xFF);
+            break;
+
+        default:
+            throw std::runtime_error ("Unsupported pixel format.");
+    }
+
+    const auto pixelStride = getPixelStride();
+    const auto lineBytes = static_cast<size_t> (clipped.getWidth()) * static_cast<size_t> (pixelStride);
+    const auto firstLine = getLinePointer (clipped.getY()) + clipped.getX() * pixelStride;
+
+    fillPixels (firstLine, clipped.getWidth(), pixel, pixelStride);
+
+    for (int y = clipped.getY() + 1; y < clipped.getY() + clipped.getHeight(); ++y)
+        std::memcpy (getLinePointer (y) + clipped.getX() * pixelStride, firstLine, lineBytes);
+}
+
+void BitmapData::blit (const BitmapData& source, const Rectangle<int>& sourceArea, Point<int> destination, bool blendAlpha)
+{
+    if (pixelBuffer == nullptr || source.pixelBuffer == nullptr)
+        return;
+
+    // Copying between overlapping areas of the same bitmap needs a snapshot of the source
+    if (&source == this)
+    {
+        const auto snapshot = convertedTo (format);
+        blit (*snapshot, sourceArea, destination, blendAlpha);
+        return;
+    }
+
+    // Clip against the source, then against this bitmap, keeping the two areas aligned
+    auto area = sourceArea.intersection ({ 0, 0, source.width, source.height });
+    destination = destination.translated (area.getX() - sourceArea.getX(), area.getY() - sourceArea.getY());
+
+    const auto destArea = Rectangle<int> (destination, area.getWidth(), area.getHeight()).intersection ({ 0, 0, width, height });
+    if (destArea.isEmpty())
+        return;
+
+    area = Rectangle<int> (area.getX() + destArea.getX() - destination.getX(),
+                           area.getY() + destArea.getY() - destination.getY(),
+                           destArea.getWidth(),
+                           destArea.getHeight());
+
+    const auto blend = blendAlpha && format == PixelFormat::RGBA && source.format == PixelFormat::RGBA;
+    const auto sourceStride = source.getPixelStride();
+    const auto destStride = getPixelStride();
+
+    for (int y = 0; y < area.getHeight(); ++y)
+    {
+        const auto sourceLine = source.getLinePointer (area.getY() + y) + area.getX() * sourceStride;
+        const auto destLine = getLinePointer (destArea.getY() + y) + destArea.getX() * destStride;
+
+        if (blend)
+            blendPremultipliedPixels (destLine, sourceLine, area.getWidth());
+        else
+            convertPixels (sourceLine, source.format, destLine, format, area.getWidth());
+    }
+}
+
+void BitmapData::premultiplyAlpha()
+{
+    if (format == PixelFormat::RGBA && pixelBuffer != nullptr)
+        premultiplyPixels (pixelBuffer.get(), width * height);
+}
+
+void BitmapData::unpremultiplyAlpha()
+{
+    if (format == PixelFormat::RGBA && pixelBuffer != nullptr)
+        unpremultiplyPixels (pixelBuffer.get(), width * height);
+}
+
+BitmapData::Ptr BitmapData::convertedTo (PixelFormat newFormat) const
+{
+    if (pixelBuffer == nullptr)
+        return new BitmapData();
+
+    BitmapData::Ptr result = new BitmapData (width, height, newFormat);
+
+    // Lines are tightly packed, so the whole bitmap converts as a single run
+    convertPixels (pixelBuffer.get(), format, result->pixelBuffer.get(), newFormat, width * height);
+
+    return result;
+}
+
+BitmapData::Ptr BitmapData::downscaled (int factor) const
+{
+    if (pixelBuffer == nullptr)
+        return new BitmapData();
+
+    const auto blockWidth = jlimit (1, width, factor);
+    const auto blockHeight = jlimit (1, height, factor);
+    const auto newWidth = width / blockWidth;
+    const auto newHeight = height / blockHeight;
+    const auto pixelStride = getPixelStride();
+    const auto blockArea = static_cast<uint32> (blockWidth * blockHeight);
+
+    BitmapData::Ptr result = new BitmapData (newWidth, newHeight, format);
+
+    const auto numSums = newWidth * blockWidth * pixelStride;
+    std::vector<uint32> sums (static_cast<size_t> (numSums));
+
+    for (int y = 0; y < newHeight; ++y)
+    {
+        std::fill (sums.begin(), sums.end(), 0u);
+
+        for (int row = 0; row < blockHeight; ++row)
+            accumulateLine (getLinePointer (y * blockHeight + row), sums.data(), numSums);
+
+        auto dest = result->getLinePointer (y);
+
+        for (int x = 0; x < newWidth; ++x)
+        {
+            for (int c = 0; c < pixelStride; ++c)
+            {
+                uint32 sum = 0;
+                for (int column = 0; column < blockWidth; ++column)
+                    sum += sums[static_cast<size_t> ((x * blockWidth + column) * pixelStride + c)];
+
+                *dest++ = static_cast<uint8> ((sum + blockArea / 2) / blockArea);
+            }
+        }
+    }
+
+    return result;
+}
+
+//==============================================================================
+
 Image::Image (int w, int h, PixelFormat fmt)
     : bitmapData (new BitmapData (w, h, fmt))
 {
@@ -108,11 +749,57 @@ void Image::fill (uint32_t color)
     bitmapData->fill (color);
 }
 
+void Image::fillRect (const Rectangle<int>& area, uint32_t color)
+{
+    jassert (bitmapData != nullptr);
+
+    bitmapData->fillRect (area, color);
+}
+
 void Image::clear()
 {
     bitmapData->clear();
 }
 
+void Image::blit (const Image& source, const Rectangle<int>& sourceArea, Point<int> destination, bool blendAlpha)
+{
+    jassert (bitmapData != nullptr && source.bitmapData != nullptr);
+
+    bitmapData->blit (*source.bitmapData, sourceArea, destination, blendAlpha);
+}
+
+void Image::premultiplyAlpha()
+{
+    jassert (bitmapData != nullptr);
+
+    bitmapData->premultiplyAlpha();
+}
+
+void Image::unpremultiplyAlpha()
+{
+    jassert (bitmapData != nullptr);
+
+    bitmapData->unpremultiplyAlpha();
+}
+
+Image Image::convertedTo (PixelFormat newFormat) const
+{
+    jassert (bitmapData != nullptr);
+
+    Image result;
+    result.bitmapData = bitmapData->convertedTo (newFormat);
+    return result;
+}
+
+Image Image::downscaled (int factor) const
+{
+    jassert (bitmapData != nullptr);
+
+    Image result;
+    result.bitmapData = bitmapData->downscaled (factor);
+    return result;
+}
+
 const BitmapData& Image::getBitmapData() const noexcept
 {
     jassert (bitmapData != nullptr);
@@ -205,58 +205,15 @@ public:
     */
     void fill (uint32_t color)
     {
-        size_t totalBytes = getTotalSizeBytes();
-
-        switch (format)
-        {
-            case PixelFormat::Grayscale:
-            {
-                uint8 gray = static_cast<uint8> (color & 0xFF);
-
-                std::memset (pixelBuffer.get(), gray, totalBytes);
-
-                break;
-            }
-
-            case PixelFormat::RGB:
-            {
-                uint8 r = static_cast<uint8> ((color >> 16) & 0xFF);
-                uint8 g = static_cast<uint8> ((color >> 8) & 0xFF);
-                uint8 b = static_cast<uint8> (color & 0xFF);
-
-                for (int i = 0; i < width * height; ++i)
-                {
-                    pixelBuffer[i * 3] = r;
-                    pixelBuffer[i * 3 + 1] = g;
-                    pixelBuffer[i * 3 + 2] = b;
-                }
-
-                break;
-            }
-
-            case PixelFormat::RGBA:
-            {
-                uint8 r = static_cast<uint8> ((color >> 24) & 0xFF);
-                uint8 g = static_cast<uint8> ((color >> 16) & 0xFF);
-                uint8 b = static_cast<uint8> ((color >> 8) & 0xFF);
-                uint8 a = static_cast<uint8> (color & 0xFF);
-
-                for (int i = 0; i < width * height; ++i)
-                {
-                    pixelBuffer[i * 4] = r;
-                    pixelBuffer[i * 4 + 1] = g;
-                    pixelBuffer[i * 4 + 2] = b;
-                    pixelBuffer[i * 4 + 3] = a;
-                }
-
-                break;
-            }
-
-            default:
-                throw std::runtime_error ("Unsupported pixel format.");
-        }
+        fillRect ({ 0, 0, width, height }, color);
     }
 
+    /** Fills an area of the bitmap with the specified color.
+        @param area     The area to fill, clipped to the bounds of the bitmap.
+        @param color    The color value to fill the area with, packed like in setPixel.
+    */
+    void fillRect (const Rectangle<int>& area, uint32_t color);
+
     /** Clears the bitmap by setting all pixels to zero. */
     void clear()
     {
@@ -275,6 +232,62 @@ public:
         return { pixelBuffer.get(), getTotalSizeBytes() };
     }
 
+    /** Returns the number of bytes between the start of two consecutive lines. */
+    int getLineStride() const noexcept
+    {
+        return width * getPixelStride();
+    }
+
+    /** Returns a pointer to the first pixel of a line, without checking the line is in range.
+
+        Writing pixels through the line pointers avoids the per pixel checks of setPixel, which
+        makes a big difference when generating images procedurally.
+    */
+    const uint8* getLinePointer (int y) const noexcept
+    {
+        return pixelBuffer.get() + static_cast<size_t> (y) * static_cast<size_t> (getLineStride());
+    }
+
+    /** Returns a mutable pointer to the first pixel of a line, without checking the line is in range. */
+    uint8* getLinePointer (int y) noexcept
+    {
+        return pixelBuffer.get() + static_cast<size_t> (y) * static_cast<size_t> (getLineStride());
+    }
+
+    //==============================================================================
+    /** Copies an area of another bitmap into this one.
+
+        Pixels are converted when the formats of the bitmaps differ. When both bitmaps are RGBA and
+        blendAlpha is true, the source is composited over the existing pixels, and both are expected
+        to hold premultiplied alpha.
+
+        @param source       The bitmap to copy pixels from.
+        @param sourceArea   The area of the source to copy, clipped to the bounds of the source.
+        @param destination  The position in this bitmap where the top left corner of the area lands.
+        @param blendAlpha   Whether to blend RGBA pixels instead of replacing them.
+    */
+    void blit (const BitmapData& source, const Rectangle<int>& sourceArea, Point<int> destination, bool blendAlpha = false);
+
+    /** Multiplies the color channels of an RGBA bitmap by their alpha. Other formats are left untouched. */
+    void premultiplyAlpha();
+
+    /** Divides the color channels of a premultiplied RGBA bitmap by their alpha. Other formats are left untouched. */
+    void unpremultiplyAlpha();
+
+    /** Returns a copy of the bitmap converted to another pixel format.
+
+        Converting to grayscale uses the Rec. 601 luma weights, and converting to RGBA makes the pixels opaque.
+    */
+    Ptr convertedTo (PixelFormat newFormat) const;
+
+    /** Returns a copy of the bitmap shrunk by averaging square blocks of pixels.
+
+        Pixels on the right and bottom edges not making a full block are dropped.
+
+        @param factor   The size of the blocks, which is clamped to the size of the bitmap.
+    */
+    Ptr downscaled (int factor) const;
+
 private:
     //==============================================================================
     /** Returns the number of bytes per pixel for the given format. */
@@ -387,9 +400,36 @@ public:
     */
     void fill (uint32_t color);
 
+    /** Fills an area of the image with the specified color.
+        @param area     The area to fill, clipped to the bounds of the image.
+        @param color    The color value to fill the area with.
+    */
+    void fillRect (const Rectangle<int>& area, uint32_t color);
+
     /** Clears the image by setting all pixels to zero. */
     void clear();
 
+    /** Copies an area of another image into this one.
+        @see BitmapData::blit
+    */
+    void blit (const Image& source, const Rectangle<int>& sourceArea, Point<int> destination, bool blendAlpha = false);
+
+    /** Multiplies the color channels of an RGBA image by their alpha. */
+    void premultiplyAlpha();
+
+    /** Divides the color channels of a premultiplied RGBA image by their alpha. */
+    void unpremultiplyAlpha();
+
+    /** Returns a copy of the image converted to another pixel format.
+        @see BitmapData::convertedTo
+    */
+    Image convertedTo (PixelFormat newFormat) const;
+
+    /** Returns a copy of the image shrunk by averaging square blocks of pixels.
+        @see BitmapData::downscaled
+    */
+    Image downscaled (int factor) const;
+
     /** Returns a const reference to BitmapData. */
     const BitmapData& getBitmapData() const noexcept;
 
@@ -412,7 +452,12 @@ public:
     rive::rcp<rive::gpu::Texture> getTexture() const;
 
     //==============================================================================
+    /** Decodes a PNG or WebP image on the calling thread.
+
+        The decoded pixels are adopted by the image without being copied.
 
+        @see ImageLoader
+    */
     static ResultValue<Image> loadFromData (Span<const uint8> imageData);
 
 private:
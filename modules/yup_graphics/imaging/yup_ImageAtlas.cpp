@@ -0,0 +1,358 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace yup
+{
+
+namespace
+{
+
+//==============================================================================
+
+constexpr int atlasPadding = 1;
+
+rive::rcp<rive::RenderBuffer> makeFilledBuffer (rive::Factory& factory, rive::RenderBufferType type, const void* data, std::size_t sizeInBytes)
+{
+    auto buffer = factory.makeRenderBuffer (type, rive::RenderBufferFlags::mappedOnceAtInitialization, sizeInBytes);
+    if (buffer == nullptr)
+        return nullptr;
+
+    std::memcpy (buffer->map(), data, sizeInBytes);
+    buffer->unmap();
+
+    return buffer;
+}
+
+} // namespace
+
+//==============================================================================
+bool ImageAtlas::canPack (const Image& image) const noexcept
+{
+    return image.isValid()
+        && image.getWidth() <= maxEntrySize
+        && image.getHeight() <= maxEntrySize
+        && image.getWidth() + 2 * atlasPadding <= pageSize
+        && image.getHeight() + 2 * atlasPadding <= pageSize;
+}
+
+//==============================================================================
+bool ImageAtlas::preload (const Image& image)
+{
+    return findOrStage (image) != nullptr;
+}
+
+void ImageAtlas::beginFrame (GraphicsContext& context)
+{
+    lastFrameStatistics = std::exchange (currentStatistics, {});
+    lastTexture = nullptr;
+
+    // Draws recorded in the previous frame have been flushed, the old page images can go
+    retiredPageImages.clear();
+
+    releaseUnusedEntries();
+
+    for (int pageIndex = 0; pageIndex < getNumPages(); ++pageIndex)
+    {
+        if (pages[static_cast<std::size_t> (pageIndex)]->needsUpload)
+            uploadPage (context, pageIndex);
+    }
+}
+
+void ImageAtlas::clear()
+{
+    entries.clear();
+    pages.clear();
+    retiredPageImages.clear();
+    lastTexture = nullptr;
+
+    ++generation;
+}
+
+//==============================================================================
+const ImageAtlas::Entry* ImageAtlas::getEntry (GraphicsContext& context, const Image& image)
+{
+    auto stored = findOrStage (image);
+    if (stored == nullptr)
+        return nullptr;
+
+    auto& entry = stored->entry;
+    auto& page = *pages[static_cast<std::size_t> (entry.pageIndex)];
+
+    if (page.needsUpload)
+    {
+        if (! uploadPage (context, entry.pageIndex))
+            return nullptr;
+
+        ++currentStatistics.synchronousUploads;
+    }
+
+    if (entry.vertices == nullptr)
+    {
+        createBuffers (context, *stored);
+
+        if (entry.vertices == nullptr || entry.uvCoords == nullptr || entry.indices == nullptr)
+            return nullptr;
+    }
+
+    entry.pageImage = page.image;
+    return &entry;
+}
+
+void ImageAtlas::recordImageDraw (const void* texture, bool isFromAtlas) noexcept
+{
+    ++currentStatistics.imageDraws;
+
+    if (isFromAtlas)
+        ++currentStatistics.atlasDraws;
+
+    if (texture != lastTexture)
+    {
+        ++currentStatistics.textureBinds;
+        lastTexture = texture;
+    }
+}
+
+//==============================================================================
+ImageAtlas::StoredEntry* ImageAtlas::findOrStage (const Image& image)
+{
+    if (! canPack (image))
+        return nullptr;
+
+    const auto& bitmap = image.getBitmapData();
+
+    if (auto it = entries.find (&bitmap); it != entries.end())
+        return &it->second;
+
+    const auto allocatedWidth = bitmap.getWidth() + 2 * atlasPadding;
+    const auto allocatedHeight = bitmap.getHeight() + 2 * atlasPadding;
+
+    std::optional<Rectangle<int>> allocated;
+    int pageIndex = 0;
+
+    for (; pageIndex < getNumPages() && ! allocated; ++pageIndex)
+        allocated = allocate (*pages[static_cast<std::size_t> (pageIndex)], allocatedWidth, allocatedHeight);
+
+    if (! allocated)
+    {
+        auto page = std::make_unique<Page>();
+        page->pixels = Image (pageSize, pageSize, PixelFormat::RGBA);
+        page->pixels.clear();
+
+        pages.push_back (std::move (page));
+        pageIndex = getNumPages();
+
+        allocated = allocate (*pages.back(), allocatedWidth, allocatedHeight);
+        jassert (allocated.has_value());
+    }
+
+    --pageIndex;
+
+    auto& page = *pages[static_cast<std::size_t> (pageIndex)];
+
+    StoredEntry stored;
+    stored.bitmap = const_cast<BitmapData*> (&bitmap);
+    stored.entry.pageIndex = pageIndex;
+    stored.entry.area = allocated->reduced (atlasPadding);
+
+    copyPixels (page, stored.entry.area, bitmap);
+
+    ++page.numEntries;
+    page.needsUpload = true;
+
+    return &entries.emplace (&bitmap, std::move (stored)).first->second;
+}
+
+std::optional<Rectangle<int>> ImageAtlas::allocate (Page& page, int width, int height)
+{
+    const auto size = page.pixels.getWidth();
+
+    // Pick the shortest shelf the image fits in, to limit the space wasted above shorter images
+    Shelf* bestShelf = nullptr;
+
+    for (auto& shelf : page.shelves)
+    {
+        if (shelf.height >= height
+            && size - shelf.usedWidth >= width
+            && (bestShelf == nullptr || shelf.height < bestShelf->height))
+        {
+            bestShelf = &shelf;
+        }
+    }
+
+    if (bestShelf == nullptr)
+    {
+        const auto nextY = page.shelves.empty() ? 0 : page.shelves.back().y + page.shelves.back().height;
+        if (nextY + height > size || width > size)
+            return std::nullopt;
+
+        page.shelves.push_back ({ nextY, height, 0 });
+        bestShelf = &page.shelves.back();
+    }
+
+    const auto area = Rectangle<int> (bestShelf->usedWidth, bestShelf->y, width, height);
+    bestShelf->usedWidth += width;
+
+    return area;
+}
+
+void ImageAtlas::copyPixels (Page& page, const Rectangle<int>& area, const BitmapData& bitmap)
+{
+    auto destination = page.pixels.getRawData().data();
+    const auto destinationStride = static_cast<std::size_t> (page.pixels.getWidth()) * 4;
+
+    const auto source = bitmap.getRawData().data();
+    const auto sourcePixelStride = static_cast<std::size_t> (bitmap.getPixelStride());
+    const auto width = bitmap.getWidth();
+    const auto height = bitmap.getHeight();
+
+    // Copy the image extruding its border into the padding, so filtering at the edges of the quad
+    // never samples the neighbouring entries
+    for (int y = -atlasPadding; y < height + atlasPadding; ++y)
+    {
+        const auto sourceY = static_cast<std::size_t> (jlimit (0, height - 1, y));
+        auto row = destination + static_cast<std::size_t> (area.getY() + y) * destinationStride;
+
+        for (int x = -atlasPadding; x < width + atlasPadding; ++x)
+        {
+            const auto sourceX = static_cast<std::size_t> (jlimit (0, width - 1, x));
+            const auto* p = source + (sourceY * static_cast<std::size_t> (width) + sourceX) * sourcePixelStride;
+            auto* d = row + static_cast<std::size_t> (area.getX() + x) * 4;
+
+            switch (bitmap.getPixelFormat())
+            {
+                case PixelFormat::RGBA:
+                    std::memcpy (d, p, 4);
+                    break;
+
+                case PixelFormat::RGB:
+                    d[0] = p[0];
+                    d[1] = p[1];
+                    d[2] = p[2];
+                    d[3] = 255;
+                    break;
+
+                case PixelFormat::Grayscale:
+                default:
+                    d[0] = d[1] = d[2] = p[0];
+                    d[3] = 255;
+                    break;
+            }
+        }
+    }
+}
+
+bool ImageAtlas::uploadPage (GraphicsContext& context, int pageIndex)
+{
+    auto& page = *pages[static_cast<std::size_t> (pageIndex)];
+
+    rive::rcp<rive::RenderImage> image;
+
+    auto renderContext = context.renderContextOrNull();
+    if (renderContext != nullptr && renderContext->impl() != nullptr)
+    {
+        // A single mip level, as smaller levels would blend neighbouring entries together
+        auto texture = renderContext->impl()->makeImageTexture (
+            static_cast<uint32_t> (page.pixels.getWidth()),
+            static_cast<uint32_t> (page.pixels.getHeight()),
+            1,
+            page.pixels.getRawData().data());
+
+        if (texture != nullptr)
+            image = rive::make_rcp<rive::RiveRenderImage> (std::move (texture));
+    }
+    else
+    {
+        image = context.makeRenderImage (page.pixels);
+    }
+
+    if (image == nullptr)
+        return false;
+
+    // Draws referencing the previous image of the page might still be pending in this frame
+    if (page.image != nullptr)
+        retiredPageImages.push_back (std::move (page.image));
+
+    page.image = std::move (image);
+    page.needsUpload = false;
+
+    ++generation;
+
+    ++currentStatistics.pageUploads;
+    return true;
+}
+
+void ImageAtlas::createBuffers (GraphicsContext& context, StoredEntry& stored)
+{
+    auto factory = context.factory();
+    if (factory == nullptr)
+        return;
+
+    auto& entry = stored.entry;
+
+    const auto width = static_cast<float> (entry.area.getWidth());
+    const auto height = static_cast<float> (entry.area.getHeight());
+    const auto size = static_cast<float> (pages[static_cast<std::size_t> (entry.pageIndex)]->pixels.getWidth());
+
+    const auto u1 = static_cast<float> (entry.area.getX()) / size;
+    const auto v1 = static_cast<float> (entry.area.getY()) / size;
+    const auto u2 = static_cast<float> (entry.area.getX() + entry.area.getWidth()) / size;
+    const auto v2 = static_cast<float> (entry.area.getY() + entry.area.getHeight()) / size;
+
+    const rive::Vec2D vertices[] = { { 0.0f, 0.0f }, { width, 0.0f }, { width, height }, { 0.0f, height } };
+    const rive::Vec2D uvCoords[] = { { u1, v1 }, { u2, v1 }, { u2, v2 }, { u1, v2 } };
+    const uint16 indices[] = { 0, 1, 2, 0, 2, 3 };
+
+    entry.vertices = makeFilledBuffer (*factory, rive::RenderBufferType::vertex, vertices, sizeof (vertices));
+    entry.uvCoords = makeFilledBuffer (*factory, rive::RenderBufferType::vertex, uvCoords, sizeof (uvCoords));
+    entry.indices = makeFilledBuffer (*factory, rive::RenderBufferType::index, indices, sizeof (indices));
+}
+
+void ImageAtlas::releaseUnusedEntries()
+{
+    // The atlas holds one reference to the pixel data of each entry, when it's the only one left the
+    // image can't be drawn anymore
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        if (it->second.bitmap->getReferenceCount() <= 1)
+        {
+            --pages[static_cast<std::size_t> (it->second.entry.pageIndex)]->numEntries;
+            it = entries.erase (it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // Shelves can't be compacted, so space is only reclaimed once a page is empty
+    for (auto& page : pages)
+    {
+        if (page->numEntries == 0 && ! page->shelves.empty())
+        {
+            page->shelves.clear();
+            page->pixels.clear();
+
+            ++generation;
+        }
+    }
+}
+
+} // namespace yup
@@ -0,0 +1,176 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace yup
+{
+
+//==============================================================================
+/** Packs small images into shared texture pages, and uploads them between frames.
+
+    Uploading every image as its own texture makes the first frame drawing many icons hitch, and
+    costs a texture switch for every image drawn. The atlas copies images no larger than the
+    maximum entry size into shared pages, and draws them as textured quads sampling a sub rectangle
+    of their page, so consecutive draws of packed images keep using the same texture.
+
+    Images can be staged ahead of time with preload(), in which case their pages are uploaded by
+    beginFrame() before painting starts. Images drawn without being preloaded are staged on first
+    use, and their page is uploaded right away, together with any other image staged so far.
+
+    Entries are keyed by the pixel data of the images, and are released by beginFrame() once no
+    Image refers to that data anymore. The pixels are copied when the image is staged, so changes
+    made to an image after it has been drawn are not reflected in the atlas.
+
+    @see GraphicsContext::getImageAtlas
+*/
+class JUCE_API ImageAtlas
+{
+public:
+    //==============================================================================
+    /** Counters collected while rendering a frame. */
+    struct Statistics
+    {
+        int imageDraws = 0;         ///< Number of images drawn.
+        int atlasDraws = 0;         ///< Number of images drawn from an atlas page.
+        int textureBinds = 0;       ///< Number of times an image draw used a different texture than the previous one.
+        int pageUploads = 0;        ///< Number of atlas pages uploaded.
+        int synchronousUploads = 0; ///< Number of page uploads that happened while drawing, instead of between frames.
+    };
+
+    /** The geometry needed to draw an image packed in the atlas. */
+    struct Entry
+    {
+        rive::rcp<rive::RenderImage> pageImage; ///< The image of the page the entry is packed into.
+        rive::rcp<rive::RenderBuffer> vertices; ///< The corners of the image, in image pixels.
+        rive::rcp<rive::RenderBuffer> uvCoords; ///< The corners of the image in the page, in normalised coordinates.
+        rive::rcp<rive::RenderBuffer> indices;  ///< The two triangles making the quad.
+        Rectangle<int> area;                    ///< The area of the page holding the image pixels.
+        int pageIndex = 0;                      ///< The index of the page the entry is packed into.
+    };
+
+    //==============================================================================
+    /** Constructs an empty atlas. */
+    ImageAtlas() = default;
+
+    /** Move constructor and assignment operator. */
+    ImageAtlas (ImageAtlas&& other) = default;
+    ImageAtlas& operator= (ImageAtlas&& other) = default;
+
+    //==============================================================================
+    /** Sets the size of the pages, only affecting pages created afterwards. */
+    void setPageSize (int newPageSize) noexcept { pageSize = jmax (64, newPageSize); }
+
+    /** Sets the size over which images are not packed into the atlas. */
+    void setMaxEntrySize (int newMaxEntrySize) noexcept { maxEntrySize = jmax (1, newMaxEntrySize); }
+
+    /** Returns true if an image is small enough to be packed into the atlas. */
+    bool canPack (const Image& image) const noexcept;
+
+    //==============================================================================
+    /** Stages an image, so its page is uploaded by the next call to beginFrame().
+
+        @return True if the image is packed into the atlas.
+    */
+    bool preload (const Image& image);
+
+    /** Marks the beginning of a new frame.
+
+        This uploads the pages with staged images, releases the entries of images that don't exist anymore
+        and rolls the per-frame statistics over.
+    */
+    void beginFrame (GraphicsContext& context);
+
+    /** Removes all the entries and pages. */
+    void clear();
+
+    //==============================================================================
+    /** Returns the entry to draw an image with, staging it and uploading its page if needed.
+
+        @return The entry, or nullptr if the image is not suitable for the atlas or its page can't be uploaded.
+    */
+    const Entry* getEntry (GraphicsContext& context, const Image& image);
+
+    /** Records that an image has been drawn using a texture, to keep track of the texture binds. */
+    void recordImageDraw (const void* texture, bool isFromAtlas) noexcept;
+
+    //==============================================================================
+    /** Returns the statistics collected during the last completed frame. */
+    Statistics getLastFrameStatistics() const noexcept { return lastFrameStatistics; }
+
+    /** Returns the statistics collected so far during the current frame. */
+    Statistics getCurrentFrameStatistics() const noexcept { return currentStatistics; }
+
+    /** Returns the number of images currently packed into the atlas. */
+    int getNumEntries() const noexcept { return static_cast<int> (entries.size()); }
+
+    /** Returns the number of pages allocated by the atlas. */
+    int getNumPages() const noexcept { return static_cast<int> (pages.size()); }
+
+    /** Returns a number that changes whenever page images are replaced or page areas are reused.
+
+        Entries obtained before a change might refer to a stale page image, so anything holding on to
+        them across frames (like a DisplayList) must be regenerated when this changes.
+    */
+    uint32 getGeneration() const noexcept { return generation; }
+
+private:
+    struct Shelf
+    {
+        int y = 0;
+        int height = 0;
+        int usedWidth = 0;
+    };
+
+    struct Page
+    {
+        Image pixels;
+        std::vector<Shelf> shelves;
+        rive::rcp<rive::RenderImage> image;
+        int numEntries = 0;
+        bool needsUpload = true;
+    };
+
+    struct StoredEntry
+    {
+        BitmapData::Ptr bitmap;
+        Entry entry;
+    };
+
+    StoredEntry* findOrStage (const Image& image);
+    std::optional<Rectangle<int>> allocate (Page& page, int width, int height);
+    void copyPixels (Page& page, const Rectangle<int>& area, const BitmapData& bitmap);
+    bool uploadPage (GraphicsContext& context, int pageIndex);
+    void createBuffers (GraphicsContext& context, StoredEntry& stored);
+    void releaseUnusedEntries();
+
+    std::vector<std::unique_ptr<Page>> pages;
+    std::unordered_map<const BitmapData*, StoredEntry> entries;
+    std::vector<rive::rcp<rive::RenderImage>> retiredPageImages;
+
+    Statistics currentStatistics;
+    Statistics lastFrameStatistics;
+    const void* lastTexture = nullptr;
+    uint32 generation = 0;
+
+    int pageSize = 1024;
+    int maxEntrySize = 256;
+};
+
+} // namespace yup
@@ -0,0 +1,247 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+ImageLoader::Request::Request (uint64 hashToUse, Span<const uint8> imageData)
+    : hash (hashToUse)
+    , encodedData (imageData.data(), imageData.size())
+{
+}
+
+bool ImageLoader::Request::hasSameData (Span<const uint8> imageData) const noexcept
+{
+    return encodedData.getSize() == imageData.size()
+        && std::memcmp (encodedData.getData(), imageData.data(), imageData.size()) == 0;
+}
+
+bool ImageLoader::Request::isReady() const
+{
+    const ScopedLock sl (lock);
+    return result.has_value();
+}
+
+void ImageLoader::Request::complete (ResultValue<Image> newResult)
+{
+    std::vector<Callback> callbacksToCall;
+
+    {
+        const ScopedLock sl (lock);
+
+        if (result.has_value())
+            return;
+
+        result.emplace (std::move (newResult));
+        callbacksToCall = std::exchange (callbacks, {});
+    }
+
+    finished.signal();
+
+    for (const auto& callback : callbacksToCall)
+        callback (*result);
+}
+
+//==============================================================================
+bool ImageLoader::Handle::isReady() const
+{
+    return request != nullptr && request->isReady();
+}
+
+bool ImageLoader::Handle::wait (int timeOutMilliseconds) const
+{
+    return request != nullptr && request->finished.wait (static_cast<double> (timeOutMilliseconds));
+}
+
+ResultValue<Image> ImageLoader::Handle::getResult() const
+{
+    if (request == nullptr)
+        return ResultValue<Image>::fail ("Invalid image load handle");
+
+    request->finished.wait();
+
+    const ScopedLock sl (request->lock);
+    return *request->result;
+}
+
+void ImageLoader::Handle::onComplete (Callback callback) const
+{
+    if (request == nullptr || callback == nullptr)
+        return;
+
+    {
+        const ScopedLock sl (request->lock);
+
+        if (! request->result.has_value())
+        {
+            request->callbacks.push_back (std::move (callback));
+            return;
+        }
+    }
+
+    // The result never changes once set, so it can be read outside of the lock
+    callback (*request->result);
+}
+
+//==============================================================================
+ImageLoader::ImageLoader()
+    : ImageLoader (jlimit (1, 4, SystemStats::getNumCpus() - 1))
+{
+}
+
+ImageLoader::ImageLoader (int numThreads)
+    : numThreads (jmax (1, numThreads))
+{
+}
+
+ImageLoader::~ImageLoader()
+{
+    // Drops the queued jobs and waits for the running ones to finish
+    threadPool.reset();
+
+    for (const auto& [hash, request] : requests)
+        request->complete (ResultValue<Image>::fail ("The image loader has been destroyed"));
+
+    clearSingletonInstance();
+}
+
+//==============================================================================
+ImageLoader::Handle ImageLoader::loadAsync (Span<const uint8> imageData)
+{
+    return loadAsync (imageData, nullptr);
+}
+
+ImageLoader::Handle ImageLoader::loadAsync (Span<const uint8> imageData, Callback callback)
+{
+    const auto hash = hashData (imageData);
+
+    std::shared_ptr<Request> request;
+
+    {
+        const ScopedLock sl (lock);
+
+        releaseUnusedRequests();
+
+        for (auto [it, end] = requests.equal_range (hash); it != end; ++it)
+        {
+            if (it->second->hasSameData (imageData))
+            {
+                request = it->second;
+                break;
+            }
+        }
+
+        if (request != nullptr)
+        {
+            ++statistics.deduplicatedLoads;
+        }
+        else
+        {
+            ++statistics.decodes;
+
+            request = std::make_shared<Request> (hash, imageData);
+            requests.emplace (hash, request);
+
+            if (threadPool == nullptr)
+            {
+                threadPool = std::make_unique<ThreadPool> (ThreadPoolOptions()
+                                                               .withThreadName ("ImageLoader")
+                                                               .withNumberOfThreads (numThreads));
+            }
+
+            threadPool->addJob ([request]
+            {
+                const auto& encodedData = request->encodedData;
+                request->complete (Image::loadFromData ({ static_cast<const uint8*> (encodedData.getData()), encodedData.getSize() }));
+            });
+        }
+    }
+
+    Handle handle (std::move (request));
+    handle.onComplete (std::move (callback));
+    return handle;
+}
+
+//==============================================================================
+void ImageLoader::clear()
+{
+    const ScopedLock sl (lock);
+
+    for (auto it = requests.begin(); it != requests.end();)
+    {
+        if (it->second->isReady())
+            it = requests.erase (it);
+        else
+            ++it;
+    }
+
+    statistics = {};
+}
+
+ImageLoader::Statistics ImageLoader::getStatistics() const
+{
+    const ScopedLock sl (lock);
+    return statistics;
+}
+
+int ImageLoader::getNumTrackedLoads() const
+{
+    const ScopedLock sl (lock);
+    return static_cast<int> (requests.size());
+}
+
+//==============================================================================
+uint64 ImageLoader::hashData (Span<const uint8> imageData) noexcept
+{
+    return Hasher().add (imageData.data(), imageData.size()).getHash();
+}
+
+bool ImageLoader::isUnused (const std::shared_ptr<Request>& request)
+{
+    // Completed requests are dropped once no Image outside of the request refers to their pixels
+    const ScopedLock sl (request->lock);
+
+    if (! request->result.has_value())
+        return false;
+
+    const auto& result = *request->result;
+    return result.failed()
+        || ! result.getReference().isValid()
+        || result.getReference().getBitmapData().getReferenceCount() <= 1;
+}
+
+void ImageLoader::releaseUnusedRequests()
+{
+    for (auto it = requests.begin(); it != requests.end();)
+    {
+        if (isUnused (it->second))
+            it = requests.erase (it);
+        else
+            ++it;
+    }
+}
+
+//==============================================================================
+JUCE_IMPLEMENT_SINGLETON (ImageLoader)
+
+} // namespace yup
@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+/** Decodes encoded images on a pool of worker threads.
+
+    Decoding a PNG or WebP file with Image::loadFromData blocks the calling thread, and loading
+    hundreds of bitmaps when opening a window can stall the message thread for seconds. The loader
+    queues the decoding on its own threads instead, and hands back a Handle that can be polled,
+    waited on, or given a callback to run once the image is ready.
+
+    Loads are de-duplicated by their encoded data: requesting an image that is already being decoded,
+    or that has been decoded and is still referenced by some Image, returns a handle to the same
+    request, and the resulting images share their pixel data. Requests keep their encoded data for as
+    long as they are tracked, and a request with a matching digest is only reused when its bytes are
+    equal too.
+
+    All the methods can be called from any thread.
+
+    @see Image::loadFromData
+*/
+class JUCE_API ImageLoader
+{
+private:
+    struct Request;
+
+public:
+    //==============================================================================
+    /** A function called once an image has been decoded, or has failed to decode. */
+    using Callback = std::function<void (const ResultValue<Image>&)>;
+
+    //==============================================================================
+    /** Counters collected by the loader since it was created or cleared. */
+    struct Statistics
+    {
+        int64 decodes = 0;           ///< Number of images decoded.
+        int64 deduplicatedLoads = 0; ///< Number of loads served by an existing request.
+    };
+
+    //==============================================================================
+    /** A reference to the result of an asynchronous load. */
+    class JUCE_API Handle
+    {
+    public:
+        /** Constructs an invalid handle. */
+        Handle() = default;
+
+        /** Returns true if the handle refers to a load. */
+        bool isValid() const noexcept { return request != nullptr; }
+
+        /** Returns true if the load has completed, successfully or not. */
+        bool isReady() const;
+
+        /** Waits for the load to complete.
+
+            @param timeOutMilliseconds The time to wait, or a negative value to wait forever.
+
+            @return True if the load has completed.
+        */
+        bool wait (int timeOutMilliseconds = -1) const;
+
+        /** Returns the result of the load, waiting for it to complete if needed. */
+        ResultValue<Image> getResult() const;
+
+        /** Registers a function to call once the load has completed.
+
+            If the load has already completed the callback is invoked right away, otherwise it will
+            be invoked on the worker thread that decoded the image.
+        */
+        void onComplete (Callback callback) const;
+
+    private:
+        friend class ImageLoader;
+
+        explicit Handle (std::shared_ptr<Request> requestToUse)
+            : request (std::move (requestToUse))
+        {
+        }
+
+        std::shared_ptr<Request> request;
+    };
+
+    //==============================================================================
+    /** Constructs a loader decoding on one worker thread per spare CPU, up to four. */
+    ImageLoader();
+
+    /** Constructs a loader decoding on a number of worker threads. */
+    explicit ImageLoader (int numThreads);
+
+    /** Destructor.
+
+        Loads still waiting to be decoded are completed with a failure.
+    */
+    ~ImageLoader();
+
+    //==============================================================================
+    /** Queues the decoding of an image.
+
+        @param imageData The encoded image, which is copied and can be released right away.
+
+        @return A handle to the result of the load.
+    */
+    Handle loadAsync (Span<const uint8> imageData);
+
+    /** Queues the decoding of an image, calling a function once it completes.
+
+        @param imageData The encoded image, which is copied and can be released right away.
+        @param callback The function to call with the result, on the worker thread decoding it.
+
+        @return A handle to the result of the load.
+    */
+    Handle loadAsync (Span<const uint8> imageData, Callback callback);
+
+    //==============================================================================
+    /** Forgets all the completed loads and resets the statistics. */
+    void clear();
+
+    /** Returns the statistics collected so far. */
+    Statistics getStatistics() const;
+
+    /** Returns the number of loads currently tracked for de-duplication. */
+    int getNumTrackedLoads() const;
+
+    //==============================================================================
+    /** The shared loader, whose worker threads are stopped when the windowing system shuts down. */
+    JUCE_DECLARE_SINGLETON (ImageLoader, false)
+
+private:
+    struct Request
+    {
+        Request (uint64 hashToUse, Span<const uint8> imageData);
+
+        bool isReady() const;
+        bool hasSameData (Span<const uint8> imageData) const noexcept;
+        void complete (ResultValue<Image> result);
+
+        const uint64 hash;
+        const MemoryBlock encodedData;
+
+        mutable CriticalSection lock;
+        WaitableEvent finished { true };
+        std::optional<ResultValue<Image>> result;
+        std::vector<Callback> callbacks;
+    };
+
+    static uint64 hashData (Span<const uint8> imageData) noexcept;
+    static bool isUnused (const std::shared_ptr<Request>& request);
+
+    void releaseUnusedRequests();
+
+    mutable CriticalSection lock;
+    std::unordered_multimap<uint64, std::shared_ptr<Request>> requests;
+    std::unique_ptr<ThreadPool> threadPool;
+    int numThreads = 1;
+
+    Statistics statistics;
+
+    JUCE_DECLARE_NON_COPYABLE (ImageLoader)
+};
+
+} // namespace yup
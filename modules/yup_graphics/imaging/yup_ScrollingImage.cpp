@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+namespace
+{
+
+//==============================================================================
+
+rive::rcp<rive::RenderBuffer> makeScrollingImageBuffer (rive::Factory& factory, rive::RenderBufferType type, const void* data, std::size_t sizeInBytes)
+{
+    auto buffer = factory.makeRenderBuffer (type, rive::RenderBufferFlags::mappedOnceAtInitialization, sizeInBytes);
+    if (buffer == nullptr)
+        return nullptr;
+
+    std::memcpy (buffer->map(), data, sizeInBytes);
+    buffer->unmap();
+
+    return buffer;
+}
+
+} // namespace
+
+//==============================================================================
+ScrollingImage::ScrollingImage (int width, int height)
+    : pixels (width, height, PixelFormat::RGBA)
+{
+    pixels.clear();
+}
+
+//==============================================================================
+void ScrollingImage::appendColumn (Span<const uint32> colors)
+{
+    const auto height = getHeight();
+    const auto numColors = jmin (height, static_cast<int> (colors.size()));
+    auto& bitmap = pixels.getBitmapData();
+
+    for (int y = 0; y < height; ++y)
+    {
+        auto pixel = bitmap.getLinePointer (y) + writePosition * 4;
+        const auto color = y < numColors ? colors[static_cast<std::size_t> (y)] : 0u;
+
+        pixel[0] = static_cast<uint8> ((color >> 24) & 0xff);
+        pixel[1] = static_cast<uint8> ((color >> 16) & 0xff);
+        pixel[2] = static_cast<uint8> ((color >> 8) & 0xff);
+        pixel[3] = static_cast<uint8> (color & 0xff);
+    }
+
+    markDirty (writePosition, 1);
+    writePosition = (writePosition + 1) % getWidth();
+}
+
+void ScrollingImage::appendColumns (const Image& columns)
+{
+    if (! columns.isValid())
+        return;
+
+    jassert (columns.getHeight() == getHeight());
+
+    const auto width = getWidth();
+    const auto numColumns = columns.getWidth();
+
+    // Only the last width columns are visible once all of them are appended
+    auto sourceX = jmax (0, numColumns - width);
+    writePosition = (writePosition + (sourceX % width)) % width;
+
+    while (sourceX < numColumns)
+    {
+        const auto chunk = jmin (numColumns - sourceX, width - writePosition);
+
+        pixels.blit (columns, { sourceX, 0, chunk, getHeight() }, { writePosition, 0 });
+        markDirty (writePosition, chunk);
+
+        sourceX += chunk;
+        writePosition = (writePosition + chunk) % width;
+    }
+}
+
+void ScrollingImage::fill (uint32 color)
+{
+    pixels.fill (color);
+    markDirty (0, getWidth());
+}
+
+//==============================================================================
+ScrollingImage::DrawData ScrollingImage::prepareForDrawing (GraphicsContext& context)
+{
+    if (renderImage == nullptr || renderContext != &context)
+        recreateRenderImage (context);
+    else
+        uploadDirtyColumns (context);
+
+    if (renderImage == nullptr)
+        return {};
+
+    updateMesh (context);
+
+    auto result = drawData;
+    result.image = renderImage.get();
+    return result;
+}
+
+//==============================================================================
+void ScrollingImage::markDirty (int firstColumn, int numColumns)
+{
+    const auto width = getWidth();
+
+    if (numDirtyColumns == 0)
+    {
+        dirtyStart = firstColumn;
+        numDirtyColumns = jmin (width, numColumns);
+        return;
+    }
+
+    // Columns are always written right after the previous ones, so the dirty range grows at its end
+    const auto dirtyEnd = (dirtyStart + numDirtyColumns) % width;
+
+    if (firstColumn == dirtyEnd)
+        numDirtyColumns = jmin (width, numDirtyColumns + numColumns);
+    else
+        numDirtyColumns = width;
+
+    if (numDirtyColumns == width)
+        dirtyStart = 0;
+}
+
+void ScrollingImage::uploadDirtyColumns (GraphicsContext& context)
+{
+    if (numDirtyColumns == 0)
+        return;
+
+    const auto width = getWidth();
+    const auto height = getHeight();
+
+    // A dirty range running past the right edge of the ring is uploaded as two areas
+    const auto firstPart = jmin (numDirtyColumns, width - dirtyStart);
+    const auto secondPart = numDirtyColumns - firstPart;
+
+    bool updated = context.updateRenderImage (*renderImage, pixels, { dirtyStart, 0, firstPart, height });
+
+    if (updated && secondPart > 0)
+        updated = context.updateRenderImage (*renderImage, pixels, { 0, 0, secondPart, height });
+
+    if (! updated)
+    {
+        recreateRenderImage (context);
+        return;
+    }
+
+    statistics.partialUploads += secondPart > 0 ? 2 : 1;
+    statistics.uploadedColumns += numDirtyColumns;
+
+    numDirtyColumns = 0;
+}
+
+void ScrollingImage::recreateRenderImage (GraphicsContext& context)
+{
+    // Keep the previous image alive, as draws already recorded in this frame can still refer to it
+    previousRenderImage = std::move (renderImage);
+
+    renderImage = context.makeUpdatableRenderImage (pixels);
+    renderContext = renderImage != nullptr ? &context : nullptr;
+    meshWritePosition = -1;
+
+    if (renderImage != nullptr)
+    {
+        ++statistics.fullUploads;
+        numDirtyColumns = 0;
+    }
+}
+
+void ScrollingImage::updateMesh (GraphicsContext& context)
+{
+    if (meshWritePosition == writePosition && drawData.vertices != nullptr)
+        return;
+
+    auto factory = context.factory();
+    if (factory == nullptr)
+        return;
+
+    const auto width = static_cast<float> (getWidth());
+    const auto height = static_cast<float> (getHeight());
+    const auto split = static_cast<float> (writePosition);
+
+    // The oldest columns, from the write position to the right edge of the ring, are displayed first
+    const float vertices[] = {
+        0.0f, 0.0f, width - split, 0.0f, width - split, height, 0.0f, height,
+        width - split, 0.0f, width, 0.0f, width, height, width - split, height
+    };
+
+    const float uvCoords[] = {
+        split / width, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, split / width, 1.0f,
+        0.0f, 0.0f, split / width, 0.0f, split / width, 1.0f, 0.0f, 1.0f
+    };
+
+    const uint16 indices[] = { 0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7 };
+
+    drawData.vertices = makeScrollingImageBuffer (*factory, rive::RenderBufferType::vertex, vertices, sizeof (vertices));
+    drawData.uvCoords = makeScrollingImageBuffer (*factory, rive::RenderBufferType::vertex, uvCoords, sizeof (uvCoords));
+    drawData.indices = makeScrollingImageBuffer (*factory, rive::RenderBufferType::index, indices, sizeof (indices));
+    drawData.vertexCount = 8;
+    drawData.indexCount = writePosition == 0 ? 6 : 12;
+
+    meshWritePosition = writePosition;
+}
+
+} // namespace yup
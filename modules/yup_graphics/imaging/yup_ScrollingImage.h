@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+/** An image that scrolls horizontally as columns of pixels are appended to it.
+
+    Real-time displays like spectrograms add a column of pixels for every analysis frame and scroll
+    the older ones to the left. Shifting a whole image and re-uploading it every frame wastes memory
+    bandwidth, so this keeps the columns in a ring: new columns overwrite the oldest ones in place,
+    only the columns written since the last draw are uploaded to the texture, and drawing maps the
+    two halves of the ring to their place on screen.
+
+    The render image is created from the first GraphicsContext drawing the image, using
+    GraphicsContext::makeUpdatableRenderImage. Contexts that can't update render images in place
+    fall back to recreating it whenever columns have been appended.
+
+    @see Graphics::drawScrollingImage
+*/
+class JUCE_API ScrollingImage
+{
+public:
+    //==============================================================================
+    /** Counters collected since the image was created. */
+    struct Statistics
+    {
+        int64 fullUploads = 0;     ///< Number of times the whole render image has been created.
+        int64 partialUploads = 0;  ///< Number of areas uploaded into the existing render image.
+        int64 uploadedColumns = 0; ///< Number of columns uploaded by the partial uploads.
+    };
+
+    //==============================================================================
+    /** Constructs an RGBA scrolling image, cleared to transparent black. */
+    ScrollingImage (int width, int height);
+
+    //==============================================================================
+    /** Returns the width of the image, in columns. */
+    int getWidth() const noexcept { return pixels.getWidth(); }
+
+    /** Returns the height of the image, in pixels. */
+    int getHeight() const noexcept { return pixels.getHeight(); }
+
+    /** Returns the column of the ring that will be overwritten by the next appended column.
+
+        This is also where the oldest column is stored, so it is the one displayed on the left.
+    */
+    int getWritePosition() const noexcept { return writePosition; }
+
+    /** Returns the ring of columns, with the oldest column at the write position. */
+    const Image& getImage() const noexcept { return pixels; }
+
+    //==============================================================================
+    /** Appends a column of pixels, scrolling the older ones to the left.
+
+        @param colors The colors of the column from top to bottom, packed like in Image::setPixel.
+                      Missing values leave the corresponding pixels transparent.
+    */
+    void appendColumn (Span<const uint32> colors);
+
+    /** Appends all the columns of an image, from left to right.
+
+        @param columns The columns to append, with the same height as this image. Formats other than
+                       RGBA are converted.
+    */
+    void appendColumns (const Image& columns);
+
+    /** Fills the whole image with a color. */
+    void fill (uint32 color);
+
+    //==============================================================================
+    /** What is needed to draw the image: its render image, and a mesh laying out the two halves of
+        the ring in image pixels.
+    */
+    struct DrawData
+    {
+        rive::RenderImage* image = nullptr;
+        rive::rcp<rive::RenderBuffer> vertices;
+        rive::rcp<rive::RenderBuffer> uvCoords;
+        rive::rcp<rive::RenderBuffer> indices;
+        uint32 vertexCount = 0;
+        uint32 indexCount = 0;
+    };
+
+    /** Uploads the columns written since the last call, and returns what is needed to draw the image.
+
+        This is called by Graphics::drawScrollingImage.
+
+        @return The data to draw with, with a null image if the context can't create render images.
+    */
+    DrawData prepareForDrawing (GraphicsContext& context);
+
+    /** Returns the statistics collected so far. */
+    Statistics getStatistics() const noexcept { return statistics; }
+
+private:
+    void markDirty (int firstColumn, int numColumns);
+    void uploadDirtyColumns (GraphicsContext& context);
+    void recreateRenderImage (GraphicsContext& context);
+    void updateMesh (GraphicsContext& context);
+
+    Image pixels;
+    int writePosition = 0;
+    int dirtyStart = 0;
+    int numDirtyColumns = 0;
+
+    GraphicsContext* renderContext = nullptr;
+    rive::rcp<rive::RenderImage> renderImage;
+    rive::rcp<rive::RenderImage> previousRenderImage;
+
+    DrawData drawData;
+    int meshWritePosition = -1;
+
+    Statistics statistics;
+
+    JUCE_DECLARE_NON_COPYABLE (ScrollingImage)
+};
+
+} // namespace yup
@@ -41,6 +41,11 @@ public:
     {
     }
 
+    ~LowLevelRenderContextD3D() override
+    {
+        releaseCachedResources();
+    }
+
     float dpiScale (void*) const override { return 1.0f; }
 
     rive::Factory* factory() override { return m_plsContext.get(); }
@@ -191,6 +191,11 @@ public:
                                                      PLSRenderContextWebGPUImpl::ContextOptions());
     }
 
+    ~LowLevelRenderContextDawnPLS() override
+    {
+        releaseCachedResources();
+    }
+
     float dpiScale (void* window) const override
     {
         return GetDawnWindowBackingScaleFactor (window, m_options.retinaDisplay);
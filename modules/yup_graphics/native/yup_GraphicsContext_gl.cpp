@@ -116,6 +116,23 @@ public:
 #endif
     }
 
+    ~LowLevelRenderContextGL() override
+    {
+        releaseCachedResources();
+
+        // Images still alive past this point keep a dangling id, but they can't be drawn without the context anyway
+        const ScopedLock sl (m_updatableTextures->lock);
+
+        for (const auto& updatable : m_updatableTextures->live)
+            glDeleteTextures (1, &updatable.textureID);
+
+        for (const auto textureID : m_updatableTextures->released)
+            glDeleteTextures (1, &textureID);
+
+        m_updatableTextures->live.clear();
+        m_updatableTextures->released.clear();
+    }
+
     float dpiScale (void*) const override
     {
 #if RIVE_DESKTOP_GL && __APPLE__
@@ -143,6 +160,8 @@ public:
 
     void begin (const rive::gpu::RenderContext::FrameDescriptor& frameDescriptor) override
     {
+        deleteReleasedUpdatableTextures();
+
         m_plsContext->static_impl_cast<rive::gpu::RenderContextGLImpl>()->invalidateGLState();
         m_plsContext->beginFrame (frameDescriptor);
     }
@@ -154,9 +173,160 @@ public:
         m_plsContext->static_impl_cast<rive::gpu::RenderContextGLImpl>()->unbindGLInternalResources();
     }
 
+    rive::rcp<rive::RenderImage> makeUpdatableRenderImage (const Image& image) override
+    {
+        if (! image.isValid() || image.getPixelFormat() != PixelFormat::RGBA)
+            return nullptr;
+
+        const auto width = image.getWidth();
+        const auto height = image.getHeight();
+
+        auto impl = m_plsContext->static_impl_cast<rive::gpu::RenderContextGLImpl>();
+        const auto& capabilities = impl->capabilities();
+
+        // Create the texture here instead of through the render context, so we know its id to update it later
+        GLuint textureID = 0;
+        glGenTextures (1, &textureID);
+        glBindTexture (GL_TEXTURE_2D, textureID);
+
+        // Immutable storage needs GL 4.2 or GLES 3.0
+        if (capabilities.isContextVersionAtLeast (capabilities.isGLES ? 3 : 4, capabilities.isGLES ? 0 : 2))
+            glTexStorage2D (GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+        else
+            glTexImage2D (GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+        glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        auto texture = impl->adoptImageTexture (static_cast<uint32_t> (width), static_cast<uint32_t> (height), textureID);
+
+        {
+            const ScopedLock sl (m_updatableTextures->lock);
+            m_updatableTextures->live.push_back ({ texture.get(), textureID });
+        }
+
+        uploadArea (textureID, image, { 0, 0, width, height });
+
+        return rive::make_rcp<UpdatableRenderImage> (std::move (texture), textureID, m_updatableTextures);
+    }
+
+    bool updateRenderImage (rive::RenderImage& renderImage, const Image& image, const Rectangle<int>& area) override
+    {
+        auto riveImage = rive::lite_rtti_cast<rive::RiveRenderImage*> (&renderImage);
+        if (riveImage == nullptr || ! image.isValid() || image.getPixelFormat() != PixelFormat::RGBA)
+            return false;
+
+        GLuint textureID = 0;
+
+        {
+            const ScopedLock sl (m_updatableTextures->lock);
+
+            for (const auto& updatable : m_updatableTextures->live)
+            {
+                if (updatable.texture == riveImage->getTexture())
+                {
+                    textureID = updatable.textureID;
+                    break;
+                }
+            }
+        }
+
+        if (textureID == 0)
+            return false;
+
+        uploadArea (textureID, image, area.intersection ({ 0, 0, image.getWidth(), image.getHeight() }));
+        return true;
+    }
+
 private:
+    /** The textures created for updatable images, shared with the images so they can hand theirs back. */
+    struct UpdatableTextures
+    {
+        struct Entry
+        {
+            const rive::gpu::Texture* texture = nullptr;
+            GLuint textureID = 0;
+        };
+
+        CriticalSection lock;
+        std::vector<Entry> live;
+        std::vector<GLuint> released;
+    };
+
+    /** A render image owning the GL texture that the adopted rive texture only refers to. */
+    class UpdatableRenderImage : public rive::RiveRenderImage
+    {
+    public:
+        UpdatableRenderImage (rive::rcp<rive::gpu::Texture> texture, GLuint textureIDToUse, std::weak_ptr<UpdatableTextures> ownerToUse)
+            : rive::RiveRenderImage (std::move (texture))
+            , textureID (textureIDToUse)
+            , owner (std::move (ownerToUse))
+        {
+        }
+
+        ~UpdatableRenderImage() override
+        {
+            // The texture might still be referenced by a frame being recorded, so it is deleted at the next begin
+            if (auto textures = owner.lock())
+            {
+                const ScopedLock sl (textures->lock);
+
+                auto& live = textures->live;
+                live.erase (std::remove_if (live.begin(), live.end(), [this] (const auto& entry) { return entry.textureID == textureID; }), live.end());
+
+                textures->released.push_back (textureID);
+            }
+        }
+
+    private:
+        const GLuint textureID;
+        const std::weak_ptr<UpdatableTextures> owner;
+    };
+
+    void uploadArea (GLuint textureID, const Image& image, const Rectangle<int>& area)
+    {
+        if (area.isEmpty())
+            return;
+
+        const auto& bitmap = image.getBitmapData();
+        auto impl = m_plsContext->static_impl_cast<rive::gpu::RenderContextGLImpl>();
+
+        impl->state()->bindBuffer (GL_PIXEL_UNPACK_BUFFER, 0);
+        glBindTexture (GL_TEXTURE_2D, textureID);
+        glPixelStorei (GL_UNPACK_ROW_LENGTH, bitmap.getWidth());
+        glTexSubImage2D (GL_TEXTURE_2D,
+                         0,
+                         area.getX(),
+                         area.getY(),
+                         area.getWidth(),
+                         area.getHeight(),
+                         GL_RGBA,
+                         GL_UNSIGNED_BYTE,
+                         bitmap.getLinePointer (area.getY()) + area.getX() * bitmap.getPixelStride());
+        glPixelStorei (GL_UNPACK_ROW_LENGTH, 0);
+
+        // The texture binding went around rive's cached state, so make it rebind what it needs
+        impl->invalidateGLState();
+    }
+
+    void deleteReleasedUpdatableTextures()
+    {
+        std::vector<GLuint> released;
+
+        {
+            const ScopedLock sl (m_updatableTextures->lock);
+            released.swap (m_updatableTextures->released);
+        }
+
+        if (! released.empty())
+            glDeleteTextures (static_cast<GLsizei> (released.size()), released.data());
+    }
+
     std::unique_ptr<rive::gpu::RenderContext> m_plsContext;
     rive::rcp<rive::gpu::RenderTargetGL> m_renderTarget;
+    std::shared_ptr<UpdatableTextures> m_updatableTextures = std::make_shared<UpdatableTextures>();
 };
 
 std::unique_ptr<GraphicsContext> juce_constructOpenGLGraphicsContext (GraphicsContext::Options)
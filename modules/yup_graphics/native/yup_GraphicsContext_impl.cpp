@@ -22,6 +22,44 @@
 namespace yup
 {
 
+//==============================================================================
+rive::rcp<rive::RenderImage> GraphicsContext::makeUpdatableRenderImage (const Image& image)
+{
+    if (! image.isValid() || image.getPixelFormat() != PixelFormat::RGBA)
+        return nullptr;
+
+    auto renderContext = renderContextOrNull();
+    if (renderContext == nullptr)
+        return makeRenderImage (image);
+
+    if (renderContext->impl() == nullptr)
+        return nullptr;
+
+    auto texture = renderContext->impl()->makeImageTexture (
+        static_cast<uint32_t> (image.getWidth()),
+        static_cast<uint32_t> (image.getHeight()),
+        1,
+        image.getRawData().data());
+
+    if (texture == nullptr)
+        return nullptr;
+
+    return rive::make_rcp<rive::RiveRenderImage> (std::move (texture));
+}
+
+bool GraphicsContext::updateRenderImage (rive::RenderImage&, const Image&, const Rectangle<int>&)
+{
+    return false;
+}
+
+//==============================================================================
+void GraphicsContext::releaseCachedResources()
+{
+    renderCache.clear();
+    imageAtlas.clear();
+}
+
+//==============================================================================
 std::unique_ptr<GraphicsContext> GraphicsContext::createContext (Api graphicsApi, Options options)
 {
     switch (graphicsApi)
@@ -46,6 +84,9 @@ std::unique_ptr<GraphicsContext> GraphicsContext::createContext (Api graphicsApi
             return juce_constructDawnGraphicsContext (options);
 #endif
 
+        case Api::Software:
+            return juce_constructSoftwareGraphicsContext (options);
+
         default:
             Logger::outputDebugString ("Invalid API requested for current platform");
             return nullptr;
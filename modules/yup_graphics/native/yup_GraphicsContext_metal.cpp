@@ -44,6 +44,11 @@ public:
         m_plsContext = rive::gpu::RenderContextMetalImpl::MakeContext (m_gpu, metalOptions);
     }
 
+    ~LowLevelRenderContextMetal() override
+    {
+        releaseCachedResources();
+    }
+
     float dpiScale (void* window) const override
     {
 #if TARGET_OS_IOS
@@ -0,0 +1,1792 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <utils/factory_utils.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define YUP_SOFTWARE_RENDERER_USE_SSE2 1
+#endif
+
+namespace yup
+{
+
+namespace detail
+{
+
+//==============================================================================
+// Pixels are stored premultiplied, as 4 bytes in R, G, B, A memory order.
+
+constexpr float flatteningTolerance = 0.2f;
+constexpr float strokeMiterLimit = 4.0f;
+constexpr int rowsPerBand = 32;
+
+inline uint32 mulDiv255 (uint32 a, uint32 b) noexcept
+{
+    const auto t = a * b + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+inline uint32 packPixel (uint32 r, uint32 g, uint32 b, uint32 a) noexcept
+{
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+inline uint32 pixelAlpha (uint32 pixel) noexcept
+{
+    return pixel >> 24;
+}
+
+inline uint32 premultipliedFromARGB (uint32 argb) noexcept
+{
+    const auto a = argb >> 24;
+    return packPixel (mulDiv255 ((argb >> 16) & 0xff, a), mulDiv255 ((argb >> 8) & 0xff, a), mulDiv255 (argb & 0xff, a), a);
+}
+
+inline uint32 scalePixel (uint32 pixel, uint32 amount) noexcept
+{
+    auto rb = (pixel & 0x00ff00ff) * amount + 0x00800080;
+    auto ga = ((pixel >> 8) & 0x00ff00ff) * amount + 0x00800080;
+
+    rb = ((rb + ((rb >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+    ga = ((ga + ((ga >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+
+    return rb | (ga << 8);
+}
+
+inline uint32 blendPixel (uint32 dst, uint32 src) noexcept
+{
+    return src + scalePixel (dst, 255 - pixelAlpha (src));
+}
+
+//==============================================================================
+#if YUP_SOFTWARE_RENDERER_USE_SSE2
+inline __m128i mulDiv255Epi16 (__m128i a, __m128i b) noexcept
+{
+    const auto t = _mm_add_epi16 (_mm_mullo_epi16 (a, b), _mm_set1_epi16 (128));
+    return _mm_srli_epi16 (_mm_add_epi16 (t, _mm_srli_epi16 (t, 8)), 8);
+}
+
+inline __m128i broadcastAlphaEpi16 (__m128i pixels) noexcept
+{
+    return _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (pixels, _MM_SHUFFLE (3, 3, 3, 3)), _MM_SHUFFLE (3, 3, 3, 3));
+}
+
+inline __m128i expandCoverage (const uint8* coverage) noexcept
+{
+    int32 packed;
+    std::memcpy (&packed, coverage, sizeof (packed));
+
+    auto c = _mm_cvtsi32_si128 (packed);
+    c = _mm_unpacklo_epi8 (c, c);
+    return _mm_unpacklo_epi16 (c, c);
+}
+
+inline __m128i blendPixelsEpi8 (__m128i dst, __m128i src, __m128i coverage) noexcept
+{
+    const auto zero = _mm_setzero_si128();
+    const auto full = _mm_set1_epi16 (255);
+
+    const auto srcLo = mulDiv255Epi16 (_mm_unpacklo_epi8 (src, zero), _mm_unpacklo_epi8 (coverage, zero));
+    const auto srcHi = mulDiv255Epi16 (_mm_unpackhi_epi8 (src, zero), _mm_unpackhi_epi8 (coverage, zero));
+
+    const auto dstLo = mulDiv255Epi16 (_mm_unpacklo_epi8 (dst, zero), _mm_sub_epi16 (full, broadcastAlphaEpi16 (srcLo)));
+    const auto dstHi = mulDiv255Epi16 (_mm_unpackhi_epi8 (dst, zero), _mm_sub_epi16 (full, broadcastAlphaEpi16 (srcHi)));
+
+    return _mm_packus_epi16 (_mm_add_epi16 (srcLo, dstLo), _mm_add_epi16 (srcHi, dstHi));
+}
+#endif
+
+//==============================================================================
+/** Composites a solid premultiplied color over a span of pixels, modulated by per pixel coverage. */
+void compositeSolidSpan (uint32* dst, uint32 src, const uint8* coverage, int count) noexcept
+{
+    const bool isOpaque = pixelAlpha (src) == 255;
+    int i = 0;
+
+#if YUP_SOFTWARE_RENDERER_USE_SSE2
+    const auto srcPixels = _mm_set1_epi32 (static_cast<int> (src));
+
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32 packedCoverage;
+        std::memcpy (&packedCoverage, coverage + i, sizeof (packedCoverage));
+
+        if (packedCoverage == 0)
+            continue;
+
+        auto* dstPixels = reinterpret_cast<__m128i*> (dst + i);
+
+        if (isOpaque && packedCoverage == 0xffffffff)
+        {
+            _mm_storeu_si128 (dstPixels, srcPixels);
+            continue;
+        }
+
+        _mm_storeu_si128 (dstPixels, blendPixelsEpi8 (_mm_loadu_si128 (dstPixels), srcPixels, expandCoverage (coverage + i)));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        const uint32 c = coverage[i];
+
+        if (c == 255)
+            dst[i] = isOpaque ? src : blendPixel (dst[i], src);
+        else if (c != 0)
+            dst[i] = blendPixel (dst[i], scalePixel (src, c));
+    }
+}
+
+/** Composites a span of premultiplied source pixels, modulated by per pixel coverage. */
+void compositeSpan (uint32* dst, const uint32* src, const uint8* coverage, int count) noexcept
+{
+    int i = 0;
+
+#if YUP_SOFTWARE_RENDERER_USE_SSE2
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32 packedCoverage;
+        std::memcpy (&packedCoverage, coverage + i, sizeof (packedCoverage));
+
+        if (packedCoverage == 0)
+            continue;
+
+        auto* dstPixels = reinterpret_cast<__m128i*> (dst + i);
+        const auto srcPixels = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + i));
+
+        _mm_storeu_si128 (dstPixels, blendPixelsEpi8 (_mm_loadu_si128 (dstPixels), srcPixels, expandCoverage (coverage + i)));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        const uint32 c = coverage[i];
+
+        if (c == 255)
+            dst[i] = blendPixel (dst[i], src[i]);
+        else if (c != 0)
+            dst[i] = blendPixel (dst[i], scalePixel (src[i], c));
+    }
+}
+
+//==============================================================================
+// Blend modes other than srcOver follow the W3C compositing formulas, working on unpremultiplied
+// colors in the 0 to 1 range and composited back with: co = cs * (1 - ab) + cb * (1 - as) + as * ab * B (Cb, Cs)
+
+struct BlendColor
+{
+    float r, g, b;
+};
+
+inline float blendChannel (rive::BlendMode mode, float cb, float cs) noexcept
+{
+    const auto screen = [] (float b, float s) { return b + s - b * s; };
+
+    const auto hardLight = [&screen] (float b, float s)
+    {
+        return s <= 0.5f ? b * 2.0f * s : screen (b, 2.0f * s - 1.0f);
+    };
+
+    switch (mode)
+    {
+        case rive::BlendMode::screen:
+            return screen (cb, cs);
+
+        case rive::BlendMode::overlay:
+            return hardLight (cs, cb);
+
+        case rive::BlendMode::darken:
+            return jmin (cb, cs);
+
+        case rive::BlendMode::lighten:
+            return jmax (cb, cs);
+
+        case rive::BlendMode::colorDodge:
+            if (cb <= 0.0f)
+                return 0.0f;
+            return cs >= 1.0f ? 1.0f : jmin (1.0f, cb / (1.0f - cs));
+
+        case rive::BlendMode::colorBurn:
+            if (cb >= 1.0f)
+                return 1.0f;
+            return cs <= 0.0f ? 0.0f : 1.0f - jmin (1.0f, (1.0f - cb) / cs);
+
+        case rive::BlendMode::hardLight:
+            return hardLight (cb, cs);
+
+        case rive::BlendMode::softLight:
+        {
+            if (cs <= 0.5f)
+                return cb - (1.0f - 2.0f * cs) * cb * (1.0f - cb);
+
+            const auto d = cb <= 0.25f ? ((16.0f * cb - 12.0f) * cb + 4.0f) * cb : std::sqrt (cb);
+            return cb + (2.0f * cs - 1.0f) * (d - cb);
+        }
+
+        case rive::BlendMode::difference:
+            return std::abs (cb - cs);
+
+        case rive::BlendMode::exclusion:
+            return cb + cs - 2.0f * cb * cs;
+
+        case rive::BlendMode::multiply:
+            return cb * cs;
+
+        default:
+            return cs;
+    }
+}
+
+inline float luminosity (BlendColor c) noexcept
+{
+    return 0.3f * c.r + 0.59f * c.g + 0.11f * c.b;
+}
+
+inline float saturation (BlendColor c) noexcept
+{
+    return jmax (c.r, c.g, c.b) - jmin (c.r, c.g, c.b);
+}
+
+inline BlendColor withLuminosity (BlendColor c, float l) noexcept
+{
+    const auto d = l - luminosity (c);
+    c = { c.r + d, c.g + d, c.b + d };
+
+    const auto lum = luminosity (c);
+    const auto n = jmin (c.r, c.g, c.b);
+    const auto x = jmax (c.r, c.g, c.b);
+
+    const auto clip = [&] (float v)
+    {
+        if (n < 0.0f)
+            v = lum + (v - lum) * lum / (lum - n);
+
+        if (x > 1.0f)
+            v = lum + (v - lum) * (1.0f - lum) / (x - lum);
+
+        return v;
+    };
+
+    return { clip (c.r), clip (c.g), clip (c.b) };
+}
+
+inline BlendColor withSaturation (BlendColor c, float s) noexcept
+{
+    const auto n = jmin (c.r, c.g, c.b);
+    const auto x = jmax (c.r, c.g, c.b);
+
+    if (x <= n)
+        return { 0.0f, 0.0f, 0.0f };
+
+    const auto scale = [&] (float v) { return (v - n) * s / (x - n); };
+    return { scale (c.r), scale (c.g), scale (c.b) };
+}
+
+inline BlendColor blendColors (rive::BlendMode mode, BlendColor cb, BlendColor cs) noexcept
+{
+    switch (mode)
+    {
+        case rive::BlendMode::hue:
+            return withLuminosity (withSaturation (cs, saturation (cb)), luminosity (cb));
+
+        case rive::BlendMode::saturation:
+            return withLuminosity (withSaturation (cb, saturation (cs)), luminosity (cb));
+
+        case rive::BlendMode::color:
+            return withLuminosity (cs, luminosity (cb));
+
+        case rive::BlendMode::luminosity:
+            return withLuminosity (cb, luminosity (cs));
+
+        default:
+            return { blendChannel (mode, cb.r, cs.r), blendChannel (mode, cb.g, cs.g), blendChannel (mode, cb.b, cs.b) };
+    }
+}
+
+inline uint32 blendPixelWithMode (uint32 dst, uint32 src, rive::BlendMode mode) noexcept
+{
+    const auto sa = pixelAlpha (src);
+    if (sa == 0)
+        return dst;
+
+    const auto da = pixelAlpha (dst);
+    const auto as = static_cast<float> (sa) / 255.0f;
+    const auto ab = static_cast<float> (da) / 255.0f;
+
+    const auto channel = [] (uint32 pixel, int shift) { return static_cast<float> ((pixel >> shift) & 0xff) / 255.0f; };
+    const BlendColor s { channel (src, 0), channel (src, 8), channel (src, 16) };
+    const BlendColor b { channel (dst, 0), channel (dst, 8), channel (dst, 16) };
+
+    const auto unpremultiply = [] (BlendColor c, float a) -> BlendColor
+    {
+        if (a <= 0.0f)
+            return { 0.0f, 0.0f, 0.0f };
+
+        return { jmin (1.0f, c.r / a), jmin (1.0f, c.g / a), jmin (1.0f, c.b / a) };
+    };
+
+    const auto blended = blendColors (mode, unpremultiply (b, ab), unpremultiply (s, as));
+
+    const auto compose = [&] (float cs, float cb, float value)
+    {
+        const auto result = cs * (1.0f - ab) + cb * (1.0f - as) + as * ab * value;
+        return static_cast<uint32> (jlimit (0.0f, 1.0f, result) * 255.0f + 0.5f);
+    };
+
+    return packPixel (compose (s.r, b.r, blended.r),
+                      compose (s.g, b.g, blended.g),
+                      compose (s.b, b.b, blended.b),
+                      sa + da - mulDiv255 (sa, da));
+}
+
+/** Composites a span of premultiplied source pixels with a blend mode other than srcOver, modulated by per pixel coverage. */
+void compositeBlendSpan (uint32* dst, const uint32* src, const uint8* coverage, int count, rive::BlendMode mode) noexcept
+{
+    for (int i = 0; i < count; ++i)
+    {
+        const uint32 c = coverage[i];
+
+        if (c == 255)
+            dst[i] = blendPixelWithMode (dst[i], src[i], mode);
+        else if (c != 0)
+            dst[i] = blendPixelWithMode (dst[i], scalePixel (src[i], c), mode);
+    }
+}
+
+/** Multiplies a span of coverage values by another one. */
+void multiplyCoverage (uint8* dst, const uint8* src, int count) noexcept
+{
+    for (int i = 0; i < count; ++i)
+        dst[i] = static_cast<uint8> (mulDiv255 (dst[i], src[i]));
+}
+
+//==============================================================================
+struct Edge
+{
+    float x0, y0, x1, y1;
+};
+
+/** Accumulates the signed area covered by line segments into a buffer of cells.
+
+    Each row of the buffer holds width + 2 cells: once the cells of a row are summed from left to
+    right, the running sum is the winding number of the pixel, with fractional values on the edges.
+*/
+class CoverageAccumulator
+{
+public:
+    void prepare (int newWidth, int newHeight)
+    {
+        width = newWidth;
+        height = newHeight;
+        stride = newWidth + 2;
+
+        const auto size = static_cast<std::size_t> (stride * newHeight);
+        if (cells.size() < size)
+            cells.resize (size, 0.0f);
+    }
+
+    void addLine (float x0, float y0, float x1, float y1) noexcept
+    {
+        if (y0 == y1 || (y0 <= 0.0f && y1 <= 0.0f) || (y0 >= height && y1 >= height))
+            return;
+
+        // Split the line where it crosses the left and right boundaries, and flatten the parts outside
+        const auto maxX = static_cast<float> (width);
+
+        float splits[2];
+        int numSplits = 0;
+
+        if ((x0 < 0.0f) != (x1 < 0.0f))
+            splits[numSplits++] = (0.0f - x0) / (x1 - x0);
+
+        if ((x0 > maxX) != (x1 > maxX))
+            splits[numSplits++] = (maxX - x0) / (x1 - x0);
+
+        if (numSplits == 2 && splits[0] > splits[1])
+            std::swap (splits[0], splits[1]);
+
+        float lastX = x0, lastY = y0;
+
+        for (int i = 0; i <= numSplits; ++i)
+        {
+            const auto x = i < numSplits ? x0 + (x1 - x0) * splits[i] : x1;
+            const auto y = i < numSplits ? y0 + (y1 - y0) * splits[i] : y1;
+
+            addClampedLine (jlimit (0.0f, maxX, lastX), lastY, jlimit (0.0f, maxX, x), y);
+
+            lastX = x;
+            lastY = y;
+        }
+    }
+
+    /** Converts a row of accumulated cells into 8 bit coverage, and clears the cells for the next use. */
+    void resolveRow (int row, uint8* coverage, bool evenOdd) noexcept
+    {
+        auto* rowCells = cells.data() + row * stride;
+        float accumulated = 0.0f;
+
+        if (evenOdd)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                accumulated += rowCells[x];
+                rowCells[x] = 0.0f;
+
+                auto value = std::fmod (std::abs (accumulated), 2.0f);
+                if (value > 1.0f)
+                    value = 2.0f - value;
+
+                coverage[x] = static_cast<uint8> (value * 255.0f + 0.5f);
+            }
+        }
+        else
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                accumulated += rowCells[x];
+                rowCells[x] = 0.0f;
+
+                coverage[x] = static_cast<uint8> (jmin (1.0f, std::abs (accumulated)) * 255.0f + 0.5f);
+            }
+        }
+
+        rowCells[width] = 0.0f;
+        rowCells[width + 1] = 0.0f;
+    }
+
+private:
+    void addClampedLine (float x0, float y0, float x1, float y1) noexcept
+    {
+        if (y0 == y1)
+            return;
+
+        float direction = 1.0f;
+        if (y0 > y1)
+        {
+            std::swap (x0, x1);
+            std::swap (y0, y1);
+            direction = -1.0f;
+        }
+
+        const auto dxdy = (x1 - x0) / (y1 - y0);
+        auto x = x0;
+
+        if (y0 < 0.0f)
+            x -= y0 * dxdy;
+
+        const auto startRow = jmax (0, static_cast<int> (y0));
+        const auto endRow = jmin (height, static_cast<int> (std::ceil (y1)));
+
+        for (int row = startRow; row < endRow; ++row)
+        {
+            auto* rowCells = cells.data() + row * stride;
+
+            const auto dy = jmin (static_cast<float> (row + 1), y1) - jmax (static_cast<float> (row), y0);
+            const auto xNext = x + dxdy * dy;
+            const auto d = dy * direction;
+
+            const auto left = jmin (x, xNext);
+            const auto right = jmax (x, xNext);
+            const auto leftFloor = std::floor (left);
+            const auto leftIndex = static_cast<int> (leftFloor);
+            const auto rightCeil = std::ceil (right);
+            const auto rightIndex = static_cast<int> (rightCeil);
+
+            if (rightIndex <= leftIndex + 1)
+            {
+                const auto xMid = 0.5f * (x + xNext) - leftFloor;
+                rowCells[leftIndex] += d - d * xMid;
+                rowCells[leftIndex + 1] += d * xMid;
+            }
+            else
+            {
+                const auto s = 1.0f / (right - left);
+                const auto leftFraction = left - leftFloor;
+                const auto a0 = 0.5f * s * (1.0f - leftFraction) * (1.0f - leftFraction);
+                const auto rightFraction = right - rightCeil + 1.0f;
+                const auto am = 0.5f * s * rightFraction * rightFraction;
+
+                rowCells[leftIndex] += d * a0;
+
+                if (rightIndex == leftIndex + 2)
+                {
+                    rowCells[leftIndex + 1] += d * (1.0f - a0 - am);
+                }
+                else
+                {
+                    const auto a1 = s * (1.5f - leftFraction);
+                    rowCells[leftIndex + 1] += d * (a1 - a0);
+
+                    for (int i = leftIndex + 2; i < rightIndex - 1; ++i)
+                        rowCells[i] += d * s;
+
+                    const auto a2 = a1 + static_cast<float> (rightIndex - leftIndex - 3) * s;
+                    rowCells[rightIndex - 1] += d * (1.0f - a2 - am);
+                }
+
+                rowCells[rightIndex] += d * am;
+            }
+
+            x = xNext;
+        }
+    }
+
+    std::vector<float> cells;
+    int width = 0;
+    int height = 0;
+    int stride = 0;
+};
+
+//==============================================================================
+class SoftwareRenderPath : public rive::RenderPath
+{
+public:
+    SoftwareRenderPath() = default;
+
+    SoftwareRenderPath (rive::RawPath& path, rive::FillRule rule)
+        : fillRuleValue (rule)
+    {
+        rawPath.swap (path);
+    }
+
+    void rewind() override { rawPath.rewind(); }
+    void fillRule (rive::FillRule value) override { fillRuleValue = value; }
+
+    void moveTo (float x, float y) override { rawPath.moveTo (x, y); }
+    void lineTo (float x, float y) override { rawPath.lineTo (x, y); }
+    void cubicTo (float ox, float oy, float ix, float iy, float x, float y) override { rawPath.cubicTo (ox, oy, ix, iy, x, y); }
+    void close() override { rawPath.close(); }
+
+    void addRenderPath (rive::RenderPath* path, const rive::Mat2D& transform) override
+    {
+        rawPath.addPath (static_cast<SoftwareRenderPath*> (path)->rawPath, &transform);
+    }
+
+    const rive::RawPath& getRawPath() const noexcept { return rawPath; }
+    rive::FillRule getFillRule() const noexcept { return fillRuleValue; }
+
+private:
+    rive::RawPath rawPath;
+    rive::FillRule fillRuleValue = rive::FillRule::nonZero;
+};
+
+//==============================================================================
+class SoftwareRenderShader : public rive::RenderShader
+{
+public:
+    enum class Type
+    {
+        linear,
+        radial
+    };
+
+    SoftwareRenderShader (Type type, float x0, float y0, float x1, float y1, float radius, const rive::ColorInt colors[], const float stops[], size_t count)
+        : type (type)
+        , startX (x0)
+        , startY (y0)
+        , endX (x1)
+        , endY (y1)
+        , radius (radius)
+    {
+        buildLookupTable (colors, stops, count);
+    }
+
+    /** Fills a span of premultiplied pixels by evaluating the gradient at the centers of the device pixels. */
+    void fillSpan (uint32* dst, int x, int y, int count, const rive::Mat2D& deviceToLocal) const noexcept
+    {
+        auto local = deviceToLocal * rive::Vec2D (static_cast<float> (x) + 0.5f, static_cast<float> (y) + 0.5f);
+        const auto step = rive::Vec2D (deviceToLocal.xx(), deviceToLocal.xy());
+
+        if (type == Type::linear)
+        {
+            const auto dx = endX - startX;
+            const auto dy = endY - startY;
+            const auto lengthSquared = dx * dx + dy * dy;
+            const auto scale = lengthSquared > 0.0f ? 1.0f / lengthSquared : 0.0f;
+
+            auto t = ((local.x - startX) * dx + (local.y - startY) * dy) * scale;
+            const auto dt = (step.x * dx + step.y * dy) * scale;
+
+            for (int i = 0; i < count; ++i, t += dt)
+                dst[i] = lookup (t);
+        }
+        else
+        {
+            const auto scale = radius > 0.0f ? 1.0f / radius : 0.0f;
+
+            for (int i = 0; i < count; ++i, local += step)
+            {
+                const auto dx = local.x - startX;
+                const auto dy = local.y - startY;
+                dst[i] = lookup (std::sqrt (dx * dx + dy * dy) * scale);
+            }
+        }
+    }
+
+private:
+    uint32 lookup (float t) const noexcept
+    {
+        return lookupTable[static_cast<std::size_t> (jlimit (0.0f, 1.0f, t) * 255.0f + 0.5f)];
+    }
+
+    void buildLookupTable (const rive::ColorInt colors[], const float stops[], size_t count)
+    {
+        if (count == 0)
+        {
+            lookupTable.fill (0);
+            return;
+        }
+
+        for (std::size_t i = 0; i < lookupTable.size(); ++i)
+        {
+            const auto t = static_cast<float> (i) / 255.0f;
+
+            std::size_t next = 0;
+            while (next < count && jlimit (0.0f, 1.0f, stops[next]) < t)
+                ++next;
+
+            if (next == 0 || next == count)
+            {
+                lookupTable[i] = premultipliedFromARGB (colors[next == 0 ? 0 : count - 1]);
+                continue;
+            }
+
+            const auto t0 = jlimit (0.0f, 1.0f, stops[next - 1]);
+            const auto t1 = jlimit (0.0f, 1.0f, stops[next]);
+            const auto alpha = t1 > t0 ? (t - t0) / (t1 - t0) : 1.0f;
+
+            const auto c0 = colors[next - 1];
+            const auto c1 = colors[next];
+
+            const auto mix = [alpha] (uint32 a, uint32 b, int shift)
+            {
+                const auto va = static_cast<float> ((a >> shift) & 0xff);
+                const auto vb = static_cast<float> ((b >> shift) & 0xff);
+                return static_cast<uint32> (va + (vb - va) * alpha + 0.5f);
+            };
+
+            lookupTable[i] = premultipliedFromARGB ((mix (c0, c1, 24) << 24) | (mix (c0, c1, 16) << 16) | (mix (c0, c1, 8) << 8) | mix (c0, c1, 0));
+        }
+    }
+
+    Type type;
+    float startX, startY, endX, endY, radius;
+    std::array<uint32, 256> lookupTable;
+};
+
+//==============================================================================
+class SoftwareRenderImage : public rive::RenderImage
+{
+public:
+    explicit SoftwareRenderImage (Image imageToUse)
+        : image (std::move (imageToUse))
+    {
+        m_Width = image.getWidth();
+        m_Height = image.getHeight();
+    }
+
+    /** Returns true if the render image samples the pixels of an image. */
+    bool isUsingPixelsOf (const Image& other) const noexcept
+    {
+        return other.isValid() && &other.getBitmapData() == &image.getBitmapData();
+    }
+
+    /** Fills a span of premultiplied pixels by bilinearly sampling the image at the centers of the device pixels. */
+    void fillSpan (uint32* dst, int x, int y, int count, const rive::Mat2D& deviceToImage, uint32 opacity) const noexcept
+    {
+        const auto& bitmap = image.getBitmapData();
+        const auto* pixels = bitmap.getRawData().data();
+        const auto format = bitmap.getPixelFormat();
+        const auto pixelStride = bitmap.getPixelStride();
+        const auto maxX = m_Width - 1;
+        const auto maxY = m_Height - 1;
+
+        const auto fetch = [&] (int px, int py) -> uint32
+        {
+            const auto* p = pixels + (static_cast<std::size_t> (jlimit (0, maxY, py)) * static_cast<std::size_t> (m_Width) + static_cast<std::size_t> (jlimit (0, maxX, px))) * static_cast<std::size_t> (pixelStride);
+
+            switch (format)
+            {
+                case PixelFormat::RGBA:
+                    return packPixel (mulDiv255 (p[0], p[3]), mulDiv255 (p[1], p[3]), mulDiv255 (p[2], p[3]), p[3]);
+
+                case PixelFormat::RGB:
+                    return packPixel (p[0], p[1], p[2], 255);
+
+                case PixelFormat::Grayscale:
+                default:
+                    return packPixel (p[0], p[0], p[0], 255);
+            }
+        };
+
+        auto local = deviceToImage * rive::Vec2D (static_cast<float> (x) + 0.5f, static_cast<float> (y) + 0.5f);
+        const auto step = rive::Vec2D (deviceToImage.xx(), deviceToImage.xy());
+
+        for (int i = 0; i < count; ++i, local += step)
+        {
+            const auto sx = local.x - 0.5f;
+            const auto sy = local.y - 0.5f;
+            const auto fx = std::floor (sx);
+            const auto fy = std::floor (sy);
+            const auto px = static_cast<int> (fx);
+            const auto py = static_cast<int> (fy);
+            const auto wx = static_cast<uint32> ((sx - fx) * 255.0f + 0.5f);
+            const auto wy = static_cast<uint32> ((sy - fy) * 255.0f + 0.5f);
+
+            const auto top = scalePixel (fetch (px, py), 255 - wx) + scalePixel (fetch (px + 1, py), wx);
+            const auto bottom = scalePixel (fetch (px, py + 1), 255 - wx) + scalePixel (fetch (px + 1, py + 1), wx);
+
+            dst[i] = scalePixel (scalePixel (top, 255 - wy) + scalePixel (bottom, wy), opacity);
+        }
+    }
+
+private:
+    Image image;
+};
+
+//==============================================================================
+class SoftwareRenderPaint : public rive::RenderPaint
+{
+public:
+    void style (rive::RenderPaintStyle value) override { paintStyle = value; }
+    void color (rive::ColorInt value) override { paintColor = value; }
+    void thickness (float value) override { strokeThickness = value; }
+    void join (rive::StrokeJoin value) override { strokeJoin = value; }
+    void cap (rive::StrokeCap value) override { strokeCap = value; }
+    void blendMode (rive::BlendMode value) override { paintBlendMode = value; }
+    void shader (rive::rcp<rive::RenderShader> value) override { paintShader = std::move (value); }
+    void invalidateStroke() override {}
+
+    rive::RenderPaintStyle paintStyle = rive::RenderPaintStyle::fill;
+    rive::ColorInt paintColor = 0xff000000;
+    float strokeThickness = 1.0f;
+    rive::StrokeJoin strokeJoin = rive::StrokeJoin::miter;
+    rive::StrokeCap strokeCap = rive::StrokeCap::butt;
+    rive::BlendMode paintBlendMode = rive::BlendMode::srcOver;
+    rive::rcp<rive::RenderShader> paintShader;
+};
+
+//==============================================================================
+class SoftwareFactory : public rive::Factory
+{
+public:
+    rive::rcp<rive::RenderBuffer> makeRenderBuffer (rive::RenderBufferType type, rive::RenderBufferFlags flags, size_t sizeInBytes) override
+    {
+        return rive::make_rcp<rive::DataRenderBuffer> (type, flags, sizeInBytes);
+    }
+
+    rive::rcp<rive::RenderShader> makeLinearGradient (float sx, float sy, float ex, float ey, const rive::ColorInt colors[], const float stops[], size_t count) override
+    {
+        return rive::make_rcp<SoftwareRenderShader> (SoftwareRenderShader::Type::linear, sx, sy, ex, ey, 0.0f, colors, stops, count);
+    }
+
+    rive::rcp<rive::RenderShader> makeRadialGradient (float cx, float cy, float radius, const rive::ColorInt colors[], const float stops[], size_t count) override
+    {
+        return rive::make_rcp<SoftwareRenderShader> (SoftwareRenderShader::Type::radial, cx, cy, cx, cy, radius, colors, stops, count);
+    }
+
+    rive::rcp<rive::RenderPath> makeRenderPath (rive::RawPath& rawPath, rive::FillRule fillRule) override
+    {
+        return rive::make_rcp<SoftwareRenderPath> (rawPath, fillRule);
+    }
+
+    rive::rcp<rive::RenderPath> makeEmptyRenderPath() override
+    {
+        return rive::make_rcp<SoftwareRenderPath>();
+    }
+
+    rive::rcp<rive::RenderPaint> makeRenderPaint() override
+    {
+        return rive::make_rcp<SoftwareRenderPaint>();
+    }
+
+    rive::rcp<rive::RenderImage> decodeImage (rive::Span<const uint8_t> encodedBytes) override
+    {
+        auto image = Image::loadFromData ({ encodedBytes.data(), encodedBytes.size() });
+        if (image.failed())
+            return nullptr;
+
+        return rive::make_rcp<SoftwareRenderImage> (image.getValue());
+    }
+};
+
+//==============================================================================
+/** The geometry and state of the drawing operations recorded during a frame. */
+struct SoftwareFrame
+{
+    enum class SourceType : uint8
+    {
+        solid,
+        gradient,
+        image
+    };
+
+    struct ClipShape
+    {
+        uint32 edgeBegin = 0, edgeEnd = 0;
+        bool evenOdd = false;
+        int parent = -1;
+    };
+
+    struct ClipState
+    {
+        Rectangle<float> rect;
+        int shape = -1;
+    };
+
+    struct DrawOp
+    {
+        uint32 edgeBegin = 0, edgeEnd = 0;
+        Rectangle<float> bounds;
+        int clipState = 0;
+        bool evenOdd = false;
+        SourceType sourceType = SourceType::solid;
+        uint32 color = 0;
+        uint32 opacity = 255;
+        rive::BlendMode blendMode = rive::BlendMode::srcOver;
+        rive::rcp<rive::RenderShader> shader;
+        rive::rcp<rive::RenderImage> image;
+        rive::Mat2D deviceToSource;
+    };
+
+    void reset (int width, int height)
+    {
+        edges.clear();
+        ops.clear();
+        clipShapes.clear();
+        clipStates.clear();
+
+        clipStates.push_back ({ Rectangle<float> (0.0f, 0.0f, static_cast<float> (width), static_cast<float> (height)), -1 });
+    }
+
+    std::vector<Edge> edges;
+    std::vector<DrawOp> ops;
+    std::vector<ClipShape> clipShapes;
+    std::vector<ClipState> clipStates;
+};
+
+//==============================================================================
+/** Converts renderer commands into device space edges, flattening curves and stroking outlines. */
+class SoftwareGeometryBuilder
+{
+public:
+    /** Flattens the path into contours of points, transformed by the matrix. */
+    void flatten (const rive::RawPath& path, const rive::Mat2D& transform, float tolerance)
+    {
+        points.clear();
+        contours.clear();
+
+        const auto startContour = [this]
+        {
+            if (! contours.empty() && contours.back().count <= 0)
+                contours.pop_back();
+
+            contours.push_back ({ static_cast<int> (points.size()), 0, false });
+        };
+
+        const auto addPoint = [this] (rive::Vec2D p)
+        {
+            if (contours.empty())
+                contours.push_back ({ static_cast<int> (points.size()), 0, false });
+
+            auto& contour = contours.back();
+            if (contour.count > 0)
+            {
+                const auto& last = points.back();
+                if (std::abs (last.x - p.x) < 1.0e-6f && std::abs (last.y - p.y) < 1.0e-6f)
+                    return;
+            }
+
+            points.push_back (p);
+            ++contour.count;
+        };
+
+        for (const auto [verb, pts] : path)
+        {
+            switch (verb)
+            {
+                case rive::PathVerb::move:
+                    startContour();
+                    addPoint (transform * pts[0]);
+                    break;
+
+                case rive::PathVerb::line:
+                    addPoint (transform * pts[1]);
+                    break;
+
+                case rive::PathVerb::quad:
+                {
+                    const auto p0 = transform * pts[0];
+                    const auto p1 = transform * pts[1];
+                    const auto p2 = transform * pts[2];
+
+                    const auto dd = (p0 - p1 * 2.0f + p2).length();
+                    const auto n = jlimit (1, 100, static_cast<int> (std::ceil (std::sqrt (0.25f * dd / tolerance))));
+
+                    for (int i = 1; i <= n; ++i)
+                    {
+                        const auto t = static_cast<float> (i) / static_cast<float> (n);
+                        const auto mt = 1.0f - t;
+                        addPoint (p0 * (mt * mt) + p1 * (2.0f * mt * t) + p2 * (t * t));
+                    }
+
+                    break;
+                }
+
+                case rive::PathVerb::cubic:
+                {
+                    const auto p0 = transform * pts[0];
+                    const auto p1 = transform * pts[1];
+                    const auto p2 = transform * pts[2];
+                    const auto p3 = transform * pts[3];
+
+                    const auto dd = jmax ((p0 - p1 * 2.0f + p2).length(), (p1 - p2 * 2.0f + p3).length());
+                    const auto n = jlimit (1, 100, static_cast<int> (std::ceil (std::sqrt (0.75f * dd / tolerance))));
+
+                    for (int i = 1; i <= n; ++i)
+                    {
+                        const auto t = static_cast<float> (i) / static_cast<float> (n);
+                        const auto mt = 1.0f - t;
+                        addPoint (p0 * (mt * mt * mt) + p1 * (3.0f * mt * mt * t) + p2 * (3.0f * mt * t * t) + p3 * (t * t * t));
+                    }
+
+                    break;
+                }
+
+                case rive::PathVerb::close:
+                    if (! contours.empty())
+                        contours.back().closed = true;
+                    break;
+            }
+        }
+
+        if (! contours.empty() && contours.back().count <= 0)
+            contours.pop_back();
+    }
+
+    /** Appends the flattened contours as fill edges, returning their bounding box. */
+    Rectangle<float> appendFillEdges (std::vector<Edge>& edges) const
+    {
+        BoundsBuilder bounds;
+
+        for (const auto& contour : contours)
+        {
+            if (contour.count < 3)
+                continue;
+
+            const auto* p = points.data() + contour.start;
+            for (int i = 0; i < contour.count; ++i)
+            {
+                const auto& a = p[i];
+                const auto& b = p[(i + 1) % contour.count];
+
+                edges.push_back ({ a.x, a.y, b.x, b.y });
+                bounds.add (a);
+            }
+        }
+
+        return bounds.get();
+    }
+
+    /** Returns true if the flattened contours describe a single axis aligned rectangle. */
+    bool isAxisAlignedRectangle (Rectangle<float>& result) const
+    {
+        if (contours.size() != 1)
+            return false;
+
+        auto count = contours[0].count;
+        const auto* p = points.data() + contours[0].start;
+
+        if (count == 5 && p[0] == p[4])
+            count = 4;
+
+        if (count != 4)
+            return false;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            const auto& a = p[i];
+            const auto& b = p[(i + 1) % 4];
+
+            if (a.x != b.x && a.y != b.y)
+                return false;
+        }
+
+        const auto minX = jmin (p[0].x, p[1].x, p[2].x, p[3].x);
+        const auto minY = jmin (p[0].y, p[1].y, p[2].y, p[3].y);
+        const auto maxX = jmax (p[0].x, p[1].x, p[2].x, p[3].x);
+        const auto maxY = jmax (p[0].y, p[1].y, p[2].y, p[3].y);
+
+        result = { minX, minY, maxX - minX, maxY - minY };
+        return true;
+    }
+
+    /** Strokes the flattened local space contours, appending device space edges, returning their bounding box. */
+    Rectangle<float> appendStrokeEdges (std::vector<Edge>& edges, const rive::Mat2D& transform, float thickness, rive::StrokeJoin join, rive::StrokeCap cap, float tolerance)
+    {
+        BoundsBuilder bounds;
+        const auto halfWidth = thickness * 0.5f;
+
+        const auto emit = [&] (std::initializer_list<rive::Vec2D> polygon)
+        {
+            emitPolygon (edges, bounds, transform, polygon.begin(), static_cast<int> (polygon.size()));
+        };
+
+        const auto emitCircle = [&] (rive::Vec2D center)
+        {
+            circle.clear();
+
+            const auto n = halfWidth > tolerance
+                             ? jlimit (8, 256, static_cast<int> (std::ceil (MathConstants<float>::pi / std::acos (1.0f - tolerance / halfWidth))))
+                             : 8;
+
+            for (int i = 0; i < n; ++i)
+            {
+                const auto angle = MathConstants<float>::twoPi * static_cast<float> (i) / static_cast<float> (n);
+                circle.push_back (center + rive::Vec2D (std::cos (angle), std::sin (angle)) * halfWidth);
+            }
+
+            emitPolygon (edges, bounds, transform, circle.data(), n);
+        };
+
+        for (const auto& contour : contours)
+        {
+            const auto* p = points.data() + contour.start;
+            auto count = contour.count;
+            const bool closed = contour.closed && count > 2;
+
+            if (closed && p[0] == p[count - 1])
+                --count;
+
+            if (count == 1)
+            {
+                if (cap == rive::StrokeCap::round)
+                    emitCircle (p[0]);
+                else if (cap == rive::StrokeCap::square)
+                    emit ({ p[0] + rive::Vec2D (-halfWidth, -halfWidth),
+                            p[0] + rive::Vec2D (halfWidth, -halfWidth),
+                            p[0] + rive::Vec2D (halfWidth, halfWidth),
+                            p[0] + rive::Vec2D (-halfWidth, halfWidth) });
+
+                continue;
+            }
+
+            const auto numSegments = closed ? count : count - 1;
+
+            for (int i = 0; i < numSegments; ++i)
+            {
+                auto a = p[i];
+                auto b = p[(i + 1) % count];
+                const auto direction = (b - a).normalized();
+                const auto normal = rive::Vec2D (-direction.y, direction.x) * halfWidth;
+
+                if (! closed && cap == rive::StrokeCap::square)
+                {
+                    if (i == 0)
+                        a -= direction * halfWidth;
+
+                    if (i == numSegments - 1)
+                        b += direction * halfWidth;
+                }
+
+                emit ({ a + normal, b + normal, b - normal, a - normal });
+            }
+
+            const auto firstJoin = closed ? 0 : 1;
+            const auto lastJoin = closed ? count : count - 1;
+
+            for (int i = firstJoin; i < lastJoin; ++i)
+            {
+                const auto& vertex = p[i];
+                const auto& previous = p[(i + count - 1) % count];
+                const auto& next = p[(i + 1) % count];
+
+                const auto d0 = (vertex - previous).normalized();
+                const auto d1 = (next - vertex).normalized();
+                const auto cross = d0.x * d1.y - d0.y * d1.x;
+                const auto dot = d0.x * d1.x + d0.y * d1.y;
+
+                if (std::abs (cross) < 1.0e-6f && dot > 0.0f)
+                    continue;
+
+                if (join == rive::StrokeJoin::round)
+                {
+                    emitCircle (vertex);
+                    continue;
+                }
+
+                const auto side = cross > 0.0f ? -1.0f : 1.0f;
+                const auto outer0 = rive::Vec2D (-d0.y, d0.x) * side;
+                const auto outer1 = rive::Vec2D (-d1.y, d1.x) * side;
+
+                if (join == rive::StrokeJoin::miter)
+                {
+                    const auto miterDirection = (outer0 + outer1).normalized();
+                    const auto cosHalfAngle = miterDirection.x * outer0.x + miterDirection.y * outer0.y;
+
+                    if (cosHalfAngle > 1.0f / strokeMiterLimit)
+                    {
+                        emit ({ vertex,
+                                vertex + outer0 * halfWidth,
+                                vertex + miterDirection * (halfWidth / cosHalfAngle),
+                                vertex + outer1 * halfWidth });
+
+                        continue;
+                    }
+                }
+
+                emit ({ vertex, vertex + outer0 * halfWidth, vertex + outer1 * halfWidth });
+            }
+
+            if (! closed && cap == rive::StrokeCap::round)
+            {
+                emitCircle (p[0]);
+                emitCircle (p[count - 1]);
+            }
+        }
+
+        return bounds.get();
+    }
+
+private:
+    struct Contour
+    {
+        int start;
+        int count;
+        bool closed;
+    };
+
+    struct BoundsBuilder
+    {
+        void add (rive::Vec2D p) noexcept
+        {
+            minX = jmin (minX, p.x);
+            minY = jmin (minY, p.y);
+            maxX = jmax (maxX, p.x);
+            maxY = jmax (maxY, p.y);
+        }
+
+        Rectangle<float> get() const noexcept
+        {
+            if (minX > maxX || minY > maxY)
+                return {};
+
+            return { minX, minY, maxX - minX, maxY - minY };
+        }
+
+        float minX = std::numeric_limits<float>::max();
+        float minY = std::numeric_limits<float>::max();
+        float maxX = std::numeric_limits<float>::lowest();
+        float maxY = std::numeric_limits<float>::lowest();
+    };
+
+    /** Emits a convex polygon with a positive orientation, so that overlapping stroke pieces add up instead of cancelling out. */
+    void emitPolygon (std::vector<Edge>& edges, BoundsBuilder& bounds, const rive::Mat2D& transform, const rive::Vec2D* polygon, int count)
+    {
+        transformed.resize (static_cast<std::size_t> (count));
+
+        float area = 0.0f;
+        for (int i = 0; i < count; ++i)
+        {
+            transformed[i] = transform * polygon[i];
+            bounds.add (transformed[i]);
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            const auto& a = transformed[i];
+            const auto& b = transformed[(i + 1) % count];
+            area += a.x * b.y - b.x * a.y;
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            const auto& a = transformed[i];
+            const auto& b = transformed[(i + 1) % count];
+
+            if (area >= 0.0f)
+                edges.push_back ({ a.x, a.y, b.x, b.y });
+            else
+                edges.push_back ({ b.x, b.y, a.x, a.y });
+        }
+    }
+
+    std::vector<rive::Vec2D> points;
+    std::vector<Contour> contours;
+    std::vector<rive::Vec2D> transformed;
+    std::vector<rive::Vec2D> circle;
+};
+
+//==============================================================================
+class SoftwareRenderer : public rive::Renderer
+{
+public:
+    explicit SoftwareRenderer (SoftwareFrame& frame)
+        : frame (frame)
+    {
+        stack.push_back ({ rive::Mat2D(), 0 });
+    }
+
+    void save() override
+    {
+        stack.push_back (stack.back());
+    }
+
+    void restore() override
+    {
+        jassert (stack.size() > 1);
+
+        if (stack.size() > 1)
+            stack.pop_back();
+    }
+
+    void transform (const rive::Mat2D& matrix) override
+    {
+        auto& state = stack.back();
+        state.transform = state.transform * matrix;
+    }
+
+    void drawPath (rive::RenderPath* path, rive::RenderPaint* paint) override
+    {
+        if (path == nullptr || paint == nullptr)
+            return;
+
+        const auto& renderPath = *static_cast<SoftwareRenderPath*> (path);
+        const auto& renderPaint = *static_cast<SoftwareRenderPaint*> (paint);
+        const auto& state = stack.back();
+
+        SoftwareFrame::DrawOp op;
+        op.clipState = state.clipState;
+        op.blendMode = renderPaint.paintBlendMode;
+        op.edgeBegin = static_cast<uint32> (frame.edges.size());
+
+        if (renderPaint.paintShader != nullptr)
+        {
+            op.sourceType = SoftwareFrame::SourceType::gradient;
+            op.shader = renderPaint.paintShader;
+            op.deviceToSource = state.transform.invertOrIdentity();
+        }
+        else
+        {
+            op.color = premultipliedFromARGB (renderPaint.paintColor);
+            if (op.color == 0)
+                return;
+        }
+
+        if (renderPaint.paintStyle == rive::RenderPaintStyle::stroke)
+        {
+            if (renderPaint.strokeThickness <= 0.0f)
+                return;
+
+            const auto scale = jmax (1.0e-6f, std::sqrt (std::abs (state.transform.xx() * state.transform.yy() - state.transform.xy() * state.transform.yx())));
+            const auto localTolerance = flatteningTolerance / scale;
+
+            geometry.flatten (renderPath.getRawPath(), rive::Mat2D(), localTolerance);
+            op.bounds = geometry.appendStrokeEdges (frame.edges, state.transform, renderPaint.strokeThickness, renderPaint.strokeJoin, renderPaint.strokeCap, localTolerance);
+        }
+        else
+        {
+            geometry.flatten (renderPath.getRawPath(), state.transform, flatteningTolerance);
+            op.bounds = geometry.appendFillEdges (frame.edges);
+            op.evenOdd = renderPath.getFillRule() == rive::FillRule::evenOdd;
+        }
+
+        op.edgeEnd = static_cast<uint32> (frame.edges.size());
+        addOp (std::move (op));
+    }
+
+    void clipPath (rive::RenderPath* path) override
+    {
+        if (path == nullptr)
+            return;
+
+        const auto& renderPath = *static_cast<SoftwareRenderPath*> (path);
+        auto& state = stack.back();
+        auto clip = frame.clipStates[static_cast<std::size_t> (state.clipState)];
+
+        geometry.flatten (renderPath.getRawPath(), state.transform, flatteningTolerance);
+
+        Rectangle<float> rect;
+        if (geometry.isAxisAlignedRectangle (rect))
+        {
+            clip.rect = clip.rect.intersection (rect);
+        }
+        else
+        {
+            SoftwareFrame::ClipShape shape;
+            shape.edgeBegin = static_cast<uint32> (frame.edges.size());
+            clip.rect = clip.rect.intersection (geometry.appendFillEdges (frame.edges));
+            shape.edgeEnd = static_cast<uint32> (frame.edges.size());
+            shape.evenOdd = renderPath.getFillRule() == rive::FillRule::evenOdd;
+            shape.parent = clip.shape;
+
+            clip.shape = static_cast<int> (frame.clipShapes.size());
+            frame.clipShapes.push_back (shape);
+        }
+
+        state.clipState = static_cast<int> (frame.clipStates.size());
+        frame.clipStates.push_back (clip);
+    }
+
+    void drawImage (const rive::RenderImage* image, rive::BlendMode blendMode, float opacity) override
+    {
+        if (image == nullptr || opacity <= 0.0f)
+            return;
+
+        const auto& state = stack.back();
+        const auto width = static_cast<float> (image->width());
+        const auto height = static_cast<float> (image->height());
+
+        SoftwareFrame::DrawOp op;
+        op.clipState = state.clipState;
+        op.sourceType = SoftwareFrame::SourceType::image;
+        op.image = rive::ref_rcp (const_cast<rive::RenderImage*> (image));
+        op.opacity = static_cast<uint32> (jlimit (0.0f, 1.0f, opacity) * 255.0f + 0.5f);
+        op.blendMode = blendMode;
+        op.deviceToSource = state.transform.invertOrIdentity();
+
+        rive::RawPath rect;
+        rect.addRect ({ 0.0f, 0.0f, width, height });
+
+        op.edgeBegin = static_cast<uint32> (frame.edges.size());
+        geometry.flatten (rect, state.transform, flatteningTolerance);
+        op.bounds = geometry.appendFillEdges (frame.edges);
+        op.edgeEnd = static_cast<uint32> (frame.edges.size());
+
+        addOp (std::move (op));
+    }
+
+    void drawImageMesh (const rive::RenderImage* image,
+                        rive::rcp<rive::RenderBuffer> vertices,
+                        rive::rcp<rive::RenderBuffer> uvCoords,
+                        rive::rcp<rive::RenderBuffer> indices,
+                        uint32_t vertexCount,
+                        uint32_t indexCount,
+                        rive::BlendMode blendMode,
+                        float opacity) override
+    {
+        if (image == nullptr || vertices == nullptr || uvCoords == nullptr || indices == nullptr || opacity <= 0.0f)
+            return;
+
+        const auto& state = stack.back();
+        const auto* positions = static_cast<rive::DataRenderBuffer*> (vertices.get())->vecs();
+        const auto* uvs = static_cast<rive::DataRenderBuffer*> (uvCoords.get())->vecs();
+        const auto* indexData = static_cast<rive::DataRenderBuffer*> (indices.get())->u16s();
+        const auto imageWidth = static_cast<float> (image->width());
+        const auto imageHeight = static_cast<float> (image->height());
+        const auto toImage = [imageWidth, imageHeight] (rive::Vec2D uv) { return rive::Vec2D (uv.x * imageWidth, uv.y * imageHeight); };
+
+        // Consecutive triangles sharing the same image mapping (like the two halves of a quad) are
+        // rasterized as a single op, so their shared edges don't leave antialiasing seams
+        SoftwareFrame::DrawOp op;
+        rive::RawPath triangles;
+
+        const auto flush = [&]
+        {
+            if (triangles.empty())
+                return;
+
+            op.edgeBegin = static_cast<uint32> (frame.edges.size());
+            geometry.flatten (triangles, state.transform, flatteningTolerance);
+            op.bounds = geometry.appendFillEdges (frame.edges);
+            op.edgeEnd = static_cast<uint32> (frame.edges.size());
+
+            addOp (std::move (op));
+            triangles.rewind();
+        };
+
+        for (uint32_t i = 0; i + 2 < indexCount; i += 3)
+        {
+            const auto i0 = indexData[i], i1 = indexData[i + 1], i2 = indexData[i + 2];
+            if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount)
+                continue;
+
+            // Build the affine mapping from triangle local space to image pixels
+            const auto t0 = toImage (uvs[i0]), t1 = toImage (uvs[i1]), t2 = toImage (uvs[i2]);
+            const auto p0 = positions[i0], p1 = positions[i1], p2 = positions[i2];
+
+            const rive::Mat2D localToTriangle (p1.x - p0.x, p1.y - p0.y, p2.x - p0.x, p2.y - p0.y, p0.x, p0.y);
+            const rive::Mat2D triangleToImage (t1.x - t0.x, t1.y - t0.y, t2.x - t0.x, t2.y - t0.y, t0.x, t0.y);
+
+            rive::Mat2D triangleFromLocal;
+            if (! localToTriangle.invert (&triangleFromLocal))
+                continue;
+
+            const auto deviceToSource = triangleToImage * triangleFromLocal * state.transform.invertOrIdentity();
+
+            if (! triangles.empty() && ! isSameMapping (op.deviceToSource, deviceToSource))
+                flush();
+
+            if (triangles.empty())
+            {
+                op = {};
+                op.clipState = state.clipState;
+                op.sourceType = SoftwareFrame::SourceType::image;
+                op.image = rive::ref_rcp (const_cast<rive::RenderImage*> (image));
+                op.opacity = static_cast<uint32> (jlimit (0.0f, 1.0f, opacity) * 255.0f + 0.5f);
+                op.blendMode = blendMode;
+                op.deviceToSource = deviceToSource;
+            }
+
+            triangles.moveTo (p0.x, p0.y);
+            triangles.lineTo (p1.x, p1.y);
+            triangles.lineTo (p2.x, p2.y);
+            triangles.close();
+        }
+
+        flush();
+    }
+
+private:
+    struct State
+    {
+        rive::Mat2D transform;
+        int clipState;
+    };
+
+    static bool isSameMapping (const rive::Mat2D& a, const rive::Mat2D& b) noexcept
+    {
+        for (int i = 0; i < 6; ++i)
+        {
+            if (std::abs (a[i] - b[i]) > 1.0e-4f)
+                return false;
+        }
+
+        return true;
+    }
+
+    void addOp (SoftwareFrame::DrawOp&& op)
+    {
+        op.bounds = op.bounds.intersection (frame.clipStates[static_cast<std::size_t> (op.clipState)].rect);
+
+        if (op.edgeBegin == op.edgeEnd || op.bounds.isEmpty())
+        {
+            frame.edges.resize (op.edgeBegin);
+            return;
+        }
+
+        frame.ops.push_back (std::move (op));
+    }
+
+    SoftwareFrame& frame;
+    SoftwareGeometryBuilder geometry;
+    std::vector<State> stack;
+};
+
+//==============================================================================
+/** Rasterises the recorded frame operations into a band of rows of the target pixels. */
+class SoftwareBandRasteriser
+{
+public:
+    void rasterise (const SoftwareFrame& frame, uint32* pixels, int width, int bandStart, int bandEnd)
+    {
+        for (const auto& op : frame.ops)
+        {
+            const auto& clip = frame.clipStates[static_cast<std::size_t> (op.clipState)];
+
+            const auto left = jmax (0, static_cast<int> (std::floor (op.bounds.getX())));
+            const auto right = jmin (width, static_cast<int> (std::ceil (op.bounds.getX() + op.bounds.getWidth())));
+            const auto top = jmax (bandStart, static_cast<int> (std::floor (op.bounds.getY())));
+            const auto bottom = jmin (bandEnd, static_cast<int> (std::ceil (op.bounds.getY() + op.bounds.getHeight())));
+
+            if (left >= right || top >= bottom)
+                continue;
+
+            const auto regionWidth = right - left;
+            const auto regionHeight = bottom - top;
+
+            coverage.resize (static_cast<std::size_t> (regionWidth * regionHeight));
+            renderCoverage (frame, op.edgeBegin, op.edgeEnd, op.evenOdd, left, top, regionWidth, regionHeight, coverage.data());
+
+            for (auto shapeIndex = clip.shape; shapeIndex >= 0;)
+            {
+                const auto& shape = frame.clipShapes[static_cast<std::size_t> (shapeIndex)];
+
+                clipCoverage.resize (coverage.size());
+                renderCoverage (frame, shape.edgeBegin, shape.edgeEnd, shape.evenOdd, left, top, regionWidth, regionHeight, clipCoverage.data());
+                multiplyCoverage (coverage.data(), clipCoverage.data(), static_cast<int> (coverage.size()));
+
+                shapeIndex = shape.parent;
+            }
+
+            applyClipRectangle (clip.rect, left, top, regionWidth, regionHeight);
+
+            const bool isSourceOver = op.blendMode == rive::BlendMode::srcOver;
+
+            if (op.sourceType != SoftwareFrame::SourceType::solid || ! isSourceOver)
+                source.resize (static_cast<std::size_t> (regionWidth));
+
+            if (op.sourceType == SoftwareFrame::SourceType::solid && ! isSourceOver)
+                std::fill (source.begin(), source.end(), op.color);
+
+            for (int row = 0; row < regionHeight; ++row)
+            {
+                const auto y = top + row;
+                auto* dst = pixels + static_cast<std::size_t> (y) * static_cast<std::size_t> (width) + static_cast<std::size_t> (left);
+                const auto* rowCoverage = coverage.data() + row * regionWidth;
+
+                switch (op.sourceType)
+                {
+                    case SoftwareFrame::SourceType::solid:
+                        if (isSourceOver)
+                            compositeSolidSpan (dst, op.color, rowCoverage, regionWidth);
+                        break;
+
+                    case SoftwareFrame::SourceType::gradient:
+                        static_cast<const SoftwareRenderShader*> (op.shader.get())->fillSpan (source.data(), left, y, regionWidth, op.deviceToSource);
+                        break;
+
+                    case SoftwareFrame::SourceType::image:
+                        static_cast<const SoftwareRenderImage*> (op.image.get())->fillSpan (source.data(), left, y, regionWidth, op.deviceToSource, op.opacity);
+                        break;
+                }
+
+                if (! isSourceOver)
+                    compositeBlendSpan (dst, source.data(), rowCoverage, regionWidth, op.blendMode);
+                else if (op.sourceType != SoftwareFrame::SourceType::solid)
+                    compositeSpan (dst, source.data(), rowCoverage, regionWidth);
+            }
+        }
+    }
+
+private:
+    void renderCoverage (const SoftwareFrame& frame, uint32 edgeBegin, uint32 edgeEnd, bool evenOdd, int left, int top, int regionWidth, int regionHeight, uint8* result)
+    {
+        accumulator.prepare (regionWidth, regionHeight);
+
+        const auto originX = static_cast<float> (left);
+        const auto originY = static_cast<float> (top);
+
+        for (auto i = edgeBegin; i < edgeEnd; ++i)
+        {
+            const auto& edge = frame.edges[i];
+            accumulator.addLine (edge.x0 - originX, edge.y0 - originY, edge.x1 - originX, edge.y1 - originY);
+        }
+
+        for (int row = 0; row < regionHeight; ++row)
+            accumulator.resolveRow (row, result + row * regionWidth, evenOdd);
+    }
+
+    void applyClipRectangle (const Rectangle<float>& clip, int left, int top, int regionWidth, int regionHeight)
+    {
+        const auto overlap = [] (float start, float end, float clipStart, float clipEnd)
+        {
+            return static_cast<uint32> (jlimit (0.0f, 1.0f, jmin (end, clipEnd) - jmax (start, clipStart)) * 255.0f + 0.5f);
+        };
+
+        const auto firstColumn = overlap (static_cast<float> (left), static_cast<float> (left + 1), clip.getX(), clip.getX() + clip.getWidth());
+        const auto lastColumn = overlap (static_cast<float> (left + regionWidth - 1), static_cast<float> (left + regionWidth), clip.getX(), clip.getX() + clip.getWidth());
+
+        for (int row = 0; row < regionHeight; ++row)
+        {
+            const auto y = static_cast<float> (top + row);
+            const auto rowFactor = overlap (y, y + 1.0f, clip.getY(), clip.getY() + clip.getHeight());
+            auto* rowCoverage = coverage.data() + row * regionWidth;
+
+            if (rowFactor < 255)
+            {
+                for (int x = 0; x < regionWidth; ++x)
+                    rowCoverage[x] = static_cast<uint8> (mulDiv255 (rowCoverage[x], rowFactor));
+            }
+
+            if (firstColumn < 255)
+                rowCoverage[0] = static_cast<uint8> (mulDiv255 (rowCoverage[0], firstColumn));
+
+            if (lastColumn < 255)
+                rowCoverage[regionWidth - 1] = static_cast<uint8> (mulDiv255 (rowCoverage[regionWidth - 1], lastColumn));
+        }
+    }
+
+    CoverageAccumulator accumulator;
+    std::vector<uint8> coverage;
+    std::vector<uint8> clipCoverage;
+    std::vector<uint32> source;
+};
+
+//==============================================================================
+class LowLevelRenderContextSoftware : public GraphicsContext
+{
+public:
+    LowLevelRenderContextSoftware (Options options)
+    {
+        if (options.numRenderThreads > 0)
+        {
+            threadPool = std::make_unique<ThreadPool> (ThreadPoolOptions()
+                                                           .withThreadName ("SoftwareRenderer")
+                                                           .withNumberOfThreads (options.numRenderThreads));
+        }
+
+        rasterisers.resize (static_cast<std::size_t> (options.numRenderThreads + 1));
+    }
+
+    ~LowLevelRenderContextSoftware() override
+    {
+        releaseCachedResources();
+
+        threadPool.reset();
+    }
+
+    float dpiScale (void*) const override { return 1.0f; }
+
+    rive::Factory* factory() override { return &softwareFactory; }
+
+    rive::gpu::RenderContext* renderContextOrNull() override { return nullptr; }
+
+    rive::gpu::RenderTarget* renderTargetOrNull() override { return nullptr; }
+
+    void onSizeChanged (void*, int width, int height, uint32_t) override
+    {
+        targetWidth = jmax (0, width);
+        targetHeight = jmax (0, height);
+
+        pixels.assign (static_cast<std::size_t> (targetWidth * targetHeight), 0);
+    }
+
+    std::unique_ptr<rive::Renderer> makeRenderer (int width, int height) override
+    {
+        if (width != targetWidth || height != targetHeight)
+            onSizeChanged (nullptr, width, height, 0);
+
+        frame.reset (targetWidth, targetHeight);
+
+        return std::make_unique<SoftwareRenderer> (frame);
+    }
+
+    void begin (const rive::gpu::RenderContext::FrameDescriptor& frameDescriptor) override
+    {
+        if (static_cast<int> (frameDescriptor.renderTargetWidth) != targetWidth
+            || static_cast<int> (frameDescriptor.renderTargetHeight) != targetHeight)
+        {
+            onSizeChanged (nullptr, static_cast<int> (frameDescriptor.renderTargetWidth), static_cast<int> (frameDescriptor.renderTargetHeight), 0);
+        }
+
+        if (frameDescriptor.loadAction == rive::gpu::LoadAction::clear)
+            std::fill (pixels.begin(), pixels.end(), premultipliedFromARGB (frameDescriptor.clearColor));
+
+        frame.reset (targetWidth, targetHeight);
+    }
+
+    void end (void*) override
+    {
+        YUP_PROFILE_NAMED_INTERNAL_TRACE (SoftwareRasterise);
+
+        const auto numBands = (targetHeight + rowsPerBand - 1) / rowsPerBand;
+
+        if (threadPool == nullptr || numBands < 2)
+        {
+            for (int band = 0; band < numBands; ++band)
+                rasteriseBand (rasterisers.front(), band);
+        }
+        else
+        {
+            std::atomic<int> nextBand { 0 };
+            std::atomic<int> pendingWorkers { static_cast<int> (rasterisers.size()) - 1 };
+            WaitableEvent workersFinished;
+
+            const auto processBands = [this, &nextBand, numBands] (SoftwareBandRasteriser& rasteriser)
+            {
+                for (int band = nextBand.fetch_add (1); band < numBands; band = nextBand.fetch_add (1))
+                    rasteriseBand (rasteriser, band);
+            };
+
+            for (std::size_t i = 1; i < rasterisers.size(); ++i)
+            {
+                threadPool->addJob ([&, i]
+                {
+                    processBands (rasterisers[i]);
+
+                    if (pendingWorkers.fetch_sub (1) == 1)
+                        workersFinished.signal();
+                });
+            }
+
+            processBands (rasterisers.front());
+            workersFinished.wait();
+        }
+
+        frame.reset (targetWidth, targetHeight);
+    }
+
+    Image readPixels() override
+    {
+        if (targetWidth <= 0 || targetHeight <= 0)
+            return {};
+
+        Image result (targetWidth, targetHeight, PixelFormat::RGBA);
+        auto* dst = result.getRawData().data();
+
+        for (const auto pixel : pixels)
+        {
+            const auto a = pixelAlpha (pixel);
+            const auto unpremultiply = [a] (uint32 value) { return a == 0 ? 0u : jmin (255u, (value * 255 + a / 2) / a); };
+
+            *dst++ = static_cast<uint8> (unpremultiply (pixel & 0xff));
+            *dst++ = static_cast<uint8> (unpremultiply ((pixel >> 8) & 0xff));
+            *dst++ = static_cast<uint8> (unpremultiply ((pixel >> 16) & 0xff));
+            *dst++ = static_cast<uint8> (a);
+        }
+
+        return result;
+    }
+
+    rive::rcp<rive::RenderImage> makeRenderImage (const Image& image) override
+    {
+        if (! image.isValid())
+            return nullptr;
+
+        return rive::make_rcp<SoftwareRenderImage> (image);
+    }
+
+    bool updateRenderImage (rive::RenderImage& renderImage, const Image& image, const Rectangle<int>&) override
+    {
+        // Software render images sample the pixels of their image directly, so there's nothing to upload
+        const auto& softwareImage = static_cast<SoftwareRenderImage&> (renderImage);
+        return softwareImage.isUsingPixelsOf (image);
+    }
+
+private:
+    void rasteriseBand (SoftwareBandRasteriser& rasteriser, int band)
+    {
+        const auto bandStart = band * rowsPerBand;
+        const auto bandEnd = jmin (targetHeight, bandStart + rowsPerBand);
+
+        rasteriser.rasterise (frame, pixels.data(), targetWidth, bandStart, bandEnd);
+    }
+
+    SoftwareFactory softwareFactory;
+    SoftwareFrame frame;
+    std::vector<uint32> pixels;
+    std::vector<SoftwareBandRasteriser> rasterisers;
+    std::unique_ptr<ThreadPool> threadPool;
+    int targetWidth = 0;
+    int targetHeight = 0;
+};
+
+} // namespace detail
+
+//==============================================================================
+std::unique_ptr<GraphicsContext> juce_constructSoftwareGraphicsContext (GraphicsContext::Options options)
+{
+    return std::make_unique<detail::LowLevelRenderContextSoftware> (options);
+}
+
+} // namespace yup
@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace yup
+{
+
+//==============================================================================
+/** Builds a 64 bit FNV-1a hash out of a sequence of values.
+
+    This is what the graphics caches use to turn their keys into map keys. It's fast and spreads
+    similar keys well, but it's not collision resistant: a matching hash only selects a candidate,
+    and the caller must still compare the full key before reusing what it found.
+
+    @code
+    const auto hash = Hasher().add (color.getARGB()).add (thickness).getHash();
+    @endcode
+*/
+class Hasher
+{
+public:
+    //==============================================================================
+    /** Creates a hasher with an empty sequence. */
+    constexpr Hasher() noexcept = default;
+
+    //==============================================================================
+    /** Adds the 4 bytes of an integer to the hash. */
+    constexpr Hasher& add (uint32 value) noexcept
+    {
+        for (int i = 0; i < 4; ++i)
+            addByte (static_cast<uint8> (value >> (i * 8)));
+
+        return *this;
+    }
+
+    /** Adds the 8 bytes of an integer to the hash. */
+    constexpr Hasher& add (uint64 value) noexcept
+    {
+        for (int i = 0; i < 8; ++i)
+            addByte (static_cast<uint8> (value >> (i * 8)));
+
+        return *this;
+    }
+
+    /** Adds the bit pattern of a float to the hash. */
+    Hasher& add (float value) noexcept
+    {
+        uint32 bits;
+        std::memcpy (&bits, &value, sizeof (bits));
+        return add (bits);
+    }
+
+    /** Adds the address of an object to the hash. */
+    Hasher& add (const void* pointer) noexcept
+    {
+        return add (static_cast<uint64> (reinterpret_cast<pointer_sized_uint> (pointer)));
+    }
+
+    /** Adds a block of bytes to the hash.
+
+        Whole 8 byte words are mixed at once, which keeps hashing large blocks of data cheap.
+    */
+    Hasher& add (const void* data, std::size_t size) noexcept
+    {
+        add (static_cast<uint64> (size));
+
+        auto bytes = static_cast<const uint8*> (data);
+
+        for (; size >= sizeof (uint64); bytes += sizeof (uint64), size -= sizeof (uint64))
+        {
+            uint64 word;
+            std::memcpy (&word, bytes, sizeof (word));
+
+            hash ^= word;
+            hash *= prime;
+            hash ^= hash >> 29;
+        }
+
+        for (; size > 0; ++bytes, --size)
+            addByte (*bytes);
+
+        return *this;
+    }
+
+    //==============================================================================
+    /** Returns the hash of the sequence added so far. */
+    constexpr uint64 getHash() const noexcept { return hash; }
+
+private:
+    constexpr void addByte (uint8 byte) noexcept
+    {
+        hash ^= byte;
+        hash *= prime;
+    }
+
+    static constexpr uint64 offsetBasis = 14695981039346656037ull;
+    static constexpr uint64 prime = 1099511628211ull;
+
+    uint64 hash = offsetBasis;
+};
+
+} // namespace yup
@@ -19,9 +19,218 @@
   ==============================================================================
 */
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define YUP_PATH_USE_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define YUP_PATH_USE_NEON 1
+#endif
+
 namespace yup
 {
 
+namespace
+{
+
+//==============================================================================
+// Bulk kernels working on points stored as interleaved x, y floats.
+
+static_assert (sizeof (Point<float>) == 2 * sizeof (float));
+static_assert (sizeof (rive::Vec2D) == 2 * sizeof (float));
+
+void interleavePoints (const float* xs, const float* ys, float* xy, std::size_t numPoints) noexcept
+{
+    std::size_t i = 0;
+
+#if YUP_PATH_USE_SSE2
+    for (; i + 4 <= numPoints; i += 4)
+    {
+        const auto x = _mm_loadu_ps (xs + i);
+        const auto y = _mm_loadu_ps (ys + i);
+
+        _mm_storeu_ps (xy + i * 2, _mm_unpacklo_ps (x, y));
+        _mm_storeu_ps (xy + i * 2 + 4, _mm_unpackhi_ps (x, y));
+    }
+#elif YUP_PATH_USE_NEON
+    for (; i + 4 <= numPoints; i += 4)
+    {
+        float32x4x2_t zipped;
+        zipped.val[0] = vld1q_f32 (xs + i);
+        zipped.val[1] = vld1q_f32 (ys + i);
+
+        vst2q_f32 (xy + i * 2, zipped);
+    }
+#endif
+
+    for (; i < numPoints; ++i)
+    {
+        xy[i * 2] = xs[i];
+        xy[i * 2 + 1] = ys[i];
+    }
+}
+
+void accumulateBounds (const float* xy, std::size_t numPoints, float& minX, float& minY, float& maxX, float& maxY) noexcept
+{
+    std::size_t i = 0;
+
+#if YUP_PATH_USE_SSE2
+    if (numPoints >= 2)
+    {
+        auto minimum = _mm_setr_ps (minX, minY, minX, minY);
+        auto maximum = _mm_setr_ps (maxX, maxY, maxX, maxY);
+
+        for (; i + 2 <= numPoints; i += 2)
+        {
+            const auto v = _mm_loadu_ps (xy + i * 2);
+            minimum = _mm_min_ps (minimum, v);
+            maximum = _mm_max_ps (maximum, v);
+        }
+
+        minimum = _mm_min_ps (minimum, _mm_movehl_ps (minimum, minimum));
+        maximum = _mm_max_ps (maximum, _mm_movehl_ps (maximum, maximum));
+
+        alignas (16) float result[8];
+        _mm_store_ps (result, minimum);
+        _mm_store_ps (result + 4, maximum);
+
+        minX = result[0];
+        minY = result[1];
+        maxX = result[4];
+        maxY = result[5];
+    }
+#elif YUP_PATH_USE_NEON
+    if (numPoints >= 2)
+    {
+        auto minimum = vcombine_f32 (vset_lane_f32 (minY, vdup_n_f32 (minX), 1), vset_lane_f32 (minY, vdup_n_f32 (minX), 1));
+        auto maximum = vcombine_f32 (vset_lane_f32 (maxY, vdup_n_f32 (maxX), 1), vset_lane_f32 (maxY, vdup_n_f32 (maxX), 1));
+
+        for (; i + 2 <= numPoints; i += 2)
+        {
+            const auto v = vld1q_f32 (xy + i * 2);
+            minimum = vminq_f32 (minimum, v);
+            maximum = vmaxq_f32 (maximum, v);
+        }
+
+        const auto resultMin = vmin_f32 (vget_low_f32 (minimum), vget_high_f32 (minimum));
+        const auto resultMax = vmax_f32 (vget_low_f32 (maximum), vget_high_f32 (maximum));
+
+        minX = vget_lane_f32 (resultMin, 0);
+        minY = vget_lane_f32 (resultMin, 1);
+        maxX = vget_lane_f32 (resultMax, 0);
+        maxY = vget_lane_f32 (resultMax, 1);
+    }
+#endif
+
+    for (; i < numPoints; ++i)
+    {
+        minX = jmin (minX, xy[i * 2]);
+        minY = jmin (minY, xy[i * 2 + 1]);
+        maxX = jmax (maxX, xy[i * 2]);
+        maxY = jmax (maxY, xy[i * 2 + 1]);
+    }
+}
+
+void transformPointsInPlace (const AffineTransform& t, float* xy, std::size_t numPoints) noexcept
+{
+    std::size_t i = 0;
+
+#if YUP_PATH_USE_SSE2
+    const auto scale = _mm_setr_ps (t.getScaleX(), t.getScaleY(), t.getScaleX(), t.getScaleY());
+    const auto shear = _mm_setr_ps (t.getShearX(), t.getShearY(), t.getShearX(), t.getShearY());
+    const auto translate = _mm_setr_ps (t.getTranslateX(), t.getTranslateY(), t.getTranslateX(), t.getTranslateY());
+
+    for (; i + 2 <= numPoints; i += 2)
+    {
+        const auto v = _mm_loadu_ps (xy + i * 2);
+        const auto swapped = _mm_shuffle_ps (v, v, _MM_SHUFFLE (2, 3, 0, 1));
+
+        const auto result = _mm_add_ps (_mm_add_ps (_mm_mul_ps (v, scale), _mm_mul_ps (swapped, shear)), translate);
+        _mm_storeu_ps (xy + i * 2, result);
+    }
+#elif YUP_PATH_USE_NEON
+    const float scaleValues[] = { t.getScaleX(), t.getScaleY(), t.getScaleX(), t.getScaleY() };
+    const float shearValues[] = { t.getShearX(), t.getShearY(), t.getShearX(), t.getShearY() };
+    const float translateValues[] = { t.getTranslateX(), t.getTranslateY(), t.getTranslateX(), t.getTranslateY() };
+
+    const auto scale = vld1q_f32 (scaleValues);
+    const auto shear = vld1q_f32 (shearValues);
+    const auto translate = vld1q_f32 (translateValues);
+
+    for (; i + 2 <= numPoints; i += 2)
+    {
+        const auto v = vld1q_f32 (xy + i * 2);
+        const auto swapped = vrev64q_f32 (v);
+
+        const auto result = vaddq_f32 (vaddq_f32 (vmulq_f32 (v, scale), vmulq_f32 (swapped, shear)), translate);
+        vst1q_f32 (xy + i * 2, result);
+    }
+#endif
+
+    for (; i < numPoints; ++i)
+        t.transformPoint (xy[i * 2], xy[i * 2 + 1]);
+}
+
+void findMinMax (const float* values, std::size_t numValues, float& minValue, float& maxValue) noexcept
+{
+    jassert (numValues > 0);
+
+    std::size_t i = 0;
+    minValue = maxValue = values[0];
+
+#if YUP_PATH_USE_SSE2
+    if (numValues >= 8)
+    {
+        auto minimum = _mm_loadu_ps (values);
+        auto maximum = minimum;
+
+        for (i = 4; i + 4 <= numValues; i += 4)
+        {
+            const auto v = _mm_loadu_ps (values + i);
+            minimum = _mm_min_ps (minimum, v);
+            maximum = _mm_max_ps (maximum, v);
+        }
+
+        minimum = _mm_min_ps (minimum, _mm_movehl_ps (minimum, minimum));
+        minimum = _mm_min_ss (minimum, _mm_shuffle_ps (minimum, minimum, _MM_SHUFFLE (1, 1, 1, 1)));
+        maximum = _mm_max_ps (maximum, _mm_movehl_ps (maximum, maximum));
+        maximum = _mm_max_ss (maximum, _mm_shuffle_ps (maximum, maximum, _MM_SHUFFLE (1, 1, 1, 1)));
+
+        minValue = _mm_cvtss_f32 (minimum);
+        maxValue = _mm_cvtss_f32 (maximum);
+    }
+#elif YUP_PATH_USE_NEON
+    if (numValues >= 8)
+    {
+        auto minimum = vld1q_f32 (values);
+        auto maximum = minimum;
+
+        for (i = 4; i + 4 <= numValues; i += 4)
+        {
+            const auto v = vld1q_f32 (values + i);
+            minimum = vminq_f32 (minimum, v);
+            maximum = vmaxq_f32 (maximum, v);
+        }
+
+        auto resultMin = vmin_f32 (vget_low_f32 (minimum), vget_high_f32 (minimum));
+        auto resultMax = vmax_f32 (vget_low_f32 (maximum), vget_high_f32 (maximum));
+        resultMin = vpmin_f32 (resultMin, resultMin);
+        resultMax = vpmax_f32 (resultMax, resultMax);
+
+        minValue = vget_lane_f32 (resultMin, 0);
+        maxValue = vget_lane_f32 (resultMax, 0);
+    }
+#endif
+
+    for (; i < numValues; ++i)
+    {
+        minValue = jmin (minValue, values[i]);
+        maxValue = jmax (maxValue, values[i]);
+    }
+}
+
+} // namespace
+
 //==============================================================================
 
 Path::Path (float x, float y) noexcept
@@ -38,21 +247,23 @@ Path::Path (const Point<float>& p) noexcept
 
 void Path::reserveSpace (int numSegments)
 {
-    data.reserve (static_cast<std::size_t> (numSegments));
+    verbs.reserve (static_cast<std::size_t> (numSegments));
+    points.reserve (static_cast<std::size_t> (numSegments));
 }
 
 //==============================================================================
 
 int Path::size() const
 {
-    return static_cast<int> (data.size());
+    return static_cast<int> (verbs.size());
 }
 
 //==============================================================================
 
 void Path::clear()
 {
-    data.clear();
+    verbs.clear();
+    points.clear();
 
     lastSubpathIndex = -1;
     resetBoundingBox();
@@ -62,21 +273,17 @@ void Path::clear()
 
 void Path::moveTo (float x, float y)
 {
-    if (! data.empty())
+    if (! verbs.empty() && verbs.back() == SegmentType::MoveTo)
     {
-        auto& segment = data.back();
-        if (segment.type == SegmentType::MoveTo)
-        {
-            segment.x = x;
-            segment.y = y;
+        points.back() = { x, y };
 
-            updateBoundingBox (x, y); // TODO this is wrong
-            return;
-        }
+        updateBoundingBox (x, y); // TODO this is wrong
+        return;
     }
 
-    lastSubpathIndex = static_cast<int> (data.size());
-    data.emplace_back (SegmentType::MoveTo, x, y);
+    lastSubpathIndex = static_cast<int> (points.size());
+    verbs.push_back (SegmentType::MoveTo);
+    points.emplace_back (x, y);
 
     updateBoundingBox (x, y);
 }
@@ -90,7 +297,8 @@ void Path::moveTo (const Point<float>& p)
 
 void Path::lineTo (float x, float y)
 {
-    data.emplace_back (SegmentType::LineTo, x, y);
+    verbs.push_back (SegmentType::LineTo);
+    points.emplace_back (x, y);
 
     updateBoundingBox (x, y);
 }
@@ -104,9 +312,12 @@ void Path::lineTo (const Point<float>& p)
 
 void Path::quadTo (float x, float y, float x1, float y1)
 {
-    data.emplace_back (SegmentType::QuadTo, x, y, x1, y1);
+    verbs.push_back (SegmentType::QuadTo);
+    points.emplace_back (x1, y1);
+    points.emplace_back (x, y);
 
     updateBoundingBox (x, y);
+    updateBoundingBox (x1, y1);
 }
 
 void Path::quadTo (const Point<float>& p, float x1, float y1)
@@ -118,9 +329,14 @@ void Path::quadTo (const Point<float>& p, float x1, float y1)
 
 void Path::cubicTo (float x, float y, float x1, float y1, float x2, float y2)
 {
-    data.emplace_back (SegmentType::CubicTo, x, y, x1, y1, x2, y2);
+    verbs.push_back (SegmentType::CubicTo);
+    points.emplace_back (x, y);
+    points.emplace_back (x1, y1);
+    points.emplace_back (x2, y2);
 
     updateBoundingBox (x, y);
+    updateBoundingBox (x1, y1);
+    updateBoundingBox (x2, y2);
 }
 
 void Path::cubicTo (const Point<float>& p, float x1, float y1, float x2, float y2)
@@ -132,14 +348,11 @@ void Path::cubicTo (const Point<float>& p, float x1, float y1, float x2, float y
 
 void Path::close()
 {
-    if (data.empty())
+    if (verbs.empty())
         return;
 
-    if (isPositiveAndBelow (lastSubpathIndex, static_cast<int> (data.size())))
-    {
-        const auto& segment = data[lastSubpathIndex];
-        lineTo (segment.x, segment.y);
-    }
+    if (isPositiveAndBelow (lastSubpathIndex, static_cast<int> (points.size())))
+        lineTo (points[static_cast<std::size_t> (lastSubpathIndex)]);
 }
 
 //==============================================================================
@@ -333,13 +546,115 @@ void Path::addCenteredArc (const Point<float>& center, const Size<float>& diamet
     addCenteredArc (center.getX(), center.getY(), diameter.getWidth() / 2.0f, diameter.getHeight() / 2.0f, rotationOfEllipse, fromRadians, toRadians, startAsNewSubPath);
 }
 
+//==============================================================================
+
+void Path::addPolyline (const float* xs, const float* ys, int numPoints, bool startAsNewSubPath)
+{
+    if (numPoints <= 0)
+        return;
+
+    int firstLine = 0;
+    if (startAsNewSubPath)
+    {
+        moveTo (xs[0], ys[0]);
+        firstLine = 1;
+    }
+
+    const auto numLines = static_cast<std::size_t> (numPoints - firstLine);
+    const auto firstPoint = points.size();
+
+    verbs.insert (verbs.end(), numLines, SegmentType::LineTo);
+    points.resize (firstPoint + numLines);
+
+    interleavePoints (xs + firstLine, ys + firstLine, reinterpret_cast<float*> (points.data() + firstPoint), numLines);
+    updateBoundingBox (points.data() + firstPoint, numLines);
+}
+
+void Path::addPolyline (Span<const Point<float>> newPoints, bool startAsNewSubPath)
+{
+    if (newPoints.empty())
+        return;
+
+    std::size_t firstLine = 0;
+    if (startAsNewSubPath)
+    {
+        moveTo (newPoints[0]);
+        firstLine = 1;
+    }
+
+    const auto numLines = newPoints.size() - firstLine;
+    const auto firstPoint = points.size();
+
+    verbs.insert (verbs.end(), numLines, SegmentType::LineTo);
+    points.insert (points.end(), newPoints.begin() + firstLine, newPoints.end());
+
+    updateBoundingBox (points.data() + firstPoint, numLines);
+}
+
+void Path::addWaveform (const float* samples, int numSamples, const Rectangle<float>& area, float minValue, float maxValue)
+{
+    if (numSamples <= 0 || area.isEmpty())
+        return;
+
+    const auto scaleY = maxValue != minValue ? area.getHeight() / (maxValue - minValue) : 0.0f;
+    const auto toY = [&] (float value)
+    {
+        return area.getY() + (maxValue - value) * scaleY;
+    };
+
+    const auto numColumns = jmax (1, roundToInt (std::ceil (area.getWidth())));
+    std::vector<Point<float>> waveform;
+
+    if (numSamples <= numColumns * 2)
+    {
+        const auto stepX = numSamples > 1 ? area.getWidth() / static_cast<float> (numSamples - 1) : 0.0f;
+
+        waveform.reserve (static_cast<std::size_t> (numSamples));
+        for (int i = 0; i < numSamples; ++i)
+            waveform.emplace_back (area.getX() + static_cast<float> (i) * stepX, toY (samples[i]));
+    }
+    else
+    {
+        const auto columnWidth = area.getWidth() / static_cast<float> (numColumns);
+        float lastY = toY (samples[0]);
+
+        waveform.reserve (static_cast<std::size_t> (numColumns) * 2);
+        for (int column = 0; column < numColumns; ++column)
+        {
+            const auto start = static_cast<int64> (column) * numSamples / numColumns;
+            const auto end = static_cast<int64> (column + 1) * numSamples / numColumns;
+
+            float minimum, maximum;
+            findMinMax (samples + start, static_cast<std::size_t> (end - start), minimum, maximum);
+
+            const auto x = area.getX() + (static_cast<float> (column) + 0.5f) * columnWidth;
+            auto first = toY (maximum), second = toY (minimum);
+
+            // Start from the extreme closest to the previous column, to keep the outline tight
+            if (std::abs (second - lastY) < std::abs (first - lastY))
+                std::swap (first, second);
+
+            waveform.emplace_back (x, first);
+            waveform.emplace_back (x, second);
+
+            lastY = second;
+        }
+    }
+
+    addPolyline (waveform);
+}
+
 //==============================================================================
 void Path::appendPath (const Path& other)
 {
-    reserveSpace (size() + other.size());
+    if (other.verbs.empty())
+        return;
 
-    for (const auto& segment : other)
-        data.push_back (segment);
+    if (other.lastSubpathIndex >= 0)
+        lastSubpathIndex = static_cast<int> (points.size()) + other.lastSubpathIndex;
+
+    verbs.insert (verbs.end(), other.verbs.begin(), other.verbs.end());
+    points.insert (points.end(), other.points.begin(), other.points.end());
 
     minX = jmin (minX, other.minX);
     maxX = jmax (maxX, other.maxX);
@@ -349,31 +664,21 @@ void Path::appendPath (const Path& other)
 
 void Path::appendPath (const Path& other, const AffineTransform& transform)
 {
-    reserveSpace (size() + other.size());
+    if (other.verbs.empty())
+        return;
 
-    for (auto segment : other)
-    {
-        if (segment.type == Path::SegmentType::MoveTo)
-        {
-            transform.transformPoints (segment.x, segment.y);
-            moveTo (segment.x, segment.y);
-        }
-        else if (segment.type == Path::SegmentType::LineTo)
-        {
-            transform.transformPoints (segment.x, segment.y);
-            lineTo (segment.x, segment.y);
-        }
-        else if (segment.type == Path::SegmentType::QuadTo)
-        {
-            transform.transformPoints (segment.x, segment.y, segment.x1, segment.y1);
-            quadTo (segment.x, segment.y, segment.x1, segment.y1);
-        }
-        else if (segment.type == Path::SegmentType::CubicTo)
-        {
-            transform.transformPoints (segment.x, segment.y, segment.x1, segment.y1, segment.x2, segment.y2);
-            cubicTo (segment.x, segment.y, segment.x1, segment.y1, segment.x2, segment.y2);
-        }
-    }
+    const auto firstPoint = points.size();
+
+    if (other.lastSubpathIndex >= 0)
+        lastSubpathIndex = static_cast<int> (firstPoint) + other.lastSubpathIndex;
+
+    verbs.insert (verbs.end(), other.verbs.begin(), other.verbs.end());
+    points.insert (points.end(), other.points.begin(), other.points.end());
+
+    const auto numPoints = points.size() - firstPoint;
+
+    transformPointsInPlace (transform, reinterpret_cast<float*> (points.data() + firstPoint), numPoints);
+    updateBoundingBox (points.data() + firstPoint, numPoints);
 }
 
 //==============================================================================
@@ -382,17 +687,10 @@ Path& Path::transform (const AffineTransform& t)
     if (t.isIdentity())
         return *this;
 
-    for (auto& segment : data)
-    {
-        if (segment.type == SegmentType::MoveTo || segment.type == SegmentType::LineTo)
-            t.transformPoints (segment.x, segment.y);
+    transformPointsInPlace (t, reinterpret_cast<float*> (points.data()), points.size());
 
-        else if (segment.type == Path::SegmentType::QuadTo)
-            t.transformPoints (segment.x, segment.y, segment.x1, segment.y1);
-
-        else if (segment.type == Path::SegmentType::CubicTo)
-            t.transformPoints (segment.x, segment.y, segment.x1, segment.y1, segment.x2, segment.y2);
-    }
+    resetBoundingBox();
+    updateBoundingBox (points.data(), points.size());
 
     return *this;
 }
@@ -407,6 +705,9 @@ Path Path::transformed (const AffineTransform& t) const
 //==============================================================================
 Rectangle<float> Path::getBoundingBox() const
 {
+    if (points.empty())
+        return {};
+
     return { minX, minY, maxX - minX, maxY - minY };
 }
 
@@ -418,12 +719,124 @@ void Path::updateBoundingBox (float x, float y)
     maxY = jmax (maxY, y);
 }
 
+void Path::updateBoundingBox (const Point<float>* newPoints, std::size_t numPoints)
+{
+    accumulateBounds (reinterpret_cast<const float*> (newPoints), numPoints, minX, minY, maxX, maxY);
+}
+
 void Path::resetBoundingBox()
 {
     minX = std::numeric_limits<float>::max();
-    maxX = std::numeric_limits<float>::min();
+    maxX = std::numeric_limits<float>::lowest();
     minY = std::numeric_limits<float>::max();
-    maxY = std::numeric_limits<float>::min();
+    maxY = std::numeric_limits<float>::lowest();
+}
+
+//==============================================================================
+Path::Segment Path::SegmentIterator::operator*() const noexcept
+{
+    switch (*verb)
+    {
+        case SegmentType::QuadTo:
+            return { SegmentType::QuadTo, point[1].getX(), point[1].getY(), point[0].getX(), point[0].getY() };
+
+        case SegmentType::CubicTo:
+            return { SegmentType::CubicTo, point[0].getX(), point[0].getY(), point[1].getX(), point[1].getY(), point[2].getX(), point[2].getY() };
+
+        default:
+            return { static_cast<SegmentType> (*verb), point[0].getX(), point[0].getY() };
+    }
+}
+
+//==============================================================================
+rive::RawPath Path::toRawPath (const AffineTransform& transform) const
+{
+    rive::RawPath result;
+
+    const auto toVec2D = [] (const Point<float>& p)
+    {
+        return rive::Vec2D (p.getX(), p.getY());
+    };
+
+    const auto* point = points.data();
+    const auto* verb = verbs.data();
+    const auto* const verbsEnd = verb + verbs.size();
+    rive::Vec2D lastPoint;
+
+    while (verb != verbsEnd)
+    {
+        switch (*verb)
+        {
+            case SegmentType::MoveTo:
+            {
+                // Polylines dominate real paths, so a contour of straight lines is handed over as one span
+                const auto* const runStart = verb++;
+                while (verb != verbsEnd && *verb == SegmentType::LineTo)
+                    ++verb;
+
+                const auto runLength = static_cast<std::size_t> (verb - runStart);
+                result.addPoly ({ reinterpret_cast<const rive::Vec2D*> (point), runLength }, false);
+
+                point += runLength;
+                lastPoint = toVec2D (point[-1]);
+                continue;
+            }
+
+            case SegmentType::LineTo:
+                lastPoint = toVec2D (*point++);
+                result.line (lastPoint);
+                break;
+
+            case SegmentType::QuadTo:
+            {
+                const auto control = toVec2D (*point++);
+                const auto end = toVec2D (*point++);
+
+                result.cubic (rive::Vec2D::lerp (lastPoint, control, 2 / 3.f),
+                              rive::Vec2D::lerp (end, control, 2 / 3.f),
+                              end);
+
+                lastPoint = end;
+                break;
+            }
+
+            case SegmentType::CubicTo:
+            {
+                const auto control1 = toVec2D (*point++);
+                const auto control2 = toVec2D (*point++);
+                lastPoint = toVec2D (*point++);
+
+                result.cubic (control1, control2, lastPoint);
+                break;
+            }
+
+            default:
+                jassertfalse;
+                break;
+        }
+
+        ++verb;
+    }
+
+    // The quad to cubic conversion is affine invariant, so the points can be transformed in bulk afterwards
+    if (! transform.isIdentity())
+    {
+        auto rawPoints = result.points();
+        transformPointsInPlace (transform, reinterpret_cast<float*> (rawPoints.data()), rawPoints.size());
+    }
+
+    return result;
+}
+
+//==============================================================================
+bool Path::operator== (const Path& other) const noexcept
+{
+    return verbs == other.verbs && points == other.points;
+}
+
+bool Path::operator!= (const Path& other) const noexcept
+{
+    return ! (*this == other);
 }
 
 //==============================================================================
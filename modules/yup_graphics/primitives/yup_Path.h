@@ -31,8 +31,9 @@ namespace yup
     rounded rectangles, ellipses, and arcs. It supports both simple constructs such as lines and
     complex cubic Bezier curves.
 
-    This class uses an internal storage mechanism to keep track of each segment in the path,
-    allowing for efficient modifications and rendering. The Path can be used for drawing operations,
+    Segments are stored as a stream of one byte verbs alongside a packed array of points, the same
+    layout used by rive::RawPath: a line only costs a verb and a single point, and converting to a
+    render path is a tight loop over the two arrays. The Path can be used for drawing operations,
     hit testing, and bounding box calculations.
 */
 class JUCE_API Path
@@ -46,13 +47,15 @@ public:
         - LineTo: Draw a straight line from the current point.
         - QuadTo: Draw a quadratic Bezier curve.
         - CubicTo: Draw a cubic Bezier curve.
+
+        The values match the ones of rive::PathVerb.
     */
-    enum SegmentType
+    enum SegmentType : uint8
     {
-        MoveTo,
-        LineTo,
-        QuadTo,
-        CubicTo
+        MoveTo = 0,
+        LineTo = 1,
+        QuadTo = 2,
+        CubicTo = 4
     };
 
     //==============================================================================
@@ -395,6 +398,44 @@ public:
 
     void addCenteredArc (const Point<float>& center, const Size<float>& diameter, float rotationOfEllipse, float fromRadians, float toRadians, bool startAsNewSubPath);
 
+    //==============================================================================
+    /** Adds a polyline through a series of points given as separate coordinate arrays.
+
+        This is much faster than calling lineTo for each point, as the points are interleaved and their
+        bounds are computed in bulk using SIMD instructions where available.
+
+        @param xs The x-coordinates of the points.
+        @param ys The y-coordinates of the points.
+        @param numPoints The number of points in both arrays.
+        @param startAsNewSubPath Whether to start this as a new sub-path or continue from the current point.
+    */
+    void addPolyline (const float* xs, const float* ys, int numPoints, bool startAsNewSubPath = true);
+
+    /** Adds a polyline through a series of points.
+
+        This is much faster than calling lineTo for each point, as the points are copied and their
+        bounds are computed in bulk using SIMD instructions where available.
+
+        @param points The points of the polyline.
+        @param startAsNewSubPath Whether to start this as a new sub-path or continue from the current point.
+    */
+    void addPolyline (Span<const Point<float>> points, bool startAsNewSubPath = true);
+
+    /** Adds the outline of a sampled signal, decimated to the horizontal resolution of an area.
+
+        The samples are spread over the width of the area, with maxValue mapped to its top and minValue
+        to its bottom. When there are more than two samples for each unit of width, the samples falling
+        in each unit are reduced to their minimum and maximum, so the peaks are preserved while a buffer
+        of millions of samples only produces a couple of points per pixel.
+
+        @param samples The sample values.
+        @param numSamples The number of samples.
+        @param area The area to fit the waveform into.
+        @param minValue The sample value mapped to the bottom of the area.
+        @param maxValue The sample value mapped to the top of the area.
+    */
+    void addWaveform (const float* samples, int numSamples, const Rectangle<float>& area, float minValue = -1.0f, float maxValue = 1.0f);
+
     //==============================================================================
     /** Appends another path to this one.
 
@@ -429,55 +470,6 @@ public:
     // TODO - doxygen
     bool parsePathData (const String& pathData);
 
-    //==============================================================================
-    /** Provides an iterator to the beginning of the path data.
-
-        This method returns an iterator pointing to the first segment in the path's internal data.
-        It allows for iteration over the path's segments from the beginning to the end.
-
-        @return An iterator to the beginning of the path data.
-    */
-    auto begin()
-    {
-        return data.begin();
-    }
-
-    /** Provides a constant iterator to the beginning of the path data.
-
-        This method returns a constant iterator pointing to the first segment in the path's
-        internal data. It ensures that the path data cannot be modified during the iteration.
-
-        @return A constant iterator to the beginning of the path data.
-    */
-    auto begin() const
-    {
-        return data.begin();
-    }
-
-    /** Provides an iterator to the end of the path data.
-
-        This method returns an iterator pointing just past the last segment in the path's internal data.
-        It is used in conjunction with begin() for range-based iteration over the path's segments.
-
-        @return An iterator to the end of the path data.
-    */
-    auto end()
-    {
-        return data.end();
-    }
-
-    /** Provides a constant iterator to the end of the path data.
-
-        This method returns a constant iterator pointing just past the last segment in the path's
-        internal data. It ensures safe iteration over the path segments without modifying them.
-
-        @return A constant iterator to the end of the path data.
-    */
-    auto end() const
-    {
-        return data.end();
-    }
-
     //==============================================================================
     struct Segment
     {
@@ -521,16 +513,123 @@ public:
         float x2 = 0.0f, y2 = 0.0f;
     };
 
+    //==============================================================================
+    /** An iterator over the segments of a path.
+
+        Segments are not stored as such, so the iterator unpacks them from the verbs and points
+        streams and returns them by value.
+    */
+    class SegmentIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Segment;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Segment*;
+        using reference = Segment;
+
+        SegmentIterator() noexcept = default;
+
+        SegmentIterator (const uint8* verb, const Point<float>* point) noexcept
+            : verb (verb)
+            , point (point)
+        {
+        }
+
+        Segment operator*() const noexcept;
+
+        SegmentIterator& operator++() noexcept
+        {
+            point += getNumPointsForVerb (*verb++);
+            return *this;
+        }
+
+        SegmentIterator operator++ (int) noexcept
+        {
+            auto result = *this;
+            ++(*this);
+            return result;
+        }
+
+        bool operator== (const SegmentIterator& other) const noexcept { return verb == other.verb; }
+        bool operator!= (const SegmentIterator& other) const noexcept { return verb != other.verb; }
+
+    private:
+        const uint8* verb = nullptr;
+        const Point<float>* point = nullptr;
+    };
+
+    /** Provides an iterator to the first segment of the path.
+
+        @return An iterator to the beginning of the path segments.
+    */
+    SegmentIterator begin() const noexcept
+    {
+        return { verbs.data(), points.data() };
+    }
+
+    /** Provides an iterator just past the last segment of the path.
+
+        @return An iterator to the end of the path segments.
+    */
+    SegmentIterator end() const noexcept
+    {
+        return { verbs.data() + verbs.size(), points.data() + points.size() };
+    }
+
+    //==============================================================================
+    /** Returns the verbs of the path, one for each segment, as SegmentType values. */
+    Span<const uint8> getVerbs() const noexcept
+    {
+        return { verbs.data(), verbs.size() };
+    }
+
+    /** Returns the points of all the segments, packed in the order they are consumed by the verbs.
+
+        A MoveTo or LineTo consumes one point, a QuadTo consumes the control point followed by the
+        end point, and a CubicTo consumes the two control points followed by the end point.
+    */
+    Span<const Point<float>> getPoints() const noexcept
+    {
+        return { points.data(), points.size() };
+    }
+
+    /** Returns the number of points consumed by a segment type. */
+    static constexpr int getNumPointsForVerb (uint8 verb) noexcept
+    {
+        return verb == QuadTo ? 2 : (verb == CubicTo ? 3 : 1);
+    }
+
+    //==============================================================================
+    /** Converts the path to a rive::RawPath, applying a transform to its points.
+
+        Quadratic segments are converted to cubics, as not all the renderers support them.
+
+        @param transform The transform to apply to the points.
+
+        @return The converted path.
+    */
+    rive::RawPath toRawPath (const AffineTransform& transform = {}) const;
+
+    //==============================================================================
+    /** Returns true if the two paths have exactly the same segments. */
+    bool operator== (const Path& other) const noexcept;
+
+    /** Returns true if the two paths have different segments. */
+    bool operator!= (const Path& other) const noexcept;
+
 private:
     void updateBoundingBox (float x, float y);
+    void updateBoundingBox (const Point<float>* newPoints, std::size_t numPoints);
     void resetBoundingBox();
 
-    std::vector<Segment> data;
+    std::vector<uint8> verbs;
+    std::vector<Point<float>> points;
     int lastSubpathIndex = -1;
     float minX = std::numeric_limits<float>::max();
-    float maxX = std::numeric_limits<float>::min();
+    float maxX = std::numeric_limits<float>::lowest();
     float minY = std::numeric_limits<float>::max();
-    float maxY = std::numeric_limits<float>::min();
+    float maxY = std::numeric_limits<float>::lowest();
 };
 
 } // namespace yup
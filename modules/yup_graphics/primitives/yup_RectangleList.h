@@ -250,24 +250,15 @@ public:
     */
     [[nodiscard]] RectangleType getBoundingBox() const
     {
-        ValueType minX = std::numeric_limits<ValueType>::max();
-        ValueType maxX = std::numeric_limits<ValueType>::min();
-        ValueType minY = std::numeric_limits<ValueType>::max();
-        ValueType maxY = std::numeric_limits<ValueType>::min();
+        if (rectangles.isEmpty())
+            return {};
+
+        auto result = rectangles.getReference (0);
 
         for (const auto& rect : rectangles)
-        {
-            if (minX > rect.getX())
-                minX = rect.getX();
-            if (minY > rect.getY())
-                minY = rect.getY();
-            if (maxX > rect.getX() + rect.getWidth())
-                maxX = rect.getX() + rect.getWidth();
-            if (maxY > rect.getY() + rect.getHeight())
-                maxY = rect.getY() + rect.getHeight();
-        }
+            result = result.smallestContainingRectangle (rect);
 
-        return { minX, minY, maxX - minX, maxY - minY };
+        return result;
     }
 
     //==============================================================================
@@ -345,25 +336,24 @@ public:
 private:
     void mergeRectangles()
     {
-        for (auto it = rectangles.begin(); it != rectangles.end();)
+        for (int i = 0; i < rectangles.size();)
         {
             bool furtherMerged = false;
 
-            for (auto& existingRect : rectangles)
+            for (int j = 0; j < rectangles.size(); ++j)
             {
-                if (it != rectangles.end() && it->intersects (existingRect) && std::addressof (existingRect) != std::addressof (*it))
+                if (i != j && rectangles.getReference (i).intersects (rectangles.getReference (j)))
                 {
-                    existingRect = existingRect.smallestContainingRectangle (*it);
-
-                    it = rectangles.erase (it);
+                    rectangles.getReference (j) = rectangles.getReference (j).smallestContainingRectangle (rectangles.getReference (i));
+                    rectangles.remove (i);
 
                     furtherMerged = true;
                     break;
                 }
             }
 
-            if (! furtherMerged)
-                ++it;
+            // A grown rectangle can now intersect the ones already checked, so start over
+            i = furtherMerged ? 0 : i + 1;
         }
     }
 
@@ -92,13 +92,20 @@
 
 //==============================================================================
 
+#include "native/yup_GraphicsContext_software.cpp"
 #include "native/yup_GraphicsContext_impl.cpp"
 
 //==============================================================================
 #include "primitives/yup_Path.cpp"
 #include "fonts/yup_Font.cpp"
+#include "fonts/yup_FontCache.cpp"
 #include "fonts/yup_StyledText.cpp"
 #include "imaging/yup_Image.cpp"
+#include "imaging/yup_ImageAtlas.cpp"
+#include "imaging/yup_ImageLoader.cpp"
+#include "imaging/yup_ScrollingImage.cpp"
 #include "graphics/yup_Color.cpp"
 #include "graphics/yup_Colors.cpp"
+#include "graphics/yup_RenderCache.cpp"
+#include "graphics/yup_DisplayList.cpp"
 #include "graphics/yup_Graphics.cpp"
@@ -66,6 +66,7 @@ JUCE_END_IGNORE_WARNINGS_GCC_LIKE
 
 //==============================================================================
 
+#include "primitives/yup_Hasher.h"
 #include "primitives/yup_AffineTransform.h"
 #include "primitives/yup_Size.h"
 #include "primitives/yup_Point.h"
@@ -74,12 +75,18 @@ JUCE_END_IGNORE_WARNINGS_GCC_LIKE
 #include "primitives/yup_RectangleList.h"
 #include "primitives/yup_Path.h"
 #include "fonts/yup_Font.h"
+#include "fonts/yup_FontCache.h"
 #include "fonts/yup_StyledText.h"
 #include "imaging/yup_Image.h"
+#include "imaging/yup_ImageAtlas.h"
+#include "imaging/yup_ImageLoader.h"
+#include "imaging/yup_ScrollingImage.h"
 #include "graphics/yup_Color.h"
 #include "graphics/yup_ColorGradient.h"
 #include "graphics/yup_Colors.h"
 #include "graphics/yup_StrokeJoin.h"
 #include "graphics/yup_StrokeCap.h"
+#include "graphics/yup_RenderCache.h"
+#include "graphics/yup_DisplayList.h"
 #include "graphics/yup_Graphics.h"
 #include "context/yup_GraphicsContext.h"
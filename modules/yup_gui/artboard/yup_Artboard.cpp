@@ -33,14 +33,18 @@ Artboard::Artboard (StringRef componentID)
 
 Result Artboard::loadFromFile (const File& file, int defaultArtboardIndex, bool shouldUseStateMachines)
 {
-    if (! file.existsAsFile())
-        return Result::fail ("Failed to find file to load");
+    if (getNativeComponent() == nullptr)
+        return Result::fail ("Unable to access top level native component");
 
-    auto is = file.createInputStream();
-    if (is == nullptr || ! is->openedOk())
-        return Result::fail ("Failed to open file for reading");
+    auto factory = getNativeComponent()->getFactory();
+    if (factory == nullptr)
+        return Result::fail ("Failed to create a graphics context");
 
-    return loadFromStream (*is, defaultArtboardIndex, shouldUseStateMachines);
+    auto result = ArtboardFileCache::getInstance().loadFromFile (file, *factory);
+    if (result.failed())
+        return Result::fail (result.getErrorMessage());
+
+    return loadFromImportedFile (result.getValue(), defaultArtboardIndex, shouldUseStateMachines);
 }
 
 Result Artboard::loadFromStream (InputStream& is, int defaultArtboardIndex, bool shouldUseStateMachines)
@@ -52,10 +56,18 @@ Result Artboard::loadFromStream (InputStream& is, int defaultArtboardIndex, bool
     if (factory == nullptr)
         return Result::fail ("Failed to create a graphics context");
 
-    yup::MemoryBlock mb;
-    is.readIntoMemoryBlock (mb);
+    auto result = ArtboardFileCache::getInstance().loadFromStream (is, *factory);
+    if (result.failed())
+        return Result::fail (result.getErrorMessage());
+
+    return loadFromImportedFile (result.getValue(), defaultArtboardIndex, shouldUseStateMachines);
+}
 
-    rivFile = rive::File::import ({ static_cast<const uint8_t*> (mb.getData()), mb.getSize() }, factory);
+Result Artboard::loadFromImportedFile (std::shared_ptr<rive::File> file, int defaultArtboardIndex, bool shouldUseStateMachines)
+{
+    jassert (file != nullptr);
+
+    rivFile = std::move (file);
     artboardIndex = jlimit (-1, static_cast<int> (rivFile->artboardCount()) - 1, defaultArtboardIndex);
 
     useStateMachines = shouldUseStateMachines;
@@ -85,7 +97,11 @@ void Artboard::advanceAndApply (float elapsedSeconds)
     if (scene == nullptr)
         return;
 
+    const auto startMs = Time::getMillisecondCounterHiRes();
+
     scene->advanceAndApply (elapsedSeconds);
+
+    lastAdvanceMilliseconds.store (Time::getMillisecondCounterHiRes() - startMs, std::memory_order_relaxed);
 }
 
 float Artboard::durationSeconds() const
@@ -96,6 +112,11 @@ float Artboard::durationSeconds() const
     return scene->durationSeconds();
 }
 
+double Artboard::getLastAdvanceMilliseconds() const
+{
+    return lastAdvanceMilliseconds.load (std::memory_order_relaxed);
+}
+
 //==============================================================================
 
 void Artboard::setNumberInput (const String& name, double value)
@@ -113,7 +134,11 @@ void Artboard::setNumberInput (const String& name, double value)
 
 void Artboard::refreshDisplay (double lastFrameTimeSeconds)
 {
-    if (! paused)
+    if (paused || scene == nullptr)
+        return;
+
+    // Within a frame phase the advance runs in parallel with the other artboards of the frame
+    if (! ArtboardScheduler::getInstance()->scheduleAdvance (*this, static_cast<float> (lastFrameTimeSeconds)))
         advanceAndApply (static_cast<float> (lastFrameTimeSeconds));
 }
 
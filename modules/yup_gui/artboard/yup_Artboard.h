@@ -40,6 +40,9 @@ public:
     void advanceAndApply (float elapsedSeconds);
     float durationSeconds() const;
 
+    /** Returns the time spent in the last call to advanceAndApply, useful to spot expensive scenes. */
+    double getLastAdvanceMilliseconds() const;
+
     //==============================================================================
     void setNumberInput (const String& name, double value);
 
@@ -59,6 +62,7 @@ public:
     void mouseDrag (const MouseEvent& event) override;
 
 private:
+    Result loadFromImportedFile (std::shared_ptr<rive::File> file, int defaultArtboardIndex, bool shouldUseStateMachines);
     void updateSceneFromFile();
     void pullEventsFromStateMachines();
 
@@ -74,6 +78,7 @@ private:
     int animationIndex = -1;
     int stateMachineIndex = -1;
     float animationTime = 0.0f;
+    std::atomic<double> lastAdvanceMilliseconds { 0.0 };
 
     bool useStateMachines = true;
     bool paused = false;
@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+
+ArtboardFileCache& ArtboardFileCache::getInstance()
+{
+    static ArtboardFileCache instance;
+    return instance;
+}
+
+//==============================================================================
+
+ResultValue<std::shared_ptr<rive::File>> ArtboardFileCache::loadFromFile (const File& file, rive::Factory& factory)
+{
+    if (! file.existsAsFile())
+        return ResultValue<std::shared_ptr<rive::File>>::fail ("Failed to find file to load");
+
+    const auto lastModified = file.getLastModificationTime();
+
+    if (auto cachedFile = findByPath (file, lastModified, factory))
+        return ResultValue<std::shared_ptr<rive::File>>::ok (std::move (cachedFile));
+
+    auto is = file.createInputStream();
+    if (is == nullptr || ! is->openedOk())
+        return ResultValue<std::shared_ptr<rive::File>>::fail ("Failed to open file for reading");
+
+    MemoryBlock data;
+    is->readIntoMemoryBlock (data);
+
+    return import (data, file, lastModified, factory);
+}
+
+ResultValue<std::shared_ptr<rive::File>> ArtboardFileCache::loadFromStream (InputStream& is, rive::Factory& factory)
+{
+    MemoryBlock data;
+    is.readIntoMemoryBlock (data);
+
+    return import (data, {}, {}, factory);
+}
+
+//==============================================================================
+
+int ArtboardFileCache::getNumCachedFiles() const
+{
+    const ScopedLock sl (lock);
+
+    return static_cast<int> (std::count_if (entries.begin(), entries.end(), [] (const Entry& entry)
+    {
+        return ! entry.file.expired();
+    }));
+}
+
+int64 ArtboardFileCache::getNumImports() const
+{
+    const ScopedLock sl (lock);
+    return numImports;
+}
+
+//==============================================================================
+
+std::shared_ptr<rive::File> ArtboardFileCache::findByPath (const File& file, const Time& lastModified, rive::Factory& factory)
+{
+    const ScopedLock sl (lock);
+
+    const auto path = file.getFullPathName();
+
+    for (const auto& entry : entries)
+    {
+        if (entry.factory == &factory && entry.path == path && entry.lastModified == lastModified)
+        {
+            if (auto cachedFile = entry.file.lock())
+                return cachedFile;
+        }
+    }
+
+    return nullptr;
+}
+
+std::shared_ptr<rive::File> ArtboardFileCache::findByContent (uint64 contentHash, const MemoryBlock& data, rive::Factory& factory)
+{
+    const ScopedLock sl (lock);
+
+    for (const auto& entry : entries)
+    {
+        // The hash only selects the candidates, the content must match byte for byte
+        if (entry.factory == &factory && entry.contentHash == contentHash && entry.content == data)
+        {
+            if (auto cachedFile = entry.file.lock())
+                return cachedFile;
+        }
+    }
+
+    return nullptr;
+}
+
+//==============================================================================
+
+ResultValue<std::shared_ptr<rive::File>> ArtboardFileCache::import (const MemoryBlock& data, const File& file, const Time& lastModified, rive::Factory& factory)
+{
+    const auto contentHash = hashContent (data);
+
+    if (auto cachedFile = findByContent (contentHash, data, factory))
+        return ResultValue<std::shared_ptr<rive::File>>::ok (std::move (cachedFile));
+
+    // Import outside of the lock, as it's the expensive part
+    std::shared_ptr<rive::File> importedFile = rive::File::import ({ static_cast<const uint8_t*> (data.getData()), data.getSize() }, &factory);
+    if (importedFile == nullptr)
+        return ResultValue<std::shared_ptr<rive::File>>::fail ("Failed to import rive file");
+
+    const ScopedLock sl (lock);
+
+    ++numImports;
+
+    removeExpiredEntries();
+
+    // Another thread might have imported the same content in the meantime, prefer that one
+    for (auto& entry : entries)
+    {
+        if (entry.factory == &factory && entry.contentHash == contentHash && entry.content == data)
+        {
+            if (auto cachedFile = entry.file.lock())
+                return ResultValue<std::shared_ptr<rive::File>>::ok (std::move (cachedFile));
+        }
+    }
+
+    Entry entry;
+    entry.factory = &factory;
+    entry.path = file.getFullPathName();
+    entry.lastModified = lastModified;
+    entry.contentHash = contentHash;
+    entry.content = data;
+    entry.file = importedFile;
+    entries.push_back (std::move (entry));
+
+    return ResultValue<std::shared_ptr<rive::File>>::ok (std::move (importedFile));
+}
+
+void ArtboardFileCache::removeFactory (rive::Factory& factory)
+{
+    const ScopedLock sl (lock);
+
+    const auto usesFactory = [&factory] (const Entry& entry)
+    {
+        return entry.factory == &factory;
+    };
+
+    entries.erase (std::remove_if (entries.begin(), entries.end(), usesFactory), entries.end());
+}
+
+void ArtboardFileCache::removeExpiredEntries()
+{
+    const auto isExpired = [] (const Entry& entry)
+    {
+        return entry.file.expired();
+    };
+
+    entries.erase (std::remove_if (entries.begin(), entries.end(), isExpired), entries.end());
+}
+
+//==============================================================================
+
+uint64 ArtboardFileCache::hashContent (const MemoryBlock& data) noexcept
+{
+    return Hasher().add (data.getData(), data.getSize()).getHash();
+}
+
+} // namespace yup
@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+/** A process wide cache of imported rive files.
+
+    Importing a rive file parses the whole content and creates the render resources (images, fonts,
+    audio) of all its assets, so artboards showing the same file would pay for this for each
+    instance. This cache hands out the same imported file to all the artboards loading it with the
+    same factory, which then only need to create their own lightweight artboard instance and scene.
+
+    Files are looked up by path and modification time when loaded from disk, and by their content
+    when loaded from a stream. A copy of the content of each file in use is kept, so that a matching
+    hash is always confirmed by comparing the bytes. The cache only holds weak references: an imported
+    file is released when the last artboard using it is destroyed.
+
+    Imported files are tied to the factory that created their render resources. Call removeFactory()
+    before destroying a factory, so that a new factory created at the same address doesn't receive them.
+
+    All the methods can be called from any thread.
+
+    @see Artboard
+*/
+class JUCE_API ArtboardFileCache
+{
+public:
+    //==============================================================================
+    /** Returns the shared cache instance. */
+    static ArtboardFileCache& getInstance();
+
+    //==============================================================================
+    /** Returns the imported content of a rive file, importing it if it isn't already in use.
+
+        @param file The file to load.
+        @param factory The factory used to create the render resources of the file.
+
+        @return The shared imported file, or an error if the file couldn't be read or imported.
+    */
+    ResultValue<std::shared_ptr<rive::File>> loadFromFile (const File& file, rive::Factory& factory);
+
+    /** Returns the imported content of a rive file read from a stream, importing it if the same
+        content isn't already in use.
+
+        @param is The stream to read the file content from.
+        @param factory The factory used to create the render resources of the file.
+
+        @return The shared imported file, or an error if the content couldn't be imported.
+    */
+    ResultValue<std::shared_ptr<rive::File>> loadFromStream (InputStream& is, rive::Factory& factory);
+
+    /** Forgets all the files imported with a factory.
+
+        This must be called before the factory is destroyed. Artboards still holding one of its files
+        keep it alive, but the cache won't hand it out anymore.
+
+        @param factory The factory being destroyed.
+    */
+    void removeFactory (rive::Factory& factory);
+
+    //==============================================================================
+    /** Returns the number of imported files currently in use. */
+    int getNumCachedFiles() const;
+
+    /** Returns the number of imports performed since the cache was created. */
+    int64 getNumImports() const;
+
+private:
+    ArtboardFileCache() = default;
+
+    struct Entry
+    {
+        rive::Factory* factory = nullptr;
+        String path;
+        Time lastModified;
+        uint64 contentHash = 0;
+        MemoryBlock content;
+        std::weak_ptr<rive::File> file;
+    };
+
+    std::shared_ptr<rive::File> findByPath (const File& file, const Time& lastModified, rive::Factory& factory);
+    std::shared_ptr<rive::File> findByContent (uint64 contentHash, const MemoryBlock& data, rive::Factory& factory);
+    ResultValue<std::shared_ptr<rive::File>> import (const MemoryBlock& data, const File& file, const Time& lastModified, rive::Factory& factory);
+    void removeExpiredEntries();
+
+    static uint64 hashContent (const MemoryBlock& data) noexcept;
+
+    mutable CriticalSection lock;
+    std::vector<Entry> entries;
+    int64 numImports = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (ArtboardFileCache)
+};
+
+} // namespace yup
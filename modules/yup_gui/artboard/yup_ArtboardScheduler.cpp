@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+
+ArtboardScheduler::ArtboardScheduler()
+    : numWorkerThreads (jmax (0, SystemStats::getNumCpus() - 1))
+{
+}
+
+ArtboardScheduler::~ArtboardScheduler()
+{
+    jassert (frameDepth == 0);
+
+    threadPool.reset();
+
+    clearSingletonInstance();
+}
+
+//==============================================================================
+
+void ArtboardScheduler::setNumWorkerThreads (int numThreads)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    jassert (frameDepth == 0);
+
+    numThreads = jmax (0, numThreads);
+    if (numWorkerThreads == numThreads)
+        return;
+
+    numWorkerThreads = numThreads;
+    threadPool.reset();
+}
+
+int ArtboardScheduler::getNumWorkerThreads() const
+{
+    return numWorkerThreads;
+}
+
+//==============================================================================
+
+void ArtboardScheduler::beginFrame()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    ++frameDepth;
+}
+
+bool ArtboardScheduler::scheduleAdvance (Artboard& artboard, float elapsedSeconds)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (frameDepth == 0)
+        return false;
+
+    pendingAdvances.push_back ({ &artboard, elapsedSeconds });
+    return true;
+}
+
+void ArtboardScheduler::endFrame()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    jassert (frameDepth > 0);
+
+    if (frameDepth == 0 || --frameDepth > 0)
+        return;
+
+    YUP_PROFILE_NAMED_INTERNAL_TRACE (AdvanceArtboards);
+
+    runPendingAdvances();
+}
+
+//==============================================================================
+
+ArtboardScheduler::FrameStatistics ArtboardScheduler::getLastFrameStatistics() const
+{
+    return lastFrameStatistics;
+}
+
+//==============================================================================
+
+void ArtboardScheduler::runPendingAdvances()
+{
+    FrameStatistics statistics;
+    statistics.numAdvancedArtboards = static_cast<int> (pendingAdvances.size());
+
+    const auto startMs = Time::getMillisecondCounterHiRes();
+    const auto numAdvances = static_cast<int> (pendingAdvances.size());
+    const auto numWorkers = jmin (numWorkerThreads, numAdvances - 1);
+
+    if (numWorkers <= 0)
+    {
+        for (const auto& pending : pendingAdvances)
+            pending.artboard->advanceAndApply (pending.elapsedSeconds);
+    }
+    else
+    {
+        if (threadPool == nullptr)
+        {
+            threadPool = std::make_unique<ThreadPool> (ThreadPoolOptions()
+                                                           .withThreadName ("ArtboardScheduler")
+                                                           .withNumberOfThreads (numWorkerThreads));
+        }
+
+        std::atomic<int> nextAdvance { 0 };
+        std::atomic<int> pendingWorkers { numWorkers };
+        WaitableEvent workersFinished;
+
+        const auto processAdvances = [this, &nextAdvance, numAdvances]
+        {
+            for (int index = nextAdvance.fetch_add (1); index < numAdvances; index = nextAdvance.fetch_add (1))
+            {
+                const auto& pending = pendingAdvances[static_cast<std::size_t> (index)];
+                pending.artboard->advanceAndApply (pending.elapsedSeconds);
+            }
+        };
+
+        for (int i = 0; i < numWorkers; ++i)
+        {
+            threadPool->addJob ([&]
+            {
+                processAdvances();
+
+                if (pendingWorkers.fetch_sub (1) == 1)
+                    workersFinished.signal();
+            });
+        }
+
+        processAdvances();
+        workersFinished.wait();
+    }
+
+    statistics.wallMs = Time::getMillisecondCounterHiRes() - startMs;
+
+    for (const auto& pending : pendingAdvances)
+        statistics.totalAdvanceMs += pending.artboard->getLastAdvanceMilliseconds();
+
+    pendingAdvances.clear();
+    lastFrameStatistics = statistics;
+}
+
+//==============================================================================
+
+JUCE_IMPLEMENT_SINGLETON (ArtboardScheduler)
+
+} // namespace yup
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+class Artboard;
+
+//==============================================================================
+/** Advances the scenes of all the artboards of a frame in parallel.
+
+    Windows open a frame phase with beginFrame() before refreshing their components, and close it
+    with endFrame() before painting them. While the phase is open, artboards don't advance their
+    scene when refreshed, but schedule the advance instead: endFrame() then runs all the scheduled
+    advances on a pool of worker threads, and only returns once all of them have completed.
+
+    Each artboard only ever touches its own scene instance, so advancing distinct artboards
+    concurrently is safe even when they share the same imported file.
+
+    This class must only be used from the message thread.
+
+    @see Artboard
+*/
+class JUCE_API ArtboardScheduler
+{
+public:
+    //==============================================================================
+    /** Statistics about the last frame phase. */
+    struct FrameStatistics
+    {
+        int numAdvancedArtboards = 0; ///< Number of artboards advanced in the frame.
+        double totalAdvanceMs = 0.0;  ///< Sum of the time spent advancing each artboard.
+        double wallMs = 0.0;          ///< Time elapsed from the start to the end of the parallel advance.
+    };
+
+    //==============================================================================
+    /** Destructor. */
+    ~ArtboardScheduler();
+
+    //==============================================================================
+    /** Sets the number of worker threads used to advance the artboards.
+
+        Passing 0 makes all the advances run serially on the message thread. By default the number
+        of worker threads is one less than the number of available cores.
+    */
+    void setNumWorkerThreads (int numThreads);
+
+    /** Returns the number of worker threads used to advance the artboards. */
+    int getNumWorkerThreads() const;
+
+    //==============================================================================
+    /** Opens a frame phase. Calls can be nested, the scheduled advances run when the outermost phase ends. */
+    void beginFrame();
+
+    /** Schedules the advance of an artboard scene.
+
+        @param artboard The artboard to advance.
+        @param elapsedSeconds The time to advance the scene by.
+
+        @return True if the advance has been scheduled, false if no frame phase is open and the caller
+                should advance the artboard directly.
+    */
+    bool scheduleAdvance (Artboard& artboard, float elapsedSeconds);
+
+    /** Closes a frame phase, advancing all the scheduled artboards and waiting for them to complete. */
+    void endFrame();
+
+    //==============================================================================
+    /** Returns the statistics of the last completed frame phase. */
+    FrameStatistics getLastFrameStatistics() const;
+
+    //==============================================================================
+    JUCE_DECLARE_SINGLETON (ArtboardScheduler, false)
+
+private:
+    ArtboardScheduler();
+
+    struct PendingAdvance
+    {
+        Artboard* artboard = nullptr;
+        float elapsedSeconds = 0.0f;
+    };
+
+    void runPendingAdvances();
+
+    std::unique_ptr<ThreadPool> threadPool;
+    int numWorkerThreads = 0;
+    int frameDepth = 0;
+    std::vector<PendingAdvance> pendingAdvances;
+    FrameStatistics lastFrameStatistics;
+};
+
+} // namespace yup
@@ -44,7 +44,10 @@ Component::~Component()
         parentComponent->removeChildComponent (this);
 
     for (auto component : children)
+    {
         component->parentComponent = nullptr;
+        component->invalidateAncestorPosition (true);
+    }
 
     children.clear();
 
@@ -98,6 +101,8 @@ void Component::setVisible (bool shouldBeVisible)
         if (native != nullptr)
             native->setVisible (shouldBeVisible);
 
+        invalidateParentHitTestIndex();
+
         visibilityChanged();
 
         repaint();
@@ -153,6 +158,9 @@ void Component::setSize (const Size<float>& newSize)
     if (options.onDesktop)
         native->setSize (newSize.to<int>());
 
+    invalidateHitTestIndex();
+    invalidateParentHitTestIndex();
+
     resized();
 }
 
@@ -176,11 +184,17 @@ float Component::getHeight() const
 
 void Component::setBounds (const Rectangle<float>& newBounds)
 {
+    if (boundsInParent.getPosition() != newBounds.getPosition())
+        invalidateAncestorPosition();
+
     boundsInParent = newBounds;
 
     if (options.onDesktop)
         native->setBounds (newBounds.to<int>());
 
+    invalidateHitTestIndex();
+    invalidateParentHitTestIndex();
+
     resized();
 }
 
@@ -196,18 +210,38 @@ Rectangle<float> Component::getLocalBounds() const
 
 Rectangle<float> Component::getBoundsRelativeToAncestor() const
 {
-    auto bounds = boundsInParent;
-    if (options.onDesktop)
-        return bounds.withZeroPosition();
+    return boundsInParent.withPosition (getPositionRelativeToAncestor());
+}
 
-    auto parent = getParentComponent();
-    while (parent != nullptr && ! parent->options.onDesktop)
+Point<float> Component::getPositionRelativeToAncestor() const
+{
+    if (! ancestorPositionValid)
     {
-        bounds.translate (parent->getPosition());
-        parent = parent->getParentComponent();
+        if (options.onDesktop)
+            ancestorPosition = {};
+        else if (parentComponent == nullptr)
+            ancestorPosition = boundsInParent.getPosition();
+        else
+            ancestorPosition = boundsInParent.getPosition() + parentComponent->getPositionRelativeToAncestor();
+
+        ancestorPositionValid = true;
     }
 
-    return bounds;
+    return ancestorPosition;
+}
+
+void Component::invalidateAncestorPosition (bool evenIfAlreadyInvalid)
+{
+    // A valid cached position implies a valid one in all the parents, so when a component moves, an
+    // invalid one has no valid descendants and the walk can stop there. Reparenting and desktop changes
+    // don't rely on that and always walk the whole subtree
+    if (! ancestorPositionValid && ! evenIfAlreadyInvalid)
+        return;
+
+    ancestorPositionValid = false;
+
+    for (auto child : children)
+        child->invalidateAncestorPosition (evenIfAlreadyInvalid);
 }
 
 float Component::proportionOfWidth (float proportion) const
@@ -288,8 +322,29 @@ bool Component::isRenderingUnclipped() const
     return options.unclippedRendering;
 }
 
+void Component::enableRetainedPainting (bool shouldBeEnabled)
+{
+    if (shouldBeEnabled == isRetainedPaintingEnabled())
+        return;
+
+    if (shouldBeEnabled)
+        displayList = std::make_unique<DisplayList>();
+    else
+        displayList.reset();
+
+    repaint();
+}
+
+bool Component::isRetainedPaintingEnabled() const
+{
+    return displayList != nullptr;
+}
+
 void Component::repaint()
 {
+    if (displayList != nullptr)
+        displayList->invalidate();
+
     if (getBounds().isEmpty())
         return;
 
@@ -299,6 +354,9 @@ void Component::repaint()
 
 void Component::repaint (const Rectangle<float>& rect)
 {
+    if (displayList != nullptr)
+        displayList->invalidate();
+
     if (rect.isEmpty())
         return;
 
@@ -359,6 +417,7 @@ void Component::addToDesktop (const ComponentNative::Options& nativeOptions, voi
     }
 
     options.onDesktop = true;
+    invalidateAncestorPosition (true);
 
     native = ComponentNative::createFor (*this, nativeOptions, parent);
 
@@ -371,6 +430,7 @@ void Component::removeFromDesktop()
         return;
 
     options.onDesktop = false;
+    invalidateAncestorPosition (true);
 
     native.reset();
 }
@@ -396,9 +456,15 @@ void Component::addChildComponent (Component& component)
 
 void Component::addChildComponent (Component* component)
 {
-    component->parentComponent = this;
+    if (component->parentComponent != this)
+    {
+        component->parentComponent = this;
+        component->invalidateAncestorPosition (true);
+    }
 
     children.addIfNotAlreadyThere (component);
+
+    invalidateHitTestIndex();
 }
 
 void Component::addAndMakeVisible (Component& component)
@@ -423,7 +489,11 @@ void Component::insertChildComponent (Component* component, int index)
     const int currentIndex = children.indexOf (component);
 
     if (isPositiveAndBelow (currentIndex, children.size()))
+    {
         children.move (currentIndex, index);
+
+        invalidateHitTestIndex();
+    }
 }
 
 void Component::removeChildComponent (Component& component)
@@ -434,8 +504,11 @@ void Component::removeChildComponent (Component& component)
 void Component::removeChildComponent (Component* component)
 {
     component->parentComponent = nullptr;
+    component->invalidateAncestorPosition (true);
 
     children.removeAllInstancesOf (component);
+
+    invalidateHitTestIndex();
 }
 
 //==============================================================================
@@ -454,14 +527,32 @@ Component* Component::findComponentAt (const Point<float>& p)
 {
     if (options.isVisible && boundsInParent.withZeroPosition().contains (p))
     {
-        for (int index = children.size(); --index >= 0;)
+        const auto findInChild = [&p] (Component* child) -> Component*
         {
-            auto child = children.getUnchecked (index);
             if (child == nullptr || ! child->isVisible() || ! child->boundsInParent.contains (p))
-                continue;
+                return nullptr;
 
-            child = child->findComponentAt (p - child->boundsInParent.getPosition());
-            if (child != nullptr)
+            return child->findComponentAt (p - child->boundsInParent.getPosition());
+        };
+
+        if (hitTestIndex != nullptr)
+        {
+            if (! hitTestIndex->isValid())
+                hitTestIndex->rebuild (getLocalBounds(), children);
+
+            const auto candidates = hitTestIndex->getCandidatesAt (p);
+            for (auto index = candidates.size(); index-- > 0;)
+            {
+                if (auto child = findInChild (children.getUnchecked (candidates[index])))
+                    return child;
+            }
+
+            return this;
+        }
+
+        for (int index = children.size(); --index >= 0;)
+        {
+            if (auto child = findInChild (children.getUnchecked (index)))
                 return child;
         }
 
@@ -471,6 +562,22 @@ Component* Component::findComponentAt (const Point<float>& p)
     return nullptr;
 }
 
+void Component::enableHitTestIndex (bool shouldBeEnabled)
+{
+    if (shouldBeEnabled == isHitTestIndexEnabled())
+        return;
+
+    if (shouldBeEnabled)
+        hitTestIndex = std::make_unique<HitTestIndex>();
+    else
+        hitTestIndex.reset();
+}
+
+bool Component::isHitTestIndexEnabled() const
+{
+    return hitTestIndex != nullptr;
+}
+
 //==============================================================================
 
 void Component::toFront()
@@ -623,6 +730,26 @@ void Component::internalRefreshDisplay (double lastFrameTimeSeconds)
 
 //==============================================================================
 
+void Component::internalPaint (Graphics& g, const RectangleList<float>& repaintRegions, bool renderContinuous)
+{
+    if (! isVisible() || (getWidth() == 0 || getHeight() == 0))
+        return;
+
+    const auto bounds = getBoundsRelativeToAncestor();
+
+    // Run one scissored pass per damaged region, so untouched pixels between regions are never drawn
+    for (const auto& region : repaintRegions)
+    {
+        if (! renderContinuous && ! region.intersects (bounds))
+            continue;
+
+        const auto regionState = g.saveState();
+        g.setClipPath (region);
+
+        internalPaint (g, region, renderContinuous);
+    }
+}
+
 void Component::internalPaint (Graphics& g, const Rectangle<float>& repaintArea, bool renderContinuous)
 {
     if (! isVisible() || (getWidth() == 0 || getHeight() == 0))
@@ -649,7 +776,10 @@ void Component::internalPaint (Graphics& g, const Rectangle<float>& repaintArea,
     {
         const auto paintState = g.saveState();
 
-        paint (g);
+        if (displayList != nullptr)
+            g.drawDisplayList (*displayList, [this] (Graphics& recorder) { paint (recorder); });
+        else
+            paint (g);
     }
 
     for (auto child : children)
@@ -778,13 +908,21 @@ void Component::internalResized (int width, int height)
 {
     boundsInParent = boundsInParent.withSize (Size<float> (width, height));
 
+    invalidateHitTestIndex();
+    invalidateParentHitTestIndex();
+
     resized();
 }
 
 void Component::internalMoved (int xpos, int ypos)
 {
+    if (boundsInParent.getPosition() != Point<float> (xpos, ypos))
+        invalidateAncestorPosition();
+
     boundsInParent = boundsInParent.withPosition (Point<float> (xpos, ypos));
 
+    invalidateParentHitTestIndex();
+
     moved();
 }
 
@@ -798,4 +936,16 @@ void Component::internalUserTriedToCloseWindow()
     userTriedToCloseWindow();
 }
 
+void Component::invalidateHitTestIndex()
+{
+    if (hitTestIndex != nullptr)
+        hitTestIndex->invalidate();
+}
+
+void Component::invalidateParentHitTestIndex()
+{
+    if (parentComponent != nullptr)
+        parentComponent->invalidateHitTestIndex();
+}
+
 } // namespace yup
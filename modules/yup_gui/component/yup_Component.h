@@ -84,6 +84,16 @@ public:
     virtual void enableRenderingUnclipped (bool shouldBeEnabled);
     bool isRenderingUnclipped() const;
 
+    /** Enables retained painting for this component.
+
+        When enabled, the drawing operations performed in paint() are recorded into a display list and replayed
+        on the following frames, until repaint() is called or the component is moved, resized or its opacity
+        changes. Only enable it for components whose paint() output depends solely on their own state, and that
+        don't draw render objects that are modified outside of paint() (like animated artboards).
+    */
+    virtual void enableRetainedPainting (bool shouldBeEnabled);
+    bool isRetainedPaintingEnabled() const;
+
     void repaint();
     void repaint (const Rectangle<float>& rect);
 
@@ -138,6 +148,16 @@ public:
     Component* getComponentAt (int index) const;
     Component* findComponentAt (const Point<float>& p);
 
+    /** Enables a spatial index of the children of this component, used by findComponentAt.
+
+        Without the index, finding the component under a point checks every visible child in reverse
+        z-order, which becomes costly for containers with many children receiving a stream of mouse
+        moves. The index is rebuilt lazily on the first hit test following a change of the size of
+        this component, of its children or of their bounds and visibility.
+    */
+    void enableHitTestIndex (bool shouldBeEnabled);
+    bool isHitTestIndexEnabled() const;
+
     //==============================================================================
     void toFront();
     void toBack();
@@ -186,6 +206,7 @@ public:
 
 private:
     void internalRefreshDisplay (double lastFrameTimeSeconds);
+    void internalPaint (Graphics& g, const RectangleList<float>& repaintRegions, bool renderContinuous);
     void internalPaint (Graphics& g, const Rectangle<float>& repaintArea, bool renderContinuous);
     void internalMouseEnter (const MouseEvent& event);
     void internalMouseExit (const MouseEvent& event);
@@ -202,6 +223,10 @@ private:
     void internalResized (int width, int height);
     void internalContentScaleChanged(float dpiScale);
     void internalUserTriedToCloseWindow();
+    void invalidateHitTestIndex();
+    void invalidateParentHitTestIndex();
+    Point<float> getPositionRelativeToAncestor() const;
+    void invalidateAncestorPosition (bool evenIfAlreadyInvalid = false);
 
     friend class ComponentNative;
     friend class GLFWComponentNative;
@@ -214,10 +239,14 @@ private:
     Component* parentComponent = nullptr;
     Array<Component*> children;
     Rectangle<float> boundsInParent;
+    mutable Point<float> ancestorPosition;
+    mutable bool ancestorPositionValid = false;
     std::unique_ptr<ComponentNative> native;
     WeakReference<Component>::Master masterReference;
     MouseListenerList mouseListeners;
     NamedValueSet properties;
+    std::unique_ptr<DisplayList> displayList;
+    std::unique_ptr<HitTestIndex> hitTestIndex;
     uint8 opacity = 255;
 
     struct Options
@@ -121,6 +121,18 @@ public:
         bool updateOnlyWhenFocused = false;              ///<
     };
 
+    //==============================================================================
+    /** Statistics about the frames produced by a native component, with timings in milliseconds. */
+    struct FrameTimings
+    {
+        double refreshMs = 0.0;       ///< Time spent refreshing the display of the components.
+        double paintMs = 0.0;         ///< Time spent painting the components into the renderer.
+        double contextEndMs = 0.0;    ///< Time spent flushing the rendered frame in the graphics context.
+        double frameMs = 0.0;         ///< Total time spent producing the frame, including the swap.
+        int64 numRenderedFrames = 0;  ///< Number of frames rendered so far.
+        int64 numSkippedFrames = 0;   ///< Number of frames skipped because nothing needed repainting.
+    };
+
     //==============================================================================
     ComponentNative (Component& newComponent, const Flags& newFlags);
     virtual ~ComponentNative();
@@ -171,6 +183,7 @@ public:
     virtual void repaint() = 0;
     virtual void repaint (const Rectangle<float>& rect) = 0;
     virtual Rectangle<float> getRepaintArea() const = 0;
+    virtual const RectangleList<float>& getRepaintRegions() const = 0;
 
     //==============================================================================
     virtual float getScaleDpi() const = 0;
@@ -178,6 +191,7 @@ public:
     //==============================================================================
     virtual float getCurrentFrameRate() const = 0;
     virtual float getDesiredFrameRate() const = 0;
+    virtual FrameTimings getLastFrameTimings() const = 0;
 
     //==============================================================================
     virtual void* getNativeHandle() const = 0;
@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+//==============================================================================
+
+void HitTestIndex::rebuild (const Rectangle<float>& newArea, const Array<Component*>& children)
+{
+    constexpr int maxCellsPerAxis = 256;
+    constexpr float childrenPerCell = 2.0f;
+
+    area = newArea;
+    valid = true;
+
+    cellStarts.clear();
+    cellEntries.clear();
+
+    // Aim at a few children per cell, with cells following the aspect ratio of the area
+    const auto numCells = jmax (1.0f, static_cast<float> (children.size()) / childrenPerCell);
+    const auto aspectRatio = area.getHeight() > 0.0f ? area.getWidth() / area.getHeight() : 1.0f;
+
+    numColumns = jlimit (1, maxCellsPerAxis, roundToInt (std::ceil (std::sqrt (numCells * aspectRatio))));
+    numRows = jlimit (1, maxCellsPerAxis, roundToInt (std::ceil (numCells / static_cast<float> (numColumns))));
+    cellWidth = area.getWidth() / static_cast<float> (numColumns);
+    cellHeight = area.getHeight() / static_cast<float> (numRows);
+
+    if (area.isEmpty())
+    {
+        cellStarts.assign (static_cast<std::size_t> (getNumCells() + 1), 0);
+        return;
+    }
+
+    // Store the cells as compressed rows: count the entries of each cell, then fill them in z-order
+    const auto forEachCell = [this, &children] (auto&& callback)
+    {
+        for (int index = 0; index < children.size(); ++index)
+        {
+            auto child = children.getUnchecked (index);
+            if (child == nullptr || ! child->isVisible())
+                continue;
+
+            const auto bounds = child->getBounds().intersection (area);
+            if (bounds.isEmpty())
+                continue;
+
+            const auto firstColumn = getColumn (bounds.getX());
+            const auto lastColumn = getColumn (bounds.getX() + bounds.getWidth());
+            const auto firstRow = getRow (bounds.getY());
+            const auto lastRow = getRow (bounds.getY() + bounds.getHeight());
+
+            for (int row = firstRow; row <= lastRow; ++row)
+                for (int column = firstColumn; column <= lastColumn; ++column)
+                    callback (row * numColumns + column, index);
+        }
+    };
+
+    std::vector<int> cellCounts (static_cast<std::size_t> (getNumCells()), 0);
+    forEachCell ([&] (int cell, int)
+    {
+        ++cellCounts[static_cast<std::size_t> (cell)];
+    });
+
+    cellStarts.resize (cellCounts.size() + 1);
+    cellStarts[0] = 0;
+    for (std::size_t cell = 0; cell < cellCounts.size(); ++cell)
+        cellStarts[cell + 1] = cellStarts[cell] + cellCounts[cell];
+
+    cellEntries.resize (static_cast<std::size_t> (cellStarts.back()));
+    std::fill (cellCounts.begin(), cellCounts.end(), 0);
+
+    forEachCell ([&] (int cell, int index)
+    {
+        const auto cellIndex = static_cast<std::size_t> (cell);
+        cellEntries[static_cast<std::size_t> (cellStarts[cellIndex] + cellCounts[cellIndex]++)] = index;
+    });
+}
+
+//==============================================================================
+
+Span<const int> HitTestIndex::getCandidatesAt (const Point<float>& p) const noexcept
+{
+    jassert (valid);
+
+    if (cellEntries.empty() || ! area.contains (p))
+        return {};
+
+    const auto cell = static_cast<std::size_t> (getRow (p.getY()) * numColumns + getColumn (p.getX()));
+    const auto start = cellStarts[cell];
+
+    return { cellEntries.data() + start, static_cast<std::size_t> (cellStarts[cell + 1] - start) };
+}
+
+//==============================================================================
+
+int HitTestIndex::getColumn (float x) const noexcept
+{
+    return jlimit (0, numColumns - 1, static_cast<int> ((x - area.getX()) / cellWidth));
+}
+
+int HitTestIndex::getRow (float y) const noexcept
+{
+    return jlimit (0, numRows - 1, static_cast<int> ((y - area.getY()) / cellHeight));
+}
+
+} // namespace yup
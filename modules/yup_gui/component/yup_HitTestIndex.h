@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+class Component;
+
+//==============================================================================
+/** A uniform grid of the child components of a container, used to speed up hit testing.
+
+    Each cell of the grid holds the indices of the children overlapping it, in z-order, so a hit
+    test only has to check the few children registered in the cell under the point instead of
+    all of them. The grid resolution adapts to the number of children, keeping the number of
+    entries per cell roughly constant.
+
+    The index doesn't track changes by itself: the owning component invalidates it whenever its
+    size, its children or their bounds and visibility change, and rebuilds it lazily on the next
+    hit test.
+
+    @see Component::enableHitTestIndex
+*/
+class JUCE_API HitTestIndex
+{
+public:
+    //==============================================================================
+    /** Constructs an empty, invalid index. */
+    HitTestIndex() = default;
+
+    //==============================================================================
+    /** Marks the index as out of date. */
+    void invalidate() noexcept { valid = false; }
+
+    /** Returns true if the index reflects the current layout of the children. */
+    bool isValid() const noexcept { return valid; }
+
+    /** Rebuilds the index.
+
+        @param area The local bounds of the container.
+        @param children The children of the container, in z-order.
+    */
+    void rebuild (const Rectangle<float>& area, const Array<Component*>& children);
+
+    //==============================================================================
+    /** Returns the indices of the visible children that might contain a point, in z-order.
+
+        @param p The point, relative to the container.
+    */
+    Span<const int> getCandidatesAt (const Point<float>& p) const noexcept;
+
+    //==============================================================================
+    /** Returns the number of cells in the grid. */
+    int getNumCells() const noexcept { return numColumns * numRows; }
+
+private:
+    int getColumn (float x) const noexcept;
+    int getRow (float y) const noexcept;
+
+    Rectangle<float> area;
+    int numColumns = 0;
+    int numRows = 0;
+    float cellWidth = 0.0f;
+    float cellHeight = 0.0f;
+    std::vector<int> cellStarts;
+    std::vector<int> cellEntries;
+    bool valid = false;
+};
+
+} // namespace yup
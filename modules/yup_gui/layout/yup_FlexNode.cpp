@@ -0,0 +1,428 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace yup
+{
+
+namespace
+{
+
+//==============================================================================
+
+YGFlexDirection toYoga (FlexNode::Direction direction) noexcept
+{
+    switch (direction)
+    {
+        case FlexNode::Direction::Column:        return YGFlexDirectionColumn;
+        case FlexNode::Direction::ColumnReverse: return YGFlexDirectionColumnReverse;
+        case FlexNode::Direction::Row:           return YGFlexDirectionRow;
+        case FlexNode::Direction::RowReverse:    return YGFlexDirectionRowReverse;
+    }
+
+    return YGFlexDirectionColumn;
+}
+
+YGWrap toYoga (FlexNode::Wrap wrap) noexcept
+{
+    switch (wrap)
+    {
+        case FlexNode::Wrap::NoWrap:      return YGWrapNoWrap;
+        case FlexNode::Wrap::Wrap:        return YGWrapWrap;
+        case FlexNode::Wrap::WrapReverse: return YGWrapWrapReverse;
+    }
+
+    return YGWrapNoWrap;
+}
+
+YGJustify toYoga (FlexNode::Justify justify) noexcept
+{
+    switch (justify)
+    {
+        case FlexNode::Justify::FlexStart:    return YGJustifyFlexStart;
+        case FlexNode::Justify::Center:       return YGJustifyCenter;
+        case FlexNode::Justify::FlexEnd:      return YGJustifyFlexEnd;
+        case FlexNode::Justify::SpaceBetween: return YGJustifySpaceBetween;
+        case FlexNode::Justify::SpaceAround:  return YGJustifySpaceAround;
+        case FlexNode::Justify::SpaceEvenly:  return YGJustifySpaceEvenly;
+    }
+
+    return YGJustifyFlexStart;
+}
+
+YGAlign toYoga (FlexNode::Align align) noexcept
+{
+    switch (align)
+    {
+        case FlexNode::Align::Auto:         return YGAlignAuto;
+        case FlexNode::Align::FlexStart:    return YGAlignFlexStart;
+        case FlexNode::Align::Center:       return YGAlignCenter;
+        case FlexNode::Align::FlexEnd:      return YGAlignFlexEnd;
+        case FlexNode::Align::Stretch:      return YGAlignStretch;
+        case FlexNode::Align::Baseline:     return YGAlignBaseline;
+        case FlexNode::Align::SpaceBetween: return YGAlignSpaceBetween;
+        case FlexNode::Align::SpaceAround:  return YGAlignSpaceAround;
+    }
+
+    return YGAlignAuto;
+}
+
+YGEdge toYoga (FlexNode::Edge edge) noexcept
+{
+    switch (edge)
+    {
+        case FlexNode::Edge::Left:       return YGEdgeLeft;
+        case FlexNode::Edge::Top:        return YGEdgeTop;
+        case FlexNode::Edge::Right:      return YGEdgeRight;
+        case FlexNode::Edge::Bottom:     return YGEdgeBottom;
+        case FlexNode::Edge::Horizontal: return YGEdgeHorizontal;
+        case FlexNode::Edge::Vertical:   return YGEdgeVertical;
+        case FlexNode::Edge::All:        return YGEdgeAll;
+    }
+
+    return YGEdgeAll;
+}
+
+YGPositionType toYoga (FlexNode::PositionType positionType) noexcept
+{
+    return positionType == FlexNode::PositionType::Absolute ? YGPositionTypeAbsolute : YGPositionTypeRelative;
+}
+
+float toAvailableSize (float size, YGMeasureMode mode) noexcept
+{
+    return mode == YGMeasureModeUndefined ? std::numeric_limits<float>::infinity() : size;
+}
+
+} // namespace
+
+//==============================================================================
+
+FlexNode::FlexNode()
+    : node (YGNodeNew())
+{
+    YGNodeSetContext (node, this);
+}
+
+FlexNode::FlexNode (Component& component)
+    : FlexNode()
+{
+    this->component = &component;
+}
+
+FlexNode::~FlexNode()
+{
+    if (parent != nullptr)
+        parent->removeChild (*this);
+
+    for (auto child : children)
+        child->parent = nullptr;
+
+    YGNodeRemoveAllChildren (node);
+    YGNodeFree (node);
+}
+
+//==============================================================================
+
+FlexNode& FlexNode::addChild (FlexNode& child)
+{
+    return insertChild (child, getNumChildren());
+}
+
+FlexNode& FlexNode::insertChild (FlexNode& child, int index)
+{
+    jassert (&child != this);
+    jassert (measureFunction == nullptr); // Nodes with a measure function can't have children
+
+    if (child.parent != nullptr)
+        child.parent->removeChild (child);
+
+    index = jlimit (0, getNumChildren(), index);
+
+    children.insert (children.begin() + index, &child);
+    child.parent = this;
+
+    YGNodeInsertChild (node, child.node, static_cast<uint32_t> (index));
+
+    return *this;
+}
+
+void FlexNode::removeChild (FlexNode& child)
+{
+    auto it = std::find (children.begin(), children.end(), &child);
+    if (it == children.end())
+        return;
+
+    children.erase (it);
+    child.parent = nullptr;
+
+    YGNodeRemoveChild (node, child.node);
+}
+
+FlexNode* FlexNode::getChild (int index) const noexcept
+{
+    return isPositiveAndBelow (index, getNumChildren()) ? children[static_cast<std::size_t> (index)] : nullptr;
+}
+
+//==============================================================================
+
+FlexNode& FlexNode::setDirection (Direction direction)
+{
+    YGNodeStyleSetFlexDirection (node, toYoga (direction));
+    return *this;
+}
+
+FlexNode& FlexNode::setWrap (Wrap wrap)
+{
+    YGNodeStyleSetFlexWrap (node, toYoga (wrap));
+    return *this;
+}
+
+FlexNode& FlexNode::setJustifyContent (Justify justify)
+{
+    YGNodeStyleSetJustifyContent (node, toYoga (justify));
+    return *this;
+}
+
+FlexNode& FlexNode::setAlignItems (Align align)
+{
+    YGNodeStyleSetAlignItems (node, toYoga (align));
+    return *this;
+}
+
+FlexNode& FlexNode::setAlignContent (Align align)
+{
+    YGNodeStyleSetAlignContent (node, toYoga (align));
+    return *this;
+}
+
+FlexNode& FlexNode::setAlignSelf (Align align)
+{
+    YGNodeStyleSetAlignSelf (node, toYoga (align));
+    return *this;
+}
+
+FlexNode& FlexNode::setPositionType (PositionType positionType)
+{
+    YGNodeStyleSetPositionType (node, toYoga (positionType));
+    return *this;
+}
+
+FlexNode& FlexNode::setPosition (Edge edge, float position)
+{
+    YGNodeStyleSetPosition (node, toYoga (edge), position);
+    return *this;
+}
+
+FlexNode& FlexNode::setFlexGrow (float flexGrow)
+{
+    YGNodeStyleSetFlexGrow (node, flexGrow);
+    return *this;
+}
+
+FlexNode& FlexNode::setFlexShrink (float flexShrink)
+{
+    YGNodeStyleSetFlexShrink (node, flexShrink);
+    return *this;
+}
+
+FlexNode& FlexNode::setFlexBasis (float flexBasis)
+{
+    YGNodeStyleSetFlexBasis (node, flexBasis);
+    return *this;
+}
+
+FlexNode& FlexNode::setWidth (float width)
+{
+    YGNodeStyleSetWidth (node, width);
+    return *this;
+}
+
+FlexNode& FlexNode::setWidthPercent (float percent)
+{
+    YGNodeStyleSetWidthPercent (node, percent);
+    return *this;
+}
+
+FlexNode& FlexNode::setHeight (float height)
+{
+    YGNodeStyleSetHeight (node, height);
+    return *this;
+}
+
+FlexNode& FlexNode::setHeightPercent (float percent)
+{
+    YGNodeStyleSetHeightPercent (node, percent);
+    return *this;
+}
+
+FlexNode& FlexNode::setMinWidth (float minWidth)
+{
+    YGNodeStyleSetMinWidth (node, minWidth);
+    return *this;
+}
+
+FlexNode& FlexNode::setMinHeight (float minHeight)
+{
+    YGNodeStyleSetMinHeight (node, minHeight);
+    return *this;
+}
+
+FlexNode& FlexNode::setMaxWidth (float maxWidth)
+{
+    YGNodeStyleSetMaxWidth (node, maxWidth);
+    return *this;
+}
+
+FlexNode& FlexNode::setMaxHeight (float maxHeight)
+{
+    YGNodeStyleSetMaxHeight (node, maxHeight);
+    return *this;
+}
+
+FlexNode& FlexNode::setAspectRatio (float aspectRatio)
+{
+    YGNodeStyleSetAspectRatio (node, aspectRatio);
+    return *this;
+}
+
+FlexNode& FlexNode::setMargin (Edge edge, float margin)
+{
+    YGNodeStyleSetMargin (node, toYoga (edge), margin);
+    return *this;
+}
+
+FlexNode& FlexNode::setPadding (Edge edge, float padding)
+{
+    YGNodeStyleSetPadding (node, toYoga (edge), padding);
+    return *this;
+}
+
+FlexNode& FlexNode::setGap (float gap)
+{
+    YGNodeStyleSetGap (node, YGGutterAll, gap);
+    return *this;
+}
+
+FlexNode& FlexNode::setDisplayed (bool shouldBeDisplayed)
+{
+    YGNodeStyleSetDisplay (node, shouldBeDisplayed ? YGDisplayFlex : YGDisplayNone);
+    return *this;
+}
+
+//==============================================================================
+
+void FlexNode::setMeasureFunction (MeasureFunction newMeasureFunction)
+{
+    jassert (children.empty()); // Only leaf nodes can be measured
+
+    measureFunction = std::move (newMeasureFunction);
+
+    if (measureFunction == nullptr)
+    {
+        YGNodeSetMeasureFunc (node, nullptr);
+        return;
+    }
+
+    YGNodeSetMeasureFunc (node, [] (YGNodeRef ygNode, float width, YGMeasureMode widthMode, float height, YGMeasureMode heightMode)
+    {
+        auto self = static_cast<FlexNode*> (YGNodeGetContext (ygNode));
+        const auto size = self->measureFunction (toAvailableSize (width, widthMode), toAvailableSize (height, heightMode));
+
+        return YGSize { size.getWidth(), size.getHeight() };
+    });
+
+    YGNodeMarkDirty (node);
+}
+
+void FlexNode::markDirty()
+{
+    // Yoga only tracks content changes for measured nodes, style changes mark the node dirty by themselves
+    if (measureFunction != nullptr)
+        YGNodeMarkDirty (node);
+}
+
+bool FlexNode::isDirty() const
+{
+    return YGNodeIsDirty (node);
+}
+
+//==============================================================================
+
+int FlexNode::performLayout()
+{
+    jassert (component != nullptr);
+
+    return performLayout (component->getLocalBounds());
+}
+
+int FlexNode::performLayout (const Rectangle<float>& area)
+{
+    jassert (parent == nullptr); // Layouts are computed from the root of the tree
+
+    // Yoga skips the branches that are neither dirty nor constrained differently, and flags the nodes
+    // it visited as having a new layout, so only those need to be applied to the components
+    YGNodeCalculateLayout (node, area.getWidth(), area.getHeight(), YGDirectionLTR);
+
+    int numChangedBounds = 0;
+    applyLayout (area.getPosition(), false, numChangedBounds);
+    return numChangedBounds;
+}
+
+Rectangle<float> FlexNode::getLayoutBounds() const
+{
+    return { YGNodeLayoutGetLeft (node), YGNodeLayoutGetTop (node), YGNodeLayoutGetWidth (node), YGNodeLayoutGetHeight (node) };
+}
+
+void FlexNode::applyLayout (Point<float> offset, bool force, int& numChangedBounds)
+{
+    if (! force && ! YGNodeGetHasNewLayout (node))
+        return;
+
+    YGNodeSetHasNewLayout (node, false);
+
+    const auto bounds = (parent == nullptr ? getLayoutBounds().withZeroPosition() : getLayoutBounds()).translated (offset);
+
+    // Children of a component are placed relative to it, while the children of a layout group are
+    // placed in the same component as the group, so they need to follow it when it moves
+    auto childOffset = Point<float>();
+    auto forceChildren = false;
+
+    if (component != nullptr && parent != nullptr)
+    {
+        if (component->getBounds() != bounds)
+        {
+            component->setBounds (bounds);
+            ++numChangedBounds;
+        }
+    }
+    else
+    {
+        childOffset = bounds.getPosition();
+        forceChildren = bounds.getPosition() != lastAppliedBounds.getPosition();
+    }
+
+    lastAppliedBounds = bounds;
+
+    for (auto child : children)
+        child->applyLayout (childOffset, forceChildren, numChangedBounds);
+}
+
+} // namespace yup
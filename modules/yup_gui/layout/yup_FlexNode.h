@@ -0,0 +1,232 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+struct YGNode;
+
+namespace yup
+{
+
+//==============================================================================
+/** A node of a flexbox layout, backed by Yoga.
+
+    Nodes are arranged in a tree mirroring the component hierarchy: the root node is bound to the
+    container, and each child node is bound to a component that is a child of the component bound
+    to its nearest ancestor node. Nodes without a component act as layout groups, their children
+    being placed in the component of the nearest ancestor node.
+
+    The layout is incremental: changing the style of a node, adding or removing nodes, or marking a
+    node with a measure function as dirty only invalidates the branch leading to it. Calling
+    performLayout() on the root then recomputes the dirty branches only, and calls setBounds() on
+    the components whose geometry actually changed.
+
+    @code
+    struct Editor : Component
+    {
+        Editor()
+        {
+            layout.setDirection (FlexNode::Direction::Row).setPadding (FlexNode::Edge::All, 8.0f);
+            layout.addChild (sidebar.setWidth (200.0f));
+            layout.addChild (content.setFlexGrow (1.0f));
+        }
+
+        void resized() override { layout.performLayout(); }
+
+        Component sidebarComponent, contentComponent;
+        FlexNode layout { *this }, sidebar { sidebarComponent }, content { contentComponent };
+    };
+    @endcode
+*/
+class JUCE_API FlexNode
+{
+public:
+    //==============================================================================
+    /** The direction of the main axis of a container. */
+    enum class Direction
+    {
+        Column,
+        ColumnReverse,
+        Row,
+        RowReverse
+    };
+
+    /** How the children of a container wrap into multiple lines. */
+    enum class Wrap
+    {
+        NoWrap,
+        Wrap,
+        WrapReverse
+    };
+
+    /** How the children of a container are distributed along the main axis. */
+    enum class Justify
+    {
+        FlexStart,
+        Center,
+        FlexEnd,
+        SpaceBetween,
+        SpaceAround,
+        SpaceEvenly
+    };
+
+    /** How children or lines are aligned along the cross axis. */
+    enum class Align
+    {
+        Auto,
+        FlexStart,
+        Center,
+        FlexEnd,
+        Stretch,
+        Baseline,
+        SpaceBetween,
+        SpaceAround
+    };
+
+    /** The edges margins, paddings and positions apply to. */
+    enum class Edge
+    {
+        Left,
+        Top,
+        Right,
+        Bottom,
+        Horizontal,
+        Vertical,
+        All
+    };
+
+    /** Whether a node takes part in the flow of its container. */
+    enum class PositionType
+    {
+        Relative,
+        Absolute
+    };
+
+    /** Measures the content of a leaf node.
+
+        The arguments are the maximum width and height available, infinite when unconstrained.
+    */
+    using MeasureFunction = std::function<Size<float> (float maxWidth, float maxHeight)>;
+
+    //==============================================================================
+    /** Creates a layout group, not bound to any component. */
+    FlexNode();
+
+    /** Creates a node bound to a component. */
+    explicit FlexNode (Component& component);
+
+    /** Destructor, detaching the node from its parent and children. */
+    ~FlexNode();
+
+    //==============================================================================
+    /** Returns the component bound to this node, or nullptr for layout groups. */
+    Component* getComponent() const noexcept { return component; }
+
+    //==============================================================================
+    /** Appends a child node. */
+    FlexNode& addChild (FlexNode& child);
+
+    /** Inserts a child node at a given index. */
+    FlexNode& insertChild (FlexNode& child, int index);
+
+    /** Removes a child node. */
+    void removeChild (FlexNode& child);
+
+    /** Returns the number of child nodes. */
+    int getNumChildren() const noexcept { return static_cast<int> (children.size()); }
+
+    /** Returns a child node. */
+    FlexNode* getChild (int index) const noexcept;
+
+    /** Returns the parent node, or nullptr for the root. */
+    FlexNode* getParent() const noexcept { return parent; }
+
+    //==============================================================================
+    FlexNode& setDirection (Direction direction);
+    FlexNode& setWrap (Wrap wrap);
+    FlexNode& setJustifyContent (Justify justify);
+    FlexNode& setAlignItems (Align align);
+    FlexNode& setAlignContent (Align align);
+    FlexNode& setAlignSelf (Align align);
+    FlexNode& setPositionType (PositionType positionType);
+    FlexNode& setPosition (Edge edge, float position);
+    FlexNode& setFlexGrow (float flexGrow);
+    FlexNode& setFlexShrink (float flexShrink);
+    FlexNode& setFlexBasis (float flexBasis);
+    FlexNode& setWidth (float width);
+    FlexNode& setWidthPercent (float percent);
+    FlexNode& setHeight (float height);
+    FlexNode& setHeightPercent (float percent);
+    FlexNode& setMinWidth (float minWidth);
+    FlexNode& setMinHeight (float minHeight);
+    FlexNode& setMaxWidth (float maxWidth);
+    FlexNode& setMaxHeight (float maxHeight);
+    FlexNode& setAspectRatio (float aspectRatio);
+    FlexNode& setMargin (Edge edge, float margin);
+    FlexNode& setPadding (Edge edge, float padding);
+    FlexNode& setGap (float gap);
+
+    /** Excludes the node and its children from the layout, collapsing their components to an empty size. */
+    FlexNode& setDisplayed (bool shouldBeDisplayed);
+
+    //==============================================================================
+    /** Sets the function measuring the content of this node.
+
+        Only leaf nodes can have a measure function. Call markDirty() when the content changes, so the
+        next layout measures it again.
+    */
+    void setMeasureFunction (MeasureFunction measureFunction);
+
+    /** Marks the content of a node with a measure function as changed. */
+    void markDirty();
+
+    /** Returns true if the node or any of its descendants needs a new layout. */
+    bool isDirty() const;
+
+    //==============================================================================
+    /** Lays out the tree into the local bounds of the component bound to this root node.
+
+        @return The number of components whose bounds have been changed.
+    */
+    int performLayout();
+
+    /** Lays out the tree into an area of the component bound to this root node.
+
+        @return The number of components whose bounds have been changed.
+    */
+    int performLayout (const Rectangle<float>& area);
+
+    /** Returns the bounds computed by the last layout, relative to the parent node. */
+    Rectangle<float> getLayoutBounds() const;
+
+private:
+    void applyLayout (Point<float> offset, bool force, int& numChangedBounds);
+
+    YGNode* node = nullptr;
+    Component* component = nullptr;
+    FlexNode* parent = nullptr;
+    std::vector<FlexNode*> children;
+    MeasureFunction measureFunction;
+    Rectangle<float> lastAppliedBounds;
+
+    JUCE_DECLARE_NON_COPYABLE (FlexNode)
+};
+
+} // namespace yup
@@ -28,6 +28,233 @@ std::atomic_flag SDL2ComponentNative::isInitialised = ATOMIC_FLAG_INIT;
 
 //==============================================================================
 
+namespace
+{
+
+constexpr int maxRepaintRegions = 8;
+constexpr float maxMergeWasteRatio = 0.25f;
+
+/** Adds a dirty rectangle to a list of repaint regions, coalescing it with the existing ones.
+
+    Two regions are merged when they overlap, or when their union wastes less than a fraction of
+    its area, so nearby updates share a single pass while distant ones stay separate. When there are
+    too many regions, the pair whose union adds the least area gets merged.
+*/
+void addRepaintRegion (RectangleList<float>& regions, Rectangle<float> rect)
+{
+    if (rect.isEmpty())
+        return;
+
+    std::vector<Rectangle<float>> pending (regions.begin(), regions.end());
+
+    for (bool mergedAny = true; mergedAny;)
+    {
+        mergedAny = false;
+
+        for (auto it = pending.begin(); it != pending.end(); ++it)
+        {
+            const auto merged = it->smallestContainingRectangle (rect);
+            const auto wastedArea = merged.area() - (it->area() + rect.area() - it->intersection (rect).area());
+
+            if (it->intersects (rect) || wastedArea <= merged.area() * maxMergeWasteRatio)
+            {
+                rect = merged;
+                pending.erase (it);
+                mergedAny = true;
+                break;
+            }
+        }
+    }
+
+    pending.push_back (rect);
+
+    while (static_cast<int> (pending.size()) > maxRepaintRegions)
+    {
+        std::size_t bestFirst = 0, bestSecond = 1;
+        float bestGrowth = std::numeric_limits<float>::max();
+
+        for (std::size_t i = 0; i < pending.size(); ++i)
+        {
+            for (std::size_t j = i + 1; j < pending.size(); ++j)
+            {
+                const auto growth = pending[i].smallestContainingRectangle (pending[j]).area() - pending[i].area() - pending[j].area();
+                if (growth < bestGrowth)
+                {
+                    bestGrowth = growth;
+                    bestFirst = i;
+                    bestSecond = j;
+                }
+            }
+        }
+
+        pending[bestFirst] = pending[bestFirst].smallestContainingRectangle (pending[bestSecond]);
+        pending.erase (pending.begin() + static_cast<std::ptrdiff_t> (bestSecond));
+    }
+
+    regions.clear();
+    for (const auto& region : pending)
+        regions.addWithoutMerge (region);
+}
+
+#if JUCE_LINUX || JUCE_BSD || JUCE_ANDROID
+/** Queries the back buffer age of the EGL or GLX surface the current OpenGL context draws into.
+
+    SDL doesn't expose the buffer age, so the entry points are resolved from the system libraries SDL
+    already loaded. The age is only queried when the current context belongs to one of them, and its
+    display advertises the buffer age extension.
+*/
+class OpenGLBufferAgeQuery
+{
+public:
+    OpenGLBufferAgeQuery()
+    {
+#if JUCE_ANDROID
+        egl.library = SDL_LoadObject ("libEGL.so");
+#else
+        egl.library = SDL_LoadObject ("libEGL.so.1");
+        glx.library = SDL_LoadObject ("libGL.so.1");
+#endif
+
+        if (egl.library != nullptr)
+        {
+            egl.getCurrentContext = reinterpret_cast<decltype (egl.getCurrentContext)> (SDL_LoadFunction (egl.library, "eglGetCurrentContext"));
+            egl.getCurrentDisplay = reinterpret_cast<decltype (egl.getCurrentDisplay)> (SDL_LoadFunction (egl.library, "eglGetCurrentDisplay"));
+            egl.getCurrentSurface = reinterpret_cast<decltype (egl.getCurrentSurface)> (SDL_LoadFunction (egl.library, "eglGetCurrentSurface"));
+            egl.queryString = reinterpret_cast<decltype (egl.queryString)> (SDL_LoadFunction (egl.library, "eglQueryString"));
+            egl.querySurface = reinterpret_cast<decltype (egl.querySurface)> (SDL_LoadFunction (egl.library, "eglQuerySurface"));
+        }
+
+        if (glx.library != nullptr)
+        {
+            glx.getCurrentContext = reinterpret_cast<decltype (glx.getCurrentContext)> (SDL_LoadFunction (glx.library, "glXGetCurrentContext"));
+            glx.getCurrentDisplay = reinterpret_cast<decltype (glx.getCurrentDisplay)> (SDL_LoadFunction (glx.library, "glXGetCurrentDisplay"));
+            glx.getCurrentDrawable = reinterpret_cast<decltype (glx.getCurrentDrawable)> (SDL_LoadFunction (glx.library, "glXGetCurrentDrawable"));
+            glx.queryExtensionsString = reinterpret_cast<decltype (glx.queryExtensionsString)> (SDL_LoadFunction (glx.library, "glXQueryExtensionsString"));
+            glx.queryDrawable = reinterpret_cast<decltype (glx.queryDrawable)> (SDL_LoadFunction (glx.library, "glXQueryDrawable"));
+        }
+    }
+
+    ~OpenGLBufferAgeQuery()
+    {
+        if (egl.library != nullptr)
+            SDL_UnloadObject (egl.library);
+
+        if (glx.library != nullptr)
+            SDL_UnloadObject (glx.library);
+    }
+
+    /** Returns the age of the current back buffer, or 0 if it can't be queried. */
+    int getBufferAge() const
+    {
+        if (egl.isAvailable() && egl.getCurrentContext() != nullptr)
+        {
+            auto* display = egl.getCurrentDisplay();
+            const auto* extensions = egl.queryString (display, eglExtensions);
+
+            int32 age = 0;
+            if (extensions != nullptr && std::strstr (extensions, "EGL_EXT_buffer_age") != nullptr
+                && egl.querySurface (display, egl.getCurrentSurface (eglDraw), eglBufferAge, &age) != 0)
+                return static_cast<int> (age);
+
+            return 0;
+        }
+
+        if (glx.isAvailable() && glx.getCurrentContext() != nullptr)
+        {
+            // An unsupported attribute raises an X error, so the extension must be checked first
+            auto* display = glx.getCurrentDisplay();
+            const auto* extensions = glx.queryExtensionsString (display, 0);
+
+            unsigned int age = 0;
+            if (extensions != nullptr && std::strstr (extensions, "GLX_EXT_buffer_age") != nullptr)
+            {
+                glx.queryDrawable (display, glx.getCurrentDrawable(), glxBackBufferAge, &age);
+                return static_cast<int> (age);
+            }
+        }
+
+        return 0;
+    }
+
+private:
+    static constexpr int32 eglExtensions = 0x3055;
+    static constexpr int32 eglDraw = 0x3059;
+    static constexpr int32 eglBufferAge = 0x313d;
+    static constexpr int glxBackBufferAge = 0x20f4;
+
+    struct
+    {
+        void* library = nullptr;
+        void* (*getCurrentContext)() = nullptr;
+        void* (*getCurrentDisplay)() = nullptr;
+        void* (*getCurrentSurface) (int32) = nullptr;
+        const char* (*queryString) (void*, int32) = nullptr;
+        uint32 (*querySurface) (void*, void*, int32, int32*) = nullptr;
+
+        bool isAvailable() const noexcept
+        {
+            return getCurrentContext != nullptr && getCurrentDisplay != nullptr && getCurrentSurface != nullptr
+                && queryString != nullptr && querySurface != nullptr;
+        }
+    } egl;
+
+    struct
+    {
+        void* library = nullptr;
+        void* (*getCurrentContext)() = nullptr;
+        void* (*getCurrentDisplay)() = nullptr;
+        unsigned long (*getCurrentDrawable)() = nullptr;
+        const char* (*queryExtensionsString) (void*, int) = nullptr;
+        void (*queryDrawable) (void*, unsigned long, int, unsigned int*) = nullptr;
+
+        bool isAvailable() const noexcept
+        {
+            return getCurrentContext != nullptr && getCurrentDisplay != nullptr && getCurrentDrawable != nullptr
+                && queryExtensionsString != nullptr && queryDrawable != nullptr;
+        }
+    } glx;
+};
+#endif
+
+/** Returns the age of the back buffer presented by the swap chain of the graphics API.
+
+    This is the number of frames since the buffer being drawn into was last drawn, as EGL buffer age
+    reports it, or 0 when its content is unknown and the whole window must be repainted.
+*/
+int getSwapChainBufferAge (GraphicsContext::Api api)
+{
+    switch (api)
+    {
+        case GraphicsContext::OpenGL:
+        {
+            int doubleBuffered = 1;
+            if (SDL_GL_GetAttribute (SDL_GL_DOUBLEBUFFER, &doubleBuffered) == 0 && doubleBuffered == 0)
+                return 1;
+
+#if JUCE_LINUX || JUCE_BSD || JUCE_ANDROID
+            static const OpenGLBufferAgeQuery query;
+            return query.getBufferAge();
+#else
+            return 0;
+#endif
+        }
+
+        case GraphicsContext::Software:
+            // The software context rasterises into a single image it owns, which keeps the previous frame
+            return 1;
+
+        case GraphicsContext::Metal:
+        case GraphicsContext::Direct3D:
+        case GraphicsContext::Dawn:
+        default:
+            return 0;
+    }
+}
+
+} // namespace
+
+//==============================================================================
+
 SDL2ComponentNative::SDL2ComponentNative (Component& component,
                                           const Options& options,
                                           void* parent)
@@ -108,6 +335,10 @@ SDL2ComponentNative::~SDL2ComponentNative()
     // Stop the rendering
     stopRendering();
 
+    // The factory goes away with the context, so the artboard files it imported can't be shared anymore
+    if (context != nullptr && context->factory() != nullptr)
+        ArtboardFileCache::getInstance().removeFactory (*context->factory());
+
     // Remove event watch
     SDL_DelEventWatch (eventDispatcher, this);
 
@@ -365,20 +596,27 @@ void SDL2ComponentNative::enableWireframe (bool shouldBeEnabled)
 
 void SDL2ComponentNative::repaint()
 {
-    currentRepaintArea = Rectangle<float>().withSize (getSize().to<float>());
+    currentRepaintRegions.clear();
+    currentRepaintRegions.addWithoutMerge (Rectangle<float>().withSize (getSize().to<float>()));
+
+    wakeUpIfThrottled();
 }
 
 void SDL2ComponentNative::repaint (const Rectangle<float>& rect)
 {
-    if (! currentRepaintArea.isEmpty())
-        currentRepaintArea = currentRepaintArea.smallestContainingRectangle (rect);
-    else
-        currentRepaintArea = rect;
+    addRepaintRegion (currentRepaintRegions, rect.intersection (Rectangle<float>().withSize (getSize().to<float>())));
+
+    wakeUpIfThrottled();
 }
 
 Rectangle<float> SDL2ComponentNative::getRepaintArea() const
 {
-    return currentRepaintArea;
+    return currentRepaintRegions.getBoundingBox();
+}
+
+const RectangleList<float>& SDL2ComponentNative::getRepaintRegions() const
+{
+    return currentRepaintRegions;
 }
 
 //==============================================================================
@@ -430,67 +668,118 @@ void* SDL2ComponentNative::getNativeHandle() const
 
 void SDL2ComponentNative::run()
 {
-    const double maxFrameTimeSeconds = 1.0 / static_cast<double> (desiredFrameRate);
-    const double maxFrameTimeMs = maxFrameTimeSeconds * 1000.0;
+    // The render thread owns the OpenGL context while it's running
+    const bool ownsOpenGLContext = window != nullptr && windowContext != nullptr;
+    if (ownsOpenGLContext)
+        SDL_GL_MakeCurrent (window, windowContext);
+
+    double nextFrameDeadlineMs = juce::Time::getMillisecondCounterHiRes();
 
     while (! threadShouldExit())
     {
-        double frameStartTimeSeconds = juce::Time::getMillisecondCounterHiRes() / 1000.0;
+        const double frameStartMs = juce::Time::getMillisecondCounterHiRes();
 
-        // Trigger and wait for rendering
-        renderEvent.reset();
-        cancelPendingUpdate();
-        triggerAsyncUpdate();
-        renderEvent.wait (maxFrameTimeMs - 2.0f);
+        // Render the frame while the message thread is blocked, and present it after letting it go,
+        // so the wait for the vertical blank doesn't hold up the message thread
+        bool hasRenderedFrame = false;
+        double frameIntervalMs = 0.0;
 
-        // Measure spent time and cap the framerate
-        double currentTimeSeconds = juce::Time::getMillisecondCounterHiRes() / 1000.0;
-        double timeSpentSeconds = currentTimeSeconds - frameStartTimeSeconds;
-
-        const double secondsToWait = maxFrameTimeSeconds - timeSpentSeconds;
-        if (secondsToWait > 0.0f)
         {
-            const auto waitUntilMs = (currentTimeSeconds + secondsToWait) * 1000.0;
+            const MessageManagerLock mmLock (this);
+            if (! mmLock.lockWasGained())
+                break;
 
-            while (juce::Time::getMillisecondCounterHiRes() < waitUntilMs - 2.0)
-                Thread::sleep (1);
+            // The flag can only be read by setting it, so it's cleared again when windowing isn't initialised yet
+            if (isInitialised.test_and_set())
+                hasRenderedFrame = renderContext();
+            else
+                isInitialised.clear();
 
-            while (juce::Time::getMillisecondCounterHiRes() < waitUntilMs)
-                Thread::sleep (0);
+            frameIntervalMs = getFramePeriodMs();
+        }
+
+        if (hasRenderedFrame)
+            presentFrame();
+
+        if (threadShouldExit())
+            break;
+
+        // Schedule the next frame, dropping to the idle frame rate when nothing has been repainted for a while
+        const double idleFrameIntervalMs = jmax (frameIntervalMs, 1000.0 / static_cast<double> (idleFrameRate));
+        const bool isIdle = isThrottledForIdle();
+        nextFrameDeadlineMs += isIdle ? idleFrameIntervalMs : frameIntervalMs;
+
+        auto currentTimeMs = juce::Time::getMillisecondCounterHiRes();
+        if (nextFrameDeadlineMs < currentTimeMs)
+            nextFrameDeadlineMs = currentTimeMs; // Don't try to catch up on missed frames
+
+        // Sleep until the deadline, a repaint request wakes us up earlier when throttled
+        while (! threadShouldExit() && currentTimeMs < nextFrameDeadlineMs)
+        {
+            if (wait (nextFrameDeadlineMs - currentTimeMs) && isIdle)
+                nextFrameDeadlineMs = jmin (nextFrameDeadlineMs, frameStartMs + frameIntervalMs);
+
+            currentTimeMs = juce::Time::getMillisecondCounterHiRes();
         }
     }
+
+    if (ownsOpenGLContext)
+        SDL_GL_MakeCurrent (window, nullptr);
 }
 
-void SDL2ComponentNative::handleAsyncUpdate()
+bool SDL2ComponentNative::isThrottledForIdle() const
 {
-    if (! isThreadRunning() || ! isInitialised.test_and_set())
+    return ! shouldRenderContinuous.load (std::memory_order_relaxed)
+        && numIdleFrames.load (std::memory_order_relaxed) >= roundToInt (desiredFrameRate * idleSecondsBeforeThrottling);
+}
+
+void SDL2ComponentNative::wakeUpIfThrottled()
+{
+    if (! isThrottledForIdle())
         return;
 
-    renderContext();
+    if constexpr (renderDrivenByTimer)
+    {
+        numIdleFrames.store (0, std::memory_order_relaxed);
+        startTimerHz (roundToInt (desiredFrameRate));
+    }
+    else
+    {
+        notify();
+    }
+}
 
-    renderEvent.signal();
+ComponentNative::FrameTimings SDL2ComponentNative::getLastFrameTimings() const
+{
+    return lastFrameTimings;
 }
 
 void SDL2ComponentNative::timerCallback()
 {
-    renderContext();
+    const bool wasThrottled = isThrottledForIdle();
+
+    if (renderContext())
+        presentFrame();
+
+    if (wasThrottled != isThrottledForIdle())
+        startTimerHz (roundToInt (wasThrottled ? desiredFrameRate : jmin (idleFrameRate, desiredFrameRate)));
 }
 
 //==============================================================================
 
-void SDL2ComponentNative::renderContext()
+bool SDL2ComponentNative::renderContext()
 {
     YUP_PROFILE_NAMED_INTERNAL_TRACE (RenderContext);
 
     if (context == nullptr)
-        return;
+        return false;
 
     const auto contentSize = getContentSize();
     auto contentWidth = contentSize.getWidth();
     auto contentHeight = contentSize.getHeight();
 
     if (contentWidth == 0 || contentHeight == 0)
-        return;
+        return false;
 
     if (currentContentWidth != contentWidth || currentContentHeight != contentHeight)
     {
@@ -502,6 +791,9 @@ void SDL2ComponentNative::renderContext()
         context->onSizeChanged (getNativeHandle(), contentWidth, contentHeight, 0);
         renderer = context->makeRenderer (contentWidth, contentHeight);
 
+        // The content of all the back buffers is undefined after a resize
+        numDamageHistoryFrames = 0;
+
         repaint();
     }
 
@@ -509,17 +801,61 @@ void SDL2ComponentNative::renderContext()
     auto currentTimeSeconds = juce::Time::getMillisecondCounterHiRes() / 1000.0;
     const auto dpiScale = getScaleDpi();
 
+    FrameTimings timings = lastFrameTimings;
+
     {
         YUP_PROFILE_NAMED_INTERNAL_TRACE (RefreshDisplay);
 
+        // Artboard scenes are advanced in parallel when the frame phase ends, before painting
+        auto scheduler = ArtboardScheduler::getInstance();
+        scheduler->beginFrame();
+
         component.internalRefreshDisplay (currentTimeSeconds - lastRenderTimeSeconds);
         lastRenderTimeSeconds = currentTimeSeconds;
+
+        scheduler->endFrame();
     }
 
+    timings.refreshMs = juce::Time::getMillisecondCounterHiRes() - currentTimeSeconds * 1000.0;
+
     if (renderContinuous)
+    {
         repaint();
-    else if (currentRepaintArea.isEmpty())
-        return;
+    }
+    else if (currentRepaintRegions.isEmpty())
+    {
+        // Nothing is dirty, skip the frame entirely
+        ++timings.numSkippedFrames;
+        lastFrameTimings = timings;
+
+        numIdleFrames.fetch_add (1, std::memory_order_relaxed);
+        return false;
+    }
+
+    numIdleFrames.store (0, std::memory_order_relaxed);
+
+    // The back buffer we're about to draw into was last drawn bufferAge frames ago, so on top of the
+    // current damage it also misses the damage of the frames rendered into the other buffers since then.
+    // When its age is unknown, or older than the damage we remember, the whole window is repainted
+    auto regionsToRender = currentRepaintRegions;
+    const auto bufferAge = getSwapChainBufferAge (currentGraphicsApi);
+
+    if (! renderContinuous && bufferAge != 1)
+    {
+        if (bufferAge <= 0 || bufferAge > maxBufferAge || numDamageHistoryFrames < bufferAge - 1)
+        {
+            regionsToRender.clear();
+            regionsToRender.addWithoutMerge (Rectangle<float>().withSize (getSize().to<float>()));
+        }
+        else
+        {
+            for (int i = 0; i < bufferAge - 1; ++i)
+            {
+                for (const auto& region : damageHistory[static_cast<std::size_t> (i)])
+                    addRepaintRegion (regionsToRender, region);
+            }
+        }
+    }
 
     auto renderFrame = [&]
     {
@@ -549,30 +885,43 @@ void SDL2ComponentNative::renderContext()
         }
 
         // Repaint components hierarchy
+        const auto paintStartMs = juce::Time::getMillisecondCounterHiRes();
+
         if (renderer != nullptr)
         {
             YUP_PROFILE_NAMED_INTERNAL_TRACE (InternalPaint);
 
             Graphics g (*context, *renderer, dpiScale);
-            component.internalPaint (g, currentRepaintArea, renderContinuous);
+            component.internalPaint (g, regionsToRender, renderContinuous);
         }
 
         // Finish context drawing
+        const auto contextEndStartMs = juce::Time::getMillisecondCounterHiRes();
+
         {
             YUP_PROFILE_NAMED_INTERNAL_TRACE (ContextEnd);
 
             context->end (getNativeHandle());
             context->tick();
         }
+
+        timings.paintMs = contextEndStartMs - paintStartMs;
+        timings.contextEndMs = juce::Time::getMillisecondCounterHiRes() - contextEndStartMs;
     };
 
+    context->getRenderCache().beginFrame();
+    context->getImageAtlas().beginFrame (*context);
+
     renderFrame();
-    if (! renderContinuous)
-        renderFrame(); // This is needed on double buffered platforms
 
-    // Swap buffers
-    if (window != nullptr && currentGraphicsApi == GraphicsContext::OpenGL)
-        SDL_GL_SwapWindow (window);
+    // Remember the damage of this frame, the next bufferAge - 1 frames will draw into buffers that miss it
+    std::rotate (damageHistory.rbegin(), damageHistory.rbegin() + 1, damageHistory.rend());
+    damageHistory.front() = currentRepaintRegions;
+    numDamageHistoryFrames = jmin (numDamageHistoryFrames + 1, maxBufferAge);
+
+    timings.frameMs = juce::Time::getMillisecondCounterHiRes() - currentTimeSeconds * 1000.0;
+    ++timings.numRenderedFrames;
+    lastFrameTimings = timings;
 
     // Compute framerate
     ++frameRateCounter;
@@ -587,9 +936,40 @@ void SDL2ComponentNative::renderContext()
         frameRateCounter = 0;
     }
 
-    currentRepaintArea = {};
+    currentRepaintRegions.clear();
+
+    return true;
 }
 
+void SDL2ComponentNative::presentFrame()
+{
+    if (window != nullptr && currentGraphicsApi == GraphicsContext::OpenGL)
+        SDL_GL_SwapWindow (window);
+}
+
+double SDL2ComponentNative::getFramePeriodMs() const
+{
+    const auto desiredPeriodMs = 1000.0 / static_cast<double> (desiredFrameRate);
+
+    SDL_DisplayMode displayMode;
+    const auto displayIndex = window != nullptr ? SDL_GetWindowDisplayIndex (window) : -1;
+
+    if (displayIndex < 0 || SDL_GetCurrentDisplayMode (displayIndex, &displayMode) != 0 || displayMode.refresh_rate <= 0)
+        return desiredPeriodMs;
+
+    const auto refreshPeriodMs = 1000.0 / static_cast<double> (displayMode.refresh_rate);
+
+    // With vsync enabled, presenting waits for swap interval vertical blanks, so frames can't be faster than that
+    int swapInterval = 0;
+    if (currentGraphicsApi == GraphicsContext::OpenGL)
+        swapInterval = std::abs (SDL_GL_GetSwapInterval());
+
+    // Pace frames on whole refresh periods, so they line up with the vertical blanks of the display
+    const auto numRefreshPeriods = jmax (1, swapInterval, static_cast<int> (std::ceil (desiredPeriodMs / refreshPeriodMs - 0.05)));
+    return refreshPeriodMs * numRefreshPeriods;
+}
+
+
 //==============================================================================
 
 void SDL2ComponentNative::startRendering()
@@ -606,7 +986,13 @@ void SDL2ComponentNative::startRendering()
     else
     {
         if (! isThreadRunning())
+        {
+            // Hand the OpenGL context over to the render thread
+            if (window != nullptr && windowContext != nullptr)
+                SDL_GL_MakeCurrent (window, nullptr);
+
             startThread (Priority::high);
+        }
     }
 
     repaint();
@@ -625,8 +1011,11 @@ void SDL2ComponentNative::stopRendering()
         {
             signalThreadShouldExit();
             notify();
-            renderEvent.signal();
             stopThread (-1);
+
+            // Take the OpenGL context back, so its resources can be released on the message thread
+            if (window != nullptr && windowContext != nullptr)
+                SDL_GL_MakeCurrent (window, windowContext);
         }
     }
 }
@@ -1243,6 +1632,12 @@ void shutdownYup_Windowing()
     SDL_DelEventWatch (displayEventDispatcher, Desktop::getInstance());
     Desktop::getInstance()->deleteInstance();
 
+    // Stop the artboard workers
+    ArtboardScheduler::deleteInstance();
+
+    // Stop the image decoding workers
+    ImageLoader::deleteInstance();
+
     // Unregister event loop
     MessageManager::getInstance()->registerEventLoopCallback (nullptr);
 
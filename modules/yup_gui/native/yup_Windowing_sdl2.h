@@ -39,7 +39,6 @@ class SDL2ComponentNative final
     : public ComponentNative
     , public Timer
     , public Thread
-    , public AsyncUpdater
 {
 #if (JUCE_EMSCRIPTEN && RIVE_WEBGL) && ! defined(__EMSCRIPTEN_PTHREADS__)
     static constexpr bool renderDrivenByTimer = true;
@@ -93,11 +92,13 @@ public:
     void repaint() override;
     void repaint (const Rectangle<float>& rect) override;
     Rectangle<float> getRepaintArea() const override;
+    const RectangleList<float>& getRepaintRegions() const override;
 
     //==============================================================================
     float getScaleDpi() const override;
     float getCurrentFrameRate() const override;
     float getDesiredFrameRate() const override;
+    FrameTimings getLastFrameTimings() const override;
 
     //==============================================================================
     void setOpacity (float opacity) override;
@@ -115,7 +116,6 @@ public:
 
     //==============================================================================
     void run() override;
-    void handleAsyncUpdate() override;
     void timerCallback() override;
 
     //==============================================================================
@@ -151,12 +151,17 @@ public:
 
 private:
     void updateComponentUnderMouse (const MouseEvent& event);
-    void renderContext();
+    bool renderContext();
+    void presentFrame();
+    double getFramePeriodMs() const;
 
     void startRendering();
     void stopRendering();
     bool isRendering() const;
 
+    bool isThrottledForIdle() const;
+    void wakeUpIfThrottled();
+
     SDL_Window* window = nullptr;
     SDL_GLContext windowContext = nullptr;
 
@@ -186,22 +191,30 @@ private:
 
     RelativeTime doubleClickTime;
 
+    static constexpr float idleFrameRate = 10.0f;
+    static constexpr float idleSecondsBeforeThrottling = 0.5f;
+
     float desiredFrameRate = 60.0f;
     std::atomic<float> currentFrameRate = 0.0f;
     double frameRateStartTimeSeconds = 0.0;
     uint64_t frameRateCounter = 0;
+    std::atomic<int> numIdleFrames = 0;
+    FrameTimings lastFrameTimings;
 
     int currentContentWidth = 0;
     int currentContentHeight = 0;
 
-    WaitableEvent renderEvent { true };
     std::atomic<bool> shouldRenderContinuous = false;
     double lastRenderTimeSeconds = 0.0;
     bool renderAtomicMode = false;
     bool renderWireframe = false;
     bool updateOnlyWhenFocused = false;
 
-    Rectangle<float> currentRepaintArea;
+    RectangleList<float> currentRepaintRegions;
+
+    static constexpr int maxBufferAge = 3;
+    std::array<RectangleList<float>, maxBufferAge> damageHistory;
+    int numDamageHistoryFrames = 0;
 };
 
 } // namespace yup
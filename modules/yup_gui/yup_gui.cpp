@@ -38,6 +38,8 @@
 #include <rive/animation/state_machine_instance.hpp>
 #include <rive/animation/state_machine_input_instance.hpp>
 
+#include <yoga/Yoga.h>
+
 //==============================================================================
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_syswm.h>
@@ -81,10 +83,14 @@
 #include "desktop/yup_Desktop.cpp"
 #include "mouse/yup_MouseEvent.cpp"
 #include "component/yup_ComponentNative.cpp"
+#include "component/yup_HitTestIndex.cpp"
 #include "component/yup_Component.cpp"
+#include "layout/yup_FlexNode.cpp"
 #include "widgets/yup_Button.cpp"
 #include "widgets/yup_TextButton.cpp"
 #include "widgets/yup_Slider.cpp"
+#include "artboard/yup_ArtboardFileCache.cpp"
+#include "artboard/yup_ArtboardScheduler.cpp"
 #include "artboard/yup_Artboard.cpp"
 #include "windowing/yup_DocumentWindow.cpp"
 
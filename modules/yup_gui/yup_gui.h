@@ -33,7 +33,7 @@
     license:            ISC
     minimumCppStandard: 17
 
-    dependencies:       juce_events yup_graphics rive
+    dependencies:       juce_events yup_graphics rive yoga_library
     osxFrameworks:      Metal
     iosFrameworks:      Metal
     iosSimFrameworks:   Metal
@@ -77,9 +77,13 @@
 #include "desktop/yup_Display.h"
 #include "desktop/yup_Desktop.h"
 #include "component/yup_ComponentNative.h"
+#include "component/yup_HitTestIndex.h"
 #include "component/yup_Component.h"
+#include "layout/yup_FlexNode.h"
 #include "widgets/yup_Button.h"
 #include "widgets/yup_TextButton.h"
 #include "widgets/yup_Slider.h"
+#include "artboard/yup_ArtboardFileCache.h"
+#include "artboard/yup_ArtboardScheduler.h"
 #include "artboard/yup_Artboard.h"
 #include "windowing/yup_DocumentWindow.h"
@@ -0,0 +1,293 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <yup_audio_processors/yup_audio_processors.h>
+
+using namespace yup;
+
+namespace
+{
+
+class RecordingProcessor : public AudioProcessor
+{
+public:
+    struct SubBlock
+    {
+        int numSamples = 0;
+        float value = 0.0f;
+        std::vector<int> midiPositions;
+    };
+
+    explicit RecordingProcessor (int minimumSubBlockSizeToUse = 0)
+        : minimumSubBlockSize (minimumSubBlockSizeToUse)
+    {
+    }
+
+    int getNumParameters() const override { return 1; }
+    AudioProcessorParameter& getParameter (int) override { return parameter; }
+
+    int getNumAudioOutputs() const override { return 1; }
+    int getNumAudioInputs() const override { return 0; }
+
+    int getMinimumSubBlockSize() const override { return minimumSubBlockSize; }
+
+    void prepareToPlay (float, int) override {}
+    void releaseResources() override {}
+
+    void processBlock (AudioSampleBuffer& audioBuffer, MidiBuffer& midiBuffer) override
+    {
+        record (audioBuffer, midiBuffer);
+    }
+
+    bool supportsDoublePrecisionProcessing() const override { return true; }
+
+    void processBlock (AudioBuffer<double>& audioBuffer, MidiBuffer& midiBuffer) override
+    {
+        record (audioBuffer, midiBuffer);
+    }
+
+    bool hasEditor() const override { return false; }
+
+    AudioProcessorParameter parameter { "Value", 0.0f, 1.0f, 0.0f };
+    std::vector<SubBlock> subBlocks;
+
+private:
+    template <class FloatType>
+    void record (AudioBuffer<FloatType>& audioBuffer, MidiBuffer& midiBuffer)
+    {
+        SubBlock subBlock;
+        subBlock.numSamples = audioBuffer.getNumSamples();
+        subBlock.value = parameter.getValue();
+
+        for (const auto metadata : midiBuffer)
+            subBlock.midiPositions.push_back (metadata.samplePosition);
+
+        subBlocks.push_back (subBlock);
+
+        for (int channel = 0; channel < audioBuffer.getNumChannels(); ++channel)
+            FloatVectorOperations::fill (audioBuffer.getWritePointer (channel), static_cast<FloatType> (parameter.getValue()), audioBuffer.getNumSamples());
+    }
+
+    const int minimumSubBlockSize;
+};
+
+} // namespace
+
+TEST (AudioProcessorTests, AppliesChangesBeforeTheBlockByDefault)
+{
+    RecordingProcessor processor;
+
+    ParameterChangeList changes;
+    changes.addChange (10, 0, 0.25f);
+    changes.addChange (100, 0, 0.75f);
+
+    AudioSampleBuffer buffer (2, 256);
+    MidiBuffer midi;
+    processor.processBlockWithParameterChanges (buffer, midi, changes);
+
+    ASSERT_EQ (processor.subBlocks.size(), 1u);
+    EXPECT_EQ (processor.subBlocks[0].numSamples, 256);
+    EXPECT_EQ (processor.subBlocks[0].value, 0.75f);
+}
+
+TEST (AudioProcessorTests, SplitsBlocksAtParameterChanges)
+{
+    RecordingProcessor processor (16);
+
+    ParameterChangeList changes;
+    changes.addChange (0, 0, 0.1f);
+    changes.addChange (64, 0, 0.2f);
+    changes.addChange (70, 0, 0.3f);
+    changes.addChange (200, 0, 0.4f);
+    changes.addChange (256, 0, 0.5f);
+
+    AudioSampleBuffer buffer (2, 256);
+    MidiBuffer midi;
+    midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 5);
+    midi.addEvent (MidiMessage::noteOn (1, 62, 1.0f), 100);
+    processor.processBlockWithParameterChanges (buffer, midi, changes);
+
+    // The change at 70 falls inside the minimum sub-block started at 64, so it's applied at 80
+    ASSERT_EQ (processor.subBlocks.size(), 4u);
+    EXPECT_EQ (processor.subBlocks[0].numSamples, 64);
+    EXPECT_EQ (processor.subBlocks[0].value, 0.1f);
+    EXPECT_EQ (processor.subBlocks[1].numSamples, 16);
+    EXPECT_EQ (processor.subBlocks[1].value, 0.2f);
+    EXPECT_EQ (processor.subBlocks[2].numSamples, 120);
+    EXPECT_EQ (processor.subBlocks[2].value, 0.3f);
+    EXPECT_EQ (processor.subBlocks[3].numSamples, 56);
+    EXPECT_EQ (processor.subBlocks[3].value, 0.4f);
+
+    EXPECT_EQ (processor.subBlocks[0].midiPositions, (std::vector<int> { 5 }));
+    EXPECT_EQ (processor.subBlocks[2].midiPositions, (std::vector<int> { 20 }));
+
+    EXPECT_EQ (buffer.getSample (0, 63), 0.1f);
+    EXPECT_EQ (buffer.getSample (1, 64), 0.2f);
+    EXPECT_EQ (buffer.getSample (0, 255), 0.4f);
+
+    // Changes past the end of the block are still applied
+    EXPECT_EQ (processor.parameter.getValue(), 0.5f);
+
+    // The MIDI returned by the sub-blocks is put back at the right positions
+    std::vector<int> positions;
+    for (const auto metadata : midi)
+        positions.push_back (metadata.samplePosition);
+
+    EXPECT_EQ (positions, (std::vector<int> { 5, 100 }));
+}
+
+TEST (AudioProcessorTests, SplitsDoublePrecisionBlocksAtParameterChanges)
+{
+    RecordingProcessor processor (16);
+
+    ParameterChangeList changes;
+    changes.addChange (32, 0, 0.5f);
+
+    AudioBuffer<double> buffer (2, 128);
+    MidiBuffer midi;
+    processor.processBlockWithParameterChanges (buffer, midi, changes);
+
+    ASSERT_EQ (processor.subBlocks.size(), 2u);
+    EXPECT_EQ (processor.subBlocks[0].numSamples, 32);
+    EXPECT_EQ (processor.subBlocks[1].numSamples, 96);
+
+    EXPECT_EQ (buffer.getSample (0, 31), 0.0);
+    EXPECT_EQ (buffer.getSample (1, 32), 0.5);
+}
+
+TEST (AudioProcessorTests, QueuesEditorChangesForTheHost)
+{
+    RecordingProcessor processor;
+
+    // Parameters not connected to a processor don't queue anything
+    processor.parameter.setValueNotifyingHost (0.1f);
+    EXPECT_EQ (processor.getEditorParameterChanges().getNumReady(), 0);
+
+    int numNotifications = 0;
+    processor.onEditorParameterChange = [&] { ++numNotifications; };
+    processor.connectParameters();
+
+    EXPECT_EQ (processor.parameter.getParameterIndex(), 0);
+
+    processor.parameter.beginChangeGesture();
+    processor.parameter.setValueNotifyingHost (0.4f);
+    processor.parameter.endChangeGesture();
+
+    EXPECT_EQ (numNotifications, 3);
+    EXPECT_EQ (processor.parameter.getValue(), 0.4f);
+
+    std::vector<ParameterChangeQueue::EventType> types;
+    processor.getEditorParameterChanges().popAll ([&] (const ParameterChangeQueue::Event& event)
+    {
+        EXPECT_EQ (event.parameterIndex, 0);
+        types.push_back (event.type);
+    });
+
+    EXPECT_EQ (types, (std::vector<ParameterChangeQueue::EventType> { ParameterChangeQueue::EventType::gestureBegin,
+                                                                         ParameterChangeQueue::EventType::valueChange,
+                                                                         ParameterChangeQueue::EventType::gestureEnd }));
+}
+
+TEST (AudioProcessorTests, MarksHostChangesForTheEditor)
+{
+    RecordingProcessor processor (16);
+    processor.connectParameters();
+
+    ParameterChangeList changes;
+    changes.addChange (32, 0, 0.5f);
+    changes.addChange (64, 3, 0.5f);
+
+    AudioSampleBuffer buffer (2, 128);
+    MidiBuffer midi;
+    processor.processBlockWithParameterChanges (buffer, midi, changes);
+
+    std::vector<int> changed;
+    processor.getHostParameterChanges().forEachChanged ([&] (int index)
+    {
+        changed.push_back (index);
+    });
+
+    EXPECT_EQ (changed, (std::vector<int> { 0 }));
+}
+
+TEST (AudioProcessorTests, ParallelForRunsEveryTask)
+{
+    for (const int numThreads : { 0, 2 })
+    {
+        RecordingProcessor processor;
+        processor.setNumParallelWorkerThreads (numThreads);
+        EXPECT_EQ (processor.getNumParallelWorkerThreads(), numThreads);
+
+        std::vector<int> results (32, 0);
+        processor.parallelFor (32, [&] (int taskIndex)
+        {
+            results[static_cast<std::size_t> (taskIndex)] = taskIndex * 2;
+        });
+
+        for (int i = 0; i < 32; ++i)
+            EXPECT_EQ (results[static_cast<std::size_t> (i)], i * 2);
+    }
+}
+
+TEST (AudioProcessorTests, ParallelForDispatchesToTheHost)
+{
+    RecordingProcessor processor;
+
+    int numDispatches = 0;
+    bool hostAccepts = true;
+
+    processor.setParallelTaskDispatcher ([&] (int numTasks)
+    {
+        ++numDispatches;
+
+        if (! hostAccepts)
+            return false;
+
+        for (int taskIndex = numTasks; --taskIndex >= 0;)
+            processor.performParallelTask (taskIndex);
+
+        return true;
+    });
+
+    std::vector<int> order;
+    processor.parallelFor (4, [&] (int taskIndex)
+    {
+        order.push_back (taskIndex);
+    });
+
+    EXPECT_EQ (numDispatches, 1);
+    EXPECT_EQ (order, (std::vector<int> { 3, 2, 1, 0 }));
+
+    // When the host can't run the tasks they still run, without the host threads
+    hostAccepts = false;
+    order.clear();
+
+    processor.parallelFor (4, [&] (int taskIndex)
+    {
+        order.push_back (taskIndex);
+    });
+
+    EXPECT_EQ (numDispatches, 2);
+    EXPECT_EQ (order, (std::vector<int> { 0, 1, 2, 3 }));
+}
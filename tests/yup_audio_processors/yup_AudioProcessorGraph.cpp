@@ -0,0 +1,460 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <yup_audio_processors/yup_audio_processors.h>
+
+#include <iostream>
+
+using namespace yup;
+
+namespace
+{
+
+constexpr int blockSize = 256;
+constexpr float sampleRate = 48000.0f;
+
+using Connection = AudioProcessorGraph::Connection;
+
+class TestProcessor : public AudioProcessor
+{
+public:
+    TestProcessor (float gainToApply = 1.0f, int latencyToAdd = 0, int numInputBuses = 1, int numOutputBuses = 1)
+        : latency (latencyToAdd)
+        , numInputs (numInputBuses)
+        , numOutputs (numOutputBuses)
+    {
+        gain.setValue (gainToApply);
+    }
+
+    int getNumParameters() const override { return 1; }
+    AudioProcessorParameter& getParameter (int) override { return gain; }
+
+    int getNumAudioOutputs() const override { return numOutputs; }
+    int getNumAudioInputs() const override { return numInputs; }
+
+    int getLatencySamples() const override { return latency; }
+
+    void prepareToPlay (float, int) override
+    {
+        delayLines.assign (static_cast<std::size_t> (2 * jmax (numInputs, numOutputs)), std::vector<float> (static_cast<std::size_t> (latency), 0.0f));
+        delayPosition = 0;
+        isPrepared = true;
+    }
+
+    void releaseResources() override
+    {
+        isPrepared = false;
+    }
+
+    void processBlock (AudioSampleBuffer& audioBuffer, MidiBuffer& midiBuffer) override
+    {
+        const auto numSamples = audioBuffer.getNumSamples();
+        auto position = delayPosition;
+
+        for (int channel = 0; channel < audioBuffer.getNumChannels(); ++channel)
+        {
+            auto* samples = audioBuffer.getWritePointer (channel);
+            auto& delayLine = delayLines[static_cast<std::size_t> (channel)];
+            position = delayPosition;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto sample = samples[i];
+
+                if (latency > 0)
+                {
+                    std::swap (sample, delayLine[position]);
+                    position = (position + 1) % delayLine.size();
+                }
+
+                samples[i] = sample * gain.getValue();
+            }
+        }
+
+        delayPosition = position;
+
+        if (noteToAdd >= 0)
+            midiBuffer.addEvent (MidiMessage::noteOn (1, noteToAdd, 1.0f), 0);
+    }
+
+    bool hasEditor() const override { return false; }
+
+    AudioProcessorParameter gain { "Gain", 0.0f, 8.0f, 1.0f };
+    int noteToAdd = -1;
+    bool isPrepared = false;
+
+private:
+    const int latency;
+    const int numInputs;
+    const int numOutputs;
+    std::vector<std::vector<float>> delayLines;
+    std::size_t delayPosition = 0;
+};
+
+class LoadProcessor : public AudioProcessor
+{
+public:
+    explicit LoadProcessor (int numStagesToRun)
+        : numStages (numStagesToRun)
+    {
+    }
+
+    int getNumParameters() const override { return 0; }
+    AudioProcessorParameter& getParameter (int) override { return unused; }
+
+    int getNumAudioOutputs() const override { return 1; }
+    int getNumAudioInputs() const override { return 1; }
+
+    void prepareToPlay (float, int) override { std::fill (std::begin (states), std::end (states), 0.0f); }
+    void releaseResources() override {}
+
+    void processBlock (AudioSampleBuffer& audioBuffer, MidiBuffer&) override
+    {
+        for (int channel = 0; channel < audioBuffer.getNumChannels(); ++channel)
+        {
+            auto* samples = audioBuffer.getWritePointer (channel);
+            auto& state = states[channel];
+
+            for (int i = 0; i < audioBuffer.getNumSamples(); ++i)
+            {
+                auto sample = samples[i] + 0.001f;
+
+                for (int stage = 0; stage < numStages; ++stage)
+                {
+                    state += 0.25f * (sample - state);
+                    sample = state;
+                }
+
+                samples[i] = sample;
+            }
+        }
+    }
+
+    bool hasEditor() const override { return false; }
+
+private:
+    AudioProcessorParameter unused { "Unused", 0.0f, 1.0f, 0.0f };
+    const int numStages;
+    float states[2] = {};
+};
+
+AudioSampleBuffer makeBuffer (float value, int numSamples = blockSize)
+{
+    AudioSampleBuffer buffer (2, numSamples);
+
+    for (int channel = 0; channel < 2; ++channel)
+        FloatVectorOperations::fill (buffer.getWritePointer (channel), value, numSamples);
+
+    return buffer;
+}
+
+void connectStereo (AudioProcessorGraph& graph, AudioProcessorGraph::NodeID source, AudioProcessorGraph::NodeID destination)
+{
+    for (int channel = 0; channel < 2; ++channel)
+        ASSERT_TRUE (graph.addConnection ({ source, channel, destination, channel }));
+}
+
+/** Builds a layered graph, where each node is fed by one or two nodes of the previous layer. */
+void buildLayeredGraph (AudioProcessorGraph& graph, int numNodes, int width, int numStages)
+{
+    Random random (1234);
+
+    std::vector<AudioProcessorGraph::NodeID> previousLayer { AudioProcessorGraph::inputNodeID };
+    std::vector<AudioProcessorGraph::NodeID> currentLayer;
+
+    for (int i = 0; i < numNodes; ++i)
+    {
+        const auto nodeID = graph.addNode (std::make_unique<LoadProcessor> (numStages));
+        connectStereo (graph, previousLayer[static_cast<std::size_t> (random.nextInt (static_cast<int> (previousLayer.size())))], nodeID);
+
+        const auto extraSource = previousLayer[static_cast<std::size_t> (random.nextInt (static_cast<int> (previousLayer.size())))];
+        if (random.nextBool())
+            graph.addConnection ({ extraSource, 0, nodeID, 0 });
+
+        currentLayer.push_back (nodeID);
+
+        if (static_cast<int> (currentLayer.size()) == width || i == numNodes - 1)
+        {
+            previousLayer = std::move (currentLayer);
+            currentLayer.clear();
+        }
+    }
+
+    for (const auto nodeID : previousLayer)
+        connectStereo (graph, nodeID, AudioProcessorGraph::outputNodeID);
+}
+
+} // namespace
+
+TEST (AudioProcessorGraphTests, EmptyGraphOutputsSilence)
+{
+    AudioProcessorGraph graph;
+    graph.prepareToPlay (sampleRate, blockSize);
+
+    auto buffer = makeBuffer (1.0f);
+    MidiBuffer midi;
+    graph.processBlock (buffer, midi);
+
+    EXPECT_EQ (buffer.getMagnitude (0, blockSize), 0.0f);
+}
+
+TEST (AudioProcessorGraphTests, PassesInputToOutput)
+{
+    AudioProcessorGraph graph;
+    connectStereo (graph, AudioProcessorGraph::inputNodeID, AudioProcessorGraph::outputNodeID);
+    graph.prepareToPlay (sampleRate, blockSize);
+
+    auto buffer = makeBuffer (0.5f);
+    MidiBuffer midi;
+    graph.processBlock (buffer, midi);
+
+    EXPECT_EQ (buffer.getSample (0, 0), 0.5f);
+    EXPECT_EQ (buffer.getSample (1, blockSize - 1), 0.5f);
+}
+
+TEST (AudioProcessorGraphTests, ProcessesChainsAndSumsBranches)
+{
+    AudioProcessorGraph graph;
+    graph.prepareToPlay (sampleRate, blockSize);
+
+    const auto first = graph.addNode (std::make_unique<TestProcessor> (2.0f));
+    const auto second = graph.addNode (std::make_unique<TestProcessor> (3.0f));
+    const auto branch = graph.addNode (std::make_unique<TestProcessor> (0.5f));
+
+    connectStereo (graph, AudioProcessorGraph::inputNodeID, first);
+    connectStereo (graph, first, second);
+    connectStereo (graph, second, AudioProcessorGraph::outputNodeID);
+    connectStereo (graph, AudioProcessorGraph::inputNodeID, branch);
+    connectStereo (graph, branch, AudioProcessorGraph::outputNodeID);
+
+    EXPECT_TRUE (static_cast<TestProcessor*> (graph.getProcessorForNode (first))->isPrepared);
+
+    auto buffer = makeBuffer (1.0f);
+    MidiBuffer midi;
+    graph.processBlock (buffer, midi);
+
+    EXPECT_EQ (buffer.getSample (0, 0), 6.5f);
+    EXPECT_EQ (buffer.getSample (1, blockSize - 1), 6.5f);
+}
+
+TEST (AudioProcessorGraphTests, RejectsInvalidConnectionsAndCycles)
+{
+    AudioProcessorGraph graph;
+
+    const auto first = graph.addNode (std::make_unique<TestProcessor>());
+    const auto second = graph.addNode (std::make_unique<TestProcessor>());
+
+    EXPECT_TRUE (graph.addConnection ({ first, 0, second, 0 }));
+    EXPECT_FALSE (graph.addConnection ({ first, 0, second, 0 }));
+    EXPECT_FALSE (graph.addConnection ({ second, 0, first, 0 }));
+    EXPECT_FALSE (graph.addConnection ({ first, 0, first, 1 }));
+    EXPECT_FALSE (graph.addConnection ({ first, 2, second, 0 }));
+    EXPECT_FALSE (graph.addConnection ({ first, 0, AudioProcessorGraph::inputNodeID, 0 }));
+    EXPECT_FALSE (graph.addConnection ({ AudioProcessorGraph::outputNodeID, 0, first, 0 }));
+    EXPECT_FALSE (graph.addConnection ({ first, AudioProcessorGraph::midiChannelIndex, second, 0 }));
+    EXPECT_FALSE (graph.addConnection ({ first, 0, 1234, 0 }));
+    EXPECT_TRUE (graph.addConnection ({ first, AudioProcessorGraph::midiChannelIndex, second, AudioProcessorGraph::midiChannelIndex }));
+
+    EXPECT_EQ (graph.getConnections().size(), 2u);
+
+    EXPECT_TRUE (graph.removeNode (first));
+    EXPECT_FALSE (graph.removeNode (first));
+    EXPECT_TRUE (graph.getConnections().empty());
+    EXPECT_EQ (graph.getNumNodes(), 1);
+}
+
+TEST (AudioProcessorGraphTests, CompensatesLatencyOfParallelPaths)
+{
+    constexpr int latency = 37;
+
+    AudioProcessorGraph graph;
+
+    const auto delayed = graph.addNode (std::make_unique<TestProcessor> (1.0f, latency));
+    connectStereo (graph, AudioProcessorGraph::inputNodeID, delayed);
+    connectStereo (graph, delayed, AudioProcessorGraph::outputNodeID);
+    connectStereo (graph, AudioProcessorGraph::inputNodeID, AudioProcessorGraph::outputNodeID);
+
+    graph.prepareToPlay (sampleRate, blockSize);
+    EXPECT_EQ (graph.getLatencySamples(), latency);
+
+    auto buffer = makeBuffer (0.0f);
+    buffer.setSample (0, 0, 1.0f);
+    buffer.setSample (1, 0, 1.0f);
+
+    MidiBuffer midi;
+    graph.processBlock (buffer, midi);
+
+    for (int i = 0; i < blockSize; ++i)
+        EXPECT_EQ (buffer.getSample (0, i), i == latency ? 2.0f : 0.0f) << "at sample " << i;
+
+    EXPECT_EQ (buffer.getSample (1, latency), 2.0f);
+}
+
+TEST (AudioProcessorGraphTests, RoutesMidi)
+{
+    AudioProcessorGraph graph;
+
+    auto processor = std::make_unique<TestProcessor>();
+    processor->noteToAdd = 64;
+
+    const auto node = graph.addNode (std::move (processor));
+    graph.addConnection ({ AudioProcessorGraph::inputNodeID, AudioProcessorGraph::midiChannelIndex, node, AudioProcessorGraph::midiChannelIndex });
+    graph.addConnection ({ node, AudioProcessorGraph::midiChannelIndex, AudioProcessorGraph::outputNodeID, AudioProcessorGraph::midiChannelIndex });
+    graph.prepareToPlay (sampleRate, blockSize);
+
+    auto buffer = makeBuffer (0.0f);
+    MidiBuffer midi;
+    midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 10);
+    graph.processBlock (buffer, midi);
+
+    std::vector<int> notes;
+    for (const auto metadata : midi)
+        notes.push_back (metadata.getMessage().getNoteNumber());
+
+    EXPECT_EQ (notes, (std::vector<int> { 64, 60 }));
+}
+
+TEST (AudioProcessorGraphTests, DropsMidiBeyondTheReservedSpace)
+{
+    AudioProcessorGraph graph;
+    graph.addConnection ({ AudioProcessorGraph::inputNodeID, AudioProcessorGraph::midiChannelIndex, AudioProcessorGraph::outputNodeID, AudioProcessorGraph::midiChannelIndex });
+    graph.prepareToPlay (sampleRate, blockSize);
+
+    constexpr int numEvents = 4096;
+
+    auto buffer = makeBuffer (0.0f);
+    MidiBuffer midi;
+    for (int i = 0; i < numEvents; ++i)
+        midi.addEvent (MidiMessage::noteOn (1, i % 128, 1.0f), i % blockSize);
+
+    graph.processBlock (buffer, midi);
+
+    const auto numEventsOut = midi.getNumEvents();
+    EXPECT_GT (numEventsOut, 0);
+    EXPECT_LT (numEventsOut, numEvents);
+    EXPECT_EQ ((*midi.begin()).getMessage().getNoteNumber(), 0);
+}
+
+TEST (AudioProcessorGraphTests, ExposesParametersOfAllNodes)
+{
+    AudioProcessorGraph graph;
+
+    const auto first = graph.addNode (std::make_unique<TestProcessor> (2.0f));
+    graph.addNode (std::make_unique<TestProcessor> (3.0f));
+
+    ASSERT_EQ (graph.getNumParameters(), 2);
+    EXPECT_EQ (graph.getParameter (1).getValue(), 3.0f);
+
+    graph.removeNode (first);
+
+    ASSERT_EQ (graph.getNumParameters(), 1);
+    EXPECT_EQ (graph.getParameter (0).getValue(), 3.0f);
+}
+
+TEST (AudioProcessorGraphTests, ParallelRenderMatchesSingleThreaded)
+{
+    AudioProcessorGraph singleThreaded, multiThreaded;
+    buildLayeredGraph (singleThreaded, 48, 6, 4);
+    buildLayeredGraph (multiThreaded, 48, 6, 4);
+
+    multiThreaded.setNumWorkerThreads (3);
+    singleThreaded.prepareToPlay (sampleRate, blockSize);
+    multiThreaded.prepareToPlay (sampleRate, blockSize);
+
+    for (int block = 0; block < 50; ++block)
+    {
+        // Also change the number of workers while rendering
+        if (block == 25)
+            multiThreaded.setNumWorkerThreads (1);
+
+        auto expected = makeBuffer (static_cast<float> (block % 7) * 0.1f);
+        auto actual = makeBuffer (static_cast<float> (block % 7) * 0.1f);
+
+        MidiBuffer midi;
+        singleThreaded.processBlock (expected, midi);
+        multiThreaded.processBlock (actual, midi);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            ASSERT_TRUE (std::equal (expected.getReadPointer (channel),
+                                     expected.getReadPointer (channel) + blockSize,
+                                     actual.getReadPointer (channel)))
+                << "block " << block << " channel " << channel;
+        }
+    }
+}
+
+TEST (AudioProcessorGraphTests, DISABLED_ThroughputAndDeadlineMissesBenchmark)
+{
+    constexpr int numBlocks = 100;
+    constexpr double deadlineMs = 1000.0 * blockSize / sampleRate;
+
+    std::vector<int> workerCounts { 0 };
+    for (int numWorkers = 1; numWorkers < jmax (2, SystemStats::getNumCpus()); numWorkers *= 2)
+        workerCounts.push_back (numWorkers);
+
+    for (const auto numNodes : { 8, 32, 128 })
+    {
+        for (const auto numWorkers : workerCounts)
+        {
+            AudioProcessorGraph graph;
+            buildLayeredGraph (graph, numNodes, 8, 8);
+
+            graph.setNumWorkerThreads (numWorkers);
+            graph.prepareToPlay (sampleRate, blockSize);
+
+            auto buffer = makeBuffer (0.0f);
+            MidiBuffer midi;
+
+            int deadlineMisses = 0;
+            double worstMs = 0.0;
+
+            const auto start = Time::getMillisecondCounterHiRes();
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                buffer.clear();
+
+                const auto blockStart = Time::getMillisecondCounterHiRes();
+                graph.processBlock (buffer, midi);
+                const auto blockMs = Time::getMillisecondCounterHiRes() - blockStart;
+
+                worstMs = jmax (worstMs, blockMs);
+                if (blockMs > deadlineMs)
+                    ++deadlineMisses;
+            }
+            const auto averageMs = (Time::getMillisecondCounterHiRes() - start) / numBlocks;
+
+            EXPECT_TRUE (std::isfinite (buffer.getSample (0, 0)));
+
+            std::cout << "nodes: " << numNodes
+                      << " workers: " << numWorkers
+                      << " average: " << averageMs << "ms"
+                      << " worst: " << worstMs << "ms"
+                      << " realtime: " << (deadlineMs / averageMs) << "x"
+                      << " deadline misses: " << deadlineMisses << "/" << numBlocks << std::endl;
+
+            graph.releaseResources();
+        }
+    }
+}
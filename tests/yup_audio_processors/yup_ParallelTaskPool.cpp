@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <yup_audio_processors/yup_audio_processors.h>
+
+using namespace yup;
+
+namespace
+{
+
+struct TaskCounters
+{
+    explicit TaskCounters (int numTasks)
+        : counts (static_cast<std::size_t> (numTasks))
+    {
+    }
+
+    static void run (void* context, int taskIndex)
+    {
+        static_cast<TaskCounters*> (context)->counts[static_cast<std::size_t> (taskIndex)].fetch_add (1);
+    }
+
+    bool allRanOnce() const
+    {
+        return std::all_of (counts.begin(), counts.end(), [] (const auto& count)
+        {
+            return count.load() == 1;
+        });
+    }
+
+    std::vector<std::atomic<int>> counts;
+};
+
+} // namespace
+
+TEST (ParallelTaskPoolTests, RunsEveryTaskOnce)
+{
+    for (const int numWorkers : { 0, 1, 3 })
+    {
+        ParallelTaskPool pool (numWorkers);
+        EXPECT_EQ (pool.getNumWorkerThreads(), numWorkers);
+
+        for (const int numTasks : { 0, 1, 2, 7, 64 })
+        {
+            TaskCounters counters (numTasks);
+            pool.run (numTasks, &TaskCounters::run, &counters);
+
+            EXPECT_TRUE (counters.allRanOnce()) << numWorkers << " workers, " << numTasks << " tasks";
+        }
+    }
+}
+
+TEST (ParallelTaskPoolTests, CompletesRepeatedBatches)
+{
+    ParallelTaskPool pool (2);
+
+    for (int batch = 0; batch < 1000; ++batch)
+    {
+        TaskCounters counters (16);
+        pool.run (16, &TaskCounters::run, &counters);
+
+        ASSERT_TRUE (counters.allRanOnce()) << "batch " << batch;
+    }
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <yup_audio_processors/yup_audio_processors.h>
+
+using namespace yup;
+
+namespace
+{
+
+std::vector<int> collectChanged (ParameterChangeFlags& flags)
+{
+    std::vector<int> indices;
+    flags.forEachChanged ([&] (int index)
+    {
+        indices.push_back (index);
+    });
+
+    return indices;
+}
+
+} // namespace
+
+TEST (ParameterChangeFlagsTests, VisitsOnlyMarkedParameters)
+{
+    ParameterChangeFlags flags;
+    flags.setNumParameters (1000);
+
+    EXPECT_FALSE (flags.hasChanges());
+
+    flags.markChanged (999);
+    flags.markChanged (3);
+    flags.markChanged (64);
+    flags.markChanged (3);
+    flags.markChanged (1000);
+    flags.markChanged (-1);
+
+    EXPECT_TRUE (flags.hasChanges());
+    EXPECT_EQ (collectChanged (flags), (std::vector<int> { 3, 64, 999 }));
+
+    EXPECT_FALSE (flags.hasChanges());
+    EXPECT_TRUE (collectChanged (flags).empty());
+}
+
+TEST (ParameterChangeFlagsTests, MarksAllParameters)
+{
+    ParameterChangeFlags flags;
+    flags.setNumParameters (70);
+    flags.markAllChanged();
+
+    const auto indices = collectChanged (flags);
+
+    ASSERT_EQ (indices.size(), 70u);
+    EXPECT_EQ (indices.front(), 0);
+    EXPECT_EQ (indices.back(), 69);
+}
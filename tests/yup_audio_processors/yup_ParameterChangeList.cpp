@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <yup_audio_processors/yup_audio_processors.h>
+
+using namespace yup;
+
+TEST (ParameterChangeListTests, StartsEmpty)
+{
+    ParameterChangeList list;
+
+    EXPECT_TRUE (list.isEmpty());
+    EXPECT_EQ (list.getNumChanges(), 0);
+    EXPECT_EQ (list.begin(), list.end());
+}
+
+TEST (ParameterChangeListTests, KeepsChangesSortedByOffset)
+{
+    ParameterChangeList list;
+    list.addChange (10, 0, 0.1f);
+    list.addChange (30, 1, 0.3f);
+    list.addChange (20, 0, 0.2f);
+    list.addChange (20, 2, 0.25f);
+    list.addChange (-5, 3, 0.0f);
+
+    ASSERT_EQ (list.getNumChanges(), 5);
+
+    std::vector<int> offsets;
+    for (const auto& change : list)
+        offsets.push_back (change.sampleOffset);
+
+    EXPECT_EQ (offsets, (std::vector<int> { 0, 10, 20, 20, 30 }));
+    EXPECT_EQ (list.getChange (2).value, 0.2f);
+    EXPECT_EQ (list.getChange (3).parameterIndex, 2);
+}
+
+TEST (ParameterChangeListTests, ClearKeepsCapacity)
+{
+    ParameterChangeList list;
+    list.ensureCapacity (64);
+
+    for (int i = 0; i < 64; ++i)
+        list.addChange (i, 0, static_cast<float> (i));
+
+    const auto* storage = list.begin();
+    list.clear();
+
+    EXPECT_TRUE (list.isEmpty());
+
+    list.addChange (0, 0, 1.0f);
+    EXPECT_EQ (list.begin(), storage);
+}
+
+TEST (ParameterChangeListTests, NeverGrowsPastItsCapacity)
+{
+    ParameterChangeList list;
+    list.ensureCapacity (4);
+
+    const auto capacity = list.getCapacity();
+    for (int i = 0; i < capacity; ++i)
+        list.addChange (i, 0, 0.0f);
+
+    const auto* storage = list.begin();
+    list.addChange (capacity, 1, 0.5f);
+
+    EXPECT_EQ (list.getNumChanges(), capacity);
+    EXPECT_EQ (list.getCapacity(), capacity);
+    EXPECT_EQ (list.begin(), storage);
+}
+
+TEST (ParameterChangeListTests, CoalescesChangesOnceFull)
+{
+    ParameterChangeList list;
+
+    const auto capacity = list.getCapacity();
+    for (int i = 0; i < capacity; ++i)
+        list.addChange (i, i % 2, 0.0f);
+
+    list.addChange (capacity, 0, 0.75f);
+    list.addChange (0, 1, 0.25f);
+
+    ASSERT_EQ (list.getNumChanges(), capacity);
+
+    const auto& lastChangeOfFirstParameter = list.getChange (capacity - 2);
+    EXPECT_EQ (lastChangeOfFirstParameter.parameterIndex, 0);
+    EXPECT_EQ (lastChangeOfFirstParameter.value, 0.75f);
+
+    for (const auto& change : list)
+    {
+        if (change.parameterIndex == 1)
+            EXPECT_EQ (change.value, 0.0f);
+    }
+}
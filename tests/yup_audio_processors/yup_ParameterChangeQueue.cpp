@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <yup_audio_processors/yup_audio_processors.h>
+
+#include <thread>
+
+using namespace yup;
+
+namespace
+{
+
+using EventType = ParameterChangeQueue::EventType;
+
+std::vector<ParameterChangeQueue::Event> popAll (ParameterChangeQueue& queue)
+{
+    std::vector<ParameterChangeQueue::Event> events;
+    queue.popAll ([&] (const ParameterChangeQueue::Event& event)
+    {
+        events.push_back (event);
+    });
+
+    return events;
+}
+
+} // namespace
+
+TEST (ParameterChangeQueueTests, PopsEventsInOrder)
+{
+    ParameterChangeQueue queue (8);
+
+    EXPECT_TRUE (queue.push ({ EventType::gestureBegin, 3, 0.0f }));
+    EXPECT_TRUE (queue.push ({ EventType::valueChange, 3, 0.5f }));
+    EXPECT_TRUE (queue.push ({ EventType::gestureEnd, 3, 0.5f }));
+    EXPECT_EQ (queue.getNumReady(), 3);
+
+    const auto events = popAll (queue);
+
+    ASSERT_EQ (events.size(), 3u);
+    EXPECT_EQ (events[0].type, EventType::gestureBegin);
+    EXPECT_EQ (events[1].type, EventType::valueChange);
+    EXPECT_EQ (events[1].value, 0.5f);
+    EXPECT_EQ (events[2].type, EventType::gestureEnd);
+    EXPECT_EQ (queue.getNumReady(), 0);
+}
+
+TEST (ParameterChangeQueueTests, RejectsEventsWhenFull)
+{
+    ParameterChangeQueue queue (4);
+
+    for (int i = 0; i < 4; ++i)
+        EXPECT_TRUE (queue.push ({ EventType::valueChange, i, 0.0f }));
+
+    EXPECT_FALSE (queue.push ({ EventType::valueChange, 4, 0.0f }));
+    EXPECT_EQ (popAll (queue).size(), 4u);
+
+    // The space is reused once read, wrapping around the storage
+    for (int i = 0; i < 3; ++i)
+        EXPECT_TRUE (queue.push ({ EventType::valueChange, i, 0.0f }));
+
+    const auto events = popAll (queue);
+    ASSERT_EQ (events.size(), 3u);
+    EXPECT_EQ (events[2].parameterIndex, 2);
+}
+
+TEST (ParameterChangeQueueTests, TransfersBetweenThreads)
+{
+    constexpr int numEvents = 100000;
+
+    ParameterChangeQueue queue (64);
+
+    std::thread producer ([&]
+    {
+        for (int i = 0; i < numEvents; ++i)
+        {
+            while (! queue.push ({ EventType::valueChange, i, static_cast<float> (i) }))
+                std::this_thread::yield();
+        }
+    });
+
+    int expected = 0;
+    bool inOrder = true;
+
+    while (expected < numEvents)
+    {
+        queue.popAll ([&] (const ParameterChangeQueue::Event& event)
+        {
+            inOrder = inOrder && event.parameterIndex == expected && event.value == static_cast<float> (expected);
+            ++expected;
+        });
+    }
+
+    producer.join();
+
+    EXPECT_TRUE (inOrder);
+    EXPECT_EQ (expected, numEvents);
+}
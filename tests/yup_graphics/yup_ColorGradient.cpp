@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <yup_graphics/yup_graphics.h>
+
+using namespace yup;
+
+TEST (ColorGradientTests, TwoStopsByDefault)
+{
+    ColorGradient gradient (Color (0xff000000), 0.0f, 0.0f, Color (0xffffffff), 100.0f, 0.0f, ColorGradient::Linear);
+
+    EXPECT_EQ (gradient.getNumStops(), 2);
+    EXPECT_EQ (gradient.getStopColor (0).getARGB(), 0xff000000u);
+    EXPECT_EQ (gradient.getStopColor (1).getARGB(), 0xffffffffu);
+    EXPECT_EQ (gradient.getStopDelta (0), 0.0f);
+    EXPECT_EQ (gradient.getStopDelta (1), 1.0f);
+}
+
+TEST (ColorGradientTests, IntermediateStopsAreSorted)
+{
+    ColorGradient gradient (Color (0xff000000), 0.0f, 0.0f, Color (0xffffffff), 100.0f, 0.0f, ColorGradient::Linear);
+    gradient.addColorStop (Color (0xff00ff00), 0.75f);
+    gradient.addColorStop (Color (0xffff0000), 0.25f);
+    gradient.addColorStop (Color (0xff0000ff), 0.75f);
+    gradient.addColorStop (Color (0xff808080), 2.0f);
+
+    ASSERT_EQ (gradient.getNumStops(), 6);
+    EXPECT_EQ (gradient.getStopColor (1).getARGB(), 0xffff0000u);
+    EXPECT_EQ (gradient.getStopColor (2).getARGB(), 0xff00ff00u);
+    EXPECT_EQ (gradient.getStopColor (3).getARGB(), 0xff0000ffu);
+    EXPECT_EQ (gradient.getStopColor (4).getARGB(), 0xff808080u);
+    EXPECT_EQ (gradient.getStopDelta (1), 0.25f);
+    EXPECT_EQ (gradient.getStopDelta (3), 0.75f);
+    EXPECT_EQ (gradient.getStopDelta (4), 1.0f);
+    EXPECT_EQ (gradient.getStopColor (5).getARGB(), 0xffffffffu);
+
+    gradient.clearIntermediateStops();
+    EXPECT_EQ (gradient.getNumStops(), 2);
+}
+
+TEST (ColorGradientTests, AlphaAppliesToAllStops)
+{
+    ColorGradient gradient (Color (0xff000000), 0.0f, 0.0f, Color (0xffffffff), 100.0f, 0.0f, ColorGradient::Linear);
+    gradient.addColorStop (Color (0xffff0000), 0.5f);
+
+    const auto translucent = gradient.withAlpha (static_cast<uint8> (0x80));
+    for (int i = 0; i < translucent.getNumStops(); ++i)
+        EXPECT_EQ (translucent.getStopColor (i).getAlpha(), 0x80);
+}
+
+TEST (ColorGradientTests, Equality)
+{
+    ColorGradient a (Color (0xff000000), 0.0f, 0.0f, Color (0xffffffff), 100.0f, 0.0f, ColorGradient::Linear);
+    ColorGradient b (a);
+    EXPECT_TRUE (a == b);
+
+    b.addColorStop (Color (0xffff0000), 0.5f);
+    EXPECT_TRUE (a != b);
+
+    a.addColorStop (Color (0xffff0000), 0.5f);
+    EXPECT_TRUE (a == b);
+
+    ColorGradient radial (Color (0xff000000), 0.0f, 0.0f, Color (0xffffffff), 100.0f, 0.0f, ColorGradient::Radial);
+    radial.addColorStop (Color (0xffff0000), 0.5f);
+    EXPECT_TRUE (a != radial);
+}
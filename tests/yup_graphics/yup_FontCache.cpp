@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <gtest/gtest.h>
+
+#include <yup_graphics/yup_graphics.h>
+
+using namespace yup;
+
+namespace
+{
+
+Font loadTestFont()
+{
+    const auto fontFile = File (__FILE__)
+                              .getParentDirectory()
+                              .getParentDirectory()
+                              .getParentDirectory()
+                              .getChildFile ("examples/graphics/data/Roboto-Regular.ttf");
+
+    return Font (fontFile);
+}
+
+} // namespace
+
+TEST (FontCacheTests, GlyphPathsAreShared)
+{
+    auto font = loadTestFont();
+    if (font.getFont() == nullptr)
+        GTEST_SKIP() << "Test font not available";
+
+    auto& cache = FontCache::getInstance();
+    cache.clear();
+
+    auto first = cache.getGlyphPath (font.getFont(), 36);
+    auto second = cache.getGlyphPath (font.getFont(), 36);
+
+    EXPECT_EQ (first.get(), second.get());
+    EXPECT_EQ (cache.getStatistics().glyphMisses, 1);
+    EXPECT_EQ (cache.getStatistics().glyphHits, 1);
+    EXPECT_EQ (cache.getNumCachedGlyphPaths(), 1);
+}
+
+TEST (FontCacheTests, GlyphPathsAreEvictedLeastRecentlyUsedFirst)
+{
+    auto font = loadTestFont();
+    if (font.getFont() == nullptr)
+        GTEST_SKIP() << "Test font not available";
+
+    auto& cache = FontCache::getInstance();
+    cache.clear();
+    cache.setMaxGlyphPaths (2);
+
+    auto a = cache.getGlyphPath (font.getFont(), 36);
+    cache.getGlyphPath (font.getFont(), 37);
+    cache.getGlyphPath (font.getFont(), 36);
+    cache.getGlyphPath (font.getFont(), 38);
+
+    EXPECT_EQ (cache.getNumCachedGlyphPaths(), 2);
+    EXPECT_EQ (cache.getGlyphPath (font.getFont(), 36).get(), a.get());
+    EXPECT_EQ (cache.getStatistics().glyphMisses, 3);
+
+    cache.setMaxGlyphPaths (4096);
+}
+
+TEST (FontCacheTests, StyledTextReusesShapedText)
+{
+    auto font = loadTestFont();
+    if (font.getFont() == nullptr)
+        GTEST_SKIP() << "Test font not available";
+
+    auto& cache = FontCache::getInstance();
+    cache.clear();
+
+    for (int i = 0; i < 3; ++i)
+    {
+        StyledText text;
+        text.appendText (font, 12.0f, 14.0f, "Hello World");
+        text.layout ({ 0.0f, 0.0f, 200.0f, 50.0f }, StyledText::left);
+
+        EXPECT_EQ (text.getGlyphs().size(), 11u);
+    }
+
+    const auto statistics = cache.getStatistics();
+    EXPECT_EQ (statistics.shapingMisses, 1);
+    EXPECT_EQ (statistics.shapingHits, 2);
+    EXPECT_EQ (statistics.glyphMisses, cache.getNumCachedGlyphPaths());
+    EXPECT_GT (statistics.glyphHits, 0);
+}
+
+TEST (FontCacheTests, DifferentRunsAreShapedSeparately)
+{
+    auto font = loadTestFont();
+    if (font.getFont() == nullptr)
+        GTEST_SKIP() << "Test font not available";
+
+    auto& cache = FontCache::getInstance();
+    cache.clear();
+
+    StyledText small;
+    small.appendText (font, 12.0f, 14.0f, "Value");
+
+    StyledText large;
+    large.appendText (font, 24.0f, 28.0f, "Value");
+
+    EXPECT_EQ (cache.getStatistics().shapingMisses, 2);
+    EXPECT_EQ (cache.getNumCachedShapedTexts(), 2);
+}
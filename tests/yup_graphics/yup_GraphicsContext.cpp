@@ -0,0 +1,313 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <gtest/gtest.h>
+
+#include <yup_graphics/yup_graphics.h>
+
+#include "yup_GraphicsTestHelpers.hpp"
+
+using namespace yup;
+using namespace yup::test;
+
+namespace
+{
+
+void expectPixelNear (uint32 actual, uint32 expected)
+{
+    for (int shift = 0; shift < 32; shift += 8)
+        EXPECT_NEAR (static_cast<int> ((actual >> shift) & 0xff), static_cast<int> ((expected >> shift) & 0xff), 1)
+            << std::hex << "actual 0x" << actual << ", expected 0x" << expected;
+}
+
+} // namespace
+
+TEST (GraphicsContextTests, SoftwareContextIsAvailable)
+{
+    auto context = createSoftwareContext();
+    ASSERT_NE (context, nullptr);
+    EXPECT_NE (context->factory(), nullptr);
+    EXPECT_EQ (context->renderContextOrNull(), nullptr);
+    EXPECT_EQ (context->dpiScale (nullptr), 1.0f);
+}
+
+TEST (GraphicsContextTests, SoftwareClearColor)
+{
+    auto context = createSoftwareContext();
+    auto image = renderFrame (*context, 0xff336699, [] (Graphics&) {});
+
+    ASSERT_TRUE (image.isValid());
+    EXPECT_EQ (image.getWidth(), width);
+    EXPECT_EQ (image.getHeight(), height);
+    EXPECT_EQ (image.getPixelFormat(), PixelFormat::RGBA);
+    EXPECT_EQ (image.getPixel (0, 0), 0x336699ffu);
+    EXPECT_EQ (image.getPixel (width - 1, height - 1), 0x336699ffu);
+}
+
+TEST (GraphicsContextTests, SoftwareFillRectangleIsPixelExact)
+{
+    auto context = createSoftwareContext();
+    auto image = renderFrame (*context, 0xff000000, [] (Graphics& g)
+    {
+        g.setFillColor (Color (0xffff0000));
+        g.fillRect (8.0f, 8.0f, 16.0f, 16.0f);
+    });
+
+    EXPECT_EQ (image.getPixel (8, 8), 0xff0000ffu);
+    EXPECT_EQ (image.getPixel (23, 23), 0xff0000ffu);
+    EXPECT_EQ (image.getPixel (7, 8), 0x000000ffu);
+    EXPECT_EQ (image.getPixel (24, 23), 0x000000ffu);
+    EXPECT_EQ (image.getPixel (23, 24), 0x000000ffu);
+}
+
+TEST (GraphicsContextTests, SoftwareFillRectangleIsAntialiased)
+{
+    auto context = createSoftwareContext();
+    auto image = renderFrame (*context, 0xff000000, [] (Graphics& g)
+    {
+        g.setFillColor (Color (0xffffffff));
+        g.fillRect (8.5f, 8.0f, 8.0f, 8.0f);
+    });
+
+    const auto edge = image.getPixel (8, 10);
+    EXPECT_NEAR (static_cast<int> (edge >> 24), 128, 2);
+    EXPECT_EQ (image.getPixel (9, 10), 0xffffffffu);
+}
+
+TEST (GraphicsContextTests, SoftwareTranslucentFillBlendsOver)
+{
+    auto context = createSoftwareContext();
+    auto image = renderFrame (*context, 0xff0000ff, [] (Graphics& g)
+    {
+        g.setFillColor (Color (0x80ff0000));
+        g.fillAll();
+    });
+
+    const auto pixel = image.getPixel (32, 32);
+    EXPECT_NEAR (static_cast<int> ((pixel >> 24) & 0xff), 128, 2);
+    EXPECT_EQ (static_cast<int> ((pixel >> 16) & 0xff), 0);
+    EXPECT_NEAR (static_cast<int> ((pixel >> 8) & 0xff), 127, 2);
+    EXPECT_EQ (static_cast<int> (pixel & 0xff), 255);
+}
+
+TEST (GraphicsContextTests, SoftwareClipRestrictsDrawing)
+{
+    auto context = createSoftwareContext();
+    auto image = renderFrame (*context, 0xff000000, [] (Graphics& g)
+    {
+        g.setClipPath (Rectangle<float> (0.0f, 0.0f, 32.0f, 64.0f));
+        g.setFillColor (Color (0xff00ff00));
+        g.fillAll();
+    });
+
+    EXPECT_EQ (image.getPixel (31, 10), 0x00ff00ffu);
+    EXPECT_EQ (image.getPixel (32, 10), 0x000000ffu);
+}
+
+TEST (GraphicsContextTests, SoftwareEllipseClipRestrictsDrawing)
+{
+    auto context = createSoftwareContext();
+    auto image = renderFrame (*context, 0xff000000, [] (Graphics& g)
+    {
+        Path clip;
+        clip.addEllipse (16.0f, 16.0f, 32.0f, 32.0f);
+
+        g.setClipPath (clip);
+        g.setFillColor (Color (0xff00ff00));
+        g.fillAll();
+    });
+
+    EXPECT_EQ (image.getPixel (32, 32), 0x00ff00ffu);
+    EXPECT_EQ (image.getPixel (17, 17), 0x000000ffu);
+    EXPECT_EQ (image.getPixel (2, 32), 0x000000ffu);
+}
+
+TEST (GraphicsContextTests, SoftwareStrokeCoversOutline)
+{
+    auto context = createSoftwareContext();
+    auto image = renderFrame (*context, 0xff000000, [] (Graphics& g)
+    {
+        g.setStrokeColor (Color (0xffffffff));
+        g.setStrokeWidth (4.0f);
+        g.strokeRect (16.0f, 16.0f, 32.0f, 32.0f);
+    });
+
+    EXPECT_EQ (image.getPixel (16, 32), 0xffffffffu);
+    EXPECT_EQ (image.getPixel (47, 32), 0xffffffffu);
+    EXPECT_EQ (image.getPixel (32, 32), 0x000000ffu);
+    EXPECT_EQ (image.getPixel (8, 32), 0x000000ffu);
+}
+
+TEST (GraphicsContextTests, SoftwareLinearGradient)
+{
+    auto context = createSoftwareContext();
+    auto image = renderFrame (*context, 0xff000000, [] (Graphics& g)
+    {
+        g.setFillColorGradient (ColorGradient (Color (0xff000000), 0.0f, 0.0f, Color (0xffffffff), static_cast<float> (width), 0.0f, ColorGradient::Linear));
+        g.fillAll();
+    });
+
+    const auto left = (image.getPixel (1, 32) >> 24) & 0xff;
+    const auto middle = (image.getPixel (32, 32) >> 24) & 0xff;
+    const auto right = (image.getPixel (62, 32) >> 24) & 0xff;
+
+    EXPECT_LT (left, 16u);
+    EXPECT_NEAR (static_cast<int> (middle), 128, 8);
+    EXPECT_GT (right, 240u);
+}
+
+TEST (GraphicsContextTests, SoftwareMultiStopLinearGradient)
+{
+    auto context = createSoftwareContext();
+    auto image = renderFrame (*context, 0xff000000, [] (Graphics& g)
+    {
+        ColorGradient gradient (Color (0xffff0000), 0.0f, 0.0f, Color (0xff0000ff), static_cast<float> (width), 0.0f, ColorGradient::Linear);
+        gradient.addColorStop (Color (0xff00ff00), 0.5f);
+
+        g.setFillColorGradient (gradient);
+        g.fillAll();
+    });
+
+    const auto left = image.getPixel (1, 32);
+    const auto middle = image.getPixel (32, 32);
+    const auto right = image.getPixel (62, 32);
+
+    EXPECT_GT ((left >> 24) & 0xff, 240u);
+    EXPECT_GT ((middle >> 16) & 0xff, 240u);
+    EXPECT_LT ((middle >> 24) & 0xff, 16u);
+    EXPECT_GT ((right >> 8) & 0xff, 240u);
+}
+
+TEST (GraphicsContextTests, SoftwareDrawImage)
+{
+    Image source (4, 4, PixelFormat::RGBA);
+    source.fill (0x0000ffff);
+
+    auto context = createSoftwareContext();
+    auto image = renderFrame (*context, 0xff000000, [&] (Graphics& g)
+    {
+        g.drawImageAt (source, { 10.0f, 10.0f });
+    });
+
+    EXPECT_EQ (image.getPixel (11, 11), 0x0000ffffu);
+    EXPECT_EQ (image.getPixel (12, 12), 0x0000ffffu);
+    EXPECT_EQ (image.getPixel (20, 20), 0x000000ffu);
+}
+
+TEST (GraphicsContextTests, SoftwareFillBlendModesMatchReferencePixels)
+{
+    // Backdrop (0.2, 0.4, 0.6) blended with source (0.8, 0.6, 0.2), using the W3C compositing formulas
+    const std::pair<BlendMode, uint32> references[] = {
+        { BlendMode::Multiply, 0x293d1fffu },
+        { BlendMode::Screen, 0xd6c2adffu },
+        { BlendMode::Overlay, 0x527a5cffu },
+        { BlendMode::Darken, 0x336633ffu },
+        { BlendMode::Lighten, 0xcc9999ffu },
+        { BlendMode::ColorDodge, 0xffffbfffu },
+        { BlendMode::ColorBurn, 0x000000ffu },
+        { BlendMode::HardLight, 0xad853dffu },
+        { BlendMode::SoftLight, 0x597274ffu },
+        { BlendMode::Difference, 0x993366ffu },
+        { BlendMode::Exclusion, 0xad858fffu },
+        { BlendMode::Hue, 0x7c5a16ffu },
+        { BlendMode::Saturation, 0x1e6bb7ffu },
+        { BlendMode::Color, 0x855900ffu },
+        { BlendMode::Luminosity, 0x74a7daffu }
+    };
+
+    auto context = createSoftwareContext();
+
+    for (const auto& [blendMode, expected] : references)
+    {
+        SCOPED_TRACE (static_cast<int> (blendMode));
+
+        auto image = renderFrame (*context, 0xff336699, [mode = blendMode] (Graphics& g)
+        {
+            g.setBlendMode (mode);
+            g.setFillColor (Color (0xffcc9933));
+            g.fillRect (8.0f, 8.0f, 16.0f, 16.0f);
+        });
+
+        expectPixelNear (image.getPixel (12, 12), expected);
+        EXPECT_EQ (image.getPixel (30, 30), 0x336699ffu);
+    }
+}
+
+TEST (GraphicsContextTests, SoftwareTranslucentMultiplyBlend)
+{
+    auto context = createSoftwareContext();
+    auto image = renderFrame (*context, 0xff336699, [] (Graphics& g)
+    {
+        g.setBlendMode (BlendMode::Multiply);
+        g.setFillColor (Color (0x80cc9933));
+        g.fillRect (8.0f, 8.0f, 16.0f, 16.0f);
+    });
+
+    // Half of the backdrop shows through, the other half is multiplied: cb * (1 - as) + as * cb * cs
+    expectPixelNear (image.getPixel (12, 12), 0x2e525cffu);
+}
+
+TEST (GraphicsContextTests, SoftwareDrawImageHonoursBlendMode)
+{
+    Image source (4, 4, PixelFormat::RGBA);
+    source.fill (0xcc9933ff);
+
+    auto context = createSoftwareContext();
+    auto image = renderFrame (*context, 0xff336699, [&] (Graphics& g)
+    {
+        g.setBlendMode (BlendMode::Difference);
+        g.drawImageAt (source, { 10.0f, 10.0f });
+    });
+
+    expectPixelNear (image.getPixel (11, 11), 0x993366ffu);
+    EXPECT_EQ (image.getPixel (20, 20), 0x336699ffu);
+}
+
+TEST (GraphicsContextTests, SoftwareMultithreadedOutputMatchesSingleThreaded)
+{
+    const auto paint = [] (Graphics& g)
+    {
+        g.setFillColor (Color (0xffff8000));
+        g.fillRoundedRect (4.0f, 4.0f, 56.0f, 40.0f, 8.0f);
+
+        g.setStrokeColor (Color (0xc00080ff));
+        g.setStrokeWidth (3.0f);
+        g.strokeLine (0.0f, 0.0f, 64.0f, 64.0f);
+
+        Path ellipse;
+        ellipse.addEllipse (20.0f, 30.0f, 40.0f, 30.0f);
+
+        g.setFillColor (Color (0x8000ff00));
+        g.fillPath (ellipse);
+    };
+
+    auto singleThreaded = createSoftwareContext (0);
+    auto multiThreaded = createSoftwareContext (3);
+
+    auto expected = renderFrame (*singleThreaded, 0xff202020, paint);
+    auto actual = renderFrame (*multiThreaded, 0xff202020, paint);
+
+    const auto expectedData = expected.getRawData();
+    const auto actualData = actual.getRawData();
+
+    ASSERT_EQ (expectedData.size(), actualData.size());
+    EXPECT_TRUE (std::equal (expectedData.begin(), expectedData.end(), actualData.begin()));
+}
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <yup_graphics/yup_graphics.h>
+
+#include <functional>
+#include <memory>
+
+namespace yup::test
+{
+
+//==============================================================================
+/** The size of the frames rendered by the graphics tests. */
+constexpr int width = 64;
+constexpr int height = 64;
+
+//==============================================================================
+/** Creates a software graphics context sized to the test frames. */
+inline std::unique_ptr<GraphicsContext> createSoftwareContext (int numRenderThreads = 0)
+{
+    GraphicsContext::Options options;
+    options.numRenderThreads = numRenderThreads;
+
+    auto context = GraphicsContext::createContext (GraphicsContext::Software, options);
+    context->onSizeChanged (nullptr, width, height, 0);
+    return context;
+}
+
+/** Renders a frame cleared to a color with the paint function, returning the resulting pixels. */
+inline Image renderFrame (GraphicsContext& context, uint32 clearColor, const std::function<void (Graphics&)>& paint)
+{
+    context.getImageAtlas().beginFrame (context);
+
+    rive::gpu::RenderContext::FrameDescriptor frameDescriptor;
+    frameDescriptor.renderTargetWidth = width;
+    frameDescriptor.renderTargetHeight = height;
+    frameDescriptor.loadAction = rive::gpu::LoadAction::clear;
+    frameDescriptor.clearColor = clearColor;
+
+    context.begin (frameDescriptor);
+
+    {
+        auto renderer = context.makeRenderer (width, height);
+
+        Graphics g (context, *renderer);
+        g.setDrawingArea ({ 0.0f, 0.0f, static_cast<float> (width), static_cast<float> (height) });
+        paint (g);
+    }
+
+    context.end (nullptr);
+
+    return context.readPixels();
+}
+
+/** Renders a frame cleared to opaque black with the paint function, returning the resulting pixels. */
+inline Image renderFrame (GraphicsContext& context, const std::function<void (Graphics&)>& paint)
+{
+    return renderFrame (context, 0xff000000, paint);
+}
+
+} // namespace yup::test
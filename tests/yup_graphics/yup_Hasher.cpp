@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <gtest/gtest.h>
+
+#include <yup_graphics/yup_graphics.h>
+
+using namespace yup;
+
+TEST (HasherTests, SameSequenceGivesSameHash)
+{
+    const auto first = Hasher().add (0x12345678u).add (1.5f).getHash();
+    const auto second = Hasher().add (0x12345678u).add (1.5f).getHash();
+
+    EXPECT_EQ (first, second);
+    EXPECT_NE (first, Hasher().getHash());
+}
+
+TEST (HasherTests, OrderOfValuesMatters)
+{
+    EXPECT_NE (Hasher().add (1u).add (2u).getHash(), Hasher().add (2u).add (1u).getHash());
+}
+
+TEST (HasherTests, FloatsAreHashedByBitPattern)
+{
+    EXPECT_NE (Hasher().add (0.0f).getHash(), Hasher().add (-0.0f).getHash());
+    EXPECT_EQ (Hasher().add (0.25f).getHash(), Hasher().add (0.25f).getHash());
+}
+
+TEST (HasherTests, BlocksHashTheirContentAndSize)
+{
+    const uint8 data[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+    uint8 copy[sizeof (data)];
+    std::memcpy (copy, data, sizeof (data));
+
+    EXPECT_EQ (Hasher().add (data, sizeof (data)).getHash(), Hasher().add (copy, sizeof (copy)).getHash());
+
+    copy[10] = 0;
+    EXPECT_NE (Hasher().add (data, sizeof (data)).getHash(), Hasher().add (copy, sizeof (copy)).getHash());
+
+    // Trailing zero bytes still change the hash, as the size is part of it
+    const uint8 padded[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 0 };
+    EXPECT_NE (Hasher().add (data, sizeof (data)).getHash(), Hasher().add (padded, sizeof (padded)).getHash());
+}
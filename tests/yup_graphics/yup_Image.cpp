@@ -0,0 +1,342 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <yup_graphics/yup_graphics.h>
+
+using namespace yup;
+
+namespace
+{
+
+// Odd sizes, so both the vectorised loops and their scalar tails are exercised
+constexpr int width = 37;
+constexpr int height = 13;
+
+Image makeNoiseImage (PixelFormat format, int seed = 1)
+{
+    Image image (width, height, format);
+
+    Random random (seed);
+    for (auto& byte : image.getRawData())
+        byte = static_cast<uint8> (random.nextInt (256));
+
+    return image;
+}
+
+uint8 divideBy255 (int value)
+{
+    return static_cast<uint8> ((value + 127) / 255);
+}
+
+} // namespace
+
+TEST (ImageTests, FillRectIsClipped)
+{
+    for (auto format : { PixelFormat::Grayscale, PixelFormat::RGB, PixelFormat::RGBA })
+    {
+        Image image (width, height, format);
+        image.clear();
+        image.fillRect ({ -3, 2, 20, 100 }, 0x11223344u);
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                const auto inside = x < 17 && y >= 2;
+                const auto expected = ! inside                         ? 0u
+                                    : format == PixelFormat::RGBA      ? 0x11223344u
+                                    : format == PixelFormat::RGB       ? 0x223344u
+                                                                       : 0x44u;
+
+                EXPECT_EQ (image.getPixel (x, y), expected);
+            }
+        }
+    }
+}
+
+TEST (ImageTests, FillMatchesSetPixel)
+{
+    for (auto format : { PixelFormat::Grayscale, PixelFormat::RGB, PixelFormat::RGBA })
+    {
+        Image filled (width, height, format);
+        filled.fill (0x8899aabbu);
+
+        Image reference (width, height, format);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+                reference.setPixel (x, y, 0x8899aabbu);
+        }
+
+        const auto a = filled.getRawData();
+        const auto b = reference.getRawData();
+        EXPECT_TRUE (std::equal (a.begin(), a.end(), b.begin()));
+    }
+}
+
+TEST (ImageTests, PremultiplyMatchesReference)
+{
+    auto image = makeNoiseImage (PixelFormat::RGBA);
+    const auto original = image.convertedTo (PixelFormat::RGBA);
+
+    image.premultiplyAlpha();
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            const auto source = original.getPixel (x, y);
+            const auto alpha = static_cast<int> (source & 0xff);
+
+            const auto r = divideBy255 (static_cast<int> (source >> 24) * alpha);
+            const auto g = divideBy255 (static_cast<int> ((source >> 16) & 0xff) * alpha);
+            const auto b = divideBy255 (static_cast<int> ((source >> 8) & 0xff) * alpha);
+
+            EXPECT_EQ (image.getPixel (x, y), (uint32 (r) << 24) | (uint32 (g) << 16) | (uint32 (b) << 8) | uint32 (alpha));
+        }
+    }
+}
+
+TEST (ImageTests, UnpremultiplyRoundTrips)
+{
+    auto image = makeNoiseImage (PixelFormat::RGBA);
+
+    // Only fairly opaque pixels keep enough precision to round trip closely
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+            image.setPixel (x, y, image.getPixel (x, y) | 0xc0u);
+    }
+
+    const auto original = image.convertedTo (PixelFormat::RGBA);
+
+    image.premultiplyAlpha();
+    image.unpremultiplyAlpha();
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            const auto a = original.getPixel (x, y);
+            const auto b = image.getPixel (x, y);
+
+            for (int shift = 0; shift < 32; shift += 8)
+                EXPECT_NEAR (static_cast<int> ((a >> shift) & 0xff), static_cast<int> ((b >> shift) & 0xff), 1);
+        }
+    }
+}
+
+TEST (ImageTests, ConversionsMatchReference)
+{
+    const auto rgba = makeNoiseImage (PixelFormat::RGBA);
+
+    const auto rgb = rgba.convertedTo (PixelFormat::RGB);
+    const auto gray = rgba.convertedTo (PixelFormat::Grayscale);
+    const auto grayFromRgb = rgb.convertedTo (PixelFormat::Grayscale);
+    const auto rgbaFromRgb = rgb.convertedTo (PixelFormat::RGBA);
+    const auto rgbaFromGray = gray.convertedTo (PixelFormat::RGBA);
+    const auto rgbFromGray = gray.convertedTo (PixelFormat::RGB);
+
+    EXPECT_EQ (rgb.getPixelFormat(), PixelFormat::RGB);
+    EXPECT_EQ (gray.getPixelFormat(), PixelFormat::Grayscale);
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            const auto pixel = rgba.getPixel (x, y);
+            const auto r = pixel >> 24, g = (pixel >> 16) & 0xff, b = (pixel >> 8) & 0xff;
+            const auto luma = (r * 77 + g * 150 + b * 29 + 128) >> 8;
+
+            EXPECT_EQ (rgb.getPixel (x, y), pixel >> 8);
+            EXPECT_EQ (gray.getPixel (x, y), luma);
+            EXPECT_EQ (grayFromRgb.getPixel (x, y), luma);
+            EXPECT_EQ (rgbaFromRgb.getPixel (x, y), pixel | 0xffu);
+            EXPECT_EQ (rgbaFromGray.getPixel (x, y), (luma << 24) | (luma << 16) | (luma << 8) | 0xffu);
+            EXPECT_EQ (rgbFromGray.getPixel (x, y), (luma << 16) | (luma << 8) | luma);
+        }
+    }
+}
+
+TEST (ImageTests, BlitCopiesAndClips)
+{
+    const auto source = makeNoiseImage (PixelFormat::RGBA);
+
+    Image dest (width, height, PixelFormat::RGBA);
+    dest.clear();
+    dest.blit (source, { 2, 3, 30, 8 }, { 20, -2 });
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            const auto sourceX = x - 20 + 2;
+            const auto sourceY = y + 2 + 3;
+            const auto inside = x >= 20 && sourceX < 32 && sourceY < 11;
+
+            EXPECT_EQ (dest.getPixel (x, y), inside ? source.getPixel (sourceX, sourceY) : 0u);
+        }
+    }
+
+    // Blitting into a different format converts the pixels
+    Image gray (width, height, PixelFormat::Grayscale);
+    gray.blit (source, { 0, 0, width, height }, { 0, 0 });
+
+    const auto converted = source.convertedTo (PixelFormat::Grayscale);
+    const auto a = gray.getRawData();
+    const auto b = converted.getRawData();
+    EXPECT_TRUE (std::equal (a.begin(), a.end(), b.begin()));
+}
+
+TEST (ImageTests, BlitBlendsPremultipliedPixels)
+{
+    auto source = makeNoiseImage (PixelFormat::RGBA, 1);
+    auto dest = makeNoiseImage (PixelFormat::RGBA, 2);
+    source.premultiplyAlpha();
+    dest.premultiplyAlpha();
+
+    const auto original = dest.convertedTo (PixelFormat::RGBA);
+    dest.blit (source, { 0, 0, width, height }, { 0, 0 }, true);
+
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            const auto src = source.getPixel (x, y);
+            const auto dst = original.getPixel (x, y);
+            const auto inverseAlpha = 255 - static_cast<int> (src & 0xff);
+
+            uint32 expected = 0;
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                const auto channel = jmin (255, static_cast<int> ((src >> shift) & 0xff) + divideBy255 (static_cast<int> ((dst >> shift) & 0xff) * inverseAlpha));
+                expected |= static_cast<uint32> (channel) << shift;
+            }
+
+            EXPECT_EQ (dest.getPixel (x, y), expected);
+        }
+    }
+}
+
+TEST (ImageTests, BlitWithinTheSameImage)
+{
+    auto image = makeNoiseImage (PixelFormat::RGB);
+    const auto original = image.convertedTo (PixelFormat::RGB);
+
+    image.blit (image, { 0, 0, 10, 10 }, { 5, 2 });
+
+    for (int y = 0; y < 10; ++y)
+    {
+        for (int x = 0; x < 10; ++x)
+            EXPECT_EQ (image.getPixel (x + 5, y + 2), original.getPixel (x, y));
+    }
+}
+
+TEST (ImageTests, DownscaleAveragesBlocks)
+{
+    for (auto format : { PixelFormat::Grayscale, PixelFormat::RGB, PixelFormat::RGBA })
+    {
+        const auto image = makeNoiseImage (format);
+        const auto stride = image.getPixelStride();
+        const auto small = image.downscaled (3);
+
+        ASSERT_EQ (small.getWidth(), width / 3);
+        ASSERT_EQ (small.getHeight(), height / 3);
+
+        const auto source = image.getRawData();
+        const auto result = small.getRawData();
+
+        for (int y = 0; y < small.getHeight(); ++y)
+        {
+            for (int x = 0; x < small.getWidth(); ++x)
+            {
+                for (int c = 0; c < stride; ++c)
+                {
+                    int sum = 0;
+                    for (int by = 0; by < 3; ++by)
+                    {
+                        for (int bx = 0; bx < 3; ++bx)
+                            sum += source[static_cast<size_t> (((y * 3 + by) * width + x * 3 + bx) * stride + c)];
+                    }
+
+                    EXPECT_EQ (result[static_cast<size_t> ((y * small.getWidth() + x) * stride + c)], (sum + 4) / 9);
+                }
+            }
+        }
+    }
+
+    // Factors larger than the image collapse it into a single pixel
+    EXPECT_EQ (makeNoiseImage (PixelFormat::RGBA).downscaled (100).getWidth(), 1);
+}
+
+TEST (ImageTests, DISABLED_KernelsBenchmark)
+{
+    constexpr int size = 1024;
+    constexpr int numIterations = 10;
+
+    Image image (size, size, PixelFormat::RGBA);
+
+    const auto setPixelStart = Time::getMillisecondCounterHiRes();
+    for (int i = 0; i < numIterations; ++i)
+    {
+        for (int y = 0; y < size; ++y)
+        {
+            for (int x = 0; x < size; ++x)
+                image.setPixel (x, y, 0x20406080u + static_cast<uint32> (i));
+        }
+    }
+    const auto setPixelMs = (Time::getMillisecondCounterHiRes() - setPixelStart) / numIterations;
+
+    const auto fillStart = Time::getMillisecondCounterHiRes();
+    for (int i = 0; i < numIterations; ++i)
+        image.fillRect ({ 0, 0, size, size }, 0x20406080u + static_cast<uint32> (i));
+    const auto fillMs = (Time::getMillisecondCounterHiRes() - fillStart) / numIterations;
+
+    const auto premultiplyStart = Time::getMillisecondCounterHiRes();
+    for (int i = 0; i < numIterations; ++i)
+        image.premultiplyAlpha();
+    const auto premultiplyMs = (Time::getMillisecondCounterHiRes() - premultiplyStart) / numIterations;
+
+    auto overlay = image.convertedTo (PixelFormat::RGBA);
+    const auto blendStart = Time::getMillisecondCounterHiRes();
+    for (int i = 0; i < numIterations; ++i)
+        image.blit (overlay, { 0, 0, size, size }, { 0, 0 }, true);
+    const auto blendMs = (Time::getMillisecondCounterHiRes() - blendStart) / numIterations;
+
+    const auto convertStart = Time::getMillisecondCounterHiRes();
+    for (int i = 0; i < numIterations; ++i)
+        overlay = image.convertedTo (PixelFormat::Grayscale).convertedTo (PixelFormat::RGBA);
+    const auto convertMs = (Time::getMillisecondCounterHiRes() - convertStart) / numIterations;
+
+    const auto downscaleStart = Time::getMillisecondCounterHiRes();
+    for (int i = 0; i < numIterations; ++i)
+        overlay = image.downscaled (4);
+    const auto downscaleMs = (Time::getMillisecondCounterHiRes() - downscaleStart) / numIterations;
+
+    EXPECT_EQ (overlay.getWidth(), size / 4);
+
+    std::cout << "Bitmap kernels (" << size << "x" << size << " RGBA): setPixel fill " << setPixelMs << " ms, fillRect " << fillMs << " ms\n"
+              << "premultiply " << premultiplyMs << " ms, blend " << blendMs << " ms, gray round trip " << convertMs
+              << " ms, downscale by 4 " << downscaleMs << " ms" << std::endl;
+}
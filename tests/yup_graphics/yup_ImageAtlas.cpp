@@ -0,0 +1,295 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <yup_graphics/yup_graphics.h>
+
+#include "yup_GraphicsTestHelpers.hpp"
+
+using namespace yup;
+using namespace yup::test;
+
+namespace
+{
+
+Image makeSolidImage (int size, uint32 color)
+{
+    Image image (size, size, PixelFormat::RGBA);
+    image.fill (color);
+    return image;
+}
+
+} // namespace
+
+TEST (ImageAtlasTests, SmallImagesShareOnePage)
+{
+    auto context = createSoftwareContext();
+    auto& atlas = context->getImageAtlas();
+
+    std::vector<Image> images;
+    for (int i = 0; i < 32; ++i)
+        images.push_back (makeSolidImage (8 + i % 8, 0xff0000ffu));
+
+    for (const auto& image : images)
+        EXPECT_TRUE (atlas.preload (image));
+
+    EXPECT_EQ (atlas.getNumEntries(), 32);
+    EXPECT_EQ (atlas.getNumPages(), 1);
+
+    // Staging the same pixels again doesn't add entries
+    EXPECT_TRUE (atlas.preload (images.front()));
+    EXPECT_EQ (atlas.getNumEntries(), 32);
+}
+
+TEST (ImageAtlasTests, EntriesDoNotOverlap)
+{
+    auto context = createSoftwareContext();
+    auto& atlas = context->getImageAtlas();
+
+    std::vector<Image> images;
+    for (int i = 0; i < 16; ++i)
+        images.push_back (makeSolidImage (5 + i * 3, 0xffffffffu));
+
+    std::vector<Rectangle<int>> areas;
+    for (const auto& image : images)
+    {
+        auto entry = atlas.getEntry (*context, image);
+        ASSERT_NE (entry, nullptr);
+
+        EXPECT_EQ (entry->area.getWidth(), image.getWidth());
+        EXPECT_EQ (entry->area.getHeight(), image.getHeight());
+        areas.push_back (entry->area);
+    }
+
+    for (std::size_t i = 0; i < areas.size(); ++i)
+    {
+        for (std::size_t j = i + 1; j < areas.size(); ++j)
+            EXPECT_TRUE (areas[i].intersection (areas[j]).isEmpty());
+    }
+}
+
+TEST (ImageAtlasTests, LargeImagesBypassTheAtlas)
+{
+    auto context = createSoftwareContext();
+    auto& atlas = context->getImageAtlas();
+    atlas.setMaxEntrySize (16);
+
+    auto small = makeSolidImage (16, 0xff0000ffu);
+    auto large = makeSolidImage (17, 0xff0000ffu);
+
+    EXPECT_TRUE (atlas.canPack (small));
+    EXPECT_FALSE (atlas.canPack (large));
+    EXPECT_FALSE (atlas.preload (large));
+    EXPECT_EQ (atlas.getEntry (*context, large), nullptr);
+    EXPECT_EQ (atlas.getNumEntries(), 0);
+}
+
+TEST (ImageAtlasTests, PreloadedImagesUploadBetweenFrames)
+{
+    auto context = createSoftwareContext();
+    auto& atlas = context->getImageAtlas();
+
+    auto first = makeSolidImage (8, 0xff0000ffu);
+    auto second = makeSolidImage (8, 0x00ff00ffu);
+
+    atlas.preload (first);
+    atlas.preload (second);
+
+    renderFrame (*context, [&] (Graphics& g)
+    {
+        g.drawImageAt (first, { 0.0f, 0.0f });
+        g.drawImageAt (second, { 16.0f, 0.0f });
+    });
+
+    const auto statistics = atlas.getCurrentFrameStatistics();
+    EXPECT_EQ (statistics.imageDraws, 2);
+    EXPECT_EQ (statistics.atlasDraws, 2);
+    EXPECT_EQ (statistics.pageUploads, 1);
+    EXPECT_EQ (statistics.synchronousUploads, 0);
+}
+
+TEST (ImageAtlasTests, ImagesDrawnWithoutPreloadUploadSynchronously)
+{
+    auto context = createSoftwareContext();
+    auto& atlas = context->getImageAtlas();
+
+    auto image = makeSolidImage (8, 0xff0000ffu);
+
+    renderFrame (*context, [&] (Graphics& g) { g.drawImageAt (image, { 0.0f, 0.0f }); });
+
+    EXPECT_EQ (atlas.getCurrentFrameStatistics().synchronousUploads, 1);
+
+    // Once uploaded, later frames don't upload again
+    renderFrame (*context, [&] (Graphics& g) { g.drawImageAt (image, { 0.0f, 0.0f }); });
+
+    EXPECT_EQ (atlas.getLastFrameStatistics().synchronousUploads, 1);
+    EXPECT_EQ (atlas.getCurrentFrameStatistics().pageUploads, 0);
+    EXPECT_EQ (atlas.getCurrentFrameStatistics().synchronousUploads, 0);
+}
+
+TEST (ImageAtlasTests, AtlasDrawsShareTextureBinds)
+{
+    auto context = createSoftwareContext();
+    auto& atlas = context->getImageAtlas();
+
+    std::vector<Image> images;
+    for (int i = 0; i < 20; ++i)
+    {
+        images.push_back (makeSolidImage (6, 0x0000ffffu));
+        atlas.preload (images.back());
+    }
+
+    renderFrame (*context, [&] (Graphics& g)
+    {
+        for (int i = 0; i < 20; ++i)
+            g.drawImageAt (images[static_cast<std::size_t> (i)], { static_cast<float> ((i % 8) * 8), static_cast<float> ((i / 8) * 8) });
+    });
+
+    const auto statistics = atlas.getCurrentFrameStatistics();
+    EXPECT_EQ (statistics.imageDraws, 20);
+    EXPECT_EQ (statistics.atlasDraws, 20);
+    EXPECT_EQ (statistics.textureBinds, 1);
+}
+
+TEST (ImageAtlasTests, AtlasDrawsArePixelExact)
+{
+    auto context = createSoftwareContext();
+
+    Image checker (4, 4, PixelFormat::RGBA);
+    for (int y = 0; y < 4; ++y)
+    {
+        for (int x = 0; x < 4; ++x)
+            checker.setPixel (x, y, ((x + y) & 1) != 0 ? 0xff0000ffu : 0x00ff00ffu);
+    }
+
+    auto solid = makeSolidImage (4, 0x0000ffffu);
+
+    context->getImageAtlas().preload (solid);
+    context->getImageAtlas().preload (checker);
+
+    auto image = renderFrame (*context, [&] (Graphics& g)
+    {
+        g.drawImageAt (solid, { 4.0f, 4.0f });
+        g.drawImageAt (checker, { 20.0f, 20.0f });
+    });
+
+    EXPECT_EQ (image.getPixel (4, 4), 0x0000ffffu);
+    EXPECT_EQ (image.getPixel (7, 7), 0x0000ffffu);
+    EXPECT_EQ (image.getPixel (8, 8), 0x000000ffu);
+
+    for (int y = 0; y < 4; ++y)
+    {
+        for (int x = 0; x < 4; ++x)
+            EXPECT_EQ (image.getPixel (20 + x, 20 + y), checker.getPixel (x, y));
+    }
+}
+
+TEST (ImageAtlasTests, AtlasAndOversizedImagesAreDrawnAtTheSamePosition)
+{
+    auto context = createSoftwareContext();
+    context->getImageAtlas().setMaxEntrySize (8);
+
+    auto small = makeSolidImage (8, 0x0000ffffu);
+    auto large = makeSolidImage (24, 0xff0000ffu);
+
+    ASSERT_NE (context->getImageAtlas().getEntry (*context, small), nullptr);
+    ASSERT_EQ (context->getImageAtlas().getEntry (*context, large), nullptr);
+
+    const auto smallImage = renderFrame (*context, [&] (Graphics& g) { g.drawImageAt (small, { 10.0f, 12.0f }); });
+    const auto largeImage = renderFrame (*context, [&] (Graphics& g) { g.drawImageAt (large, { 10.0f, 12.0f }); });
+
+    EXPECT_EQ (smallImage.getPixel (10, 12), 0x0000ffffu);
+    EXPECT_EQ (smallImage.getPixel (17, 19), 0x0000ffffu);
+    EXPECT_EQ (smallImage.getPixel (9, 12), 0x000000ffu);
+    EXPECT_EQ (smallImage.getPixel (10, 11), 0x000000ffu);
+    EXPECT_EQ (smallImage.getPixel (18, 19), 0x000000ffu);
+
+    EXPECT_EQ (largeImage.getPixel (10, 12), 0xff0000ffu);
+    EXPECT_EQ (largeImage.getPixel (33, 35), 0xff0000ffu);
+    EXPECT_EQ (largeImage.getPixel (9, 12), 0x000000ffu);
+    EXPECT_EQ (largeImage.getPixel (10, 11), 0x000000ffu);
+    EXPECT_EQ (largeImage.getPixel (34, 35), 0x000000ffu);
+}
+
+TEST (ImageAtlasTests, EntriesAreReleasedWithTheirImages)
+{
+    auto context = createSoftwareContext();
+    auto& atlas = context->getImageAtlas();
+
+    auto kept = makeSolidImage (8, 0xff0000ffu);
+    atlas.preload (kept);
+
+    {
+        auto temporary = makeSolidImage (8, 0x00ff00ffu);
+        atlas.preload (temporary);
+        EXPECT_EQ (atlas.getNumEntries(), 2);
+    }
+
+    atlas.beginFrame (*context);
+    EXPECT_EQ (atlas.getNumEntries(), 1);
+
+    kept = Image();
+    atlas.beginFrame (*context);
+    EXPECT_EQ (atlas.getNumEntries(), 0);
+}
+
+TEST (ImageAtlasTests, DisplayListsAreRerecordedWhenPagesChange)
+{
+    auto context = createSoftwareContext();
+    auto& atlas = context->getImageAtlas();
+
+    auto first = makeSolidImage (8, 0xff0000ffu);
+    atlas.preload (first);
+
+    DisplayList displayList;
+    int numRecordings = 0;
+
+    const auto paint = [&] (Graphics& g)
+    {
+        g.drawDisplayList (displayList, [&] (Graphics& recorder)
+        {
+            ++numRecordings;
+            recorder.drawImageAt (first, { 4.0f, 4.0f });
+        });
+    };
+
+    renderFrame (*context, paint);
+    renderFrame (*context, paint);
+    EXPECT_EQ (numRecordings, 1);
+
+    // Replayed draws are accounted for like the recorded ones
+    auto statistics = atlas.getCurrentFrameStatistics();
+    EXPECT_EQ (statistics.imageDraws, 1);
+    EXPECT_EQ (statistics.atlasDraws, 1);
+
+    // Staging another image re-uploads the page the recording refers to
+    const auto generation = atlas.getGeneration();
+
+    auto second = makeSolidImage (8, 0x00ff00ffu);
+    atlas.preload (second);
+
+    const auto image = renderFrame (*context, paint);
+    EXPECT_NE (atlas.getGeneration(), generation);
+    EXPECT_EQ (numRecordings, 2);
+    EXPECT_EQ (image.getPixel (6, 6), 0xff0000ffu);
+}
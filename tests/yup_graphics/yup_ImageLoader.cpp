@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <yup_graphics/yup_graphics.h>
+
+using namespace yup;
+
+namespace
+{
+
+// A 2x2 RGBA png with red, green, blue and white pixels
+const uint8 checkerPng[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x08, 0x06, 0x00, 0x00, 0x00, 0x72, 0xb6, 0x0d,
+    0x24, 0x00, 0x00, 0x00, 0x12, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0xf8, 0xcf, 0xc0, 0xf0,
+    0x1f, 0x0c, 0x81, 0x34, 0x18, 0x00, 0x00, 0x49, 0xc8, 0x09, 0xf7, 0x03, 0xd9, 0x64, 0xf1, 0x00,
+    0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82
+};
+
+// A 1x1 RGBA png with a single azure pixel
+const uint8 pixelPng[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x08, 0x06, 0x00, 0x00, 0x00, 0x1f, 0x15, 0xc4,
+    0x89, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0x60, 0x68, 0xf8, 0xff,
+    0x1f, 0x00, 0x04, 0x82, 0x02, 0x7f, 0x38, 0x86, 0x48, 0x7c, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45,
+    0x4e, 0x44, 0xae, 0x42, 0x60, 0x82
+};
+
+Span<const uint8> toSpan (const uint8* data, std::size_t size)
+{
+    return { data, size };
+}
+
+} // namespace
+
+TEST (ImageLoaderTests, DecodesOnWorkerThreads)
+{
+    ImageLoader loader (2);
+
+    auto handle = loader.loadAsync (toSpan (checkerPng, sizeof (checkerPng)));
+    ASSERT_TRUE (handle.isValid());
+    EXPECT_TRUE (handle.wait (5000));
+    EXPECT_TRUE (handle.isReady());
+
+    auto result = handle.getResult();
+    ASSERT_TRUE (result.wasOk());
+
+    const auto& image = result.getReference();
+    EXPECT_EQ (image.getWidth(), 2);
+    EXPECT_EQ (image.getHeight(), 2);
+    EXPECT_EQ (image.getPixel (0, 0), 0xff0000ffu);
+    EXPECT_EQ (image.getPixel (1, 0), 0x00ff00ffu);
+    EXPECT_EQ (image.getPixel (0, 1), 0x0000ffffu);
+    EXPECT_EQ (image.getPixel (1, 1), 0xffffffffu);
+}
+
+TEST (ImageLoaderTests, InvalidDataFails)
+{
+    ImageLoader loader (1);
+
+    const uint8 garbage[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+    auto result = loader.loadAsync (toSpan (garbage, sizeof (garbage))).getResult();
+    EXPECT_TRUE (result.failed());
+
+    EXPECT_TRUE (ImageLoader::Handle().getResult().failed());
+}
+
+TEST (ImageLoaderTests, CallbacksReceiveTheResult)
+{
+    ImageLoader loader (1);
+
+    WaitableEvent called;
+    std::atomic<int> width { 0 };
+
+    loader.loadAsync (toSpan (pixelPng, sizeof (pixelPng)), [&] (const ResultValue<Image>& result)
+    {
+        if (result.wasOk())
+            width = result.getReference().getWidth();
+
+        called.signal();
+    });
+
+    EXPECT_TRUE (called.wait (5000));
+    EXPECT_EQ (width.load(), 1);
+
+    // Callbacks registered on a completed load are invoked right away
+    auto handle = loader.loadAsync (toSpan (pixelPng, sizeof (pixelPng)));
+    handle.wait();
+
+    bool calledImmediately = false;
+    handle.onComplete ([&] (const ResultValue<Image>&) { calledImmediately = true; });
+    EXPECT_TRUE (calledImmediately);
+}
+
+TEST (ImageLoaderTests, RepeatedLoadsShareThePixels)
+{
+    ImageLoader loader (2);
+
+    // A copy of the data, so de-duplication can't rely on the address of the buffer
+    std::vector<uint8> copy (checkerPng, checkerPng + sizeof (checkerPng));
+
+    auto first = loader.loadAsync (toSpan (checkerPng, sizeof (checkerPng)));
+    auto second = loader.loadAsync (toSpan (copy.data(), copy.size()));
+    auto other = loader.loadAsync (toSpan (pixelPng, sizeof (pixelPng)));
+
+    auto firstImage = first.getResult().getValue();
+    auto secondImage = second.getResult().getValue();
+    auto otherImage = other.getResult().getValue();
+
+    EXPECT_EQ (&firstImage.getBitmapData(), &secondImage.getBitmapData());
+    EXPECT_NE (&firstImage.getBitmapData(), &otherImage.getBitmapData());
+
+    const auto statistics = loader.getStatistics();
+    EXPECT_EQ (statistics.decodes, 2);
+    EXPECT_EQ (statistics.deduplicatedLoads, 1);
+}
+
+TEST (ImageLoaderTests, DifferentDataOfTheSameSizeIsNotShared)
+{
+    ImageLoader loader (2);
+
+    // Same size as the original, but a different pixel in the compressed stream
+    std::vector<uint8> modified (pixelPng, pixelPng + sizeof (pixelPng));
+    modified[48] ^= 0xff;
+
+    auto original = loader.loadAsync (toSpan (pixelPng, sizeof (pixelPng)));
+    auto other = loader.loadAsync (toSpan (modified.data(), modified.size()));
+
+    original.wait();
+    other.wait();
+
+    EXPECT_TRUE (original.getResult().wasOk());
+
+    const auto statistics = loader.getStatistics();
+    EXPECT_EQ (statistics.decodes, 2);
+    EXPECT_EQ (statistics.deduplicatedLoads, 0);
+}
+
+TEST (ImageLoaderTests, ReleasedImagesAreDecodedAgain)
+{
+    ImageLoader loader (1);
+
+    {
+        auto image = loader.loadAsync (toSpan (pixelPng, sizeof (pixelPng))).getResult().getValue();
+        EXPECT_TRUE (image.isValid());
+
+        loader.loadAsync (toSpan (pixelPng, sizeof (pixelPng))).wait();
+        EXPECT_EQ (loader.getStatistics().decodes, 1);
+        EXPECT_EQ (loader.getNumTrackedLoads(), 1);
+    }
+
+    loader.loadAsync (toSpan (pixelPng, sizeof (pixelPng))).wait();
+    EXPECT_EQ (loader.getStatistics().decodes, 2);
+    EXPECT_EQ (loader.getNumTrackedLoads(), 1);
+}
+
+TEST (ImageLoaderTests, ManyConcurrentLoadsComplete)
+{
+    ImageLoader loader (4);
+
+    std::vector<std::vector<uint8>> buffers;
+    std::vector<ImageLoader::Handle> handles;
+    std::vector<Image> images;
+
+    for (int i = 0; i < 64; ++i)
+    {
+        const auto& source = (i % 2) == 0 ? checkerPng : pixelPng;
+        const auto size = (i % 2) == 0 ? sizeof (checkerPng) : sizeof (pixelPng);
+
+        buffers.emplace_back (source, source + size);
+        handles.push_back (loader.loadAsync (toSpan (buffers.back().data(), buffers.back().size())));
+    }
+
+    for (const auto& handle : handles)
+    {
+        auto result = handle.getResult();
+        ASSERT_TRUE (result.wasOk());
+        images.push_back (result.getValue());
+    }
+
+    EXPECT_EQ (loader.getStatistics().decodes, 2);
+    EXPECT_EQ (loader.getStatistics().deduplicatedLoads, 62);
+}
+
+TEST (ImageLoaderTests, SharedInstanceCanBeShutDown)
+{
+    auto* loader = ImageLoader::getInstance();
+    ASSERT_NE (loader, nullptr);
+
+    auto image = loader->loadAsync (toSpan (pixelPng, sizeof (pixelPng))).getResult().getValue();
+    const auto pixel = image.getPixel (0, 0);
+
+    ImageLoader::deleteInstance();
+    EXPECT_EQ (ImageLoader::getInstanceWithoutCreating(), nullptr);
+
+    // The decoded image outlives the loader that produced it
+    EXPECT_EQ (image.getWidth(), 1);
+    EXPECT_EQ (image.getPixel (0, 0), pixel);
+}
@@ -0,0 +1,405 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <gtest/gtest.h>
+
+#include <yup_graphics/yup_graphics.h>
+
+using namespace yup;
+
+
+namespace
+{
+
+// The segment layout used by Path before switching to separate verbs and points streams
+struct LegacySegment
+{
+    Path::SegmentType type = Path::MoveTo;
+    float x = 0.0f, y = 0.0f;
+    float x1 = 0.0f, y1 = 0.0f;
+    float x2 = 0.0f, y2 = 0.0f;
+};
+
+Path makeWaveform (int numPoints)
+{
+    Path path;
+    path.reserveSpace (numPoints);
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const auto x = static_cast<float> (i);
+        const auto y = 100.0f + 50.0f * std::sin (x * 0.05f);
+
+        if (i == 0)
+            path.moveTo (x, y);
+        else
+            path.lineTo (x, y);
+    }
+
+    return path;
+}
+
+} // namespace
+
+TEST (PathTests, SegmentsRoundTrip)
+{
+    Path path;
+    path.moveTo (1.0f, 2.0f);
+    path.lineTo (3.0f, 4.0f);
+    path.quadTo (5.0f, 6.0f, 7.0f, 8.0f);
+    path.cubicTo (9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f);
+
+    EXPECT_EQ (path.size(), 4);
+    EXPECT_EQ (path.getVerbs().size(), 4u);
+    EXPECT_EQ (path.getPoints().size(), 7u);
+
+    std::vector<Path::Segment> segments (path.begin(), path.end());
+    ASSERT_EQ (segments.size(), 4u);
+
+    EXPECT_EQ (segments[0].type, Path::MoveTo);
+    EXPECT_EQ (segments[0].x, 1.0f);
+    EXPECT_EQ (segments[0].y, 2.0f);
+
+    EXPECT_EQ (segments[1].type, Path::LineTo);
+    EXPECT_EQ (segments[1].x, 3.0f);
+    EXPECT_EQ (segments[1].y, 4.0f);
+
+    EXPECT_EQ (segments[2].type, Path::QuadTo);
+    EXPECT_EQ (segments[2].x, 5.0f);
+    EXPECT_EQ (segments[2].y, 6.0f);
+    EXPECT_EQ (segments[2].x1, 7.0f);
+    EXPECT_EQ (segments[2].y1, 8.0f);
+
+    EXPECT_EQ (segments[3].type, Path::CubicTo);
+    EXPECT_EQ (segments[3].x, 9.0f);
+    EXPECT_EQ (segments[3].y2, 14.0f);
+}
+
+TEST (PathTests, ConsecutiveMovesAreMerged)
+{
+    Path path;
+    path.moveTo (1.0f, 1.0f);
+    path.moveTo (2.0f, 2.0f);
+    path.lineTo (3.0f, 3.0f);
+
+    EXPECT_EQ (path.size(), 2);
+    EXPECT_EQ (path.getPoints()[0], Point<float> (2.0f, 2.0f));
+}
+
+TEST (PathTests, CloseReturnsToSubpathStart)
+{
+    Path path;
+    path.moveTo (0.0f, 0.0f);
+    path.lineTo (10.0f, 0.0f);
+    path.moveTo (5.0f, 5.0f);
+    path.lineTo (10.0f, 10.0f);
+    path.close();
+
+    EXPECT_EQ (path.getPoints().back(), Point<float> (5.0f, 5.0f));
+}
+
+TEST (PathTests, AppendPathKeepsSegmentsAndBounds)
+{
+    Path a;
+    a.addRectangle (0.0f, 0.0f, 10.0f, 10.0f);
+
+    Path b;
+    b.addEllipse (20.0f, 20.0f, 10.0f, 10.0f);
+
+    Path combined (a);
+    combined.appendPath (b);
+
+    EXPECT_EQ (combined.size(), a.size() + b.size());
+    EXPECT_EQ (combined.getBoundingBox(), Rectangle<float> (0.0f, 0.0f, 30.0f, 30.0f));
+
+    Path translated;
+    translated.appendPath (a, AffineTransform::translation (5.0f, 5.0f));
+    EXPECT_EQ (translated.getBoundingBox(), Rectangle<float> (5.0f, 5.0f, 10.0f, 10.0f));
+}
+
+TEST (PathTests, TransformUpdatesBounds)
+{
+    Path path;
+    path.addRectangle (-10.0f, -10.0f, 5.0f, 5.0f);
+    EXPECT_EQ (path.getBoundingBox(), Rectangle<float> (-10.0f, -10.0f, 5.0f, 5.0f));
+
+    path.transform (AffineTransform::scaling (2.0f));
+    EXPECT_EQ (path.getBoundingBox(), Rectangle<float> (-20.0f, -20.0f, 10.0f, 10.0f));
+}
+
+TEST (PathTests, EqualityComparesSegments)
+{
+    Path a, b;
+    a.addEllipse (0.0f, 0.0f, 10.0f, 10.0f);
+    b.addEllipse (0.0f, 0.0f, 10.0f, 10.0f);
+
+    EXPECT_TRUE (a == b);
+
+    b.lineTo (1.0f, 1.0f);
+    EXPECT_TRUE (a != b);
+}
+
+TEST (PathTests, ToRawPathConvertsQuadsToCubics)
+{
+    Path path;
+    path.moveTo (0.0f, 0.0f);
+    path.lineTo (10.0f, 0.0f);
+    path.quadTo (10.0f, 10.0f, 20.0f, 5.0f);
+
+    const auto rawPath = path.toRawPath (AffineTransform::translation (1.0f, 2.0f));
+
+    const auto verbs = rawPath.verbs();
+    ASSERT_EQ (verbs.size(), 3u);
+    EXPECT_EQ (verbs[0], rive::PathVerb::move);
+    EXPECT_EQ (verbs[1], rive::PathVerb::line);
+    EXPECT_EQ (verbs[2], rive::PathVerb::cubic);
+
+    const auto points = rawPath.points();
+    ASSERT_EQ (points.size(), 5u);
+    EXPECT_EQ (points[0], rive::Vec2D (1.0f, 2.0f));
+    EXPECT_EQ (points[4], rive::Vec2D (11.0f, 12.0f));
+}
+
+TEST (PathTests, ToRawPathKeepsSeparateContours)
+{
+    Path path;
+    path.moveTo (0.0f, 0.0f);
+    path.lineTo (10.0f, 0.0f);
+    path.lineTo (10.0f, 10.0f);
+    path.moveTo (20.0f, 20.0f);
+    path.lineTo (30.0f, 20.0f);
+    path.cubicTo (30.0f, 30.0f, 25.0f, 35.0f, 20.0f, 30.0f);
+
+    const auto rawPath = path.toRawPath();
+
+    const auto verbs = rawPath.verbs();
+    ASSERT_EQ (verbs.size(), 6u);
+    EXPECT_EQ (verbs[0], rive::PathVerb::move);
+    EXPECT_EQ (verbs[2], rive::PathVerb::line);
+    EXPECT_EQ (verbs[3], rive::PathVerb::move);
+    EXPECT_EQ (verbs[4], rive::PathVerb::line);
+    EXPECT_EQ (verbs[5], rive::PathVerb::cubic);
+
+    const auto points = rawPath.points();
+    ASSERT_EQ (points.size(), 8u);
+    EXPECT_EQ (points[3], rive::Vec2D (20.0f, 20.0f));
+    EXPECT_EQ (points[7], rive::Vec2D (20.0f, 30.0f));
+}
+
+TEST (PathTests, AddPolylineMatchesLineTo)
+{
+    constexpr int numPoints = 37;
+
+    std::vector<float> xs, ys;
+    std::vector<Point<float>> points;
+
+    Path expected;
+    for (int i = 0; i < numPoints; ++i)
+    {
+        xs.push_back (static_cast<float> (i) * 2.0f - 10.0f);
+        ys.push_back (std::cos (static_cast<float> (i)) * 30.0f);
+        points.emplace_back (xs.back(), ys.back());
+
+        if (i == 0)
+            expected.moveTo (xs.back(), ys.back());
+        else
+            expected.lineTo (xs.back(), ys.back());
+    }
+
+    Path fromArrays;
+    fromArrays.addPolyline (xs.data(), ys.data(), numPoints);
+
+    Path fromPoints;
+    fromPoints.addPolyline (points);
+
+    EXPECT_TRUE (fromArrays == expected);
+    EXPECT_TRUE (fromPoints == expected);
+    EXPECT_EQ (fromArrays.getBoundingBox(), expected.getBoundingBox());
+    EXPECT_EQ (fromPoints.getBoundingBox(), expected.getBoundingBox());
+
+    Path continued (0.0f, 0.0f);
+    continued.addPolyline (points, false);
+    EXPECT_EQ (continued.size(), numPoints + 1);
+    EXPECT_EQ (continued.getVerbs()[1], Path::LineTo);
+}
+
+TEST (PathTests, BulkTransformMatchesScalarTransform)
+{
+    const auto transform = AffineTransform::rotation (0.3f).scaled (1.5f, 0.5f).translated (10.0f, -4.0f);
+
+    for (int numPoints : { 1, 2, 3, 4, 5, 17 })
+    {
+        Path path (0.0f, 1.0f);
+        for (int i = 1; i < numPoints; ++i)
+            path.lineTo (static_cast<float> (i), static_cast<float> (i * i) * 0.5f);
+
+        const auto transformed = path.transformed (transform);
+
+        auto expected = path.getPoints().begin();
+        for (const auto& point : transformed.getPoints())
+        {
+            auto x = expected->getX(), y = expected->getY();
+            transform.transformPoint (x, y);
+            ++expected;
+
+            EXPECT_NEAR (point.getX(), x, 1.0e-4f);
+            EXPECT_NEAR (point.getY(), y, 1.0e-4f);
+        }
+
+        const auto rawPath = path.toRawPath (transform);
+        ASSERT_EQ (rawPath.points().size(), transformed.getPoints().size());
+
+        for (std::size_t i = 0; i < rawPath.points().size(); ++i)
+        {
+            EXPECT_EQ (rawPath.points()[i].x, transformed.getPoints()[i].getX());
+            EXPECT_EQ (rawPath.points()[i].y, transformed.getPoints()[i].getY());
+        }
+    }
+}
+
+TEST (PathTests, AddWaveformKeepsShortBuffersIntact)
+{
+    const float samples[] = { 0.0f, 1.0f, -1.0f, 0.5f };
+
+    Path path;
+    path.addWaveform (samples, 4, { 0.0f, 0.0f, 30.0f, 20.0f });
+
+    ASSERT_EQ (path.size(), 4);
+    EXPECT_EQ (path.getPoints()[0], Point<float> (0.0f, 10.0f));
+    EXPECT_EQ (path.getPoints()[1], Point<float> (10.0f, 0.0f));
+    EXPECT_EQ (path.getPoints()[2], Point<float> (20.0f, 20.0f));
+    EXPECT_EQ (path.getPoints()[3], Point<float> (30.0f, 5.0f));
+}
+
+TEST (PathTests, AddWaveformDecimatesToMinMaxPerColumn)
+{
+    constexpr int numSamples = 100000;
+    constexpr float width = 100.0f;
+
+    std::vector<float> samples (numSamples, 0.0f);
+    samples[12345] = 0.75f;
+    samples[54321] = -0.5f;
+
+    Path path;
+    path.addWaveform (samples.data(), numSamples, { 0.0f, 0.0f, width, 200.0f });
+
+    EXPECT_EQ (path.size(), static_cast<int> (width) * 2);
+
+    // The isolated peaks survive the decimation
+    const auto bounds = path.getBoundingBox();
+    EXPECT_FLOAT_EQ (bounds.getY(), 25.0f);
+    EXPECT_FLOAT_EQ (bounds.getY() + bounds.getHeight(), 150.0f);
+}
+
+TEST (PathTests, DISABLED_PolylineBenchmark)
+{
+    constexpr int numSamples = 2000000;
+    constexpr int numPoints = 100000;
+
+    std::vector<float> samples (numSamples);
+    for (int i = 0; i < numSamples; ++i)
+        samples[static_cast<std::size_t> (i)] = std::sin (static_cast<float> (i) * 0.001f) * std::sin (static_cast<float> (i) * 0.37f);
+
+    std::vector<float> xs (numPoints), ys (numPoints);
+    for (int i = 0; i < numPoints; ++i)
+    {
+        xs[static_cast<std::size_t> (i)] = static_cast<float> (i);
+        ys[static_cast<std::size_t> (i)] = samples[static_cast<std::size_t> (i)];
+    }
+
+    const auto lineToStart = Time::getMillisecondCounterHiRes();
+    Path perPoint;
+    perPoint.reserveSpace (numPoints);
+    perPoint.moveTo (xs[0], ys[0]);
+    for (int i = 1; i < numPoints; ++i)
+        perPoint.lineTo (xs[static_cast<std::size_t> (i)], ys[static_cast<std::size_t> (i)]);
+    const auto lineToMs = Time::getMillisecondCounterHiRes() - lineToStart;
+
+    const auto polylineStart = Time::getMillisecondCounterHiRes();
+    Path bulk;
+    bulk.addPolyline (xs.data(), ys.data(), numPoints);
+    const auto polylineMs = Time::getMillisecondCounterHiRes() - polylineStart;
+
+    EXPECT_TRUE (bulk == perPoint);
+
+    const auto waveformStart = Time::getMillisecondCounterHiRes();
+    Path waveform;
+    waveform.addWaveform (samples.data(), numSamples, { 0.0f, 0.0f, 2000.0f, 400.0f });
+    const auto waveformMs = Time::getMillisecondCounterHiRes() - waveformStart;
+
+    EXPECT_EQ (waveform.size(), 4000);
+
+    std::cout << "Polyline (" << numPoints << " points): lineTo " << lineToMs << " ms, addPolyline " << polylineMs << " ms\n"
+              << "Waveform (" << numSamples << " samples to 2000 columns): " << waveformMs << " ms" << std::endl;
+}
+
+TEST (PathTests, DISABLED_CompactLayoutBenchmark)
+{
+    constexpr int numPoints = 100000;
+    constexpr int numIterations = 20;
+
+    const auto path = makeWaveform (numPoints);
+
+    std::vector<LegacySegment> legacy;
+    legacy.reserve (numPoints);
+    for (const auto& segment : path)
+        legacy.push_back ({ segment.type, segment.x, segment.y });
+
+    const auto legacyBytes = legacy.size() * sizeof (LegacySegment);
+    const auto compactBytes = path.getVerbs().size() * sizeof (uint8) + path.getPoints().size() * sizeof (Point<float>);
+
+    // A polyline stores one verb and one point per segment instead of a full segment
+    EXPECT_LT (compactBytes * 2, legacyBytes);
+
+    std::size_t checksum = 0;
+
+    const auto legacyStart = Time::getMillisecondCounterHiRes();
+    for (int i = 0; i < numIterations; ++i)
+    {
+        rive::RawPath rawPath;
+
+        for (const auto& segment : legacy)
+        {
+            if (segment.type == Path::MoveTo)
+                rawPath.move ({ segment.x, segment.y });
+            else if (segment.type == Path::LineTo)
+                rawPath.line ({ segment.x, segment.y });
+            else if (segment.type == Path::QuadTo)
+                rawPath.quad ({ segment.x1, segment.y1 }, { segment.x, segment.y });
+            else if (segment.type == Path::CubicTo)
+                rawPath.cubic ({ segment.x, segment.y }, { segment.x1, segment.y1 }, { segment.x2, segment.y2 });
+        }
+
+        checksum += rawPath.points().size();
+    }
+    const auto legacyMs = Time::getMillisecondCounterHiRes() - legacyStart;
+
+    const auto compactStart = Time::getMillisecondCounterHiRes();
+    for (int i = 0; i < numIterations; ++i)
+        checksum += path.toRawPath().points().size();
+    const auto compactMs = Time::getMillisecondCounterHiRes() - compactStart;
+
+    EXPECT_EQ (checksum, static_cast<std::size_t> (2 * numIterations * numPoints));
+
+    std::cout << "Path memory: legacy " << legacyBytes << " bytes, compact " << compactBytes << " bytes\n"
+              << "Path conversion (" << numPoints << " segments): legacy " << legacyMs / numIterations
+              << " ms, compact " << compactMs / numIterations << " ms" << std::endl;
+}
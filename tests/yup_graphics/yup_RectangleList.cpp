@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <gtest/gtest.h>
+
+#include <yup_graphics/yup_graphics.h>
+
+using namespace yup;
+
+TEST (RectangleListTests, EmptyListHasEmptyBoundingBox)
+{
+    RectangleList<float> list;
+    EXPECT_TRUE (list.isEmpty());
+    EXPECT_TRUE (list.getBoundingBox().isEmpty());
+}
+
+TEST (RectangleListTests, BoundingBoxContainsAllRectangles)
+{
+    RectangleList<float> list;
+    list.addWithoutMerge ({ 10.0f, 10.0f, 5.0f, 5.0f });
+    list.addWithoutMerge ({ 100.0f, 50.0f, 20.0f, 10.0f });
+
+    EXPECT_EQ (list.getNumRectangles(), 2);
+    EXPECT_EQ (list.getBoundingBox(), Rectangle<float> (10.0f, 10.0f, 110.0f, 50.0f));
+}
+
+TEST (RectangleListTests, AddMergesIntersectingRectangles)
+{
+    RectangleList<int> list;
+    list.add ({ 0, 0, 10, 10 });
+    list.add ({ 5, 5, 10, 10 });
+    list.add ({ 100, 100, 10, 10 });
+
+    EXPECT_EQ (list.getNumRectangles(), 2);
+    EXPECT_TRUE (list.contains (12, 12));
+    EXPECT_FALSE (list.contains (50, 50));
+}
@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <yup_graphics/yup_graphics.h>
+
+#include "yup_GraphicsTestHelpers.hpp"
+
+using namespace yup;
+using namespace yup::test;
+
+namespace
+{
+
+ColorGradient makeMeterGradient()
+{
+    ColorGradient gradient (Color (0xff00ff00), 0.0f, 100.0f, Color (0xffff0000), 0.0f, 0.0f, ColorGradient::Linear);
+    gradient.addColorStop (Color (0xffffff00), 0.7f);
+    return gradient;
+}
+
+} // namespace
+
+TEST (RenderCacheTests, GradientShadersAreReused)
+{
+    auto context = createSoftwareContext();
+    auto& factory = *context->factory();
+
+    RenderCache cache;
+    cache.beginFrame();
+
+    const auto gradient = makeMeterGradient();
+    const auto transform = AffineTransform::translation (10.0f, 20.0f);
+
+    auto first = cache.getGradientShader (factory, gradient, transform);
+    auto second = cache.getGradientShader (factory, makeMeterGradient(), transform);
+
+    ASSERT_NE (first, nullptr);
+    EXPECT_EQ (first.get(), second.get());
+    EXPECT_EQ (cache.getNumCachedShaders(), 1);
+
+    const auto statistics = cache.getCurrentFrameStatistics();
+    EXPECT_EQ (statistics.shaderMisses, 1);
+    EXPECT_EQ (statistics.shaderHits, 1);
+
+    // The same gradient persists across frames
+    cache.beginFrame();
+    EXPECT_EQ (cache.getGradientShader (factory, gradient, transform).get(), first.get());
+}
+
+TEST (RenderCacheTests, GradientShadersAreKeyedByStopsAndTransform)
+{
+    auto context = createSoftwareContext();
+    auto& factory = *context->factory();
+
+    RenderCache cache;
+    cache.beginFrame();
+
+    const auto gradient = makeMeterGradient();
+
+    auto base = cache.getGradientShader (factory, gradient, {});
+    auto translated = cache.getGradientShader (factory, gradient, AffineTransform::translation (1.0f, 0.0f));
+
+    auto moreStops = gradient;
+    moreStops.addColorStop (Color (0xff0000ff), 0.2f);
+    auto withMoreStops = cache.getGradientShader (factory, moreStops, {});
+
+    EXPECT_NE (base.get(), translated.get());
+    EXPECT_NE (base.get(), withMoreStops.get());
+    EXPECT_EQ (cache.getNumCachedShaders(), 3);
+}
+
+TEST (RenderCacheTests, UnusedGradientShadersAreEvicted)
+{
+    auto context = createSoftwareContext();
+    auto& factory = *context->factory();
+
+    RenderCache cache;
+    cache.setMaxUnusedFrames (2);
+    cache.beginFrame();
+
+    cache.getGradientShader (factory, makeMeterGradient(), {});
+    EXPECT_EQ (cache.getNumCachedShaders(), 1);
+
+    for (int i = 0; i < 3; ++i)
+        cache.beginFrame();
+
+    EXPECT_EQ (cache.getNumCachedShaders(), 0);
+}
+
+TEST (RenderCacheTests, PrimitivesAreSharedAcrossTranslations)
+{
+    auto context = createSoftwareContext();
+    auto& factory = *context->factory();
+
+    RenderCache cache;
+    cache.beginFrame();
+
+    Path rect;
+    rect.addRectangle (0.0f, 0.0f, 10.0f, 10.0f);
+
+    auto first = cache.getPrimitivePath (factory, rect, AffineTransform::translation (5.0f, 5.0f));
+    auto moved = cache.getPrimitivePath (factory, rect, AffineTransform::translation (50.0f, 20.0f));
+    auto scaled = cache.getPrimitivePath (factory, rect, AffineTransform::scaling (2.0f));
+
+    EXPECT_EQ (first.get(), moved.get());
+    EXPECT_NE (first.get(), scaled.get());
+    EXPECT_EQ (cache.getNumCachedPaths(), 2);
+}
+
+TEST (RenderCacheTests, LargePrimitivesAreNotCached)
+{
+    auto context = createSoftwareContext();
+    auto& factory = *context->factory();
+
+    RenderCache cache;
+    cache.beginFrame();
+
+    Path polyline;
+    polyline.moveTo (0.0f, 0.0f);
+
+    for (int i = 1; i <= RenderCache::maxPrimitivePoints; ++i)
+        polyline.lineTo (static_cast<float> (i), static_cast<float> (i % 7));
+
+    auto first = cache.getPrimitivePath (factory, polyline, {});
+    auto second = cache.getPrimitivePath (factory, polyline, {});
+
+    ASSERT_NE (first, nullptr);
+    EXPECT_NE (first.get(), second.get());
+    EXPECT_EQ (cache.getNumCachedPaths(), 0);
+}
+
+TEST (RenderCacheTests, PaintsBeyondTheLimitAreNotCached)
+{
+    auto context = createSoftwareContext();
+    auto& factory = *context->factory();
+
+    RenderCache cache;
+    cache.setMaxCachedPaints (4);
+    cache.beginFrame();
+
+    for (uint32 i = 0; i < 16; ++i)
+        EXPECT_NE (cache.getFillPaint (factory, Color (0xff000000 | i)), nullptr);
+
+    EXPECT_EQ (cache.getNumCachedPaints(), 4);
+
+    // The cached styles are still served from the cache
+    auto first = cache.getFillPaint (factory, Color (0xff000000));
+    EXPECT_EQ (first.get(), cache.getFillPaint (factory, Color (0xff000000)).get());
+    EXPECT_EQ (cache.getCurrentFrameStatistics().paintMisses, 16);
+}
@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <yup_graphics/yup_graphics.h>
+
+#include "yup_GraphicsTestHelpers.hpp"
+
+using namespace yup;
+using namespace yup::test;
+
+namespace
+{
+
+const uint32 columnColors[] = { 0xff0000ffu, 0x00ff00ffu, 0x0000ffffu, 0xffffffffu, 0xffff00ffu, 0x00ffffffu };
+
+// Magnified images are sampled bilinearly, so pixels near the center of a column can bleed a bit of their neighbours
+bool isCloseTo (uint32 actual, uint32 expected)
+{
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        if (std::abs (static_cast<int> ((actual >> shift) & 0xff) - static_cast<int> ((expected >> shift) & 0xff)) > 24)
+            return false;
+    }
+
+    return true;
+}
+
+void appendSolidColumn (ScrollingImage& image, uint32 color)
+{
+    std::vector<uint32> colors (static_cast<std::size_t> (image.getHeight()), color);
+    image.appendColumn ({ colors.data(), colors.size() });
+}
+
+} // namespace
+
+TEST (ScrollingImageTests, AppendedColumnsWrapAround)
+{
+    ScrollingImage image (4, 3);
+    EXPECT_EQ (image.getWritePosition(), 0);
+    EXPECT_EQ (image.getImage().getPixel (0, 0), 0u);
+
+    for (int i = 0; i < 6; ++i)
+        appendSolidColumn (image, columnColors[i]);
+
+    EXPECT_EQ (image.getWritePosition(), 2);
+
+    // The first two columns have been overwritten by the last two appended
+    EXPECT_EQ (image.getImage().getPixel (0, 2), columnColors[4]);
+    EXPECT_EQ (image.getImage().getPixel (1, 2), columnColors[5]);
+    EXPECT_EQ (image.getImage().getPixel (2, 2), columnColors[2]);
+    EXPECT_EQ (image.getImage().getPixel (3, 2), columnColors[3]);
+}
+
+TEST (ScrollingImageTests, AppendingAnImageKeepsTheNewestColumns)
+{
+    ScrollingImage image (4, 2);
+    appendSolidColumn (image, columnColors[0]);
+
+    Image columns (6, 2, PixelFormat::RGBA);
+    for (int x = 0; x < 6; ++x)
+        columns.fillRect ({ x, 0, 1, 2 }, columnColors[x]);
+
+    image.appendColumns (columns);
+
+    // Same ring state as appending the columns one by one
+    EXPECT_EQ (image.getWritePosition(), 3);
+    EXPECT_EQ (image.getImage().getPixel (3, 0), columnColors[2]);
+    EXPECT_EQ (image.getImage().getPixel (0, 0), columnColors[3]);
+    EXPECT_EQ (image.getImage().getPixel (1, 1), columnColors[4]);
+    EXPECT_EQ (image.getImage().getPixel (2, 1), columnColors[5]);
+}
+
+TEST (ScrollingImageTests, DrawsOldestColumnsFirst)
+{
+    auto context = createSoftwareContext();
+
+    ScrollingImage image (8, 4);
+    for (int i = 0; i < 11; ++i)
+        appendSolidColumn (image, columnColors[i % 6]);
+
+    ASSERT_EQ (image.getWritePosition(), 3);
+
+    auto frame = renderFrame (*context, [&] (Graphics& g)
+    {
+        g.drawScrollingImage (image, { 0.0f, 0.0f, 64.0f, 32.0f });
+    });
+
+    // Columns 3 to 10 were appended last, and show from left to right, each 8 pixels wide
+    for (int column = 0; column < 8; ++column)
+        EXPECT_TRUE (isCloseTo (frame.getPixel (column * 8 + 4, 16), columnColors[(column + 3) % 6])) << "column " << column;
+
+    EXPECT_EQ (frame.getPixel (32, 40), 0x000000ffu);
+}
+
+TEST (ScrollingImageTests, OnlyNewColumnsAreUploaded)
+{
+    auto context = createSoftwareContext();
+
+    ScrollingImage image (8, 4);
+    const auto draw = [&]
+    {
+        return renderFrame (*context, [&] (Graphics& g) { g.drawScrollingImage (image, { 0.0f, 0.0f, 64.0f, 32.0f }); });
+    };
+
+    draw();
+    EXPECT_EQ (image.getStatistics().fullUploads, 1);
+    EXPECT_EQ (image.getStatistics().partialUploads, 0);
+
+    appendSolidColumn (image, columnColors[0]);
+    draw();
+    EXPECT_EQ (image.getStatistics().fullUploads, 1);
+    EXPECT_EQ (image.getStatistics().partialUploads, 1);
+    EXPECT_EQ (image.getStatistics().uploadedColumns, 1);
+
+    // Nothing changed, nothing to upload
+    draw();
+    EXPECT_EQ (image.getStatistics().partialUploads, 1);
+
+    // Appending more columns than the ring holds uploads each column once
+    for (int i = 0; i < 12; ++i)
+        appendSolidColumn (image, columnColors[i % 6]);
+
+    draw();
+    EXPECT_EQ (image.getStatistics().fullUploads, 1);
+    EXPECT_EQ (image.getStatistics().uploadedColumns, 1 + 8);
+}
+
+TEST (ScrollingImageTests, DirtyRangeWrappingTheRingUploadsTwoAreas)
+{
+    auto context = createSoftwareContext();
+
+    ScrollingImage image (8, 4);
+    for (int i = 0; i < 6; ++i)
+        appendSolidColumn (image, columnColors[i]);
+
+    renderFrame (*context, [&] (Graphics& g) { g.drawScrollingImage (image, { 0.0f, 0.0f, 64.0f, 32.0f }); });
+
+    for (int i = 0; i < 4; ++i)
+        appendSolidColumn (image, columnColors[i]);
+
+    auto frame = renderFrame (*context, [&] (Graphics& g) { g.drawScrollingImage (image, { 0.0f, 0.0f, 64.0f, 32.0f }); });
+
+    EXPECT_EQ (image.getWritePosition(), 2);
+    EXPECT_EQ (image.getStatistics().partialUploads, 2);
+    EXPECT_EQ (image.getStatistics().uploadedColumns, 4);
+
+    // The newest column is drawn on the right
+    EXPECT_TRUE (isCloseTo (frame.getPixel (60, 16), columnColors[3]));
+}
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <gtest/gtest.h>
+
+#include <yup_graphics/yup_graphics.h>
+
+using namespace yup;
+
+namespace
+{
+
+Font loadTestFont()
+{
+    const auto fontFile = File (__FILE__)
+                              .getParentDirectory()
+                              .getParentDirectory()
+                              .getParentDirectory()
+                              .getChildFile ("examples/graphics/data/Roboto-Regular.ttf");
+
+    return Font (fontFile);
+}
+
+std::vector<StyledText::Glyph> layoutGlyphs (StyledText& text)
+{
+    text.layout ({ 0.0f, 0.0f, 400.0f, 400.0f }, StyledText::left);
+    return text.getGlyphs();
+}
+
+} // namespace
+
+TEST (StyledTextTests, IncrementalAppendMatchesSingleAppend)
+{
+    auto font = loadTestFont();
+    if (font.getFont() == nullptr)
+        GTEST_SKIP() << "Test font not available";
+
+    StyledText whole;
+    whole.appendText (font, 12.0f, 14.0f, "First line\nSecond line\nThird");
+
+    StyledText incremental;
+    incremental.appendText (font, 12.0f, 14.0f, "First ");
+    incremental.appendText (font, 12.0f, 14.0f, "line\nSecond");
+    incremental.appendText (font, 12.0f, 14.0f, " line\n");
+    incremental.appendText (font, 12.0f, 14.0f, "Third");
+
+    const auto expected = layoutGlyphs (whole);
+    const auto actual = layoutGlyphs (incremental);
+
+    ASSERT_EQ (expected.size(), actual.size());
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_EQ (expected[i].path.get(), actual[i].path.get());
+        EXPECT_NEAR (expected[i].transform.tx(), actual[i].transform.tx(), 0.01f);
+        EXPECT_NEAR (expected[i].transform.ty(), actual[i].transform.ty(), 0.01f);
+    }
+}
+
+TEST (StyledTextTests, AppendingLinesShapesOnlyTheNewParagraph)
+{
+    auto font = loadTestFont();
+    if (font.getFont() == nullptr)
+        GTEST_SKIP() << "Test font not available";
+
+    auto& cache = FontCache::getInstance();
+    cache.clear();
+
+    StyledText text;
+    text.appendText (font, 12.0f, 14.0f, "Log line 1\n");
+    text.appendText (font, 12.0f, 14.0f, "Log line 2\n");
+    text.appendText (font, 12.0f, 14.0f, "Log line 3\n");
+
+    // Each line is shaped on its own, so the cache only ever sees single lines
+    EXPECT_EQ (cache.getStatistics().shapingMisses, 3);
+    EXPECT_EQ (cache.getStatistics().shapingHits, 0);
+
+    StyledText other;
+    other.appendText (font, 12.0f, 14.0f, "Log line 2\n");
+    EXPECT_EQ (cache.getStatistics().shapingHits, 1);
+}
+
+TEST (StyledTextTests, BatchedEditsShapeOnce)
+{
+    auto font = loadTestFont();
+    if (font.getFont() == nullptr)
+        GTEST_SKIP() << "Test font not available";
+
+    auto& cache = FontCache::getInstance();
+    cache.clear();
+
+    StyledText text;
+    text.beginEdit();
+    text.appendText (font, 12.0f, 14.0f, "One ");
+    text.beginEdit();
+    text.appendText (font, 16.0f, 18.0f, "Two ");
+    text.endEdit();
+    text.appendText (font, 12.0f, 14.0f, "Three");
+
+    EXPECT_EQ (cache.getStatistics().shapingMisses, 0);
+
+    text.endEdit();
+    EXPECT_EQ (cache.getStatistics().shapingMisses, 1);
+
+    EXPECT_EQ (layoutGlyphs (text).size(), 13u);
+}
+
+TEST (StyledTextTests, ClearRemovesAllText)
+{
+    auto font = loadTestFont();
+    if (font.getFont() == nullptr)
+        GTEST_SKIP() << "Test font not available";
+
+    StyledText text;
+    text.appendText (font, 12.0f, 14.0f, "Some text\nMore text");
+    EXPECT_FALSE (layoutGlyphs (text).empty());
+
+    text.clear();
+    EXPECT_TRUE (layoutGlyphs (text).empty());
+
+    text.appendText (font, 12.0f, 14.0f, "Again");
+    EXPECT_EQ (layoutGlyphs (text).size(), 5u);
+}
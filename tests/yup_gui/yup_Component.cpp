@@ -0,0 +1,270 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <yup_gui/yup_gui.h>
+
+using namespace yup;
+
+namespace
+{
+
+// A container with a grid of children, optionally nested in groups to build a deeper tree
+struct ComponentTree
+{
+    ComponentTree (int numGroups, int childrenPerSide, float childSize)
+    {
+        const auto groupsPerSide = jmax (1, roundToInt (std::ceil (std::sqrt (static_cast<float> (numGroups)))));
+        const auto groupSize = childSize * static_cast<float> (childrenPerSide);
+
+        root.setBounds ({ 0.0f, 0.0f, groupSize * static_cast<float> (groupsPerSide), groupSize * static_cast<float> (groupsPerSide) });
+        root.setVisible (true);
+
+        for (int g = 0; g < numGroups; ++g)
+        {
+            auto& group = groups.emplace_back (std::make_unique<Component>());
+            root.addAndMakeVisible (*group);
+            group->setBounds ({ static_cast<float> (g % groupsPerSide) * groupSize, static_cast<float> (g / groupsPerSide) * groupSize, groupSize, groupSize });
+
+            for (int i = 0; i < childrenPerSide * childrenPerSide; ++i)
+            {
+                auto& child = leaves.emplace_back (std::make_unique<Component>());
+                group->addAndMakeVisible (*child);
+                child->setBounds ({ static_cast<float> (i % childrenPerSide) * childSize, static_cast<float> (i / childrenPerSide) * childSize, childSize - 1.0f, childSize - 1.0f });
+            }
+        }
+    }
+
+    void enableHitTestIndex (bool shouldBeEnabled)
+    {
+        root.enableHitTestIndex (shouldBeEnabled);
+
+        for (auto& group : groups)
+            group->enableHitTestIndex (shouldBeEnabled);
+    }
+
+    Component root;
+    std::vector<std::unique_ptr<Component>> groups;
+    std::vector<std::unique_ptr<Component>> leaves;
+};
+
+std::vector<Point<float>> makeMouseMoves (const Rectangle<float>& area, int numMoves)
+{
+    Random random (12345);
+
+    std::vector<Point<float>> moves;
+    moves.reserve (static_cast<std::size_t> (numMoves));
+
+    // A random walk, like a pointer being dragged around
+    Point<float> position = area.getCenter();
+    for (int i = 0; i < numMoves; ++i)
+    {
+        position = Point<float> (jlimit (area.getX(), area.getX() + area.getWidth() - 1.0f, position.getX() + random.nextFloat() * 16.0f - 8.0f),
+                                 jlimit (area.getY(), area.getY() + area.getHeight() - 1.0f, position.getY() + random.nextFloat() * 16.0f - 8.0f));
+
+        moves.push_back (position);
+    }
+
+    return moves;
+}
+
+} // namespace
+
+TEST (ComponentTests, HitTestIndexIsDisabledByDefault)
+{
+    Component component;
+    EXPECT_FALSE (component.isHitTestIndexEnabled());
+
+    component.enableHitTestIndex (true);
+    EXPECT_TRUE (component.isHitTestIndexEnabled());
+
+    component.enableHitTestIndex (false);
+    EXPECT_FALSE (component.isHitTestIndexEnabled());
+}
+
+TEST (ComponentTests, HitTestIndexMatchesLinearSearch)
+{
+    ComponentTree tree (4, 16, 10.0f);
+
+    Random random (42);
+    std::vector<Point<float>> points;
+    for (int i = 0; i < 2000; ++i)
+        points.emplace_back (random.nextFloat() * 330.0f - 5.0f, random.nextFloat() * 330.0f - 5.0f);
+
+    std::vector<Component*> expected;
+    for (const auto& p : points)
+        expected.push_back (tree.root.findComponentAt (p));
+
+    tree.enableHitTestIndex (true);
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+        EXPECT_EQ (tree.root.findComponentAt (points[i]), expected[i]);
+}
+
+TEST (ComponentTests, HitTestIndexHonoursZOrder)
+{
+    Component parent, below, above;
+    parent.setVisible (true);
+    parent.setBounds ({ 0.0f, 0.0f, 100.0f, 100.0f });
+    parent.enableHitTestIndex (true);
+
+    parent.addAndMakeVisible (below);
+    parent.addAndMakeVisible (above);
+    below.setBounds ({ 0.0f, 0.0f, 60.0f, 60.0f });
+    above.setBounds ({ 40.0f, 40.0f, 60.0f, 60.0f });
+
+    EXPECT_EQ (parent.findComponentAt ({ 50.0f, 50.0f }), &above);
+    EXPECT_EQ (parent.findComponentAt ({ 10.0f, 10.0f }), &below);
+    EXPECT_EQ (parent.findComponentAt ({ 90.0f, 10.0f }), &parent);
+
+    below.toFront();
+    EXPECT_EQ (parent.findComponentAt ({ 50.0f, 50.0f }), &below);
+}
+
+TEST (ComponentTests, HitTestIndexFollowsChanges)
+{
+    Component parent, child;
+    parent.setVisible (true);
+    parent.setBounds ({ 0.0f, 0.0f, 100.0f, 100.0f });
+    parent.enableHitTestIndex (true);
+
+    parent.addAndMakeVisible (child);
+    child.setBounds ({ 0.0f, 0.0f, 10.0f, 10.0f });
+    EXPECT_EQ (parent.findComponentAt ({ 5.0f, 5.0f }), &child);
+
+    child.setBounds ({ 80.0f, 80.0f, 10.0f, 10.0f });
+    EXPECT_EQ (parent.findComponentAt ({ 5.0f, 5.0f }), &parent);
+    EXPECT_EQ (parent.findComponentAt ({ 85.0f, 85.0f }), &child);
+
+    child.setSize ({ 15.0f, 15.0f });
+    EXPECT_EQ (parent.findComponentAt ({ 92.0f, 92.0f }), &child);
+
+    child.setVisible (false);
+    EXPECT_EQ (parent.findComponentAt ({ 85.0f, 85.0f }), &parent);
+
+    child.setVisible (true);
+    EXPECT_EQ (parent.findComponentAt ({ 85.0f, 85.0f }), &child);
+
+    parent.setSize ({ 50.0f, 50.0f });
+    EXPECT_EQ (parent.findComponentAt ({ 85.0f, 85.0f }), nullptr);
+
+    parent.setSize ({ 100.0f, 100.0f });
+    EXPECT_EQ (parent.findComponentAt ({ 85.0f, 85.0f }), &child);
+
+    parent.removeChildComponent (child);
+    EXPECT_EQ (parent.findComponentAt ({ 85.0f, 85.0f }), &parent);
+}
+
+TEST (ComponentTests, DISABLED_HitTestIndexMouseMoveBenchmark)
+{
+    constexpr int numMoves = 200000;
+
+    ComponentTree tree (16, 32, 8.0f);
+    const auto moves = makeMouseMoves (tree.root.getLocalBounds(), numMoves);
+
+    std::vector<Component*> expected;
+    expected.reserve (moves.size());
+
+    const auto linearStart = Time::getMillisecondCounterHiRes();
+    for (const auto& p : moves)
+        expected.push_back (tree.root.findComponentAt (p));
+    const auto linearMs = Time::getMillisecondCounterHiRes() - linearStart;
+
+    tree.enableHitTestIndex (true);
+
+    int numMismatches = 0;
+
+    const auto indexedStart = Time::getMillisecondCounterHiRes();
+    for (std::size_t i = 0; i < moves.size(); ++i)
+        numMismatches += tree.root.findComponentAt (moves[i]) != expected[i] ? 1 : 0;
+    const auto indexedMs = Time::getMillisecondCounterHiRes() - indexedStart;
+
+    EXPECT_EQ (numMismatches, 0);
+
+    std::cout << "Hit testing " << numMoves << " mouse moves over " << tree.leaves.size() << " components: "
+              << "linear " << linearMs << " ms, indexed " << indexedMs << " ms" << std::endl;
+}
+
+TEST (ComponentTests, BoundsRelativeToAncestorFollowsMoves)
+{
+    Component root, group, child;
+    root.setBounds ({ 10.0f, 10.0f, 200.0f, 200.0f });
+    root.addChildComponent (group);
+    group.setBounds ({ 20.0f, 30.0f, 100.0f, 100.0f });
+    group.addChildComponent (child);
+    child.setBounds ({ 5.0f, 6.0f, 10.0f, 10.0f });
+
+    EXPECT_EQ (child.getBoundsRelativeToAncestor(), Rectangle<float> (35.0f, 46.0f, 10.0f, 10.0f));
+
+    group.setBounds ({ 40.0f, 50.0f, 100.0f, 100.0f });
+    EXPECT_EQ (child.getBoundsRelativeToAncestor(), Rectangle<float> (55.0f, 66.0f, 10.0f, 10.0f));
+
+    root.setBounds ({ 0.0f, 0.0f, 200.0f, 200.0f });
+    EXPECT_EQ (child.getBoundsRelativeToAncestor(), Rectangle<float> (45.0f, 56.0f, 10.0f, 10.0f));
+
+    group.setSize ({ 50.0f, 50.0f });
+    child.setSize ({ 20.0f, 20.0f });
+    EXPECT_EQ (child.getBoundsRelativeToAncestor(), Rectangle<float> (45.0f, 56.0f, 20.0f, 20.0f));
+}
+
+TEST (ComponentTests, BoundsRelativeToAncestorFollowsReparenting)
+{
+    Component first, second, child;
+    first.setBounds ({ 10.0f, 0.0f, 100.0f, 100.0f });
+    second.setBounds ({ 0.0f, 20.0f, 100.0f, 100.0f });
+    child.setBounds ({ 1.0f, 2.0f, 10.0f, 10.0f });
+
+    first.addChildComponent (child);
+    EXPECT_EQ (child.getBoundsRelativeToAncestor().getPosition(), Point<float> (11.0f, 2.0f));
+
+    first.removeChildComponent (child);
+    EXPECT_EQ (child.getBoundsRelativeToAncestor().getPosition(), Point<float> (1.0f, 2.0f));
+
+    second.addChildComponent (child);
+    EXPECT_EQ (child.getBoundsRelativeToAncestor().getPosition(), Point<float> (1.0f, 22.0f));
+
+    first.addChildComponent (second);
+    EXPECT_EQ (child.getBoundsRelativeToAncestor().getPosition(), Point<float> (11.0f, 22.0f));
+}
+
+TEST (ComponentTests, BoundsRelativeToAncestorFollowsNestedReparenting)
+{
+    Component first, second, group, child;
+    first.setBounds ({ 10.0f, 0.0f, 100.0f, 100.0f });
+    second.setBounds ({ 0.0f, 20.0f, 100.0f, 100.0f });
+    group.setBounds ({ 5.0f, 5.0f, 50.0f, 50.0f });
+    child.setBounds ({ 1.0f, 2.0f, 10.0f, 10.0f });
+
+    group.addChildComponent (child);
+    first.addChildComponent (group);
+    EXPECT_EQ (child.getBoundsRelativeToAncestor().getPosition(), Point<float> (16.0f, 7.0f));
+
+    first.removeChildComponent (group);
+    EXPECT_EQ (child.getBoundsRelativeToAncestor().getPosition(), Point<float> (6.0f, 7.0f));
+
+    second.addChildComponent (group);
+    EXPECT_EQ (child.getBoundsRelativeToAncestor().getPosition(), Point<float> (6.0f, 27.0f));
+
+    first.addChildComponent (second);
+    EXPECT_EQ (child.getBoundsRelativeToAncestor().getPosition(), Point<float> (16.0f, 27.0f));
+}
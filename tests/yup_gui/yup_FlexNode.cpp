@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+   This file is part of the YUP library.
+   Copyright (c) 2024 - kunitoki@gmail.com
+
+   YUP is an open source library subject to open-source licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   to use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   YUP IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include <gtest/gtest.h>
+
+#include <yup_gui/yup_gui.h>
+
+using namespace yup;
+
+namespace
+{
+
+struct CountingComponent : Component
+{
+    void resized() override { ++numResized; }
+
+    int numResized = 0;
+};
+
+} // namespace
+
+TEST (FlexNodeTests, RowDistributesSpace)
+{
+    Component container;
+    CountingComponent fixed, flexible;
+    container.addChildComponent (fixed);
+    container.addChildComponent (flexible);
+    container.setBounds ({ 0.0f, 0.0f, 300.0f, 100.0f });
+
+    FlexNode root (container), fixedNode (fixed), flexibleNode (flexible);
+    root.setDirection (FlexNode::Direction::Row).setPadding (FlexNode::Edge::All, 10.0f).setGap (5.0f);
+    root.addChild (fixedNode.setWidth (100.0f));
+    root.addChild (flexibleNode.setFlexGrow (1.0f));
+
+    EXPECT_EQ (root.performLayout(), 2);
+    EXPECT_EQ (fixed.getBounds(), Rectangle<float> (10.0f, 10.0f, 100.0f, 80.0f));
+    EXPECT_EQ (flexible.getBounds(), Rectangle<float> (115.0f, 10.0f, 175.0f, 80.0f));
+}
+
+TEST (FlexNodeTests, UnchangedLayoutDoesNotTouchComponents)
+{
+    Component container;
+    CountingComponent first, second;
+    container.addChildComponent (first);
+    container.addChildComponent (second);
+    container.setBounds ({ 0.0f, 0.0f, 200.0f, 100.0f });
+
+    FlexNode root (container), firstNode (first), secondNode (second);
+    root.setDirection (FlexNode::Direction::Row);
+    root.addChild (firstNode.setFlexGrow (1.0f));
+    root.addChild (secondNode.setWidth (50.0f));
+
+    root.performLayout();
+    EXPECT_EQ (first.numResized, 1);
+    EXPECT_EQ (second.numResized, 1);
+    EXPECT_FALSE (root.isDirty());
+
+    EXPECT_EQ (root.performLayout(), 0);
+    EXPECT_EQ (first.numResized, 1);
+    EXPECT_EQ (second.numResized, 1);
+
+    // Only the flexible child changes when the container grows
+    container.setSize ({ 300.0f, 100.0f });
+    EXPECT_EQ (root.performLayout(), 2);
+    EXPECT_EQ (first.getBounds(), Rectangle<float> (0.0f, 0.0f, 250.0f, 100.0f));
+    EXPECT_EQ (second.getBounds(), Rectangle<float> (250.0f, 0.0f, 50.0f, 100.0f));
+    EXPECT_EQ (first.numResized, 2);
+}
+
+TEST (FlexNodeTests, StyleChangeOnlyRelayoutsAffectedBranch)
+{
+    Component container, left, right;
+    CountingComponent leftA, leftB, rightA, rightB;
+    container.addChildComponent (left);
+    container.addChildComponent (right);
+    left.addChildComponent (leftA);
+    left.addChildComponent (leftB);
+    right.addChildComponent (rightA);
+    right.addChildComponent (rightB);
+    container.setBounds ({ 0.0f, 0.0f, 400.0f, 200.0f });
+
+    FlexNode root (container), leftNode (left), rightNode (right);
+    FlexNode leftANode (leftA), leftBNode (leftB), rightANode (rightA), rightBNode (rightB);
+
+    root.setDirection (FlexNode::Direction::Row);
+    root.addChild (leftNode.setWidth (200.0f));
+    root.addChild (rightNode.setFlexGrow (1.0f));
+    leftNode.addChild (leftANode.setFlexGrow (1.0f));
+    leftNode.addChild (leftBNode.setFlexGrow (1.0f));
+    rightNode.addChild (rightANode.setFlexGrow (1.0f));
+    rightNode.addChild (rightBNode.setFlexGrow (1.0f));
+
+    root.performLayout();
+    EXPECT_EQ (leftA.getBounds(), Rectangle<float> (0.0f, 0.0f, 200.0f, 100.0f));
+    EXPECT_EQ (rightB.getBounds(), Rectangle<float> (0.0f, 100.0f, 200.0f, 100.0f));
+
+    leftANode.setFlexGrow (3.0f);
+    EXPECT_TRUE (root.isDirty());
+    EXPECT_FALSE (rightNode.isDirty());
+
+    EXPECT_EQ (root.performLayout(), 2);
+    EXPECT_EQ (leftA.getBounds(), Rectangle<float> (0.0f, 0.0f, 200.0f, 150.0f));
+    EXPECT_EQ (leftB.getBounds(), Rectangle<float> (0.0f, 150.0f, 200.0f, 50.0f));
+    EXPECT_EQ (rightA.numResized, 1);
+    EXPECT_EQ (rightB.numResized, 1);
+}
+
+TEST (FlexNodeTests, MeasuredContentChange)
+{
+    Component container;
+    CountingComponent label, filler;
+    container.addChildComponent (label);
+    container.addChildComponent (filler);
+    container.setBounds ({ 0.0f, 0.0f, 300.0f, 50.0f });
+
+    float textWidth = 40.0f;
+
+    FlexNode root (container), labelNode (label), fillerNode (filler);
+    root.setDirection (FlexNode::Direction::Row);
+    root.addChild (labelNode);
+    root.addChild (fillerNode.setFlexGrow (1.0f));
+
+    labelNode.setMeasureFunction ([&textWidth] (float maxWidth, float)
+    {
+        return Size<float> (jmin (textWidth, maxWidth), 20.0f);
+    });
+
+    root.performLayout();
+    EXPECT_EQ (label.getBounds(), Rectangle<float> (0.0f, 0.0f, 40.0f, 50.0f));
+    EXPECT_EQ (filler.getBounds(), Rectangle<float> (40.0f, 0.0f, 260.0f, 50.0f));
+
+    textWidth = 100.0f;
+    EXPECT_EQ (root.performLayout(), 0);
+
+    labelNode.markDirty();
+    EXPECT_EQ (root.performLayout(), 2);
+    EXPECT_EQ (label.getBounds(), Rectangle<float> (0.0f, 0.0f, 100.0f, 50.0f));
+    EXPECT_EQ (filler.getBounds(), Rectangle<float> (100.0f, 0.0f, 200.0f, 50.0f));
+}
+
+TEST (FlexNodeTests, LayoutGroupsOffsetTheirChildren)
+{
+    Component container, first, second;
+    container.addChildComponent (first);
+    container.addChildComponent (second);
+    container.setBounds ({ 0.0f, 0.0f, 200.0f, 200.0f });
+
+    FlexNode root (container), spacer, group, firstNode (first), secondNode (second);
+    root.addChild (spacer.setHeight (50.0f));
+    root.addChild (group.setDirection (FlexNode::Direction::Row).setHeight (20.0f));
+    group.addChild (firstNode.setWidth (30.0f));
+    group.addChild (secondNode.setWidth (30.0f));
+
+    root.performLayout();
+    EXPECT_EQ (first.getBounds(), Rectangle<float> (0.0f, 50.0f, 30.0f, 20.0f));
+    EXPECT_EQ (second.getBounds(), Rectangle<float> (30.0f, 50.0f, 30.0f, 20.0f));
+
+    // Moving the group without changing its size still moves the components inside it
+    spacer.setHeight (80.0f);
+    EXPECT_EQ (root.performLayout(), 2);
+    EXPECT_EQ (first.getBounds(), Rectangle<float> (0.0f, 80.0f, 30.0f, 20.0f));
+    EXPECT_EQ (second.getBounds(), Rectangle<float> (30.0f, 80.0f, 30.0f, 20.0f));
+}
+
+TEST (FlexNodeTests, ChildrenCanBeRemovedAndDestroyed)
+{
+    Component container, first, second;
+    container.addChildComponent (first);
+    container.addChildComponent (second);
+    container.setBounds ({ 0.0f, 0.0f, 100.0f, 100.0f });
+
+    FlexNode root (container), firstNode (first);
+    root.addChild (firstNode.setFlexGrow (1.0f));
+
+    {
+        FlexNode secondNode (second);
+        root.addChild (secondNode.setFlexGrow (1.0f));
+        EXPECT_EQ (root.getNumChildren(), 2);
+
+        root.performLayout();
+        EXPECT_EQ (first.getBounds(), Rectangle<float> (0.0f, 0.0f, 100.0f, 50.0f));
+    }
+
+    EXPECT_EQ (root.getNumChildren(), 1);
+
+    root.performLayout();
+    EXPECT_EQ (first.getBounds(), Rectangle<float> (0.0f, 0.0f, 100.0f, 100.0f));
+
+    root.removeChild (firstNode);
+    EXPECT_EQ (root.getNumChildren(), 0);
+    EXPECT_EQ (firstNode.getParent(), nullptr);
+}